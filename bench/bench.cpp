@@ -0,0 +1,380 @@
+/*
+ * This file is part of Susa.
+ *
+ * Susa is free software: you can redistribute it and/or modify
+ * it under the terms of the Lesser GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * at your option) any later version.
+ *
+ * Susa is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * Lesser GNU General Public License for more details.
+ *
+ * You should have received a copy of the Lesser GNU General Public License
+ * along with Susa.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file bench.cpp
+ * @brief The micro-benchmarks of the hot kernels.
+ *
+ * Usage: susa_bench [--filter NAME] [--json FILE] [--repeats N] [--min-time SECONDS] [--quick]
+ *
+ * @author Behrooz Kamary
+ * @version 1.0.0
+ */
+
+#include "bench.h"
+
+using namespace susa;
+
+static std::string param(const std::string& str_key, size_t sizet_value)
+{
+    std::ostringstream oss;
+    oss << str_key << "=" << sizet_value;
+    return oss.str();
+}
+
+static void bench_matmul(bench_runner& runner, bool bool_quick)
+{
+    rng rng_gen(11);
+    size_t sizet_sizes[] = {64, 128, 256, 512};
+
+    for (size_t sizet_n : sizet_sizes)
+    {
+        if (bool_quick && sizet_n > 128) break;
+        matrix <double> mat_a = rng_gen.randn(sizet_n * sizet_n);
+        matrix <double> mat_b = rng_gen.randn(sizet_n * sizet_n);
+        mat_a.resize(sizet_n, sizet_n);
+        mat_b.resize(sizet_n, sizet_n);
+
+        runner.run("matmul<double>", param("n", sizet_n), 2.0 * sizet_n * sizet_n * sizet_n, "GFLOP/s", 1e-9, [&]()
+        {
+            matrix <double> mat_c = matmul(mat_a, mat_b);
+            do_not_optimize(mat_c(0));
+        });
+    }
+}
+
+static void bench_filter(bench_runner& runner, bool bool_quick)
+{
+    rng rng_gen(13);
+    size_t sizet_len = bool_quick ? 1 << 14 : 1 << 18;
+    matrix <double> mat_x = rng_gen.randn(sizet_len);
+    size_t sizet_taps[] = {8, 64, 512};
+
+    for (size_t sizet_t : sizet_taps)
+    {
+        matrix <double> mat_b = rng_gen.randn(sizet_t);
+        runner.run("filter_fir<double>", param("taps", sizet_t), sizet_len, "Msamples/s", 1e-6, [&]()
+        {
+            matrix <double> mat_y = filter(mat_b, matrix <double> (1, 1, 1), mat_x);
+            do_not_optimize(mat_y(0));
+        });
+    }
+}
+
+static void bench_fft(bench_runner& runner, bool bool_quick)
+{
+    size_t sizet_sizes[] = {256, 4096, 65536};
+
+    for (size_t sizet_n : sizet_sizes)
+    {
+        if (bool_quick && sizet_n > 4096) break;
+        fft_plan <double> plan(sizet_n);
+        std::vector <std::complex <double> > vec_data(sizet_n, std::complex <double> (1, -1));
+
+        // the conventional 5 N log2(N) operations of a radix-2 transform
+        runner.run("fft<double>", param("n", sizet_n), 5.0 * sizet_n * std::log2(static_cast <double> (sizet_n)), "GFLOP/s", 1e-9, [&]()
+        {
+            plan.forward(vec_data.data());
+            do_not_optimize(vec_data[0]);
+        });
+    }
+}
+
+static void bench_bcjr(bench_runner& runner, bool bool_quick)
+{
+    rng rng_gen(17);
+    size_t sizet_len = bool_quick ? 1 << 10 : 1 << 14;
+    unsigned int uint_memories[] = {2, 4, 6};
+    unsigned int uint_gens[][2] = {{07, 05}, {031, 033}, {0171, 0133}};
+
+    for (size_t sizet_i = 0; sizet_i < 3; sizet_i++)
+    {
+        ccode code(2, 1, uint_memories[sizet_i]);
+        code.set_generator(uint_gens[sizet_i][0], 0);
+        code.set_generator(uint_gens[sizet_i][1], 1);
+
+        matrix <uint8_t> mat_bits  = rng_gen.bernoulli(sizet_len);
+        matrix <double>  mat_tx    = bpsk(code.encode(mat_bits));
+        matrix <double>  mat_noisy = mat_tx + 0.7 * rng_gen.randn(2 * sizet_len);
+
+        runner.run("ccode::decode_bcjr", param("memory", uint_memories[sizet_i]), sizet_len, "Mbit/s", 1e-6, [&]()
+        {
+            matrix <double> mat_llr = code.decode_bcjr(mat_noisy, 2.0);
+            do_not_optimize(mat_llr(0));
+        });
+    }
+}
+
+static void bench_viterbi(bench_runner& runner, bool bool_quick)
+{
+    // the float and the saturating fixed-point path metrics of a 64-state code
+    rng rng_gen(23);
+    size_t sizet_len = bool_quick ? 1 << 10 : 1 << 14;
+
+    ccode code(2, 1, 6);
+    code.set_generator(0171, 0);
+    code.set_generator(0133, 1);
+
+    matrix <uint8_t> mat_bits  = rng_gen.bernoulli(sizet_len);
+    matrix <double>  mat_tx    = bpsk(code.encode(mat_bits));
+    matrix <double>  mat_noisy = mat_tx + 0.7 * rng_gen.randn(2 * sizet_len);
+
+    runner.run("decode_viterbi<float>", param("memory", 6), sizet_len, "Mbit/s", 1e-6, [&]()
+    {
+        matrix <uint8_t> mat_hat = code.decode_viterbi <float> (mat_noisy, llr_quantizer());
+        do_not_optimize(mat_hat(0));
+    });
+
+    runner.run("decode_viterbi<int16>", param("memory", 6), sizet_len, "Mbit/s", 1e-6, [&]()
+    {
+        matrix <uint8_t> mat_hat = code.decode_viterbi <int16_t> (mat_noisy, llr_quantizer(64, 8));
+        do_not_optimize(mat_hat(0));
+    });
+
+    runner.run("decode_viterbi<int8>", param("memory", 6), sizet_len, "Mbit/s", 1e-6, [&]()
+    {
+        matrix <uint8_t> mat_hat = code.decode_viterbi <int8_t> (mat_noisy, llr_quantizer(4, 4));
+        do_not_optimize(mat_hat(0));
+    });
+}
+
+static void bench_turbo(bench_runner& runner, bool bool_quick)
+{
+    // the iterations to the maximum against the early termination at a high SNR
+    rng rng_gen(29);
+    size_t sizet_len = bool_quick ? 1 << 10 : 1 << 12;
+
+    ccode code_1(2, 1, 2), code_2(2, 1, 2);
+    code_1.set_generator(07, 0);
+    code_1.set_generator(05, 1);
+    code_2.set_generator(07, 0);
+    code_2.set_generator(05, 1);
+    turbo tcode(code_1, code_2, random_interleaver(sizet_len, 3));
+
+    matrix <uint8_t> mat_bits  = rng_gen.bernoulli(sizet_len);
+    matrix <double>  mat_tx    = bpsk(tcode.encode(mat_bits));
+    matrix <double>  mat_noisy = mat_tx + 0.8 * rng_gen.randn(mat_tx.size());
+
+    bool bool_early[] = {false, true};
+    for (size_t sizet_i = 0; sizet_i < 2; sizet_i++)
+    {
+        tcode.set_early_termination(bool_early[sizet_i]);
+        runner.run("turbo::decode", param("early", sizet_i), sizet_len, "Mbit/s", 1e-6, [&]()
+        {
+            matrix <uint8_t> mat_hat = tcode.decode(mat_noisy, 0.78);
+            do_not_optimize(mat_hat(0));
+        });
+    }
+}
+
+static void bench_demapper(bench_runner& runner, bool bool_quick)
+{
+    // the soft demapping of the square QAMs into a preallocated buffer
+    rng rng_gen(37);
+    size_t sizet_len = bool_quick ? 1 << 10 : 1 << 14;
+
+    matrix <std::complex <double> > mat_rx(sizet_len, 1);
+    matrix <double> mat_llr;
+
+    unsigned int uint_orders[] = {16, 64, 256};
+    for (size_t sizet_i = 0; sizet_i < 3; sizet_i++)
+    {
+        qam qam_m(uint_orders[sizet_i]);
+        rng_gen.fill_complex_normal(mat_rx, std::sqrt(static_cast <double> (uint_orders[sizet_i])) / 2);
+
+        runner.run("qam::demodulate_llr", param("m", uint_orders[sizet_i]), sizet_len, "Msym/s", 1e-6, [&]()
+        {
+            qam_m.demodulate_llr(mat_rx, 0.5, mat_llr);
+            do_not_optimize(mat_llr(0));
+        });
+    }
+}
+
+static void bench_mlse(bench_runner& runner, bool bool_quick)
+{
+    rng rng_gen(19);
+    size_t sizet_len = bool_quick ? 1 << 10 : 1 << 14;
+    matrix <double> mat_pam("-1;1");
+    size_t sizet_taps[] = {3, 5, 7};
+
+    for (size_t sizet_t : sizet_taps)
+    {
+        matrix <double> mat_taps = rng_gen.randn(sizet_t);
+        mat_taps.resize(1, sizet_t);
+        channel <double> ch(mat_taps, mat_pam);
+
+        matrix <double> mat_symbols = bpsk(rng_gen.bernoulli(sizet_len));
+        mat_symbols.resize(1, sizet_len);
+        matrix <double> mat_rx    = filter(mat_taps, matrix <double> (1, 1, 1), mat_symbols);
+        matrix <double> mat_noise = 0.1 * rng_gen.randn(mat_rx.size());
+        mat_noise.resize(mat_rx.no_rows(), mat_rx.no_cols());
+        mat_rx += mat_noise;
+
+        runner.run("channel::decode_mlse", param("taps", sizet_t), sizet_len, "Msymbols/s", 1e-6, [&]()
+        {
+            matrix <double> mat_eq = ch.decode_mlse(mat_rx, 0);
+            do_not_optimize(mat_eq(0));
+        });
+    }
+
+    // the reduced-state detector of the long channels
+    size_t sizet_long[] = {7, 16};
+    for (size_t sizet_t : sizet_long)
+    {
+        matrix <double> mat_taps = rng_gen.randn(sizet_t);
+        mat_taps.resize(1, sizet_t);
+        rsse_equalizer <double> eq(mat_taps, mat_pam, 16, 4);
+
+        matrix <double> mat_symbols = bpsk(rng_gen.bernoulli(sizet_len));
+        mat_symbols.resize(1, sizet_len);
+        matrix <double> mat_rx = filter(mat_taps, matrix <double> (1, 1, 1), mat_symbols);
+
+        runner.run("rsse_equalizer::decode", param("taps", sizet_t) + " M=16", sizet_len, "Msymbols/s", 1e-6, [&]()
+        {
+            matrix <double> mat_eq = eq.decode(mat_rx, 0);
+            do_not_optimize(mat_eq(0));
+        });
+    }
+}
+
+static void bench_rng(bench_runner& runner, bool bool_quick)
+{
+    rng rng_gen(23);
+    size_t sizet_len = bool_quick ? 1 << 14 : 1 << 20;
+
+    runner.run("rng::randn", param("n", sizet_len), sizet_len, "Msamples/s", 1e-6, [&]()
+    {
+        matrix <double> mat_n = rng_gen.randn(sizet_len);
+        do_not_optimize(mat_n(0));
+    });
+
+    runner.run("rng::bernoulli", param("n", sizet_len), sizet_len, "Msamples/s", 1e-6, [&]()
+    {
+        matrix <uint8_t> mat_b = rng_gen.bernoulli(sizet_len);
+        do_not_optimize(mat_b(0));
+    });
+}
+
+static void bench_complex_mul(bench_runner& runner, bool)
+{
+    // the element-wise product of the interleaved and the planar complex layouts
+    const size_t sizet_len = 4096;
+    rng rng_gen(41);
+    matrix <std::complex <double> > mat_a(sizet_len, 1), mat_b(sizet_len, 1);
+    for (size_t sizet_i = 0; sizet_i < sizet_len; sizet_i++)
+    {
+        mat_a(sizet_i) = std::complex <double> (rng_gen.randn(), rng_gen.randn());
+        mat_b(sizet_i) = std::complex <double> (rng_gen.randn(), rng_gen.randn());
+    }
+    cmatrix <double> cmat_a(mat_a), cmat_b(mat_b);
+
+    runner.run("complex_mul<double>", param("n", sizet_len) + " interleaved", sizet_len, "Msamples/s", 1e-6, [&]()
+    {
+        matrix <std::complex <double> > mat_c = mat_a * mat_b;
+        do_not_optimize(mat_c(0));
+    });
+
+    runner.run("complex_mul<double>", param("n", sizet_len) + " planar", sizet_len, "Msamples/s", 1e-6, [&]()
+    {
+        cmatrix <double> cmat_c = cmat_a * cmat_b;
+        do_not_optimize(cmat_c.real()(0));
+    });
+}
+
+static void bench_small_solve(bench_runner& runner, bool)
+{
+    // a 4x4 MIMO channel of a subcarrier, the heap-backed and the fixed-size matrix
+    rng rng_gen(37);
+    matrix <double> mat_h = rng_gen.randn(16);
+    matrix <double> mat_y = rng_gen.randn(4);
+    mat_h.resize(4, 4);
+    for (size_t sizet_i = 0; sizet_i < 4; sizet_i++) mat_h(sizet_i, sizet_i) += 4;
+
+    fixed_matrix <double, 4, 4> fmat_h(mat_h);
+    fixed_vector <double, 4>    fvec_y(mat_y);
+
+    runner.run("linsolve<double>", "n=4 matrix", 1, "Msolves/s", 1e-6, [&]()
+    {
+        matrix <double> mat_x = linsolve(mat_h, mat_y);
+        do_not_optimize(mat_x(0));
+    });
+
+    runner.run("linsolve<double>", "n=4 fixed_matrix", 1, "Msolves/s", 1e-6, [&]()
+    {
+        fixed_vector <double, 4> fvec_x = linsolve(fmat_h, fvec_y);
+        do_not_optimize(fvec_x(0));
+    });
+}
+
+int main(int argc, char* argv[])
+{
+    std::string str_filter;
+    std::string str_json;
+    size_t      sizet_repeats = 9;
+    double      dbl_min_time  = 0.05;
+    bool        bool_quick    = false;
+
+    for (int int_i = 1; int_i < argc; int_i++)
+    {
+        std::string str_arg = argv[int_i];
+        if (str_arg == "--filter" && int_i + 1 < argc) str_filter = argv[++int_i];
+        else if (str_arg == "--json" && int_i + 1 < argc) str_json = argv[++int_i];
+        else if (str_arg == "--repeats" && int_i + 1 < argc) sizet_repeats = std::strtoul(argv[++int_i], nullptr, 10);
+        else if (str_arg == "--min-time" && int_i + 1 < argc) dbl_min_time = std::strtod(argv[++int_i], nullptr);
+        else if (str_arg == "--quick") bool_quick = true;
+        else
+        {
+            std::cerr << "usage: " << argv[0] << " [--filter NAME] [--json FILE] [--repeats N] [--min-time SECONDS] [--quick]" << std::endl;
+            return 1;
+        }
+    }
+
+    if (bool_quick)
+    {
+        sizet_repeats = std::min <size_t> (sizet_repeats, 3);
+        dbl_min_time  = std::min(dbl_min_time, 0.01);
+    }
+
+    bench_runner runner(2, sizet_repeats, dbl_min_time);
+    runner.set_filter(str_filter);
+
+    bench_runner::print_header(std::cout);
+    bench_matmul(runner, bool_quick);
+    bench_filter(runner, bool_quick);
+    bench_fft(runner, bool_quick);
+    bench_bcjr(runner, bool_quick);
+    bench_viterbi(runner, bool_quick);
+    bench_turbo(runner, bool_quick);
+    bench_demapper(runner, bool_quick);
+    bench_mlse(runner, bool_quick);
+    bench_rng(runner, bool_quick);
+    bench_complex_mul(runner, bool_quick);
+    bench_small_solve(runner, bool_quick);
+
+    if (!str_json.empty())
+    {
+        std::ofstream ofs(str_json.c_str());
+        runner.print_json(ofs);
+        if (!ofs.good())
+        {
+            std::cerr << "the JSON report can not be written." << std::endl;
+            return 1;
+        }
+    }
+
+    return 0;
+}
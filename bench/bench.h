@@ -0,0 +1,191 @@
+/*
+ * This file is part of Susa.
+ *
+ * Susa is free software: you can redistribute it and/or modify
+ * it under the terms of the Lesser GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * at your option) any later version.
+ *
+ * Susa is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * Lesser GNU General Public License for more details.
+ *
+ * You should have received a copy of the Lesser GNU General Public License
+ * along with Susa.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file bench.h
+ * @brief The micro-benchmark harness.
+ *
+ * A benchmark is warmed up, then every sample times a batch of calls that
+ * lasts at least a minimum duration. The median and the median absolute
+ * deviation (MAD) of the samples are robust to the outliers of an
+ * interrupted run.
+ *
+ * @author Behrooz Kamary
+ * @version 1.0.0
+ */
+
+#ifndef SUSA_BENCH_H
+#define SUSA_BENCH_H
+
+#include <susa.h>
+#include <chrono>
+#include <iomanip>
+
+namespace susa {
+
+//! Keeps the compiler from removing the computation of a value
+template <class T> inline void do_not_optimize(const T& T_arg)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    __asm__ __volatile__("" : : "g"(&T_arg) : "memory");
+#else
+    volatile const char* ptr_sink = reinterpret_cast <volatile const char*> (&T_arg);
+    (void) *ptr_sink;
+#endif
+}
+
+//! The measurement of a benchmark
+struct bench_result
+{
+    std::string str_name;       //!< the benchmark name
+    std::string str_params;     //!< the parameters e.g. "n=256"
+    double      dbl_median;     //!< the median time of a call in seconds
+    double      dbl_mad;        //!< the median absolute deviation in seconds
+    double      dbl_work;       //!< the work of a call in <i>str_unit</i>
+    std::string str_unit;       //!< the unit of the rate e.g. "GFLOP/s"
+    double      dbl_scale;      //!< the scale of the rate e.g. 1e-9 for GFLOP/s
+    size_t      sizet_calls;    //!< the number of calls per sample
+};
+
+/**
+ * @brief The <i>bench_runner</i> class.
+ *
+ * It measures the benchmarks whose names contain the filter and keeps
+ * their results for the text and the JSON reports.
+ */
+class bench_runner
+{
+  public:
+    /**
+     * @brief Constructor
+     *
+     * @param sizet_warmup the number of calls before the measurement
+     * @param sizet_repeats the number of samples
+     * @param dbl_min_time the minimum duration of a sample in seconds
+     */
+    bench_runner(size_t sizet_warmup = 2, size_t sizet_repeats = 9, double dbl_min_time = 0.05)
+    : sizet_warmup(sizet_warmup)
+    , sizet_repeats(std::max <size_t> (1, sizet_repeats))
+    , dbl_min_time(dbl_min_time)
+    {
+    }
+
+    //! Runs only the benchmarks whose names contain the string
+    void set_filter(const std::string& str_arg)
+    {
+        str_filter = str_arg;
+    }
+
+    /**
+     * @brief Measures a benchmark
+     *
+     * @param str_name the benchmark name
+     * @param str_params the parameters
+     * @param dbl_work the work of a call e.g. the floating-point operations
+     * @param str_unit the unit of the rate
+     * @param dbl_scale the scale of the rate
+     * @param func the call
+     */
+    template <class F> void run(const std::string& str_name, const std::string& str_params, double dbl_work,
+      const std::string& str_unit, double dbl_scale, F func)
+    {
+        if (str_name.find(str_filter) == std::string::npos) return;
+
+        typedef std::chrono::steady_clock clock;
+        for (size_t sizet_w = 0; sizet_w < sizet_warmup; sizet_w++) func();
+
+        // the batch grows until it is long enough for the clock
+        size_t sizet_calls = 1;
+        for (;;)
+        {
+            clock::time_point tp_start = clock::now();
+            for (size_t sizet_c = 0; sizet_c < sizet_calls; sizet_c++) func();
+            double dbl_elapsed = std::chrono::duration <double> (clock::now() - tp_start).count();
+            if (dbl_elapsed >= dbl_min_time || sizet_calls >= (1u << 30)) break;
+            sizet_calls = dbl_elapsed > 0 ? std::max <size_t> (sizet_calls * 2, sizet_calls * 1.2 * dbl_min_time / dbl_elapsed) : sizet_calls * 10;
+        }
+
+        std::vector <double> vec_samples(sizet_repeats);
+        for (size_t sizet_r = 0; sizet_r < sizet_repeats; sizet_r++)
+        {
+            clock::time_point tp_start = clock::now();
+            for (size_t sizet_c = 0; sizet_c < sizet_calls; sizet_c++) func();
+            vec_samples[sizet_r] = std::chrono::duration <double> (clock::now() - tp_start).count() / sizet_calls;
+        }
+
+        double dbl_median = median(vec_samples);
+        for (size_t sizet_r = 0; sizet_r < sizet_repeats; sizet_r++) vec_samples[sizet_r] = std::abs(vec_samples[sizet_r] - dbl_median);
+
+        bench_result result = {str_name, str_params, dbl_median, median(vec_samples), dbl_work, str_unit, dbl_scale, sizet_calls};
+        vec_results.push_back(result);
+        print_row(std::cout, result);
+    }
+
+    //! Writes the results as a JSON document
+    void print_json(std::ostream& os) const
+    {
+        os << "{\n  \"benchmarks\": [\n";
+        for (size_t sizet_i = 0; sizet_i < vec_results.size(); sizet_i++)
+        {
+            const bench_result& result = vec_results[sizet_i];
+            os << "    {\"name\": \"" << result.str_name << "\", \"params\": \"" << result.str_params
+               << "\", \"median_s\": " << result.dbl_median << ", \"mad_s\": " << result.dbl_mad
+               << ", \"rate\": " << rate(result) << ", \"unit\": \"" << result.str_unit
+               << "\", \"calls\": " << result.sizet_calls << "}" << (sizet_i + 1 < vec_results.size() ? "," : "") << "\n";
+        }
+        os << "  ]\n}\n";
+    }
+
+    //! Writes the header of the text report
+    static void print_header(std::ostream& os)
+    {
+        os << std::left << std::setw(24) << "benchmark" << std::setw(22) << "params" << std::right
+           << std::setw(14) << "median [us]" << std::setw(12) << "MAD [%]" << std::setw(14) << "rate" << "  unit" << std::endl;
+    }
+
+  private:
+    size_t                      sizet_warmup;
+    size_t                      sizet_repeats;
+    double                      dbl_min_time;
+    std::string                 str_filter;
+    std::vector <bench_result>  vec_results;
+
+    static double median(std::vector <double> vec_arg)
+    {
+        std::sort(vec_arg.begin(), vec_arg.end());
+        size_t sizet_half = vec_arg.size() / 2;
+        return vec_arg.size() % 2 ? vec_arg[sizet_half] : 0.5 * (vec_arg[sizet_half - 1] + vec_arg[sizet_half]);
+    }
+
+    static double rate(const bench_result& result)
+    {
+        return result.dbl_median > 0 ? result.dbl_work * result.dbl_scale / result.dbl_median : 0;
+    }
+
+    static void print_row(std::ostream& os, const bench_result& result)
+    {
+        os << std::left << std::setw(24) << result.str_name << std::setw(22) << result.str_params << std::right << std::fixed
+           << std::setprecision(2) << std::setw(14) << result.dbl_median * 1e6
+           << std::setw(12) << (result.dbl_median > 0 ? 100 * result.dbl_mad / result.dbl_median : 0)
+           << std::setprecision(3) << std::setw(14) << rate(result) << "  " << result.str_unit << std::endl;
+        os.unsetf(std::ios::fixed);
+        os << std::setprecision(6);
+    }
+};
+
+}       // NAMESPACE SUSA
+#endif  // SUSA_BENCH_H
@@ -36,7 +36,7 @@ int main(void)
   unsigned int target = 55;
   unsigned int u = target;
 
-  while (prev(u))
+  while (prev(u) != u)
   {
     std::cout << " " << u;
     u = prev(u);
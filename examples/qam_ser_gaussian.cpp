@@ -34,57 +34,62 @@ int main(void) {
 
     fstream fs_result;
     fs_result.open("result.txt",fstream::out);
-    rng _rng(2987549);
-
-
 
     unsigned int uint_m         = 16;           // Modulation order
-    unsigned int uint_n         = 1e6;          // Number of transmitted symbols
+    unsigned int uint_n         = 1000;         // Number of symbols per trial
+    unsigned int uint_trials    = 1000;         // Maximum number of trials per point
+    unsigned int uint_errors    = 2000;         // Target number of symbol errors per point
     double dbl_min_noise_db     = 0;            // Minimum Eb/N0 in dB
     double dbl_max_noise_db     = 12;           // Maximum Eb/N0 in dB
     unsigned int uint_num_steps = 12;           // Number of simulation points
 
-    matrix <unsigned int> mat_num_errors(uint_num_steps,1,0);
-
     qam _qam(uint_m);
+    const matrix < std::complex <double> > cmat_constellation = _qam.get_constellation();
 
-    matrix < std::complex <double> > cmat_symbols = matrix < std::complex <double> > (uint_n, 1, std::complex <double>(0,0));
-
-    matrix < std::complex <double> > cmat_noise(uint_n,1);
+    matrix <double> mat_noise_db(uint_num_steps, 1);
+    for (unsigned int uint_noise_step = 0; uint_noise_step < uint_num_steps; uint_noise_step++)
+        mat_noise_db(uint_noise_step) = dbl_min_noise_db + uint_noise_step * (dbl_max_noise_db - dbl_min_noise_db)/(uint_num_steps - 1);
 
-    std::cout << std::fixed;
-    std::cout << std::setprecision(4);
-    std::cout << setw(25) << "Empirical" << setw(20) << "Theoretical" << endl;
+    /* A trial transmits a frame of symbols; the trials run in parallel with their own random streams */
+    montecarlo _mc(uint_trials, uint_errors, 4, 2987549);
 
-    for (unsigned int uint_noise_step = 0; uint_noise_step < uint_num_steps; uint_noise_step++)
+    std::vector <mc_point> vec_points = _mc.sweep(mat_noise_db, [&](double dbl_noise_db, rng& _rng) -> mc_count
     {
+        double dbl_noise_dev = _qam.get_noise_deviation(dbl_noise_db);
+        mc_count count = {0, uint_n};
 
-        double dbl_noise_db     = dbl_min_noise_db + uint_noise_step * (dbl_max_noise_db - dbl_min_noise_db)/(uint_num_steps - 1);
-        double dbl_noise_dev    = _qam.get_noise_deviation(dbl_noise_db);
-        double dbl_ser          = 1.5 * std::erfc(std::sqrt(0.1 * std::pow(10, ( dbl_noise_db/10 )) * 4 ));
-        
-        /* Uniform symbol generation */
-        for (unsigned int uint_i = 0; uint_i < uint_n; uint_i++)
-            cmat_symbols(uint_i) = _qam.get_constellation()(_rng.rand_mask(0xF));
-        
         /* AWGN channel generation */
+        matrix < std::complex <double> > cmat_noise(uint_n, 1);
+        _rng.fill_complex_normal(cmat_noise, dbl_noise_dev);
+
         for (unsigned int uint_i = 0; uint_i < uint_n; uint_i++)
-            cmat_noise(uint_i) = dbl_noise_dev * std::complex <double> (_rng.randn(), _rng.randn());
+        {
+            /* Uniform symbol generation */
+            std::complex <double> complex_symbol = cmat_constellation(_rng.rand_mask(0xF));
 
-        /* The QAM symbols pass AWGN channel */
-        matrix < std::complex <double> > cmat_noisy_symbols = cmat_symbols + cmat_noise;
+            /* The QAM symbol passes AWGN channel */
+            std::complex <double> complex_noisy = complex_symbol + cmat_noise(uint_i);
 
+            /* Demodulate the noisy symbol */
+            if (_qam.demodulate_symbol(complex_noisy) != complex_symbol) count.uint_errors++;
+        }
 
-        /* Demodulate the noisy symbols */
-        for (unsigned int uint_i = 0; uint_i < uint_n; uint_i++)
-            if (_qam.demodulate_symbol(cmat_noisy_symbols(uint_i)) != cmat_symbols(uint_i))
-                mat_num_errors(uint_noise_step)++;
+        return count;
+    });
+
+    std::cout << std::fixed;
+    std::cout << std::setprecision(4);
+    std::cout << setw(25) << "Empirical" << setw(20) << "Theoretical" << endl;
 
+    for (unsigned int uint_noise_step = 0; uint_noise_step < uint_num_steps; uint_noise_step++)
+    {
+        double dbl_noise_db     = vec_points[uint_noise_step].dbl_snr;
+        double dbl_ser          = 1.5 * std::erfc(std::sqrt(0.1 * std::pow(10, ( dbl_noise_db/10 )) * 4 ));
 
         cout << "Eb/N0 = " << dbl_noise_db;
-        cout << setw(10) << "SER = " << (double) mat_num_errors(uint_noise_step)/uint_n;
+        cout << setw(10) << "SER = " << vec_points[uint_noise_step].rate();
         cout << setw(10) << "SER = " << dbl_ser << endl;
-        fs_result << dbl_noise_db << "   " <<  (double) mat_num_errors(uint_noise_step)/uint_n << endl;
+        fs_result << dbl_noise_db << "   " << vec_points[uint_noise_step].rate() << endl;
     }
 
     fs_result.close();
@@ -59,28 +59,47 @@
 #include <initializer_list>
 #include <typeinfo>
 #include <tuple>
+#include <algorithm>
 #include <type_traits>
 
 // Susa headers
 #include "susa/type_traits.h"
+#include "susa/thread.h"
+#include "susa/allocator.h"
+#include "susa/profile.h"
+#include "susa/metric.h"
+#include "susa/cpu.h"
 #include "susa/memory.h"
+#include "susa/expression.h"
+#include "susa/view.h"
 #include "susa/sets.h"
 #include "susa/matrix.h"
+#include "susa/cmatrix.h"
+#include "susa/bitvec.h"
 #include "susa/array.h"
+#include "susa/io.h"
 #include "susa/base.h"
 #include "susa/svd.h"
 #include "susa/statistics.h"
 #include "susa/rng.h"
 #include "susa/mt.h"
+#include "susa/philox.h"
 #include "susa/fft.h"
 #include "susa/rrcosine.h"
-#include "susa/channel.h"
+#include "susa/trellis.h"
 #include "susa/ccode.h"
+#include "susa/turbo.h"
 #include "susa/modulation.h"
+#include "susa/montecarlo.h"
 #include "susa/utility.h"
+#include "susa/gemm.h"
 #include "susa/linalg.h"
 #include "susa/solver.h"
+#include "susa/fixed.h"
+#include "susa/sparse.h"
 #include "susa/search.h"
+#include "susa/channel.h"
+#include "susa/filters.h"
 #include "susa/signal.h"
 #include "susa/debug.h"
 
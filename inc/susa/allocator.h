@@ -0,0 +1,263 @@
+/*
+ * This file is part of Susa.
+ *
+ * Susa is free software: you can redistribute it and/or modify
+ * it under the terms of the Lesser GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * at your option) any later version.
+ *
+ * Susa is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * Lesser GNU General Public License for more details.
+ *
+ * You should have received a copy of the Lesser GNU General Public License
+ * along with Susa.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file allocator.h
+ * @brief Memory allocation policies (declaration).
+ *
+ * The Susa types acquire their storage through an <i>allocator</i>.
+ * Each buffer remembers the allocator it came from, hence the buffers of
+ * different allocators can be mixed freely. The allocator of the new buffers
+ * is selected per thread using <i>set_allocator()</i> or an <i>allocator_scope</i>.
+ *
+ * @author Behrooz Kamary
+ * @version 1.0.0
+ */
+
+#ifndef SUSA_ALLOCATOR_H
+#define SUSA_ALLOCATOR_H
+
+#include <cstddef>
+#include <mutex>
+#include <vector>
+
+namespace susa
+{
+
+/**
+ * @brief The <i>allocator</i> interface.
+ *
+ * @ingroup TYPES
+ */
+class allocator
+{
+  public:
+    virtual ~allocator();
+
+    /**
+     * @brief Allocates an uninitialized block
+     *
+     * @param sizet_bytes the block size in bytes (non-zero)
+     * @return the block or nullptr on failure
+     */
+    virtual void* allocate(size_t sizet_bytes) = 0;
+
+    /**
+     * @brief Resizes a block and keeps its content
+     *
+     * The default implementation allocates a new block, copies
+     * the content and releases the old block.
+     *
+     * @param ptr_block the block
+     * @param sizet_old the current size in bytes
+     * @param sizet_new the new size in bytes (non-zero)
+     * @return the resized block or nullptr on failure (the old block is kept)
+     */
+    virtual void* reallocate(void* ptr_block, size_t sizet_old, size_t sizet_new);
+
+    /**
+     * @brief Releases a block
+     *
+     * @param ptr_block the block
+     * @param sizet_bytes the block size in bytes
+     */
+    virtual void deallocate(void* ptr_block, size_t sizet_bytes) = 0;
+};
+
+/**
+ * @brief The default allocator based on <i>malloc, realloc</i> and <i>free</i>.
+ *
+ * @ingroup TYPES
+ */
+class heap_allocator : public allocator
+{
+  public:
+    void* allocate(size_t sizet_bytes);
+    void* reallocate(void* ptr_block, size_t sizet_old, size_t sizet_new);
+    void deallocate(void* ptr_block, size_t sizet_bytes);
+};
+
+/**
+ * @brief An allocator that aligns the blocks.
+ *
+ * The default alignment (64 bytes) is a cache line and suits
+ * the aligned loads of all the common SIMD extensions.
+ *
+ * @ingroup TYPES
+ */
+class aligned_allocator : public allocator
+{
+  public:
+    /**
+     * @brief Constructor
+     *
+     * @param sizet_alignment the alignment in bytes (a power of two)
+     */
+    explicit aligned_allocator(size_t sizet_alignment = 64);
+
+    void* allocate(size_t sizet_bytes);
+    void deallocate(void* ptr_block, size_t sizet_bytes);
+
+  private:
+    size_t sizet_alignment;
+};
+
+/**
+ * @brief A thread-safe size-class pool.
+ *
+ * The requests are rounded to power of two size classes between 64 bytes and
+ * <i>sizet_max_block</i>. The released blocks are kept in per class free lists
+ * and reused, the larger requests are forwarded to the heap.
+ * All the blocks are 64 bytes aligned.
+ *
+ * @ingroup TYPES
+ */
+class pool_allocator : public allocator
+{
+  public:
+    /**
+     * @brief Constructor
+     *
+     * @param sizet_max_block the largest pooled block in bytes
+     */
+    explicit pool_allocator(size_t sizet_max_block = 65536);
+
+    //! Destructor releases all the pooled blocks
+    ~pool_allocator();
+
+    void* allocate(size_t sizet_bytes);
+    void* reallocate(void* ptr_block, size_t sizet_old, size_t sizet_new);
+    void deallocate(void* ptr_block, size_t sizet_bytes);
+
+    //! Releases the free blocks to the system
+    void trim();
+
+  private:
+    static const size_t sizet_min_block = 64;
+
+    size_t                               sizet_max_block;
+    std::vector <std::vector <void*> >   vec_free;
+    aligned_allocator                    alloc_blocks;
+    std::mutex                           mutex_pool;
+
+    size_t size_class(size_t sizet_bytes) const;
+};
+
+/**
+ * @brief A bump (arena) allocator.
+ *
+ * The blocks are carved out of large chunks and are released all at once
+ * with <i>reset()</i>, e.g. at the end of a simulation frame. Releasing a single
+ * block does not reclaim it, hence a buffer may outlive a reset and be released
+ * later without harm, although its elements must not be used. The last block grows
+ * or shrinks in place if the chunk has room. An arena is not thread-safe;
+ * <i>thread_arena()</i> returns the arena of the calling thread.
+ *
+ * @ingroup TYPES
+ */
+class arena_allocator : public allocator
+{
+  public:
+    /**
+     * @brief Constructor
+     *
+     * @param sizet_chunk the chunk size in bytes
+     */
+    explicit arena_allocator(size_t sizet_chunk = 1 << 20);
+
+    //! Destructor releases all the chunks
+    ~arena_allocator();
+
+    void* allocate(size_t sizet_bytes);
+    void* reallocate(void* ptr_block, size_t sizet_old, size_t sizet_new);
+    void deallocate(void* ptr_block, size_t sizet_bytes);
+
+    //! Releases all the blocks and keeps the chunks for reuse
+    void reset();
+
+    //! Returns the number of bytes handed out since the last reset
+    size_t used() const;
+
+  private:
+    struct chunk
+    {
+        char*  ptr_begin;
+        size_t sizet_size;
+    };
+
+    size_t               sizet_chunk;
+    std::vector <chunk>  vec_chunks;
+    size_t               sizet_current;
+    size_t               sizet_offset;
+    size_t               sizet_used;
+    void*                ptr_last;
+    aligned_allocator    alloc_chunks;
+
+    bool grow(size_t sizet_bytes);
+};
+
+/**
+ * @brief Returns the allocator used for the new buffers on the calling thread.
+ *
+ * @ingroup TYPES
+ */
+allocator* get_allocator();
+
+/**
+ * @brief Sets the allocator used for the new buffers on the calling thread.
+ *
+ * @param ptr_alloc the allocator, nullptr selects the default heap allocator.
+ * @ingroup TYPES
+ */
+void set_allocator(allocator* ptr_alloc);
+
+/**
+ * @brief Returns the arena of the calling thread.
+ *
+ * @ingroup TYPES
+ */
+arena_allocator& thread_arena();
+
+/**
+ * @brief Selects an allocator for the lifetime of the scope.
+ *
+ * @ingroup TYPES
+ */
+class allocator_scope
+{
+  public:
+    explicit allocator_scope(allocator& alloc)
+    : ptr_previous(get_allocator())
+    {
+        set_allocator(&alloc);
+    }
+
+    ~allocator_scope()
+    {
+        set_allocator(ptr_previous);
+    }
+
+    allocator_scope(const allocator_scope&) = delete;
+    allocator_scope& operator=(const allocator_scope&) = delete;
+
+  private:
+    allocator* ptr_previous;
+};
+
+}      // NAMESPACE SUSA
+
+#endif // SUSA_ALLOCATOR_H
@@ -34,21 +34,43 @@
 #ifndef SUSA_ARRAY_H
 #define SUSA_ARRAY_H
 
+#include <array>
 #include <susa/debug.h>
 #include <susa/memory.h>
 
 namespace susa
 {
+  //! sets the number of the run-time dimensions
+  inline void resize_dims(std::vector <size_t>& vec_dims, size_t sizet_num)
+  {
+    vec_dims.assign(sizet_num, 0);
+  }
+
+  //! the number of the compile-time dimensions is fixed
+  template <size_t N> void resize_dims(std::array <size_t, N>& arr_dims, size_t)
+  {
+    arr_dims.fill(0);
+  }
+
   /**
    * @brief The <i>array</i> class.
    * An array is a multidimensional container that should be used
    * to represent three or more dimensions.
-   * 
+   *
+   * The first index runs fastest and the strides of the dimensions are
+   * computed once at the construction. A nonzero <i>N</i> fixes the rank at
+   * compile time, the dimensions and the strides then live in fixed-size
+   * arrays and an element access unrolls to plain pointer arithmetic.
+   * <i>N = 0</i> keeps the rank a run-time property. The element access does
+   * not modify the array, hence several threads may read it at once.
+   * A single index addresses the elements linearly.
+   *
    * @ingroup TYPES
    *
    */
-  template <class T> class array : public susa::memory <T>
+  template <class T, size_t N = 0> class array : public susa::memory <T>
   {
+      typedef typename std::conditional <N == 0, std::vector <size_t>, std::array <size_t, N> >::type dims_type;
 
     public:
 
@@ -61,22 +83,33 @@ namespace susa
        */
       array (std::initializer_list<size_t> list);
 
+      /**
+       * @brief Constructor
+       * @param sizet_dim the size of the first dimension followed by the others
+       */
+      template <typename... Args> explicit array(size_t sizet_dim, Args... sizet_dims);
+
+      /**
+       * @brief Constructor
+       * @param vec_shape the sizes of the dimensions
+       */
+      explicit array(const std::vector <size_t>& vec_shape);
+
       //! Constructor
       array(array&& arg);
 
       //! Copy constructor
       array(const array& arg);
-      
+
       //! Copy assignment constructor
-      array& operator=(const array <T>& arg);
-      
+      array& operator=(const array& arg);
+
       //! Destructor
       ~array() noexcept;
 
       T get(std::initializer_list<size_t> list) const;
-    
-      T get(const std::vector<size_t>& list) const;
 
+      T get(const std::vector<size_t>& list) const;
 
       /**
        * @brief Clone the data by pointer that may be read from the disk.
@@ -85,9 +118,18 @@ namespace susa
        *
        * @param data pointer to the data
        */
-      void clone(T* data);
+      void clone(const T* data);
+
+      template <typename... Args> T get(size_t uint_elem, Args... uint_args) const
+      {
+        size_t uint_index = offset(uint_elem, uint_args...);
+
+        SUSA_ASSERT_MESSAGE(uint_index < this->sizet_objects, "the element index is out of range.");
 
-      template <typename... Args> T get(size_t uint_elem, Args... uint_args);
+        if (uint_index < this->sizet_objects) return this->_matrix[uint_index];
+
+        return T_fake;
+      }
 
       //! () operator to set or get elements
       template <typename... Args> T operator ()( size_t uint_elem, Args... uint_args ) const
@@ -97,249 +139,295 @@ namespace susa
 
       template <typename... Args> T &operator ()( size_t uint_elem, Args... uint_args )
       {
-        size_t uint_index = index(uint_elem, uint_args...);
+        size_t uint_index = offset(uint_elem, uint_args...);
 
-        SUSA_ASSERT_MESSAGE(uint_index < uint_total, "the element index is out of range.");
+        SUSA_ASSERT_MESSAGE(uint_index < this->sizet_objects, "the element index is out of range.");
 
-        if (uint_index < uint_total && this->_matrix != NULL)
-        {
-          return this->_matrix[uint_index];
-        }
+        if (uint_index < this->sizet_objects) return this->_matrix[uint_index];
 
-        return *T_fake;
+        return T_fake;
       }
 
-      template <typename... Args> size_t get_raw_index(size_t uint_elem, Args... uint_args)
+      template <typename... Args> size_t get_raw_index(size_t uint_elem, Args... uint_args) const
       {
-        return index(uint_elem, uint_args...);
+        return offset(uint_elem, uint_args...);
       }
 
-    private:
-
-      std::vector<size_t> vec_dims;
-      size_t              uint_total;
-      size_t              uint_num_dims;
-      T*                  T_fake;
-
-      std::vector<size_t> vec_get;
-      size_t              uint_get_step;
-      T                   T_get_value;
+      //! Returns the number of dimensions
+      size_t no_dims() const
+      {
+        return vec_dims.size();
+      }
 
-      size_t index(size_t uint_elem);
-      size_t index(const std::vector<size_t>& list);
-      template <typename... Args> size_t index(size_t uint_elem, Args... uint_args);
-  };
+      //! Returns the size of a dimension
+      size_t dim(size_t sizet_axis) const
+      {
+        return vec_dims[sizet_axis];
+      }
 
-  // Implementations
-  template <class T> array<T>::array()
-  : susa::memory<T>()
-  , T_fake(new T)
-  {
-      uint_get_step = 0;
-  }
+      //! Returns the distance between two consecutive elements of a dimension
+      size_t stride(size_t sizet_axis) const
+      {
+        return vec_strides[sizet_axis];
+      }
 
-  template <class T> array<T>::array (std::initializer_list<size_t> list)
-  : vec_dims(list)
-  , T_fake(new T)
-  {
-    uint_total = 1;
-    for (auto dim_size : vec_dims)
-    {
-      uint_total *= dim_size;
-    }
+      //! Returns the first element for the contiguous iteration
+      T* begin()
+      {
+        return this->_matrix;
+      }
 
-    uint_num_dims = vec_dims.size();
-    uint_get_step = 0;
-    vec_get       = std::vector<size_t> (uint_num_dims);
+      //! Returns the first element for the contiguous iteration
+      const T* begin() const
+      {
+        return this->_matrix;
+      }
 
-    this->allocate(uint_total);
-  }
+      //! Returns the element past the last element
+      T* end()
+      {
+        return this->_matrix + this->sizet_objects;
+      }
 
-  template <class T> void array<T>::clone(T* data)
-  {
-    std::memset(this->_matrix, 0x00, sizeof(T) * uint_total);
-    std::memcpy(this->_matrix, data, sizeof(T) * uint_total);
-  }
+      //! Returns the element past the last element
+      const T* end() const
+      {
+        return this->_matrix + this->sizet_objects;
+      }
 
-  template <class T> array<T>::array(array&& arg)
-  : susa::memory <T> (std::move(arg))
-  {
+      /**
+       * @brief Strided slice along one dimension
+       *
+       * The column vector view starts at the element and runs to the end
+       * of the dimension, e.g. the subcarriers of a symbol of an antenna.
+       *
+       * @param sizet_axis the dimension of the slice
+       * @param uint_elem the indices of the first element
+       */
+      template <typename... Args> matrix_view <T> slice(size_t sizet_axis, size_t uint_elem, Args... uint_args)
+      {
+        size_t sizet_idx[] = {uint_elem, static_cast <size_t> (uint_args)...};
+        static_assert(N == 0 || sizeof...(Args) + 1 == N, "a slice needs one index per dimension.");
+        check_slice(sizeof...(Args) + 1);
+        return matrix_view <T> (this->_matrix + offset(uint_elem, uint_args...),
+          vec_dims[sizet_axis] - sizet_idx[sizet_axis], 1, vec_strides[sizet_axis], 0);
+      }
 
-    uint_total        = arg.uint_total;
-    vec_dims          = arg.vec_dims;
-    uint_num_dims     = vec_dims.size();
-    vec_get           = std::vector<size_t>(uint_num_dims);
-    uint_get_step     = 0;
+      //! Strided slice along one dimension of a constant array
+      template <typename... Args> matrix_view <const T> slice(size_t sizet_axis, size_t uint_elem, Args... uint_args) const
+      {
+        size_t sizet_idx[] = {uint_elem, static_cast <size_t> (uint_args)...};
+        static_assert(N == 0 || sizeof...(Args) + 1 == N, "a slice needs one index per dimension.");
+        check_slice(sizeof...(Args) + 1);
+        return matrix_view <const T> (this->_matrix + offset(uint_elem, uint_args...),
+          vec_dims[sizet_axis] - sizet_idx[sizet_axis], 1, vec_strides[sizet_axis], 0);
+      }
 
-    T_fake            = arg.T_fake;
-    arg.T_fake        = nullptr;
+      /**
+       * @brief Strided two dimensional slice
+       *
+       * The view starts at the element and its rows and columns run
+       * along two dimensions to their ends.
+       *
+       * @param sizet_row_axis the dimension of the rows
+       * @param sizet_col_axis the dimension of the columns
+       * @param uint_elem the indices of the first element
+       */
+      template <typename... Args> matrix_view <T> slice2(size_t sizet_row_axis, size_t sizet_col_axis,
+        size_t uint_elem, Args... uint_args)
+      {
+        size_t sizet_idx[] = {uint_elem, static_cast <size_t> (uint_args)...};
+        static_assert(N == 0 || sizeof...(Args) + 1 == N, "a slice needs one index per dimension.");
+        check_slice(sizeof...(Args) + 1);
+        return matrix_view <T> (this->_matrix + offset(uint_elem, uint_args...),
+          vec_dims[sizet_row_axis] - sizet_idx[sizet_row_axis], vec_dims[sizet_col_axis] - sizet_idx[sizet_col_axis],
+          vec_strides[sizet_row_axis], vec_strides[sizet_col_axis]);
+      }
 
-  }
+      //! Strided two dimensional slice of a constant array
+      template <typename... Args> matrix_view <const T> slice2(size_t sizet_row_axis, size_t sizet_col_axis,
+        size_t uint_elem, Args... uint_args) const
+      {
+        size_t sizet_idx[] = {uint_elem, static_cast <size_t> (uint_args)...};
+        static_assert(N == 0 || sizeof...(Args) + 1 == N, "a slice needs one index per dimension.");
+        check_slice(sizeof...(Args) + 1);
+        return matrix_view <const T> (this->_matrix + offset(uint_elem, uint_args...),
+          vec_dims[sizet_row_axis] - sizet_idx[sizet_row_axis], vec_dims[sizet_col_axis] - sizet_idx[sizet_col_axis],
+          vec_strides[sizet_row_axis], vec_strides[sizet_col_axis]);
+      }
 
-  template <class T> array<T>::array(const array& arg)
-  : susa::memory<T>(arg)
-  , T_fake(new T)
-  {
-    uint_total        = arg.uint_total;
-    vec_dims          = arg.vec_dims;
-    uint_num_dims     = vec_dims.size();
-    vec_get           = std::vector<size_t>(uint_num_dims);
-    uint_get_step     = 0;
-  }
-  
-   template <class T> array<T>& array<T>::operator=(const array <T>& arg)
-   {
-     
-      susa::memory<T>::operator=(arg);
-
-      uint_total        = arg.uint_total;
-      vec_dims          = arg.vec_dims;
-      uint_num_dims     = vec_dims.size();
-      vec_get           = std::vector<size_t>(uint_num_dims);
-      uint_get_step     = 0;
-
-      return *this;
-   }
-
-  template <class T> array<T>::~array() noexcept
-  {
-    delete T_fake;
-  }
+    private:
 
-  template <class T> T array <T>::get( std::initializer_list<size_t> list ) const
-  {
+      dims_type           vec_dims;
+      dims_type           vec_strides;
+      T                   T_fake;
 
-    SUSA_ASSERT(this->_matrix != NULL);
+      //! computes the strides and allocates the elements
+      void shape(const size_t* ptr_dims, size_t sizet_num);
 
-    size_t uint_elem      = 0;
-    size_t uint_dim_count = 0;
-    size_t uint_factor    = 1;
+      size_t index(const size_t* ptr_idx, size_t sizet_num) const;
 
-    for (auto dim_size : list)
-    {
+      //! a slice needs the indices of all the dimensions
+      void check_slice(size_t sizet_num) const
+      {
+        SUSA_ASSERT_MESSAGE(sizet_num == vec_dims.size() && sizet_num > 1, "a slice needs one index per dimension.");
+        (void) sizet_num;
+      }
 
-      uint_factor = 1;
-      for (size_t indx = 0; indx < uint_dim_count; ++indx)
+      //! a single index is linear
+      size_t offset(size_t uint_elem) const
       {
-        uint_factor *= vec_dims[indx];
+        return uint_elem;
       }
 
-      uint_elem += dim_size * uint_factor;
-      uint_dim_count++;
-    }
+      template <typename... Args> size_t offset(size_t uint_elem, size_t uint_next, Args... uint_args) const
+      {
+        static_assert(N == 0 || sizeof...(Args) + 2 == N, "the number of indices differs from the rank.");
+        SUSA_ASSERT_MESSAGE(sizeof...(Args) + 2 <= vec_dims.size(), "the number of arguments exceeded the number of dimensions.");
+        return offset_of(0, uint_elem, uint_next, uint_args...);
+      }
 
-    SUSA_ASSERT_MESSAGE(uint_elem < uint_total, "the element index is out of range.");
+      size_t offset_of(size_t sizet_axis, size_t uint_elem) const
+      {
+        SUSA_ASSERT_MESSAGE(uint_elem < vec_dims[sizet_axis], "the element index is out of range.");
+        return uint_elem * vec_strides[sizet_axis];
+      }
 
-    if (uint_elem < uint_total && this->_matrix != NULL)
-    {
-      return this->_matrix[uint_elem];
-    }
+      template <typename... Args> size_t offset_of(size_t sizet_axis, size_t uint_elem, Args... uint_args) const
+      {
+        return offset_of(sizet_axis, uint_elem) + offset_of(sizet_axis + 1, uint_args...);
+      }
+  };
 
-    return *T_fake;
+  // Implementations
+  template <class T, size_t N> array<T,N>::array()
+  : susa::memory<T>()
+  , vec_dims()
+  , vec_strides()
+  , T_fake()
+  {
   }
 
-  template <class T> T array <T>::get(const std::vector<size_t>& list ) const
+  template <class T, size_t N> array<T,N>::array (std::initializer_list<size_t> list)
+  : susa::memory<T>()
+  , vec_dims()
+  , vec_strides()
+  , T_fake()
   {
-
-    SUSA_ASSERT(this->_matrix != NULL);
-
-    size_t uint_index = index(list);
-
-    SUSA_ASSERT_MESSAGE(uint_index < uint_total, "the element index is out of range.");
-
-    if (uint_index < uint_total && this->_matrix != NULL)
-    {
-      return this->_matrix[uint_index];
-    }
-
-    return *T_fake;
+    shape(list.begin(), list.size());
   }
 
-  template <class T>
+  template <class T, size_t N>
   template <typename... Args>
-  T array<T>::get(size_t uint_elem, Args... uint_args)
+  array<T,N>::array(size_t sizet_dim, Args... sizet_dims)
+  : susa::memory<T>()
+  , vec_dims()
+  , vec_strides()
+  , T_fake()
   {
+    static_assert(N == 0 || sizeof...(Args) + 1 == N, "the number of dimensions differs from the rank.");
+    size_t sizet_list[] = {sizet_dim, static_cast <size_t> (sizet_dims)...};
+    shape(sizet_list, sizeof...(Args) + 1);
+  }
 
-    SUSA_ASSERT(this->_matrix != NULL);
+  template <class T, size_t N> array<T,N>::array(const std::vector <size_t>& vec_shape)
+  : susa::memory<T>()
+  , vec_dims()
+  , vec_strides()
+  , T_fake()
+  {
+    shape(vec_shape.data(), vec_shape.size());
+  }
 
-    size_t uint_index = index(uint_elem, uint_args...);
+  template <class T, size_t N> void array<T,N>::shape(const size_t* ptr_dims, size_t sizet_num)
+  {
+    SUSA_ASSERT_MESSAGE(N == 0 || sizet_num == N, "the number of dimensions differs from the rank.");
 
-    SUSA_ASSERT_MESSAGE(uint_index < uint_total, "the element index is out of range.");
+    vec_dims    = dims_type();
+    vec_strides = dims_type();
+    resize_dims(vec_dims, sizet_num);
+    resize_dims(vec_strides, sizet_num);
 
-    if (uint_index < uint_total && this->_matrix != NULL)
+    size_t sizet_total = 1;
+    for (size_t sizet_axis = 0; sizet_axis < std::min(sizet_num, vec_dims.size()); sizet_axis++)
     {
-      return this->_matrix[uint_index];
+      vec_dims[sizet_axis]    = ptr_dims[sizet_axis];
+      vec_strides[sizet_axis] = sizet_total;
+      sizet_total            *= ptr_dims[sizet_axis];
     }
 
-    return *T_fake;
+    this->allocate(sizet_total);
   }
 
-  template <class T> size_t array <T>::index (const std::vector<size_t>& list)
+  template <class T, size_t N> void array<T,N>::clone(const T* data)
   {
+    std::memcpy(this->_matrix, data, sizeof(T) * this->sizet_objects);
+  }
 
-    size_t uint_elem = 0;
-    size_t uint_dim_count = 0;
-    size_t uint_factor = 1;
+  template <class T, size_t N> array<T,N>::array(array&& arg)
+  : susa::memory <T> (std::move(arg))
+  , vec_dims(arg.vec_dims)
+  , vec_strides(arg.vec_strides)
+  , T_fake()
+  {
+  }
 
-    for (auto dim_size : list)
-    {
+  template <class T, size_t N> array<T,N>::array(const array& arg)
+  : susa::memory<T>(arg)
+  , vec_dims(arg.vec_dims)
+  , vec_strides(arg.vec_strides)
+  , T_fake()
+  {
+  }
 
-      uint_factor = 1;
-      for (size_t indx = 0; indx < uint_dim_count; ++indx)
-      {
-        uint_factor *= vec_dims[indx];
-      }
+  template <class T, size_t N> array<T,N>& array<T,N>::operator=(const array& arg)
+  {
+    susa::memory<T>::operator=(arg);
 
-      uint_elem += dim_size * uint_factor;
-      uint_dim_count++;
-    }
+    vec_dims    = arg.vec_dims;
+    vec_strides = arg.vec_strides;
 
-    return uint_elem;
+    return *this;
   }
 
-  template <class T> size_t array<T>::index(size_t uint_elem)
+  template <class T, size_t N> array<T,N>::~array() noexcept
   {
+  }
 
-    size_t ret;
-
-    if (uint_get_step == 0)
-    {
-      vec_get = std::vector<size_t>(uint_num_dims);
-      uint_get_step = 0;
-
-      SUSA_ASSERT_MESSAGE(uint_elem < uint_total, "the element index is out of range.");
+  template <class T, size_t N> T array <T,N>::get( std::initializer_list<size_t> list ) const
+  {
+    size_t uint_index = index(list.begin(), list.size());
 
-      if (uint_elem < uint_total) return uint_elem;
+    SUSA_ASSERT_MESSAGE(uint_index < this->sizet_objects, "the element index is out of range.");
 
-      return 0;
-    }
-    else
-    {
+    if (uint_index < this->sizet_objects) return this->_matrix[uint_index];
 
-      SUSA_ASSERT_MESSAGE(uint_get_step < uint_num_dims, "the number of arguments exceeded the number of dimensions.");
+    return T_fake;
+  }
 
-      vec_get[uint_get_step] = uint_elem;
-      uint_get_step++;
+  template <class T, size_t N> T array <T,N>::get(const std::vector<size_t>& list ) const
+  {
+    size_t uint_index = index(list.data(), list.size());
 
-      ret = index(vec_get);
-    }
+    SUSA_ASSERT_MESSAGE(uint_index < this->sizet_objects, "the element index is out of range.");
 
-    vec_get = std::vector<size_t>(uint_num_dims);
-    uint_get_step = 0;
+    if (uint_index < this->sizet_objects) return this->_matrix[uint_index];
 
-    return ret;
+    return T_fake;
   }
 
-  template <class T>
-  template <typename... Args>
-  size_t array<T>::index(size_t uint_elem, Args... uint_args)
+  //! the indices of the leading dimensions, the missing trailing indices are zero
+  template <class T, size_t N> size_t array <T,N>::index(const size_t* ptr_idx, size_t sizet_num) const
   {
+    SUSA_ASSERT_MESSAGE(sizet_num <= vec_dims.size(), "the number of arguments exceeded the number of dimensions.");
 
-    SUSA_ASSERT_MESSAGE(uint_get_step < uint_num_dims, "the number of arguments exceeded the number of dimensions.");
+    size_t uint_elem = 0;
+    for (size_t sizet_axis = 0; sizet_axis < std::min(sizet_num, vec_dims.size()); sizet_axis++)
+    {
+      uint_elem += ptr_idx[sizet_axis] * vec_strides[sizet_axis];
+    }
 
-    vec_get[uint_get_step] = uint_elem;
-    uint_get_step++;
-    return index(uint_args...);
+    return uint_elem;
   }
 
 }      // NAMESPACE SUSA
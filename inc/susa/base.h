@@ -32,6 +32,14 @@
 
 namespace susa {
 
+//! The dimension along which a reduction runs
+enum axis
+{
+    AXIS_COLS, //!< one result per column, a row vector
+    AXIS_ROWS, //!< one result per row, a column vector
+    AXIS_ALL   //!< one result for the whole matrix
+};
+
 /**
  * @brief Minimum value indices
  *
@@ -41,6 +49,15 @@ namespace susa {
  */
 template <class T> matrix <size_t> min(const matrix <T> &mat_arg);
 
+/**
+ * @brief Minimum value indices
+ *
+ * @param mat_arg the input view
+ * @return returns minimum value indices in the input view
+ * @ingroup Math
+ */
+template <class T> matrix <size_t> min(const matrix_view <T> &mat_arg);
+
 /**
  * @brief Maximum
  *
@@ -50,6 +67,15 @@ template <class T> matrix <size_t> min(const matrix <T> &mat_arg);
  */
 template <class T> matrix <size_t> max(const matrix <T> &mat_arg);
 
+/**
+ * @brief Maximum
+ *
+ * @param mat_arg the input view
+ * @return Returns maximum value indices in the input view
+ * @ingroup Math
+ */
+template <class T> matrix <size_t> max(const matrix_view <T> &mat_arg);
+
 /**
  * @brief Differential
  *
@@ -68,6 +94,15 @@ template <class T> std::vector <T> diff(const std::vector <T> &vec_arg);
  */
 template <class T> matrix <T> sum(const matrix <T> &mat_arg);
 
+/**
+ * @brief Sum
+ *
+ * @param mat_arg the input view
+ * @return Returns sum of values in the input view
+ * @ingroup Math
+ */
+template <class T> matrix <typename std::remove_const <T>::type> sum(const matrix_view <T> &mat_arg);
+
 /**
  * @brief Mean
  *
@@ -77,6 +112,107 @@ template <class T> matrix <T> sum(const matrix <T> &mat_arg);
  */
 template <class T> matrix <T> mean(const matrix <T> &mat_arg);
 
+/**
+ * @brief Mean
+ *
+ * @param mat_arg the input view
+ * @return Returns mean of values in the input view
+ * @ingroup Math
+ */
+template <class T> matrix <typename std::remove_const <T>::type> mean(const matrix_view <T> &mat_arg);
+
+/**
+ * @brief Sum along an axis
+ *
+ * The floating-point sums are pairwise, which keeps the rounding error
+ * O(log n) on long vectors.
+ *
+ * @param mat_arg the input matrix
+ * @param ax the reduction axis
+ * @ingroup Math
+ */
+template <class T> matrix <T> sum(const matrix <T> &mat_arg, axis ax);
+
+//! Sum of a view along an axis
+template <class T> matrix <typename std::remove_const <T>::type> sum(const matrix_view <T> &mat_arg, axis ax);
+
+/**
+ * @brief Mean along an axis
+ *
+ * @param mat_arg the input matrix
+ * @param ax the reduction axis
+ * @ingroup Math
+ */
+template <class T> matrix <T> mean(const matrix <T> &mat_arg, axis ax);
+
+//! Mean of a view along an axis
+template <class T> matrix <typename std::remove_const <T>::type> mean(const matrix_view <T> &mat_arg, axis ax);
+
+/**
+ * @brief Euclidean norm along an axis
+ *
+ * @param mat_arg the input matrix
+ * @param ax the reduction axis
+ * @ingroup Math
+ */
+template <class T> matrix <T> norm(const matrix <T> &mat_arg, axis ax);
+
+//! Euclidean norm of a view along an axis
+template <class T> matrix <typename std::remove_const <T>::type> norm(const matrix_view <T> &mat_arg, axis ax);
+
+/**
+ * @brief Energy along an axis
+ *
+ * The sum of the squared magnitudes in one pass, i.e. <i>sum(mag())</i>
+ * without the intermediate matrices.
+ *
+ * @param mat_arg the input matrix
+ * @param ax the reduction axis
+ * @ingroup Math
+ */
+template <class T> matrix <T> energy(const matrix <T> &mat_arg, axis ax = AXIS_ALL);
+
+//! Energy of a complex matrix along an axis
+template <class T> matrix <T> energy(const matrix <std::complex <T>> &mat_arg, axis ax = AXIS_ALL);
+
+/**
+ * @brief Minimum and maximum with their indices in one pass
+ *
+ * @param mat_arg the input matrix
+ * @param mat_min the minimum values
+ * @param mat_min_index the indices of the minimum values
+ * @param mat_max the maximum values
+ * @param mat_max_index the indices of the maximum values
+ * @param ax the reduction axis, the indices of <i>AXIS_ALL</i> are linear
+ * @ingroup Math
+ */
+template <class T> void minmax(const matrix <T> &mat_arg, matrix <T> &mat_min, matrix <size_t> &mat_min_index,
+  matrix <T> &mat_max, matrix <size_t> &mat_max_index, axis ax = AXIS_COLS);
+
+/**
+ * @brief Minimum value indices along an axis
+ *
+ * @param mat_arg the input matrix
+ * @param ax the reduction axis, the indices of <i>AXIS_ALL</i> are linear
+ * @ingroup Math
+ */
+template <class T> matrix <size_t> min(const matrix <T> &mat_arg, axis ax);
+
+//! Minimum value indices of a view along an axis
+template <class T> matrix <size_t> min(const matrix_view <T> &mat_arg, axis ax);
+
+/**
+ * @brief Maximum value indices along an axis
+ *
+ * @param mat_arg the input matrix
+ * @param ax the reduction axis, the indices of <i>AXIS_ALL</i> are linear
+ * @ingroup Math
+ */
+template <class T> matrix <size_t> max(const matrix <T> &mat_arg, axis ax);
+
+//! Maximum value indices of a view along an axis
+template <class T> matrix <size_t> max(const matrix_view <T> &mat_arg, axis ax);
+
 /**
  * @brief Magnitude
  *
@@ -95,6 +231,15 @@ template <class T> matrix <T> mag(const matrix <std::complex <T>> &mat_arg);
  */
 template <class T> matrix <T> norm(const matrix <T> &mat_arg);
 
+/**
+ * @brief Norm operator
+ *
+ * @param mat_arg the input view
+ * @return Returns the Euclidean norm of the input view
+ * @ingroup Math
+ */
+template <class T> matrix <typename std::remove_const <T>::type> norm(const matrix_view <T> &mat_arg);
+
 /**
  * @brief Real
  *
@@ -131,6 +276,20 @@ template <class T> std::vector <T> abs(const std::vector <T> &vec_arg);
  */
 template <class T> matrix <std::complex <T>> conj(const matrix <std::complex <T>> &mat_arg);
 
+/**
+ * @brief Conjugate of a scalar
+ *
+ * The conjugate of a real scalar is the scalar itself, hence the
+ * algorithms of Hermitian matrices serve the real and the complex types.
+ *
+ * @param T_arg real or complex scalar
+ * @ingroup Math
+ */
+template <class T> T conjugate(const T& T_arg);
+
+//! Conjugate of a complex scalar
+template <class T> std::complex <T> conjugate(const std::complex <T>& cplx_arg);
+
 /**
  * @brief Sign
  *
@@ -200,6 +359,19 @@ double normcdf(const double x);
  */
 double qfunc(const double x);
 
+/**
+ * @brief Jacobian logarithm
+ *
+ * ln(exp(a) + exp(b)) = max(a, b) + ln(1 + exp(-|a - b|)) with the
+ * correction term taken from a lookup table (the max* operation of Log-MAP).
+ * Two -inf arguments give -inf.
+ *
+ * @param dbl_a the first argument
+ * @param dbl_b the second argument
+ * @ingroup Math
+ */
+double log_sum_exp(double dbl_a, double dbl_b);
+
 /**
  * @brief Modular operation
  *
@@ -233,72 +405,251 @@ matrix <double> round(const matrix <double> &mat_arg, int int_decimal = -1);
 
 // Implementations
 
-template <class T> std::vector <T> diff(std::vector <T> &vec_arg)
+//! the block length below which the pairwise summation adds sequentially
+const size_t PAIRWISE_BLOCK = 128;
+
+//! the element itself
+struct reduce_value
 {
-    std::vector <T> vec_diff(vec_arg.size() - 1, T(0));
+    template <class T> T operator()(const T& T_arg) const
+    {
+        return T_arg;
+    }
+};
 
-    for (size_t i = 0; i < vec_arg.size() - 1; i++)
+//! the squared magnitude of an element
+struct reduce_energy
+{
+    template <class T> T operator()(const T& T_arg) const
     {
-        vec_diff[i] = vec_arg[i + 1] - vec_arg[i];
+        return T_arg * T_arg;
     }
 
-    return (vec_diff);
-}
+    template <class T> T operator()(const std::complex <T>& cplx_arg) const
+    {
+        return cplx_arg.real() * cplx_arg.real() + cplx_arg.imag() * cplx_arg.imag();
+    }
+};
 
-template <class T> matrix <T> sum(const matrix <T> &mat_arg)
+/**
+ * @brief Pairwise summation of a strided sequence
+ *
+ * The blocks are added with four independent accumulators, which breaks the
+ * dependency chain of the additions, and the halves are added recursively.
+ */
+template <class V, class T, class F> V pairwise_sum(const T* ptr_first, size_t sizet_num, size_t sizet_stride, F func)
 {
-    matrix <T> mat_ret;
-
-    if (mat_arg.no_rows() == 1 || mat_arg.no_cols() == 1)
+    if (sizet_num <= PAIRWISE_BLOCK)
     {
-        mat_ret = matrix <T> (1,1, T(0));
-        for (size_t uint_i = 0; uint_i < mat_arg.size(); uint_i++)
-            mat_ret(0) += mat_arg(uint_i);
+        V V_acc[4] = {V(0), V(0), V(0), V(0)};
+        size_t sizet_i = 0;
+        for (; sizet_i + 4 <= sizet_num; sizet_i += 4)
+        {
+            V_acc[0] += func(ptr_first[sizet_i * sizet_stride]);
+            V_acc[1] += func(ptr_first[(sizet_i + 1) * sizet_stride]);
+            V_acc[2] += func(ptr_first[(sizet_i + 2) * sizet_stride]);
+            V_acc[3] += func(ptr_first[(sizet_i + 3) * sizet_stride]);
+        }
+        for (; sizet_i < sizet_num; sizet_i++) V_acc[0] += func(ptr_first[sizet_i * sizet_stride]);
+        return (V_acc[0] + V_acc[1]) + (V_acc[2] + V_acc[3]);
     }
-    else if (mat_arg.no_rows() > 1 && mat_arg.no_cols() > 1)
+
+    size_t sizet_half = ((sizet_num / 2 + PAIRWISE_BLOCK - 1) / PAIRWISE_BLOCK) * PAIRWISE_BLOCK;
+    return pairwise_sum <V> (ptr_first, sizet_half, sizet_stride, func)
+         + pairwise_sum <V> (ptr_first + sizet_half * sizet_stride, sizet_num - sizet_half, sizet_stride, func);
+}
+
+//! the axis of the reductions without one, a vector reduces to a scalar
+template <class T> axis default_axis(const matrix_view <T> &mat_arg)
+{
+    return (mat_arg.no_rows() == 1 || mat_arg.no_cols() == 1) ? AXIS_ALL : AXIS_COLS;
+}
+
+/**
+ * @brief Sums the mapped elements of a view along an axis
+ *
+ * The whole of a contiguous view is one sequence, otherwise the sums of
+ * the columns are added pairwise.
+ */
+template <class V, class T, class F> matrix <V> reduce_sum(const matrix_view <T> &mat_arg, axis ax, F func)
+{
+    size_t sizet_rows = mat_arg.no_rows();
+    size_t sizet_cols = mat_arg.no_cols();
+    size_t sizet_rs   = mat_arg.row_stride();
+    size_t sizet_cs   = mat_arg.col_stride();
+
+    if (mat_arg.size() == 0) return matrix <V> ();
+
+    if (ax == AXIS_ROWS)
     {
-        mat_ret = matrix <T> (1, mat_arg.no_cols(), T(0));
-        for (size_t uint_col = 0; uint_col < mat_arg.no_cols(); uint_col++)
+        matrix <V> mat_ret(sizet_rows, 1);
+        for (size_t sizet_row = 0; sizet_row < sizet_rows; sizet_row++)
         {
-            for (size_t uint_row = 0; uint_row < mat_arg.no_rows(); uint_row++)
-                mat_ret(uint_col) += mat_arg(uint_row, uint_col);
+            mat_ret(sizet_row) = pairwise_sum <V> (mat_arg.data() + sizet_row * sizet_rs, sizet_cols, sizet_cs, func);
         }
+        return mat_ret;
     }
 
+    if (ax == AXIS_ALL && (mat_arg.is_contiguous() || sizet_cols == 1))
+    {
+        return matrix <V> (1, 1, pairwise_sum <V> (mat_arg.data(), mat_arg.size(), sizet_cols == 1 ? sizet_rs : 1, func));
+    }
+
+    if (ax == AXIS_ALL && sizet_rows == 1)
+    {
+        return matrix <V> (1, 1, pairwise_sum <V> (mat_arg.data(), sizet_cols, sizet_cs, func));
+    }
+
+    matrix <V> mat_ret(1, sizet_cols);
+    for (size_t sizet_col = 0; sizet_col < sizet_cols; sizet_col++)
+    {
+        mat_ret(sizet_col) = pairwise_sum <V> (mat_arg.data() + sizet_col * sizet_cs, sizet_rows, sizet_rs, func);
+    }
+
+    if (ax == AXIS_ALL) return matrix <V> (1, 1, pairwise_sum <V> (mat_ret.data(), sizet_cols, 1, reduce_value()));
+
     return mat_ret;
 }
 
-template <class T> matrix <T> mean(const matrix <T> &mat_arg)
+/**
+ * @brief Finds the minimum and the maximum of a strided sequence in one pass
+ *
+ * The first of the equal extrema wins.
+ */
+template <class T> void minmax_range(const T* ptr_first, size_t sizet_num, size_t sizet_stride,
+  size_t& sizet_min, size_t& sizet_max)
 {
-    matrix <T>  mat_ret;
-    T           T_ret(0);
+    sizet_min = 0;
+    sizet_max = 0;
+    T T_min   = ptr_first[0];
+    T T_max   = ptr_first[0];
 
-    if (mat_arg.no_rows() == 1 || mat_arg.no_cols() == 1)
+    for (size_t sizet_i = 1; sizet_i < sizet_num; sizet_i++)
     {
-        for (size_t uint_i = 0; uint_i < mat_arg.size(); uint_i++)
+        const T& T_value = ptr_first[sizet_i * sizet_stride];
+        if (T_value < T_min)
+        {
+            T_min     = T_value;
+            sizet_min = sizet_i;
+        }
+        if (T_max < T_value)
         {
-            T_ret += mat_arg(uint_i);
+            T_max     = T_value;
+            sizet_max = sizet_i;
         }
-        T_ret /= mat_arg.size();
-        mat_ret = matrix <T> (1, 1, T_ret);
     }
-    else if (mat_arg.no_rows() > 1 && mat_arg.no_cols() > 1)
+}
+
+//! the indices of the extrema of a view along an axis, <i>AXIS_ALL</i> gives the linear indices
+template <class T> void reduce_minmax(const matrix_view <T> &mat_arg, axis ax,
+  matrix <size_t> &mat_min_index, matrix <size_t> &mat_max_index)
+{
+    size_t sizet_rows = mat_arg.no_rows();
+    size_t sizet_cols = mat_arg.no_cols();
+    size_t sizet_rs   = mat_arg.row_stride();
+    size_t sizet_cs   = mat_arg.col_stride();
+
+    if (mat_arg.size() == 0)
+    {
+        mat_min_index = matrix <size_t> ();
+        mat_max_index = matrix <size_t> ();
+        return;
+    }
+
+    if (ax == AXIS_ALL)
     {
-        size_t no_rows = mat_arg.no_rows();
-        mat_ret = matrix <T> (1, mat_arg.no_cols());
-        for (size_t uint_col = 0; uint_col < mat_arg.no_cols(); uint_col++)
+        mat_min_index = matrix <size_t> (1, 1, 0);
+        mat_max_index = matrix <size_t> (1, 1, 0);
+
+        if (mat_arg.is_contiguous() || sizet_cols == 1 || sizet_rows == 1)
+        {
+            size_t sizet_stride = sizet_cols == 1 ? sizet_rs : (sizet_rows == 1 ? sizet_cs : 1);
+            minmax_range(mat_arg.data(), mat_arg.size(), sizet_stride, mat_min_index(0), mat_max_index(0));
+            return;
+        }
+
+        for (size_t sizet_col = 0; sizet_col < sizet_cols; sizet_col++)
         {
-            for (size_t uint_row = 0; uint_row < no_rows; uint_row++)
-            {
-                T_ret += mat_arg(uint_row, uint_col);
-            }
-
-            T_ret               /= no_rows;
-            mat_ret(uint_col)   = T_ret;
-            T_ret               = T(0);
+            size_t sizet_min, sizet_max;
+            minmax_range(mat_arg.data() + sizet_col * sizet_cs, sizet_rows, sizet_rs, sizet_min, sizet_max);
+            sizet_min += sizet_col * sizet_rows;
+            sizet_max += sizet_col * sizet_rows;
+            if (mat_arg(sizet_min) < mat_arg(mat_min_index(0))) mat_min_index(0) = sizet_min;
+            if (mat_arg(mat_max_index(0)) < mat_arg(sizet_max)) mat_max_index(0) = sizet_max;
         }
+        return;
+    }
+
+    bool   bool_rows  = ax == AXIS_ROWS;
+    size_t sizet_out  = bool_rows ? sizet_rows : sizet_cols;
+    size_t sizet_len  = bool_rows ? sizet_cols : sizet_rows;
+    size_t sizet_step = bool_rows ? sizet_cs : sizet_rs;
+    size_t sizet_jump = bool_rows ? sizet_rs : sizet_cs;
+
+    mat_min_index = bool_rows ? matrix <size_t> (sizet_out, 1) : matrix <size_t> (1, sizet_out);
+    mat_max_index = bool_rows ? matrix <size_t> (sizet_out, 1) : matrix <size_t> (1, sizet_out);
+
+    for (size_t sizet_i = 0; sizet_i < sizet_out; sizet_i++)
+    {
+        minmax_range(mat_arg.data() + sizet_i * sizet_jump, sizet_len, sizet_step, mat_min_index(sizet_i), mat_max_index(sizet_i));
+    }
+}
+
+template <class T> std::vector <T> diff(std::vector <T> &vec_arg)
+{
+    std::vector <T> vec_diff(vec_arg.size() - 1, T(0));
+
+    for (size_t i = 0; i < vec_arg.size() - 1; i++)
+    {
+        vec_diff[i] = vec_arg[i + 1] - vec_arg[i];
     }
 
+    return (vec_diff);
+}
+
+template <class T> matrix <T> sum(const matrix <T> &mat_arg)
+{
+    return sum(mat_arg.view());
+}
+
+template <class T> matrix <typename std::remove_const <T>::type> sum(const matrix_view <T> &mat_arg)
+{
+    return sum(mat_arg, default_axis(mat_arg));
+}
+
+template <class T> matrix <T> sum(const matrix <T> &mat_arg, axis ax)
+{
+    return sum(mat_arg.view(), ax);
+}
+
+template <class T> matrix <typename std::remove_const <T>::type> sum(const matrix_view <T> &mat_arg, axis ax)
+{
+    return reduce_sum <typename std::remove_const <T>::type> (mat_arg, ax, reduce_value());
+}
+
+template <class T> matrix <T> mean(const matrix <T> &mat_arg)
+{
+    return mean(mat_arg.view());
+}
+
+template <class T> matrix <typename std::remove_const <T>::type> mean(const matrix_view <T> &mat_arg)
+{
+    return mean(mat_arg, default_axis(mat_arg));
+}
+
+template <class T> matrix <T> mean(const matrix <T> &mat_arg, axis ax)
+{
+    return mean(mat_arg.view(), ax);
+}
+
+template <class T> matrix <typename std::remove_const <T>::type> mean(const matrix_view <T> &mat_arg, axis ax)
+{
+    typedef typename std::remove_const <T>::type V;
+    matrix <V> mat_ret = reduce_sum <V> (mat_arg, ax, reduce_value());
+
+    size_t sizet_num = ax == AXIS_ALL ? mat_arg.size() : (ax == AXIS_ROWS ? mat_arg.no_cols() : mat_arg.no_rows());
+    for (size_t sizet_i = 0; sizet_i < mat_ret.size(); sizet_i++) mat_ret(sizet_i) /= sizet_num;
+
     return mat_ret;
 }
 
@@ -311,78 +662,81 @@ template <class T> std::vector <T> abs(const std::vector <T> &vec_arg)
 
 template <class T> matrix <size_t> min(const matrix <T> &mat_arg)
 {
-    matrix <size_t>     mat_ret;
-    T                   T_min;
+    return min(mat_arg.view());
+}
 
-    if (mat_arg.no_cols() == 1 || mat_arg.no_rows() == 1)
-    {
-        mat_ret = matrix <size_t> (1, 1, 0);
-        T_min = mat_arg(0);
-        for (size_t uint_i = 1; uint_i < mat_arg.size(); uint_i++)
-        {
-            if (mat_arg(uint_i) < T_min)
-            {
-                T_min = mat_arg(uint_i);
-                mat_ret(0) = uint_i;
-            }
-        }
-    }
-    else if (mat_arg.no_rows() > 1 && mat_arg.no_cols() > 1)
-    {
-        mat_ret = matrix <size_t> (1, mat_arg.no_cols(), 0);
-        for (size_t uint_col = 0; uint_col < mat_arg.no_cols(); uint_col++)
-        {
-            T_min = mat_arg(0, uint_col);
-            for (size_t uint_row = 1; uint_row < mat_arg.no_rows(); uint_row++)
-            {
-                if (mat_arg(uint_row, uint_col) < T_min)
-                {
-                    T_min = mat_arg(uint_row, uint_col);
-                    mat_ret(uint_col) = uint_row;
-                }
-            }
-        }
-    }
+template <class T> matrix <size_t> min(const matrix_view <T> &mat_arg)
+{
+    matrix <size_t> mat_min, mat_max;
+    reduce_minmax(mat_arg, default_axis(mat_arg), mat_min, mat_max);
+    return mat_min;
+}
 
-    return mat_ret;
+template <class T> matrix <size_t> min(const matrix <T> &mat_arg, axis ax)
+{
+    return min(mat_arg.view(), ax);
+}
+
+template <class T> matrix <size_t> min(const matrix_view <T> &mat_arg, axis ax)
+{
+    matrix <size_t> mat_min, mat_max;
+    reduce_minmax(mat_arg, ax, mat_min, mat_max);
+    return mat_min;
 }
 
 template <class T> matrix <size_t> max(const matrix <T> &mat_arg)
 {
-    matrix <size_t> mat_ret;
-    T               T_max;
+    return max(mat_arg.view());
+}
+
+template <class T> matrix <size_t> max(const matrix_view <T> &mat_arg)
+{
+    matrix <size_t> mat_min, mat_max;
+    reduce_minmax(mat_arg, default_axis(mat_arg), mat_min, mat_max);
+    return mat_max;
+}
 
-    if (mat_arg.is_vector())
+template <class T> matrix <size_t> max(const matrix <T> &mat_arg, axis ax)
+{
+    return max(mat_arg.view(), ax);
+}
+
+template <class T> matrix <size_t> max(const matrix_view <T> &mat_arg, axis ax)
+{
+    matrix <size_t> mat_min, mat_max;
+    reduce_minmax(mat_arg, ax, mat_min, mat_max);
+    return mat_max;
+}
+
+template <class T> void minmax(const matrix <T> &mat_arg, matrix <T> &mat_min, matrix <size_t> &mat_min_index,
+  matrix <T> &mat_max, matrix <size_t> &mat_max_index, axis ax)
+{
+    reduce_minmax(mat_arg.view(), ax, mat_min_index, mat_max_index);
+
+    mat_min = matrix <T> (mat_min_index.shape());
+    mat_max = matrix <T> (mat_max_index.shape());
+
+    for (size_t sizet_i = 0; sizet_i < mat_min_index.size(); sizet_i++)
     {
-        mat_ret = matrix <size_t> (1, 1, 0);
-        T_max = mat_arg(0);
-        for (size_t uint_i = 1; uint_i < mat_arg.size(); uint_i++)
+        // the indices along an axis are rows or columns of the line they belong to
+        size_t sizet_min = mat_min_index(sizet_i);
+        size_t sizet_max = mat_max_index(sizet_i);
+        if (ax == AXIS_COLS)
         {
-            if (mat_arg(uint_i) > T_max)
-            {
-                T_max = mat_arg(uint_i);
-                mat_ret(0) = uint_i;
-            }
+            mat_min(sizet_i) = mat_arg(sizet_min, sizet_i);
+            mat_max(sizet_i) = mat_arg(sizet_max, sizet_i);
         }
-    }
-    else if (mat_arg.no_rows() > 1 && mat_arg.no_cols() > 1)
-    {
-        mat_ret = matrix <size_t> (1, mat_arg.no_cols(), 0);
-        for (size_t uint_col = 0; uint_col < mat_arg.no_cols(); uint_col++)
+        else if (ax == AXIS_ROWS)
+        {
+            mat_min(sizet_i) = mat_arg(sizet_i, sizet_min);
+            mat_max(sizet_i) = mat_arg(sizet_i, sizet_max);
+        }
+        else
         {
-            T_max = mat_arg(0, uint_col);
-            for (size_t uint_row = 1; uint_row < mat_arg.no_rows(); uint_row++)
-            {
-                if (mat_arg(uint_row, uint_col) > T_max)
-                {
-                    T_max = mat_arg(uint_row,uint_col);
-                    mat_ret(uint_col) = uint_row;
-                }
-            }
+            mat_min(sizet_i) = mat_arg(sizet_min);
+            mat_max(sizet_i) = mat_arg(sizet_max);
         }
     }
-
-    return mat_ret;
 }
 
 template <class T> matrix <std::complex <T>> conj(const matrix <std::complex <T>> &mat_arg)
@@ -396,45 +750,63 @@ template <class T> matrix <std::complex <T>> conj(const matrix <std::complex <T>
     return mat_ret;
 }
 
+template <class T> T conjugate(const T& T_arg)
+{
+    return T_arg;
+}
+
+template <class T> std::complex <T> conjugate(const std::complex <T>& cplx_arg)
+{
+    return std::conj(cplx_arg);
+}
+
 template <class T> matrix <T> mag(const matrix <std::complex <T>> &mat_arg)
 {
-    matrix <T> mat_ret(mat_arg.shape());
+    matrix <T>                  mat_ret(mat_arg.shape());
+    const std::complex <T>*     ptr_in  = mat_arg.data();
+    T*                          ptr_out = mat_ret.data();
+    reduce_energy               energy;
+
+    for (size_t sizet_i = 0; sizet_i < mat_arg.size(); sizet_i++) ptr_out[sizet_i] = energy(ptr_in[sizet_i]);
 
-    for (size_t uint_i = 0; uint_i < mat_arg.size(); uint_i++)
-    {
-        mat_ret(uint_i) = (mat_arg(uint_i) * std::conj(mat_arg(uint_i))).real();
-    }
     return mat_ret;
 }
 
 template <class T> matrix <T> norm(const matrix <T> &mat_arg)
 {
-    matrix <T> mat_ret;
+    return norm(mat_arg.view());
+}
+
+template <class T> matrix <typename std::remove_const <T>::type> norm(const matrix_view <T> &mat_arg)
+{
+    return norm(mat_arg, default_axis(mat_arg));
+}
+
+template <class T> matrix <T> norm(const matrix <T> &mat_arg, axis ax)
+{
+    return norm(mat_arg.view(), ax);
+}
+
+template <class T> matrix <typename std::remove_const <T>::type> norm(const matrix_view <T> &mat_arg, axis ax)
+{
+    typedef typename std::remove_const <T>::type V;
+    matrix <V> mat_ret = reduce_sum <V> (mat_arg, ax, reduce_energy());
+
+    for (size_t sizet_i = 0; sizet_i < mat_ret.size(); sizet_i++) mat_ret(sizet_i) = std::sqrt(mat_ret(sizet_i));
 
-    if (mat_arg.is_vector())
-    {
-        mat_ret = matrix <T> (1,1, T(0));
-        for (size_t uint_i = 0; uint_i < mat_arg.size(); uint_i++)
-        {
-            mat_ret(0) += mat_arg(uint_i) * mat_arg(uint_i);
-        }
-        mat_ret(0) = std::sqrt(mat_ret(0));
-    }
-    else if (mat_arg.no_rows() > 1 && mat_arg.no_cols() > 1)
-    {
-        mat_ret = matrix <T> (1, mat_arg.no_cols(), T(0));
-        for (size_t uint_col = 0; uint_col < mat_arg.no_cols(); uint_col++)
-        {
-            for (size_t uint_row = 0; uint_row < mat_arg.no_rows(); uint_row++)
-            {
-                mat_ret(uint_col) += mat_arg(uint_row,uint_col) * mat_arg(uint_row,uint_col);
-            }
-            mat_ret(uint_col) = std::sqrt(mat_ret(uint_col));
-        }
-    }
     return mat_ret;
 }
 
+template <class T> matrix <T> energy(const matrix <T> &mat_arg, axis ax)
+{
+    return reduce_sum <T> (mat_arg.view(), ax, reduce_energy());
+}
+
+template <class T> matrix <T> energy(const matrix <std::complex <T>> &mat_arg, axis ax)
+{
+    return reduce_sum <T> (mat_arg.view(), ax, reduce_energy());
+}
+
 template <class T> matrix <T> real(const matrix < std::complex <T> > &mat_arg)
 {
     matrix <T> mat_ret(mat_arg.shape());
@@ -0,0 +1,180 @@
+/*
+ * This file is part of Susa.
+ *
+ * Susa is free software: you can redistribute it and/or modify
+ * it under the terms of the Lesser GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * at your option) any later version.
+ *
+ * Susa is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * Lesser GNU General Public License for more details.
+ *
+ * You should have received a copy of the Lesser GNU General Public License
+ * along with Susa.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file bitvec.h
+ * @brief A packed bit vector (declaration).
+ * @author Behrooz Kamary
+ * @version 1.0.0
+ */
+
+#ifndef SUSA_BITVEC_H
+#define SUSA_BITVEC_H
+
+#include <cstdint>
+
+namespace susa
+{
+
+//! Returns the number of one bits of a word
+inline unsigned int popcount64(uint64_t uint_x)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_popcountll(uint_x);
+#else
+    uint_x = uint_x - ((uint_x >> 1) & 0x5555555555555555ull);
+    uint_x = (uint_x & 0x3333333333333333ull) + ((uint_x >> 2) & 0x3333333333333333ull);
+    uint_x = (uint_x + (uint_x >> 4)) & 0x0F0F0F0F0F0F0F0Full;
+    return static_cast <unsigned int> ((uint_x * 0x0101010101010101ull) >> 56);
+#endif
+}
+
+/**
+* @brief The <i>bitvec</i> class.
+*
+* <i>bitvec</i> stores a sequence of bits packed in 64 bit words, the bit <i>i</i>
+* is the bit <i>i % 64</i> of the word <i>i / 64</i>. The unused bits of the last
+* word are kept zero, hence the word-wise operations (counting, comparison and
+* the Hamming distance) need no masking. The bit access methods follow <i>bitset</i>.
+*
+* @ingroup TYPES
+*
+*/
+class bitvec :
+public memory <uint64_t>
+{
+  public :
+
+    //! Constructor of an empty vector
+    bitvec();
+
+    /**
+     * @brief Constructor
+     *
+     * @param sizet_bits number of bits, all zero
+     */
+    explicit bitvec(size_t sizet_bits);
+
+    /**
+     * @brief Constructor
+     *
+     * @param mat_arg one bit per element (nonzero is one)
+     */
+    explicit bitvec(const matrix <uint8_t>& mat_arg);
+
+    //! Returns the number of bits
+    size_t no_bits() const
+    {
+        return sizet_bits;
+    }
+
+    //! Returns the number of words
+    size_t no_words() const
+    {
+        return (sizet_bits + 63) / 64;
+    }
+
+    //! Returns a bit
+    bool exists(size_t sizet_index) const
+    {
+        return (this->_matrix[sizet_index >> 6] >> (sizet_index & 63)) & 0x1;
+    }
+
+    //! Sets a bit to one
+    void set(size_t sizet_index)
+    {
+        this->_matrix[sizet_index >> 6] |= 1ull << (sizet_index & 63);
+    }
+
+    //! Sets a bit to zero
+    void reset(size_t sizet_index)
+    {
+        this->_matrix[sizet_index >> 6] &= ~(1ull << (sizet_index & 63));
+    }
+
+    //! Sets a bit to a value
+    void assign(size_t sizet_index, bool bool_value)
+    {
+        if (bool_value) set(sizet_index);
+        else reset(sizet_index);
+    }
+
+    /**
+     * @brief Returns up to 64 bits starting at a bit
+     *
+     * @param sizet_index the first bit (the least significant bit of the result)
+     * @param uint_num the number of bits
+     */
+    uint64_t get_bits(size_t sizet_index, unsigned int uint_num) const;
+
+    /**
+     * @brief Writes up to 64 bits starting at a bit
+     *
+     * @param sizet_index the first bit
+     * @param uint_value the bits, the least significant bit first
+     * @param uint_num the number of bits
+     */
+    void set_bits(size_t sizet_index, uint64_t uint_value, unsigned int uint_num);
+
+    //! Sets all the bits to one
+    void set();
+
+    //! Sets all the bits to zero
+    void reset();
+
+    //! Returns true if any bit is one
+    bool any() const;
+
+    //! Returns the number of one bits
+    size_t count() const;
+
+    //! Returns the bits one per element as a column vector
+    matrix <uint8_t> unpack() const;
+
+    //! Bit-wise exclusive or with a vector of the same length
+    bitvec& operator^=(const bitvec& bv_arg);
+
+    //! Bit-wise exclusive or
+    friend bitvec operator^(const bitvec& bv_argl, const bitvec& bv_argr)
+    {
+        bitvec bv_ret(bv_argl);
+        bv_ret ^= bv_argr;
+        return bv_ret;
+    }
+
+    //! Comparison
+    friend bool operator==(const bitvec& bv_argl, const bitvec& bv_argr);
+
+  private :
+
+    size_t sizet_bits;
+
+    //! clears the unused bits of the last word
+    void trim();
+};
+
+/**
+ * @brief The Hamming distance i.e. the number of bit errors
+ *
+ * @param bv_argl the first vector
+ * @param bv_argr the second vector (of the same length)
+ * @ingroup TYPES
+ */
+size_t hamming_distance(const bitvec& bv_argl, const bitvec& bv_argr);
+
+}       // NAMESPACE SUSA
+#endif  // SUSA_BITVEC_H
@@ -44,6 +44,13 @@ class ccode
 {
   public:
 
+    //! The max* operation of the log-domain BCJR decoder
+    enum bcjr_metric
+    {
+        MAX_LOG_MAP,    //!< max(a, b)
+        LOG_MAP         //!< max(a, b) + ln(1 + exp(-|a - b|)) from a lookup table
+    };
+
     /**
      * @brief Constructor
      * 
@@ -92,6 +99,12 @@ class ccode
       return (uint_k / uint_n);
     }
 
+    //! The trellis of the code (shared read-only by the decoders)
+    trellis_ptr get_trellis() const
+    {
+        return ptr_trellis;
+    }
+
     /**
      * @brief 1/n Convolutional encoder
      * 
@@ -99,6 +112,18 @@ class ccode
      **/
     matrix <uint8_t> encode(const matrix <uint8_t>& mat_arg);
 
+    /**
+     * @brief 1/n Convolutional encoder of packed bits
+     *
+     * The encoder starts at the zero state and the output bits are in the order of
+     * <i>encode(matrix)</i>. For up to eight memories and eight outputs a table indexed
+     * by the state and the next eight input bits gives the next state and the 8n output
+     * bits, hence a byte of the input costs one lookup and one packed store.
+     *
+     * @param bv_arg packed bits to be encoded
+     **/
+    bitvec encode(const bitvec& bv_arg) const;
+
     /**
      * @brief BCJR decoder
      * 
@@ -106,10 +131,176 @@ class ccode
      * @param dbl_ebn0 Eb/N0 in linear scale with AWGN assumption
      * @param c_k input bernolli process probability (0.5 for equiprobable binary signal)
      */
-    matrix <double> decode_bcjr(const matrix <double> &mat_arg, double dbl_ebn0, double c_k = 0.5);
+    matrix <double> decode_bcjr(const matrix <double> &mat_arg, double dbl_ebn0, double c_k = 0.5) const;
+
+    /**
+     * @brief Log-domain BCJR decoder
+     *
+     * The forward and backward recursions run on the logarithms of the metrics, hence there is
+     * no transcendental function in the recursions and no overflow or underflow at high Eb/N0.
+     * The branch metrics are computed once per stage for the 2^n output labels and only
+     * the forward metrics are stored, the beta recursion computes the LLRs on the fly.
+     * The trellis starts and ends in the zero state.
+     *
+     * @param mat_arg Input matrix to be decoded (antipodal, positive for a one bit)
+     * @param dbl_ebn0 Eb/N0 in linear scale with AWGN assumption
+     * @param metric the max* operation
+     * @param c_k the a priori probability of a one bit
+     * @return the Log-Likelihood Ratios ln(P(1)/P(0)) of the stages
+     */
+    matrix <double> decode_bcjr_log(const matrix <double> &mat_arg, double dbl_ebn0, bcjr_metric metric = LOG_MAP, double c_k = 0.5) const;
+
+    /**
+     * @brief Sliding-window log-domain BCJR decoder
+     *
+     * The frame is decoded in windows of <i>sizet_window</i> stages. The backward recursion
+     * of a window is initialized <i>sizet_warmup</i> stages after its end with equal metrics,
+     * hence the memory is O((W + D) S) instead of O(N S). A window as long as the frame gives
+     * <i>decode_bcjr_log()</i>.
+     *
+     * @param mat_arg Input matrix to be decoded (antipodal, positive for a one bit)
+     * @param dbl_ebn0 Eb/N0 in linear scale with AWGN assumption
+     * @param sizet_window the window length in stages
+     * @param sizet_warmup the warm-up length in stages of the backward recursion
+     * @param metric the max* operation
+     * @param c_k the a priori probability of a one bit
+     * @return the Log-Likelihood Ratios ln(P(1)/P(0)) of the stages
+     */
+    matrix <double> decode_bcjr_window(const matrix <double> &mat_arg, double dbl_ebn0, size_t sizet_window, size_t sizet_warmup,
+      bcjr_metric metric = LOG_MAP, double c_k = 0.5) const;
+
+    /**
+     * @brief Batched log-domain BCJR decoder
+     *
+     * The frames are decoded in parallel on the thread pool. The decoders only read the
+     * shared trellis and each worker reuses its own scratch space for all of its frames,
+     * hence the throughput scales with the number of threads.
+     *
+     * @param mat_frames the frames as columns (antipodal, positive for a one bit)
+     * @param dbl_ebn0 Eb/N0 in linear scale with AWGN assumption
+     * @param sizet_window the window length in stages (zero for the whole frame)
+     * @param sizet_warmup the warm-up length in stages of the backward recursion
+     * @param metric the max* operation
+     * @param c_k the a priori probability of a one bit
+     * @return the Log-Likelihood Ratios of the frames as columns
+     */
+    matrix <double> decode_bcjr_batch(const matrix <double> &mat_frames, double dbl_ebn0, size_t sizet_window = 0,
+      size_t sizet_warmup = 0, bcjr_metric metric = LOG_MAP, double c_k = 0.5) const;
+
+    //! Batched log-domain BCJR decoder of frames with different lengths
+    std::vector <matrix <double> > decode_bcjr_batch(const std::vector <matrix <double> > &vec_frames, double dbl_ebn0,
+      size_t sizet_window = 0, size_t sizet_warmup = 0, bcjr_metric metric = LOG_MAP, double c_k = 0.5) const;
+
+    /**
+     * @brief Max-Log-MAP decoder with the metrics of type <i>M</i>
+     *
+     * The soft values are quantized by <i>quant</i> and the recursions of <i>decode_bcjr_window()</i>
+     * run on the metric type, i.e. float or the saturating int16_t and int8_t of the hardware
+     * decoders. The fixed-point metrics are normalized by their maximum at every stage, hence
+     * only the unlikely states saturate. The inputs are equiprobable.
+     *
+     * @param mat_arg Input matrix to be decoded (antipodal, positive for a one bit)
+     * @param quant the quantizer of the soft values
+     * @param sizet_window the window length in stages (zero for the whole frame)
+     * @param sizet_warmup the warm-up length in stages of the backward recursion
+     * @return the Log-Likelihood Ratios of the stages in the units of the quantized values
+     */
+    template <typename M> matrix <M> decode_bcjr_max_log(const matrix <double> &mat_arg, const llr_quantizer& quant,
+      size_t sizet_window = 0, size_t sizet_warmup = 0) const;
+
+    /**
+     * @brief Viterbi decoder with soft input
+     *
+     * The maximum likelihood sequence is searched over the trellis with the correlation
+     * metric, i.e. a positive input favours a one bit (antipodal mapping 0 to -1 and 1 to +1).
+     * The trellis starts in the zero state.
+     *
+     * @param mat_arg the soft input, <i>n</i> values per stage
+     * @param bool_terminated the encoder is flushed to the zero state (otherwise the traceback
+     * starts from the best state)
+     * @return the decoded bits
+     */
+    matrix <uint8_t> decode_viterbi(const matrix <double>& mat_arg, bool bool_terminated = true) const;
+
+    /**
+     * @brief Viterbi decoder with the metrics of type <i>M</i>
+     *
+     * The soft values are quantized by <i>quant</i> and the path metrics are float or the
+     * saturating int16_t and int8_t. The metrics are renormalized before the largest one can
+     * saturate, i.e. every (max metric) / (n * quantizer range) stages. The narrower metrics
+     * give more lanes to the add-compare-select and less memory traffic.
+     *
+     * @param mat_arg the soft input, <i>n</i> values per stage
+     * @param quant the quantizer of the soft values
+     * @param bool_terminated the encoder is flushed to the zero state
+     * @return the decoded bits
+     */
+    template <typename M> matrix <uint8_t> decode_viterbi(const matrix <double>& mat_arg, const llr_quantizer& quant,
+      bool bool_terminated = true) const;
+
+    /**
+     * @brief Viterbi decoder with hard input
+     *
+     * It minimizes the Hamming distance to the received bits.
+     *
+     * @param mat_arg the received bits, <i>n</i> bits per stage
+     * @param bool_terminated the encoder is flushed to the zero state
+     * @return the decoded bits
+     */
+    matrix <uint8_t> decode_viterbi(const matrix <uint8_t>& mat_arg, bool bool_terminated = true) const;
+
+    /**
+     * @brief Batched Viterbi decoder with soft input
+     *
+     * The frames are decoded in parallel on the thread pool, see <i>decode_bcjr_batch()</i>.
+     *
+     * @param mat_frames the frames as columns, <i>n</i> values per stage
+     * @param bool_terminated the encoder is flushed to the zero state
+     * @return the decoded bits of the frames as columns
+     */
+    matrix <uint8_t> decode_viterbi_batch(const matrix <double>& mat_frames, bool bool_terminated = true) const;
+
+    //! Batched Viterbi decoder of frames with different lengths
+    std::vector <matrix <uint8_t> > decode_viterbi_batch(const std::vector <matrix <double> >& vec_frames,
+      bool bool_terminated = true) const;
 
   private:
 
+    // the iterative decoder reuses the frame decoders and their scratch space
+    friend class turbo;
+
+    //! The scratch space of the decoders, a worker reuses it for all of its frames
+    struct workspace
+    {
+        std::vector <float>    vec_metric;
+        std::vector <float>    vec_next;
+        std::vector <float>    vec_branch;
+        std::vector <uint8_t>  vec_mask;
+        std::vector <uint64_t> vec_decisions;
+        std::vector <uint8_t>  vec_out00;
+        std::vector <uint8_t>  vec_out10;
+        std::vector <uint8_t>  vec_out01;
+        std::vector <uint8_t>  vec_out11;
+        std::vector <double>   vec_alpha;
+        std::vector <double>   vec_bm;
+        std::vector <double>   vec_bm_stage;
+        std::vector <double>   vec_beta;
+        std::vector <double>   vec_beta_prev;
+    };
+
+    //! the Viterbi decoder of a frame
+    void viterbi(const double* ptr_input, size_t sizet_stages, bool bool_terminated, workspace& ws, uint8_t* ptr_out) const;
+
+    //! the Viterbi decoder of a frame with the metrics of type <i>M</i>, renormalized every <i>sizet_period</i> stages,
+    //! the branch metrics are followed by their planes per butterfly
+    template <typename I, typename M> void viterbi(const I* ptr_input, size_t sizet_stages, bool bool_terminated,
+      size_t sizet_period, workspace& ws, std::vector <M>& vec_metric, std::vector <M>& vec_next,
+      std::vector <M>& vec_branch, uint8_t* ptr_out) const;
+
+    //! the log-domain BCJR decoder of a frame, the a priori LLRs of the stages <i>ptr_la</i> replace <i>c_k</i>
+    void bcjr(const double* ptr_in, size_t sizet_stages, double dbl_ebn0, size_t sizet_window, size_t sizet_warmup,
+      bcjr_metric metric, double c_k, workspace& ws, double* ptr_llr, const double* ptr_la = nullptr) const;
+
     /**
      * @brief get the next state
      *
@@ -128,12 +319,8 @@ class ccode
 
     uint8_t next_output(bool b_input);
     
-    /**
-     * @brief get all possible previous states
-     *
-     * @param uint_state the current state
-     */
-    std::vector <uint32_t> prev_states(uint32_t uint_state);
+    //! builds the trellis tables from the generators
+    void build_trellis();
 
     //! the previous output for a given state and input
     uint32_t prev_output(uint32_t uint_state, bool b_input);
@@ -172,6 +359,12 @@ class ccode
     uint32_t uint_current_state;
     uint32_t uint_last_state;
 
+    trellis_ptr ptr_trellis;
+
+    // the packed encoder tables at (state << 8) | byte (empty for large codes)
+    std::vector <uint64_t> vec_enc_out;
+    std::vector <uint16_t> vec_enc_next;
+
 };
 
 }
@@ -60,17 +60,16 @@ template <class T> class channel
     matrix <unsigned int> mat_source_states;
     matrix <unsigned int> mat_decoded_states;
 
-    //! next state
-    unsigned int next_state(unsigned int uint_state, unsigned int uint_pam_index);
+    trellis_ptr     ptr_trellis;
 
-    //! previous state
-    matrix <unsigned int> prev_states(unsigned int uint_state);
+    //! next state
+    unsigned int next_state(unsigned int uint_state, unsigned int uint_pam_index) const;
 
-    T next_output(unsigned int uint_state, unsigned int uint_pam_index);
+    T next_output(unsigned int uint_state, unsigned int uint_pam_index) const;
 
-    matrix <T> get_full_state(unsigned int uint_state);
+    matrix <T> get_full_state(unsigned int uint_state) const;
 
-    matrix <T> get_mem_state(unsigned int uint_state);
+    matrix <T> get_mem_state(unsigned int uint_state) const;
 
   public:
 
@@ -89,6 +88,30 @@ template <class T> class channel
     //! Destructor
     ~channel();
 
+    //! The trellis of the channel memory (shared read-only by the decoders)
+    trellis_ptr get_trellis() const
+    {
+        return ptr_trellis;
+    }
+
+    //! The noiseless channel outputs indexed by the trellis labels
+    const matrix <T>& get_outputs() const
+    {
+        return mat_outputs;
+    }
+
+    //! The signal amplitudes of the constellation symbols
+    const matrix <T>& get_pam() const
+    {
+        return mat_pam;
+    }
+
+    //! The Channel Impulse Response (CIR)
+    const matrix <T>& get_taps() const
+    {
+        return mat_taps;
+    }
+
     /**
      * @brief Inter-Symbol Interference (ISI) channel encoder
      *
@@ -107,7 +130,37 @@ template <class T> class channel
      * @param mat_arg the encoded signal vector
      * @param dbl_ebn0 the signal to noise ratio Eb/N0
      */
-    matrix <T> decode_bcjr(const matrix <T> &mat_arg, T dbl_ebn0);
+    matrix <T> decode_bcjr(const matrix <T> &mat_arg, T dbl_ebn0) const;
+
+    /**
+     * @brief Sliding-window BCJR equalizer
+     *
+     * The signal is equalized in windows of <i>size_window</i> stages. The backward recursion
+     * of a window starts <i>size_warmup</i> stages after its end from equiprobable states.
+     * The branch probabilities of a window are stored for the valid transitions only
+     * (states x inputs), hence the memory is O(W S) instead of O(N S^2).
+     * A window as long as the signal gives <i>decode_bcjr()</i>.
+     *
+     * @param mat_arg the encoded signal vector
+     * @param dbl_ebn0 the signal to noise ratio Eb/N0
+     * @param size_window the window length in stages
+     * @param size_warmup the warm-up length in stages of the backward recursion
+     */
+    matrix <T> decode_bcjr_window(const matrix <T> &mat_arg, T dbl_ebn0, size_t size_window, size_t size_warmup) const;
+
+    /**
+     * @brief Batched sliding-window BCJR equalizer
+     *
+     * The frames are equalized in parallel on the thread pool. The equalizers only read
+     * the shared trellis and the channel outputs, each call has its own scratch space.
+     *
+     * @param mat_frames the encoded signals as columns
+     * @param dbl_ebn0 the signal to noise ratio Eb/N0
+     * @param size_window the window length in stages (zero for the whole frame)
+     * @param size_warmup the warm-up length in stages of the backward recursion
+     * @return the likelihood ratios of the frames as columns
+     */
+    matrix <T> decode_bcjr_batch(const matrix <T> &mat_frames, T dbl_ebn0, size_t size_window = 0, size_t size_warmup = 0) const;
 
     /**
      * @brief Viterbi i.e. maximum likelihood sequence estimation (MLSE) algorithm
@@ -116,7 +169,18 @@ template <class T> class channel
      * @param mat_arg the encoded signal vector
      * @param uint_init_state the initial state of the trellis
      */
-    matrix <T> decode_mlse(const matrix <T> &mat_arg, unsigned int uint_init_state);
+    matrix <T> decode_mlse(const matrix <T> &mat_arg, unsigned int uint_init_state) const;
+
+    /**
+     * @brief Batched MLSE equalizer
+     *
+     * The frames are equalized in parallel on the thread pool, see <i>decode_bcjr_batch()</i>.
+     *
+     * @param mat_frames the encoded signals as columns
+     * @param uint_init_state the initial state of the trellis
+     * @return the detected symbols of the frames as columns
+     */
+    matrix <T> decode_mlse_batch(const matrix <T> &mat_frames, unsigned int uint_init_state) const;
 
     /**
      * @brief Viterbi algorithm
@@ -125,21 +189,269 @@ template <class T> class channel
      *
      * @param mat_arg the encoded signal vector
      */
-    matrix <T> decode_mlse(const matrix <T> &mat_arg);
+    matrix <T> decode_mlse(const matrix <T> &mat_arg) const;
 
 
     /**
      * @brief ZF-DFE with BPSK quantizer
      *
      * Zero-Forcing (ZF) Decision–Feedback Equalization (DFE)
-     * for BPSK modulated signals.
+     * for BPSK modulated signals, see <i>dfe_equalizer</i>. The channel starts in a known
+     * state and the tail is dropped as in <i>decode_mlse()</i>.
      *
      * @param mat_arg the input signal
+     * @param uint_init_state the initial state of the channel memory
      */
-    matrix <T> decode_bpsk_dfe(const matrix <T> &mat_arg);
+    matrix <T> decode_bpsk_dfe(const matrix <T> &mat_arg, unsigned int uint_init_state = 0) const;
 
 };
 
+/**
+ * @brief The streaming Viterbi (MLSE) equalizer class.
+ *
+ * The samples are pushed block by block and a decision is emitted with a
+ * fixed latency of <i>D</i> samples (the traceback depth), i.e. after the first
+ * <i>D</i> samples every sample produces the decision of the sample that was pushed
+ * <i>D</i> samples earlier. The survivors are kept in a ring buffer of <i>D + 1</i> stages
+ * and the metrics are double-buffered, hence the memory is O(S D) and the cost of a sample
+ * is constant on an arbitrarily long stream.
+ *
+ * @ingroup Communications
+ */
+template <class T> class viterbi_equalizer
+{
+  public:
+    /**
+     * @brief Constructor
+     *
+     * The initial state is unknown (see <i>reset()</i>).
+     *
+     * @param ch the ISI channel
+     * @param size_depth the traceback depth (a few times the channel memory)
+     */
+    viterbi_equalizer(const channel <T>& ch, size_t size_depth);
+
+    //! Returns the traceback depth
+    size_t depth() const;
+
+    //! Restarts the stream with an unknown initial state
+    void reset();
+
+    //! Restarts the stream from a known state of the channel memory
+    void reset(unsigned int uint_init_state);
+
+    /**
+     * @brief Pushes a block of samples
+     *
+     * @param ptr_in the received samples
+     * @param size_num number of samples
+     * @param ptr_out the decided symbol amplitudes, up to <i>size_num</i> elements
+     * @return number of emitted decisions
+     */
+    size_t process(const T* ptr_in, size_t size_num, T* ptr_out);
+
+    //! Pushes a block of samples and returns the emitted decisions (a column vector)
+    matrix <T> process(const matrix <T>& mat_in);
+
+    /**
+     * @brief Emits the pending decisions from the best state and restarts the stream
+     *
+     * @param ptr_out the decided symbol amplitudes, up to <i>depth()</i> elements
+     * @return number of emitted decisions
+     */
+    size_t flush(T* ptr_out);
+
+    //! Emits the pending decisions and restarts the stream
+    matrix <T> flush();
+
+  private:
+    trellis_ptr                 ptr_trellis;
+    matrix <T>                  mat_pam;
+    size_t                      size_depth;
+    size_t                      size_states;
+    size_t                      size_inputs;
+    std::vector <T>             vec_branch_out;     // the output from the k-th predecessor of each state
+    std::vector <T>             vec_metric;
+    std::vector <T>             vec_metric_next;
+    std::vector <uint8_t>       vec_survivors;      // the k of the survivor, a ring of D + 1 stages
+    size_t                      size_count;         // the number of pushed samples (saturates at D + 1)
+    size_t                      size_head;          // the ring position of the last stage
+
+    // the state of the best metric
+    size_t best_state() const;
+};
+
+/**
+ * @brief The streaming Decision-Feedback Equalizer (DFE) class.
+ *
+ * The feedforward filter runs on the latest samples and the feedback filter cancels the
+ * ISI of the past decisions, i.e. the sample <i>k</i> gives the decision of the symbol
+ * <i>k - delay</i>
+ * \f[
+ * y_{k} = \sum_{i} f_{i} x_{k - i} - \sum_{j \geq 1} b_{j} \hat{s}_{k - delay - j}
+ * \f]
+ * quantized to the nearest signal amplitude (the sign for BPSK). With a nonzero step the
+ * taps are adapted by the LMS algorithm, either on the known symbols of <i>train()</i> or
+ * on the decisions of <i>process()</i>.
+ *
+ * @ingroup Communications
+ */
+template <class T> class dfe_equalizer
+{
+  public:
+    /**
+     * @brief Constructor
+     *
+     * @param mat_ff the feedforward taps
+     * @param mat_fb the feedback taps, the first one for the latest decision
+     * @param mat_pam the signal amplitudes of the constellation symbols
+     * @param size_delay the decision delay in samples (less than the feedforward taps)
+     * @param T_step the LMS step size (zero for the fixed taps)
+     */
+    dfe_equalizer(const matrix <T>& mat_ff, const matrix <T>& mat_fb, const matrix <T>& mat_pam,
+      size_t size_delay = 0, T T_step = 0);
+
+    /**
+     * @brief The Zero-Forcing (ZF) DFE of a channel
+     *
+     * A single feedforward tap inverts the main tap and the feedback taps are the
+     * remaining taps of the channel, hence the channel has to be minimum phase.
+     * A channel without a main tap gives a slicer of the samples (no feedback).
+     *
+     * @param ch the ISI channel
+     * @param T_step the LMS step size (zero for the fixed taps)
+     */
+    explicit dfe_equalizer(const channel <T>& ch, T T_step = 0);
+
+    //! Restarts the stream with zero samples and decisions (the taps are kept)
+    void reset();
+
+    //! Restarts the stream with the known past decisions, the latest first
+    void reset(const matrix <T>& mat_decisions);
+
+    /**
+     * @brief Pushes a block of samples (decision-directed)
+     *
+     * @param ptr_in the received samples
+     * @param size_num number of samples
+     * @param ptr_out the decided symbol amplitudes, up to <i>size_num</i> elements
+     * @return number of emitted decisions
+     */
+    size_t process(const T* ptr_in, size_t size_num, T* ptr_out);
+
+    //! Pushes a block of samples and returns the emitted decisions (a column vector)
+    matrix <T> process(const matrix <T>& mat_in);
+
+    /**
+     * @brief Pushes a block of samples with the known symbols (training)
+     *
+     * The feedback and the LMS error take the known symbols instead of the decisions.
+     *
+     * @param ptr_in the received samples
+     * @param ptr_ref the transmitted symbols, one per sample
+     * @param size_num number of samples
+     * @param ptr_out the decided symbol amplitudes, up to <i>size_num</i> elements
+     * @return number of emitted decisions
+     */
+    size_t train(const T* ptr_in, const T* ptr_ref, size_t size_num, T* ptr_out);
+
+    //! Pushes a block of samples with the known symbols and returns the emitted decisions
+    matrix <T> train(const matrix <T>& mat_in, const matrix <T>& mat_ref);
+
+    //! Returns the feedforward taps
+    const matrix <T>& feedforward() const
+    {
+        return mat_ff;
+    }
+
+    //! Returns the feedback taps
+    const matrix <T>& feedback() const
+    {
+        return mat_fb;
+    }
+
+    //! Returns the decision delay
+    size_t delay() const
+    {
+        return size_delay;
+    }
+
+  private:
+    matrix <T>                  mat_ff;
+    matrix <T>                  mat_fb;
+    matrix <T>                  mat_pam;
+    size_t                      size_delay;
+    T                           T_step;
+    std::vector <T>             vec_samples;        // the latest samples, the newest first
+    std::vector <T>             vec_decisions;      // the past decisions, the latest first
+    std::vector <T>             vec_refs;           // the known symbols of the delay line
+    size_t                      size_count;         // the number of pushed samples (saturates at delay)
+
+    // the nearest signal amplitude
+    T slice(T T_arg) const;
+
+    // a sample with an optional known symbol
+    bool push(T T_in, const T* ptr_ref, T& T_out);
+};
+
+/**
+ * @brief The Reduced-State Sequence Estimation (RSSE) class, the M-algorithm.
+ *
+ * Instead of the full trellis of <i>P^(L)</i> states only the best <i>M</i> survivors are
+ * extended at every stage. Each survivor carries its own channel memory (per-survivor
+ * processing), hence the cost of a stage is O(M P L) and long channels are tractable.
+ * The <i>M P</i> extensions are pruned by a partial selection of the least metrics, see
+ * <i>select_least()</i>.
+ * The extensions that share their latest <i>K</i> symbols can be merged first, i.e. only
+ * the best one of a reduced state survives. With <i>K = L</i> and <i>M = P^(L)</i> the
+ * detector is the Viterbi algorithm of <i>channel::decode_mlse()</i>.
+ *
+ * @ingroup Communications
+ */
+template <class T> class rsse_equalizer
+{
+  public:
+    /**
+     * @brief Constructor
+     *
+     * @param mat_taps the Channel Impulse Response (CIR)
+     * @param mat_pam the signal amplitudes of the constellation symbols
+     * @param size_survivors the number of survivors <i>M</i>
+     * @param size_merge the number of the latest symbols <i>K</i> that define a reduced state (zero for no merging)
+     */
+    rsse_equalizer(const matrix <T>& mat_taps, const matrix <T>& mat_pam, size_t size_survivors, size_t size_merge = 0);
+
+    /**
+     * @brief Sequence detection
+     *
+     * The channel starts and ends in a known state (see <i>channel::encode_isi()</i>),
+     * the tail is dropped as in <i>channel::decode_mlse()</i>.
+     *
+     * @param mat_arg the received signal
+     * @param uint_init_state the state of the channel memory, i.e. the signal amplitude indices of the taps 1 to L as base P digits
+     * @return the detected symbol amplitudes
+     */
+    matrix <T> decode(const matrix <T>& mat_arg, unsigned int uint_init_state = 0);
+
+  private:
+    matrix <T>                  mat_taps;
+    matrix <T>                  mat_pam;
+    size_t                      size_survivors;
+    size_t                      size_merge;
+    size_t                      size_memory;        // L, the number of the taps minus one
+
+    // the scratch space of the stages
+    std::vector <T>             vec_metric;
+    std::vector <T>             vec_cost;           // the metrics of the M P extensions
+    std::vector <unsigned int>  vec_index;
+    std::vector <unsigned int>  vec_best;           // the best extension of a reduced state
+    std::vector <uint8_t>       vec_memory;         // the symbol indices of the survivors, the latest first
+    std::vector <uint8_t>       vec_memory_next;
+    std::vector <uint32_t>      vec_parent;         // the survivor of every stage
+    std::vector <uint8_t>       vec_symbol;
+    std::vector <unsigned int>  vec_key;            // the reduced state of a survivor without the new symbol
+};
+
 
 
 // Constructor
@@ -180,11 +492,24 @@ template <class T> void channel <T>::init(const matrix <T> &mat_taps, const matr
     }
 
     mat_outputs = matmul(mat_taps, mat_trellis);
+
+    // the label of a transition is its index in mat_outputs
+    std::vector <uint32_t> vec_next(uint_num_states);
+    std::vector <uint32_t> vec_labels(uint_num_states);
+    for (unsigned int uint_state = 0; uint_state < uint_num_states_mem; uint_state++)
+    {
+        for (unsigned int uint_pam_index = 0; uint_pam_index < uint_num_pam; uint_pam_index++)
+        {
+            vec_next[uint_state * uint_num_pam + uint_pam_index]   = next_state(uint_state, uint_pam_index);
+            vec_labels[uint_state * uint_num_pam + uint_pam_index] = uint_state * uint_num_pam + uint_pam_index;
+        }
+    }
+    ptr_trellis = std::make_shared <const trellis> (uint_num_states_mem, uint_num_pam, vec_next, vec_labels);
 } // INIT
 
 
 
-template <class T>  matrix <T> channel <T>::get_full_state(unsigned int uint_state)
+template <class T>  matrix <T> channel <T>::get_full_state(unsigned int uint_state) const
 {
     matrix <T> mat_ret(uint_num_taps, 1, 0);
     unsigned int uint_tmp_state = uint_state;
@@ -196,7 +521,7 @@ template <class T>  matrix <T> channel <T>::get_full_state(unsigned int uint_sta
     return mat_ret;
 }
 
-template <class T>  matrix <T> channel <T>::get_mem_state(unsigned int uint_state)
+template <class T>  matrix <T> channel <T>::get_mem_state(unsigned int uint_state) const
 {
     matrix <T> mat_ret(uint_num_taps - 1, 1, 0);
     unsigned int uint_tmp_state = uint_state;
@@ -208,7 +533,7 @@ template <class T>  matrix <T> channel <T>::get_mem_state(unsigned int uint_stat
     return mat_ret;
 }
 
-template <class T> unsigned int channel <T>::next_state(unsigned int uint_state_mem_arg, unsigned int uint_pam_index)
+template <class T> unsigned int channel <T>::next_state(unsigned int uint_state_mem_arg, unsigned int uint_pam_index) const
 {
     unsigned int uint_base = 1;
     for (unsigned int uint_i = 0; uint_i < (uint_num_taps - 1); uint_i++)
@@ -221,25 +546,11 @@ template <class T> unsigned int channel <T>::next_state(unsigned int uint_state_
     return uint_state;
 }
 
-template <class T> T channel <T>::next_output(unsigned int uint_state_mem_arg, unsigned int uint_pam_index)
+template <class T> T channel <T>::next_output(unsigned int uint_state_mem_arg, unsigned int uint_pam_index) const
 {
     return mat_outputs(uint_state_mem_arg * uint_num_pam + uint_pam_index);
 }
 
-template <class T> matrix <unsigned int> channel <T>::prev_states(unsigned int uint_state_mem_arg)
-{
-
-    matrix <unsigned int> mat_ret(uint_num_pam, 1, 0);
-    unsigned int uint_shift = uint_state_mem_arg / uint_num_pam;
-
-    unsigned int uint_base = 1;
-    for (unsigned int uint_i = 0; uint_i < (uint_num_taps - 2); uint_i++) uint_base *= uint_num_pam;
-    for (unsigned int uint_i = 0; uint_i < uint_num_pam; uint_i++) mat_ret(uint_i) = uint_shift + uint_i * uint_base;
-
-    return mat_ret;
-
-} // PREV_STATES
-
 
 // Public methods
 
@@ -250,13 +561,14 @@ template <class T> matrix <T> channel <T>::encode_isi(const matrix <T> &mat_arg,
     matrix <T> mat_ret;
     matrix <T> mat_init_state = flipud(get_mem_state(uint_init_state));
 
-    mat_ret = conv(concat(concat(mat_init_state, mat_arg),mat_init_state), mat_taps).mid(mat_taps.size() - 1, mat_arg.size() + 2 * mat_taps.size() - 3);
+    mat_ret = conv(concat(concat(mat_init_state, mat_arg),mat_init_state), mat_taps).mid_view(mat_taps.size() - 1, mat_arg.size() + 2 * mat_taps.size() - 3);
 
     return mat_ret;
 } // ENCODE
 
 
-template <class T> matrix <T> channel <T>::decode_mlse(const matrix <T> &mat_arg, unsigned int uint_init_state) { // DECODE_MLSE Initial state
+template <class T> matrix <T> channel <T>::decode_mlse(const matrix <T> &mat_arg, unsigned int uint_init_state) const { // DECODE_MLSE Initial state
+    SUSA_PROFILE_SCOPE("channel.mlse");
 
     T dbl_metric = 0;
     unsigned int uint_l = mat_taps.size() - 1;
@@ -264,17 +576,18 @@ template <class T> matrix <T> channel <T>::decode_mlse(const matrix <T> &mat_arg
     unsigned int uint_num_states = uint_num_states_mem;
 
 
-    matrix <T> mat_metric_past(uint_num_states, 1);
+    matrix <T> mat_metric_past(uint_num_states, 1, 0);
     matrix <T> mat_metric_next(uint_num_states, 1,std::numeric_limits<T>::max());
 
 
     matrix <unsigned int> mat_survivor_path(uint_num_states, uint_num_stages);
     matrix <unsigned int> mat_previous_state(uint_num_states, uint_num_stages);
 
-    matrix <unsigned int> mat_visited(uint_num_states,1);
-    matrix <unsigned int> mat_visited_forward(uint_num_states,1);
+    matrix <unsigned int> mat_visited(uint_num_states, 1, 0);
+    matrix <unsigned int> mat_visited_forward(uint_num_states, 1, 0);
     mat_visited(uint_init_state) = 1;
 
+    const trellis& trel = *ptr_trellis;
     T dbl_next_output;
     unsigned int uint_next_state;
 
@@ -287,8 +600,8 @@ template <class T> matrix <T> channel <T>::decode_mlse(const matrix <T> &mat_arg
                 for (unsigned int uint_pam_index = 0; uint_pam_index < uint_num_pam; uint_pam_index++)
                 {
 
-                    dbl_next_output = this->next_output(uint_state,uint_pam_index);
-                    uint_next_state = this->next_state(uint_state,uint_pam_index);
+                    dbl_next_output = mat_outputs(trel.label(uint_state, uint_pam_index));
+                    uint_next_state = trel.next_state(uint_state, uint_pam_index);
 
                     mat_visited_forward(uint_next_state) = 1;
 
@@ -304,10 +617,10 @@ template <class T> matrix <T> channel <T>::decode_mlse(const matrix <T> &mat_arg
                 }
             }
         }
-        mat_metric_past = mat_metric_next;
-        mat_metric_next = matrix <T> (uint_num_states, 1,std::numeric_limits<T>::max());
-        mat_visited = mat_visited_forward;
-        mat_visited_forward = matrix <unsigned int> (uint_num_states,1);
+        std::swap(mat_metric_past, mat_metric_next);
+        mat_metric_next.set_all(std::numeric_limits<T>::max());
+        std::swap(mat_visited, mat_visited_forward);
+        mat_visited_forward.set_all(0);
     }
 
 
@@ -326,13 +639,39 @@ template <class T> matrix <T> channel <T>::decode_mlse(const matrix <T> &mat_arg
     }
 
 
-    mat_ret = mat_ret.left(uint_num_stages - uint_l);
+    // drop the tail in place
+    mat_ret.resize(uint_num_stages - uint_l, 1);
 
     return mat_ret;
 }// DECODE_MLSE Initial state
 
-template <class T> matrix <T> channel <T>::decode_mlse(const matrix <T> &mat_arg)
+template <class T> matrix <T> channel <T>::decode_mlse_batch(const matrix <T> &mat_frames, unsigned int uint_init_state) const
+{
+    size_t size_frames = mat_frames.no_cols();
+    size_t size_l      = mat_taps.size() - 1;
+
+    matrix <T> mat_ret;
+    if (size_frames == 0 || mat_frames.no_rows() <= size_l) return mat_ret;
+
+    size_t size_len = mat_frames.no_rows() - size_l;
+    mat_ret = matrix <T> (size_len, size_frames);
+
+    parallel_for(0, size_frames, 1, [&](size_t size_first, size_t size_last)
+    {
+        for (size_t size_f = size_first; size_f < size_last; size_f++)
+        {
+            matrix <T> mat_symbols = decode_mlse(matrix <T> (mat_frames.col_view(size_f)), uint_init_state);
+            std::copy(mat_symbols.data(), mat_symbols.data() + size_len, mat_ret.data() + size_f * size_len);
+        }
+    });
+
+    return mat_ret;
+}
+
+template <class T> matrix <T> channel <T>::decode_mlse(const matrix <T> &mat_arg) const
 { // DECODE_MLSE
+    SUSA_PROFILE_SCOPE("channel.mlse");
+
 
     // NOTES
     // This decoder must be used with CONV as the channel encoder.
@@ -343,7 +682,7 @@ template <class T> matrix <T> channel <T>::decode_mlse(const matrix <T> &mat_arg
     unsigned int uint_num_stages = mat_arg.size() - 2 * uint_l;
     unsigned int uint_num_states = uint_num_states_mem;
 
-    matrix <T> mat_new_arg = mat_arg.mid(uint_l, mat_arg.size() - uint_l - 1);
+    matrix_view <const T> mat_new_arg = mat_arg.mid_view(uint_l, mat_arg.size() - uint_l - 1);
 
 
 
@@ -362,12 +701,13 @@ template <class T> matrix <T> channel <T>::decode_mlse(const matrix <T> &mat_arg
 
     for (unsigned int uint_i = 0; uint_i < uint_num_states; uint_i++)
     {
-        mat_first(uint_i) = norm(conv(flipud(get_mem_state(uint_i)),mat_taps).left(uint_l) - mat_arg.left(uint_l))(0);
+        mat_first(uint_i) = norm(matrix <T> (conv(flipud(get_mem_state(uint_i)),mat_taps).left_view(uint_l) - mat_arg.left_view(uint_l)))(0);
         mat_first(uint_i) *= mat_first(uint_i);
         mat_metric_past(uint_i) = mat_first(uint_i)/uint_l;
     }
 
 
+    const trellis& trel = *ptr_trellis;
     T dbl_next_output;
     unsigned int uint_next_state;
 
@@ -375,8 +715,8 @@ template <class T> matrix <T> channel <T>::decode_mlse(const matrix <T> &mat_arg
         for (unsigned int uint_state = 0; uint_state < uint_num_states; uint_state++) {
             for (unsigned int uint_pam_index = 0; uint_pam_index < uint_num_pam; uint_pam_index++) {
 
-                dbl_next_output = this->next_output(uint_state,uint_pam_index);
-                uint_next_state = this->next_state(uint_state,uint_pam_index);
+                dbl_next_output = mat_outputs(trel.label(uint_state, uint_pam_index));
+                uint_next_state = trel.next_state(uint_state, uint_pam_index);
 
                 dbl_metric = (dbl_next_output - mat_new_arg(uint_stage)) * (dbl_next_output - mat_new_arg(uint_stage));
 
@@ -387,8 +727,8 @@ template <class T> matrix <T> channel <T>::decode_mlse(const matrix <T> &mat_arg
                 }
             }
         }
-        mat_metric_past = mat_metric_next;
-        mat_metric_next = matrix <T> (uint_num_states, 1,std::numeric_limits<T>::max());
+        std::swap(mat_metric_past, mat_metric_next);
+        mat_metric_next.set_all(std::numeric_limits<T>::max());
     }
 
     // Last
@@ -396,7 +736,7 @@ template <class T> matrix <T> channel <T>::decode_mlse(const matrix <T> &mat_arg
 
     for (unsigned int uint_i = 0; uint_i < uint_num_states; uint_i++)
     {
-        mat_last(uint_i) = norm(conv(flipud(get_mem_state(uint_i)),mat_taps).right(uint_l) - mat_arg.right(uint_l))(0);
+        mat_last(uint_i) = norm(matrix <T> (conv(flipud(get_mem_state(uint_i)),mat_taps).right_view(uint_l) - mat_arg.right_view(uint_l)))(0);
         mat_last(uint_i) *= mat_last(uint_i);
         mat_metric_next(uint_i) += mat_last(uint_i)/uint_l;
     }
@@ -424,145 +764,666 @@ template <class T> matrix <T> channel <T>::decode_mlse(const matrix <T> &mat_arg
     return mat_ret;
 } // DECODE_MLSE
 
-template <class T> matrix <T> channel <T>::decode_bcjr(const matrix <T> &mat_arg, T dbl_ebn0)
+template <class T> matrix <T> channel <T>::decode_bcjr(const matrix <T> &mat_arg, T dbl_ebn0) const
 {
 // The data sequence must begin/end to zero state.
 
-    T dbl_sum = 0;
+    return decode_bcjr_window(mat_arg, dbl_ebn0, mat_arg.size(), 0);
+} // DECODE_BCJR
 
-    unsigned int uint_num_stages = mat_arg.size();
-    unsigned int uint_num_states = uint_num_states_mem;
+template <class T> matrix <T> channel <T>::decode_bcjr_batch(const matrix <T> &mat_frames, T dbl_ebn0, size_t size_window, size_t size_warmup) const
+{
+    size_t size_frames = mat_frames.no_cols();
+    size_t size_len    = mat_frames.no_rows();
 
-    // Gamma
-    matrix <T> mat_gamma(uint_num_states, uint_num_states);
-    std::vector <matrix <T> > vec_gamma(uint_num_stages, matrix <T> (uint_num_states, uint_num_states));
+    matrix <T> mat_lr(size_len, size_frames, 0);
+    if (size_frames == 0 || size_len == 0) return mat_lr;
 
+    parallel_for(0, size_frames, 1, [&](size_t size_first, size_t size_last)
+    {
+        for (size_t size_f = size_first; size_f < size_last; size_f++)
+        {
+            matrix <T> mat_frame_lr = decode_bcjr_window(matrix <T> (mat_frames.col_view(size_f)), dbl_ebn0, size_window, size_warmup);
+            std::copy(mat_frame_lr.data(), mat_frame_lr.data() + size_len, mat_lr.data() + size_f * size_len);
+        }
+    });
+
+    return mat_lr;
+}
 
-    // Alpha
-    matrix <T> mat_alpha(uint_num_states, 1, 0);
-    std::vector <matrix <T> > vec_alpha(uint_num_stages + 1, matrix <T> (uint_num_states, 1, 0));
-    vec_alpha[0](0,0) = 1;
+template <class T> matrix <T> channel <T>::decode_bcjr_window(const matrix <T> &mat_arg, T dbl_ebn0, size_t size_window, size_t size_warmup) const
+{
+// The data sequence must begin in the zero state, the last window ends in the zero state.
+    SUSA_PROFILE_SCOPE("channel.bcjr");
 
-    // Beta
-    matrix <T> mat_beta(uint_num_states, 1, 0);
-    std::vector <matrix <T> > vec_beta(uint_num_stages + 1, matrix <T> (uint_num_states, 1, 0));
-    vec_beta[uint_num_stages](0,0) = 1;
+    size_t size_stages = mat_arg.size();
+    size_t size_states = uint_num_states_mem;
+    size_t size_inputs = uint_num_pam;
+    size_t size_trans  = size_states * size_inputs;
 
+    // likelihood ratios
+    matrix <T> mat_lr(mat_arg.shape(), 0);
+    if (size_stages == 0) return mat_lr;
+    if (size_window == 0 || size_window > size_stages) size_window = size_stages;
+
+    // the transitions (state, input) are indexed by their labels i.e. state * P + input
+    const trellis& trel  = *ptr_trellis;
+    const T* ptr_outputs = mat_outputs.data();
+    std::vector <uint32_t> vec_next(size_trans);
+    for (size_t size_s = 0; size_s < size_states; size_s++)
+    {
+        for (size_t size_p = 0; size_p < size_inputs; size_p++) vec_next[trel.label(size_s, size_p)] = trel.next_state(size_s, size_p);
+    }
 
-    // Forward calculation of Gamma/Alpha
+    // the gamma of a window is kept sparse, i.e. only the valid transitions
+    std::vector <T> vec_alpha((size_window + 1) * size_states, 0);
+    std::vector <T> vec_gamma(size_window * size_trans);
+    std::vector <T> vec_gamma_stage(size_trans);
+    std::vector <T> vec_beta(size_states);
+    std::vector <T> vec_beta_prev(size_states);
+    std::vector <T> vec_p(size_inputs);
+    vec_alpha[0] = 1;
 
-    matrix <unsigned int> mat_uint_prev_states;
+    auto gamma_stage = [&](size_t size_stage, T* ptr_gamma)
+    {
+        for (size_t size_tr = 0; size_tr < size_trans; size_tr++)
+        {
+            T T_diff = mat_arg(size_stage) - ptr_outputs[size_tr];
+            ptr_gamma[size_tr] = std::exp((-dbl_ebn0) * T_diff * T_diff);
+        }
+    };
 
-    unsigned int uint_next_zero, uint_next_one;
+    auto normalize = [](T* ptr_arg, size_t size_len)
+    {
+        T T_sum = 0;
+        for (size_t size_i = 0; size_i < size_len; size_i++) T_sum += ptr_arg[size_i];
+        for (size_t size_i = 0; size_i < size_len; size_i++) ptr_arg[size_i] /= T_sum;
+    };
 
-    for (unsigned int uint_stage = 0; uint_stage < uint_num_stages; uint_stage++)
+    for (size_t size_begin = 0; size_begin < size_stages; size_begin += size_window)
     {
-        // Gamma Calculation
+        size_t size_end = std::min(size_begin + size_window, size_stages);
+        size_t size_len = size_end - size_begin;
 
-        for (unsigned int uint_state = 0; uint_state < uint_num_states; uint_state++)
+        // Forward calculation of Gamma/Alpha
+        for (size_t size_j = 0; size_j < size_len; size_j++)
         {
+            const T* ptr_alpha = vec_alpha.data() + size_j * size_states;
+            T*       ptr_next  = vec_alpha.data() + (size_j + 1) * size_states;
+            T*       ptr_gamma = vec_gamma.data() + size_j * size_trans;
 
-            uint_next_zero  =  this->next_state(uint_state, 0);
-            uint_next_one   =  this->next_state(uint_state, 1);
+            gamma_stage(size_begin + size_j, ptr_gamma);
+            std::fill(ptr_next, ptr_next + size_states, T(0));
 
-            mat_gamma(uint_state,uint_next_zero) = exp((-dbl_ebn0) * std::pow(mat_arg(uint_stage) - this->next_output(uint_state, 0),2));
+            for (size_t size_tr = 0; size_tr < size_trans; size_tr++)
+            {
+                ptr_next[vec_next[size_tr]] += ptr_alpha[size_tr / size_inputs] * ptr_gamma[size_tr];
+            }
 
-            mat_gamma(uint_state,uint_next_one) = exp((-dbl_ebn0) * std::pow(mat_arg(uint_stage) - this->next_output(uint_state, 1),2));
+            normalize(ptr_next, size_states);
+        }
 
+        // Beta Calculation, the warm-up stages start from equiprobable states
+        size_t size_last = std::min(size_end + size_warmup, size_stages);
+        if (size_last == size_stages)
+        {
+            std::fill(vec_beta.begin(), vec_beta.end(), T(0));
+            vec_beta[0] = 1;
+        }
+        else
+        {
+            std::fill(vec_beta.begin(), vec_beta.end(), T(1) / T(size_states));
         }
-        vec_gamma[uint_stage] = mat_gamma;
 
+        for (size_t size_stage = size_last; size_stage > size_begin; size_stage--)
+        {
+            bool     bool_warmup = size_stage > size_end;
+            const T* ptr_gamma   = vec_gamma_stage.data();
 
+            if (bool_warmup) gamma_stage(size_stage - 1, vec_gamma_stage.data());
+            else ptr_gamma = vec_gamma.data() + (size_stage - 1 - size_begin) * size_trans;
 
-        // Alpha Calculation
+            // the alphas of the warm-up stages are not kept
+            const T* ptr_alpha = bool_warmup ? nullptr : vec_alpha.data() + (size_stage - 1 - size_begin) * size_states;
+            std::fill(vec_p.begin(), vec_p.end(), T(0));
 
+            for (size_t size_s = 0; size_s < size_states; size_s++)
+            {
+                T T_beta = 0;
+                for (size_t size_p = 0; size_p < size_inputs; size_p++)
+                {
+                    size_t size_tr = size_s * size_inputs + size_p;
+                    T T_branch = ptr_gamma[size_tr] * vec_beta[vec_next[size_tr]];
+                    if (!bool_warmup) vec_p[size_p] += ptr_alpha[size_s] * T_branch;
+                    T_beta += T_branch;
+                }
+                vec_beta_prev[size_s] = T_beta;
+            }
 
-        for (unsigned int uint_state = 0; uint_state < uint_num_states; uint_state++)
+            if (!bool_warmup && size_inputs > 1) mat_lr(size_stage - 1) = vec_p[1] / vec_p[0];
+
+            normalize(vec_beta_prev.data(), size_states);
+            std::swap(vec_beta, vec_beta_prev);
+        }
+
+        // the forward recursion continues from the end of the window
+        std::copy(vec_alpha.begin() + size_len * size_states, vec_alpha.begin() + (size_len + 1) * size_states, vec_alpha.begin());
+    }
+
+    return mat_lr;
+} // DECODE_BCJR_WINDOW
+
+// VITERBI EQUALIZER
+
+template <class T> viterbi_equalizer <T>::viterbi_equalizer(const channel <T>& ch, size_t size_depth)
+: ptr_trellis(ch.get_trellis())
+, mat_pam(ch.get_pam())
+, size_depth(size_depth == 0 ? 1 : size_depth)
+{
+    const trellis&    trel        = *ptr_trellis;
+    const matrix <T>& mat_outputs = ch.get_outputs();
+
+    size_states = trel.no_states();
+    size_inputs = trel.no_inputs();
+
+    SUSA_ASSERT_MESSAGE(size_inputs <= 256, "the constellation is too large.");
+
+    // the survivors are stored as bytes, a larger constellation leaves the equalizer without states
+    if (size_inputs > 256)
+    {
+        size_states = 0;
+        size_inputs = 0;
+        reset();
+        return;
+    }
+
+    vec_branch_out.resize(size_inputs * size_states);
+    for (size_t size_k = 0; size_k < size_inputs; size_k++)
+    {
+        for (size_t size_s = 0; size_s < size_states; size_s++)
         {
+            vec_branch_out[size_k * size_states + size_s] = mat_outputs(trel.label(trel.prev_states(size_k)[size_s], trel.prev_inputs(size_k)[size_s]));
+        }
+    }
+
+    vec_metric.resize(size_states);
+    vec_metric_next.resize(size_states);
+    vec_survivors.resize((this->size_depth + 1) * size_states);
+
+    reset();
+}
+
+template <class T> size_t viterbi_equalizer <T>::depth() const
+{
+    return size_depth;
+}
+
+template <class T> void viterbi_equalizer <T>::reset()
+{
+    std::fill(vec_metric.begin(), vec_metric.end(), T(0));
+    size_count = 0;
+    size_head  = 0;
+}
+
+template <class T> void viterbi_equalizer <T>::reset(unsigned int uint_init_state)
+{
+    reset();
+    std::fill(vec_metric.begin(), vec_metric.end(), std::numeric_limits <T>::max() / 2);
+    if (uint_init_state < size_states) vec_metric[uint_init_state] = 0;
+}
+
+template <class T> size_t viterbi_equalizer <T>::best_state() const
+{
+    return std::min_element(vec_metric.begin(), vec_metric.end()) - vec_metric.begin();
+}
+
+template <class T> size_t viterbi_equalizer <T>::process(const T* ptr_in, size_t size_num, T* ptr_out)
+{
+    SUSA_PROFILE_SCOPE("channel.viterbi_equalizer");
 
-            mat_uint_prev_states = this->prev_states(uint_state);
+    const trellis& trel    = *ptr_trellis;
+    const size_t   size_ring = size_depth + 1;
+    size_t         size_no   = 0;
 
-            for (unsigned int uinti = 0; uinti < mat_uint_prev_states.size(); uinti++)
-                mat_alpha(uint_state) += vec_alpha[uint_stage](mat_uint_prev_states(uinti)) * mat_gamma(mat_uint_prev_states(uinti), uint_state);
+    if (size_states == 0) return 0;
 
+    for (size_t size_i = 0; size_i < size_num; size_i++)
+    {
+        size_head = (size_head + 1) % size_ring;
+        uint8_t* ptr_surv = vec_survivors.data() + size_head * size_states;
+        T        T_min    = std::numeric_limits <T>::max();
+
+        // add-compare-select over the predecessors of each state
+        for (size_t size_s = 0; size_s < size_states; size_s++)
+        {
+            T       T_best = std::numeric_limits <T>::max();
+            uint8_t uint_k = 0;
+            for (size_t size_k = 0; size_k < size_inputs; size_k++)
+            {
+                T T_diff  = ptr_in[size_i] - vec_branch_out[size_k * size_states + size_s];
+                T T_cand  = vec_metric[trel.prev_states(size_k)[size_s]] + T_diff * T_diff;
+                if (T_cand < T_best)
+                {
+                    T_best = T_cand;
+                    uint_k = size_k;
+                }
+            }
+            vec_metric_next[size_s] = T_best;
+            ptr_surv[size_s]        = uint_k;
+            T_min = std::min(T_min, T_best);
         }
 
-        // Normalize the alpha
-        dbl_sum = 0;
-        for (unsigned int uinti = 0; uinti < mat_alpha.size(); uinti++) dbl_sum += mat_alpha(uinti);
-        mat_alpha = mat_alpha / dbl_sum;
+        // renormalization
+        for (size_t size_s = 0; size_s < size_states; size_s++) vec_metric[size_s] = vec_metric_next[size_s] - T_min;
+
+        if (size_count <= size_depth) size_count++;
+        if (size_count <= size_depth) continue;
 
-        vec_alpha[uint_stage + 1] = mat_alpha;
-        mat_alpha.set_all(0);
+        // the decision of D stages ago from the best state
+        size_t size_state = best_state();
+        size_t size_pos   = size_head;
+        for (size_t size_d = 0; size_d < size_depth; size_d++)
+        {
+            size_state = trel.prev_states(vec_survivors[size_pos * size_states + size_state])[size_state];
+            size_pos   = (size_pos + size_ring - 1) % size_ring;
+        }
+        size_t size_k = vec_survivors[size_pos * size_states + size_state];
+        ptr_out[size_no++] = mat_pam(trel.prev_inputs(size_k)[size_state]);
     }
 
+    return size_no;
+}
+
+template <class T> matrix <T> viterbi_equalizer <T>::process(const matrix <T>& mat_in)
+{
+    matrix <T> mat_out;
+    std::vector <T> vec_out(mat_in.size());
 
-    // Beta Calculation
+    size_t size_no = process(mat_in.data(), mat_in.size(), vec_out.data());
+    if (size_no == 0) return mat_out;
 
-    for (unsigned int uint_stage = uint_num_stages; uint_stage > 0; uint_stage--)
+    mat_out = matrix <T> (size_no, 1);
+    std::copy(vec_out.begin(), vec_out.begin() + size_no, mat_out.data());
+
+    return mat_out;
+}
+
+template <class T> size_t viterbi_equalizer <T>::flush(T* ptr_out)
+{
+    const trellis& trel      = *ptr_trellis;
+    const size_t   size_ring = size_depth + 1;
+
+    if (size_states == 0) return 0;
+
+    // the stages in the ring that have not been decided yet
+    size_t size_pending = size_count <= size_depth ? size_count : size_depth;
+    size_t size_state   = best_state();
+    size_t size_pos     = size_head;
+
+    for (size_t size_d = size_pending; size_d > 0; size_d--)
     {
+        size_t size_k = vec_survivors[size_pos * size_states + size_state];
+        ptr_out[size_d - 1] = mat_pam(trel.prev_inputs(size_k)[size_state]);
+        size_state = trel.prev_states(size_k)[size_state];
+        size_pos   = (size_pos + size_ring - 1) % size_ring;
+    }
 
-        for (unsigned int uint_state = 0; uint_state < uint_num_states; uint_state++)
-        {
+    reset();
+
+    return size_pending;
+}
 
-            mat_gamma = vec_gamma[uint_stage - 1];
+template <class T> matrix <T> viterbi_equalizer <T>::flush()
+{
+    matrix <T> mat_out;
+    std::vector <T> vec_out(size_depth);
 
-            uint_next_zero  =  this->next_state(uint_state, 0);
-            uint_next_one   =  this->next_state(uint_state, 1);
+    size_t size_no = flush(vec_out.data());
+    if (size_no == 0) return mat_out;
 
-            mat_beta(uint_state) += vec_beta[uint_stage](uint_next_zero) * mat_gamma(uint_state, uint_next_zero);
-            mat_beta(uint_state) += vec_beta[uint_stage](uint_next_one) * mat_gamma(uint_state, uint_next_one);
+    mat_out = matrix <T> (size_no, 1);
+    std::copy(vec_out.begin(), vec_out.begin() + size_no, mat_out.data());
 
-        }
+    return mat_out;
+}
+
+// DFE EQUALIZER
+
+template <class T> dfe_equalizer <T>::dfe_equalizer(const matrix <T>& mat_ff, const matrix <T>& mat_fb, const matrix <T>& mat_pam,
+  size_t size_delay, T T_step)
+: mat_ff(mat_ff)
+, mat_fb(mat_fb)
+, mat_pam(mat_pam)
+, size_delay(size_delay)
+, T_step(T_step)
+{
+    SUSA_ASSERT_MESSAGE(mat_ff.size() > 0 && mat_pam.size() > 0, "the feedforward taps and the signal amplitudes are required.");
+    SUSA_ASSERT_MESSAGE(size_delay < mat_ff.size(), "the decision delay exceeds the feedforward taps.");
+    if (this->size_delay >= mat_ff.size()) this->size_delay = mat_ff.size() == 0 ? 0 : mat_ff.size() - 1;
+
+    reset();
+}
 
+template <class T> dfe_equalizer <T>::dfe_equalizer(const channel <T>& ch, T T_step)
+: mat_ff(1, 1)
+, mat_pam(ch.get_pam())
+, size_delay(0)
+, T_step(T_step)
+{
+    const matrix <T>& mat_taps = ch.get_taps();
 
-        // Normalize the beta
-        dbl_sum = 0;
-        for (unsigned int uinti = 0; uinti < mat_beta.size(); uinti++) dbl_sum += mat_beta(uinti);
-        mat_beta = mat_beta / dbl_sum;
+    SUSA_ASSERT_MESSAGE(mat_taps.size() > 0 && mat_taps(0) != T(0), "the main tap of the channel is zero.");
 
-        vec_beta[uint_stage - 1] = mat_beta;
+    // without a main tap the equalizer only slices the samples
+    mat_ff(0) = T(1);
+    if (mat_taps.size() == 0 || mat_taps(0) == T(0))
+    {
+        reset();
+        return;
+    }
 
-        mat_beta.set_all(0);
+    mat_ff(0) = T(1) / mat_taps(0);
+    if (mat_taps.size() > 1)
+    {
+        mat_fb = matrix <T> (mat_taps.size() - 1, 1);
+        for (size_t size_j = 1; size_j < mat_taps.size(); size_j++) mat_fb(size_j - 1) = mat_taps(size_j) / mat_taps(0);
     }
 
+    reset();
+}
 
-    matrix <T> mat_p_norm(uint_num_stages, 1, 0);
-    matrix <T> mat_p_one(uint_num_stages, 1, 0);
-    matrix <T> mat_p_zero(uint_num_stages, 1, 0);
+template <class T> void dfe_equalizer <T>::reset()
+{
+    vec_samples.assign(mat_ff.size(), T(0));
+    vec_decisions.assign(mat_fb.size(), T(0));
+    vec_refs.assign(size_delay + 1, T(0));
+    size_count = 0;
+}
 
-    // likelihood ratios
-    matrix <T> mat_lr(mat_arg.shape(), 0);
+template <class T> void dfe_equalizer <T>::reset(const matrix <T>& mat_decisions)
+{
+    reset();
+    size_t size_num = std::min(mat_decisions.size(), vec_decisions.size());
+    std::copy(mat_decisions.data(), mat_decisions.data() + size_num, vec_decisions.begin());
+}
 
-    for (unsigned int uint_stage = 0; uint_stage < uint_num_stages; uint_stage++)
+template <class T> T dfe_equalizer <T>::slice(T T_arg) const
+{
+    size_t size_best = 0;
+    for (size_t size_p = 1; size_p < mat_pam.size(); size_p++)
     {
+        if (std::abs(T_arg - mat_pam(size_p)) < std::abs(T_arg - mat_pam(size_best))) size_best = size_p;
+    }
+    return mat_pam(size_best);
+}
 
-        mat_alpha   = vec_alpha[uint_stage];
-        mat_beta    = vec_beta[uint_stage + 1];
-        mat_gamma   = vec_gamma[uint_stage]; // Note ! code : Gamma_1 = Gamma(0)
+template <class T> bool dfe_equalizer <T>::push(T T_in, const T* ptr_ref, T& T_out)
+{
+    // the delay lines, the newest first
+    std::copy_backward(vec_samples.begin(), vec_samples.end() - 1, vec_samples.end());
+    vec_samples[0] = T_in;
+    std::copy_backward(vec_refs.begin(), vec_refs.end() - 1, vec_refs.end());
+    vec_refs[0] = ptr_ref == nullptr ? T(0) : *ptr_ref;
 
+    if (size_count < size_delay)
+    {
+        size_count++;
+        return false;
+    }
 
-        for (unsigned int uint_state = 0; uint_state < uint_num_states; uint_state++)
+    T T_y = 0;
+    for (size_t size_i = 0; size_i < vec_samples.size(); size_i++) T_y += mat_ff(size_i) * vec_samples[size_i];
+    for (size_t size_j = 0; size_j < vec_decisions.size(); size_j++) T_y -= mat_fb(size_j) * vec_decisions[size_j];
+
+    T_out = slice(T_y);
+    T T_symbol = ptr_ref == nullptr ? T_out : vec_refs[size_delay];
+
+    // LMS, the feedback enters the output with the negative sign
+    if (T_step != T(0))
+    {
+        T T_err = T_step * (T_symbol - T_y);
+        for (size_t size_i = 0; size_i < vec_samples.size(); size_i++) mat_ff(size_i) += T_err * vec_samples[size_i];
+        for (size_t size_j = 0; size_j < vec_decisions.size(); size_j++) mat_fb(size_j) -= T_err * vec_decisions[size_j];
+    }
+
+    if (!vec_decisions.empty())
+    {
+        std::copy_backward(vec_decisions.begin(), vec_decisions.end() - 1, vec_decisions.end());
+        vec_decisions[0] = T_symbol;
+    }
+
+    return true;
+}
+
+template <class T> size_t dfe_equalizer <T>::process(const T* ptr_in, size_t size_num, T* ptr_out)
+{
+    SUSA_PROFILE_SCOPE("channel.dfe");
+
+    size_t size_no = 0;
+    for (size_t size_i = 0; size_i < size_num; size_i++)
+    {
+        if (push(ptr_in[size_i], nullptr, ptr_out[size_no])) size_no++;
+    }
+
+    return size_no;
+}
+
+template <class T> size_t dfe_equalizer <T>::train(const T* ptr_in, const T* ptr_ref, size_t size_num, T* ptr_out)
+{
+    SUSA_PROFILE_SCOPE("channel.dfe");
+
+    size_t size_no = 0;
+    for (size_t size_i = 0; size_i < size_num; size_i++)
+    {
+        if (push(ptr_in[size_i], ptr_ref + size_i, ptr_out[size_no])) size_no++;
+    }
+
+    return size_no;
+}
+
+template <class T> matrix <T> dfe_equalizer <T>::process(const matrix <T>& mat_in)
+{
+    matrix <T> mat_out;
+    std::vector <T> vec_out(mat_in.size());
+
+    size_t size_no = process(mat_in.data(), mat_in.size(), vec_out.data());
+    if (size_no == 0) return mat_out;
+
+    mat_out = matrix <T> (size_no, 1);
+    std::copy(vec_out.begin(), vec_out.begin() + size_no, mat_out.data());
+
+    return mat_out;
+}
+
+template <class T> matrix <T> dfe_equalizer <T>::train(const matrix <T>& mat_in, const matrix <T>& mat_ref)
+{
+    matrix <T> mat_out;
+
+    SUSA_ASSERT_MESSAGE(mat_in.size() == mat_ref.size(), "the number of the known symbols and the samples differ.");
+    if (mat_in.size() != mat_ref.size()) return mat_out;
+
+    std::vector <T> vec_out(mat_in.size());
+
+    size_t size_no = train(mat_in.data(), mat_ref.data(), mat_in.size(), vec_out.data());
+    if (size_no == 0) return mat_out;
+
+    mat_out = matrix <T> (size_no, 1);
+    std::copy(vec_out.begin(), vec_out.begin() + size_no, mat_out.data());
+
+    return mat_out;
+}
+
+template <class T> matrix <T> channel <T>::decode_bpsk_dfe(const matrix <T> &mat_arg, unsigned int uint_init_state) const
+{
+    dfe_equalizer <T> eq(*this);
+    eq.reset(get_mem_state(uint_init_state));
+
+    matrix <T> mat_ret = eq.process(mat_arg);
+
+    // drop the tail in place
+    size_t size_l = mat_taps.size() - 1;
+    if (mat_ret.size() > size_l) mat_ret.resize(mat_ret.size() - size_l, 1);
+
+    return mat_ret;
+}
+
+// RSSE EQUALIZER
+
+template <class T> rsse_equalizer <T>::rsse_equalizer(const matrix <T>& mat_taps, const matrix <T>& mat_pam,
+  size_t size_survivors, size_t size_merge)
+: mat_taps(mat_taps)
+, mat_pam(mat_pam)
+, size_survivors(size_survivors == 0 ? 1 : size_survivors)
+, size_merge(size_merge)
+, size_memory(mat_taps.size() == 0 ? 0 : mat_taps.size() - 1)
+{
+    SUSA_ASSERT_MESSAGE(mat_taps.size() > 0, "the channel has no taps.");
+    SUSA_ASSERT_MESSAGE(mat_pam.size() > 0 && mat_pam.size() <= 256, "the constellation size is not supported.");
+
+    if (this->size_merge > size_memory) this->size_merge = size_memory;
+
+    // the table of the reduced states
+    size_t size_keys = 1;
+    for (size_t size_i = 0; size_i < this->size_merge && size_keys <= (1u << 20); size_i++) size_keys *= mat_pam.size();
+
+    SUSA_ASSERT_MESSAGE(size_keys <= (1u << 20), "too many reduced states to merge.");
+    if (size_keys > (1u << 20)) this->size_merge = 0;
+
+    if (this->size_merge > 0) vec_best.assign(size_keys, std::numeric_limits <unsigned int>::max());
+}
+
+template <class T> matrix <T> rsse_equalizer <T>::decode(const matrix <T>& mat_arg, unsigned int uint_init_state)
+{
+    SUSA_PROFILE_SCOPE("channel.rsse");
+
+    const size_t size_stages = mat_arg.size();
+    const size_t size_l      = size_memory;
+    const size_t size_p      = mat_pam.size();
+    const size_t size_m      = size_survivors;
+    const unsigned int uint_none = std::numeric_limits <unsigned int>::max();
+
+    matrix <T> mat_ret;
+    if (size_stages == 0 || mat_taps.size() == 0 || size_p == 0 || size_p > 256) return mat_ret;
+
+    // the symbol indices of the initial state, the latest first
+    std::vector <uint8_t> vec_init(size_l);
+    for (size_t size_i = 0; size_i < size_l; size_i++)
+    {
+        vec_init[size_i] = uint_init_state % size_p;
+        uint_init_state /= size_p;
+    }
+
+    vec_metric.assign(size_m, T(0));
+    vec_memory.assign(size_m * size_l, 0);
+    vec_memory_next.resize(size_m * size_l);
+    vec_cost.resize(size_m * size_p);
+    vec_index.resize(size_m * size_p);
+    vec_parent.resize(size_stages * size_m);
+    vec_symbol.resize(size_stages * size_m);
+    std::copy(vec_init.begin(), vec_init.end(), vec_memory.begin());
+
+    vec_key.resize(size_m);
+    size_t size_live = 1;
+
+    for (size_t size_stage = 0; size_stage < size_stages; size_stage++)
+    {
+        T T_rx = mat_arg(size_stage);
+
+        // the extensions of the survivors with their own channel memory
+        for (size_t size_s = 0; size_s < size_live; size_s++)
+        {
+            const uint8_t* ptr_mem = vec_memory.data() + size_s * size_l;
+            T T_isi = 0;
+            for (size_t size_i = 0; size_i < size_l; size_i++) T_isi += mat_taps(size_i + 1) * mat_pam(ptr_mem[size_i]);
+
+            for (size_t size_k = 0; size_k < size_p; size_k++)
+            {
+                T T_diff = T_rx - mat_taps(0) * mat_pam(size_k) - T_isi;
+                vec_cost[size_s * size_p + size_k] = vec_metric[size_s] + T_diff * T_diff;
+            }
+
+            // the reduced state of the extensions without their new symbol
+            unsigned int uint_key = 0;
+            for (size_t size_i = size_merge; size_i > 1; size_i--) uint_key = uint_key * size_p + ptr_mem[size_i - 2];
+            vec_key[size_s] = uint_key * size_p;
+        }
+
+        size_t size_valid = 0;
+        size_t size_cands = size_live * size_p;
+        if (size_merge > 0)
+        {
+            // the best extension of every reduced state
+            for (size_t size_c = 0; size_c < size_cands; size_c++)
+            {
+                unsigned int& uint_best = vec_best[vec_key[size_c / size_p] + size_c % size_p];
+                if (uint_best == uint_none || vec_cost[size_c] < vec_cost[uint_best]) uint_best = size_c;
+            }
+            for (size_t size_c = 0; size_c < size_cands; size_c++)
+            {
+                unsigned int& uint_best = vec_best[vec_key[size_c / size_p] + size_c % size_p];
+                if (uint_best == size_c) vec_index[size_valid++] = size_c;
+            }
+            for (size_t size_v = 0; size_v < size_valid; size_v++)
+            {
+                unsigned int uint_c = vec_index[size_v];
+                vec_best[vec_key[uint_c / size_p] + uint_c % size_p] = uint_none;
+            }
+        }
+        else
         {
+            for (size_t size_c = 0; size_c < size_cands; size_c++) vec_index[size_c] = size_c;
+            size_valid = size_cands;
+        }
+
+        // the pruning, the survivors are in the ascending order of their metrics
+        size_t size_keep = std::min(size_m, size_valid);
+        select_index_range(vec_cost.data(), vec_index.data(), vec_index.data() + size_valid, size_keep, false);
 
-            uint_next_zero          =  this->next_state(uint_state,0);
-            uint_next_one           =  this->next_state(uint_state,1);
+        T T_min = vec_cost[vec_index[0]];
+        for (size_t size_j = 0; size_j < size_keep; size_j++)
+        {
+            unsigned int uint_c = vec_index[size_j];
+            size_t size_s = uint_c / size_p;
+            uint8_t* ptr_next = vec_memory_next.data() + size_j * size_l;
 
-            mat_p_zero(uint_stage)  += mat_alpha(uint_state) * mat_gamma(uint_state,uint_next_zero) * mat_beta(uint_next_zero);
-            mat_p_one(uint_stage)   += mat_alpha(uint_state) * mat_gamma(uint_state,uint_next_one) * mat_beta(uint_next_one);
+            if (size_l > 0)
+            {
+                ptr_next[0] = uint_c % size_p;
+                std::copy(vec_memory.data() + size_s * size_l, vec_memory.data() + (size_s + 1) * size_l - 1, ptr_next + 1);
+            }
+
+            vec_metric[size_j] = vec_cost[uint_c] - T_min;
+            vec_parent[size_stage * size_m + size_j] = size_s;
+            vec_symbol[size_stage * size_m + size_j] = uint_c % size_p;
         }
 
-        mat_p_norm(uint_stage)      = mat_p_one(uint_stage) + mat_p_zero(uint_stage);
+        std::swap(vec_memory, vec_memory_next);
+        size_live = size_keep;
+    }
 
-        mat_p_one(uint_stage)       = mat_p_one(uint_stage) / mat_p_norm(uint_stage);
-        mat_p_zero(uint_stage)      = mat_p_zero(uint_stage) / mat_p_norm(uint_stage);
+    // the best survivor that ends in the known state, otherwise the best one
+    size_t size_s = 0;
+    for (size_t size_j = 0; size_j < size_live; size_j++)
+    {
+        if (std::equal(vec_init.begin(), vec_init.end(), vec_memory.begin() + size_j * size_l))
+        {
+            size_s = size_j;
+            break;
+        }
+    }
 
-        mat_lr(uint_stage)          = mat_p_one(uint_stage) / mat_p_zero(uint_stage);
+    mat_ret = matrix <T> (size_stages, 1);
+    for (size_t size_stage = size_stages; size_stage > 0; size_stage--)
+    {
+        mat_ret(size_stage - 1) = mat_pam(vec_symbol[(size_stage - 1) * size_m + size_s]);
+        size_s = vec_parent[(size_stage - 1) * size_m + size_s];
     }
 
+    // drop the tail in place
+    if (size_stages > size_l) mat_ret.resize(size_stages - size_l, 1);
 
-    return mat_lr;
-} // DECODE_BCJR
+    return mat_ret;
+}
 
 } // NAMESPACE SUSA
 #endif // CHANNEL_H
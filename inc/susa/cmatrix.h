@@ -0,0 +1,408 @@
+/*
+ * This file is part of Susa.
+ *
+ * Susa is free software: you can redistribute it and/or modify
+ * it under the terms of the Lesser GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * at your option) any later version.
+ *
+ * Susa is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * Lesser GNU General Public License for more details.
+ *
+ * You should have received a copy of the Lesser GNU General Public License
+ * along with Susa.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file cmatrix.h
+ * @brief Complex matrix with planar storage (declaration and definition).
+ *
+ * A <i>cmatrix</i> keeps the real and the imaginary parts in two separate
+ * real matrices (planes). The complex products are then plain element-wise
+ * loops over contiguous reals, which the compiler vectorizes at the full
+ * SIMD width without the shuffles of the interleaved <i>std::complex</i>.
+ *
+ * @author Behrooz Kamary
+ * @version 1.0.0
+ */
+
+#ifndef SUSA_CMATRIX_H
+#define SUSA_CMATRIX_H
+
+namespace susa {
+
+/**
+ * @brief Splits the interleaved complex numbers into the planes
+ *
+ * @ingroup Math
+ */
+template <class T> SUSA_INLINE_KERNEL void planar_split(const std::complex <T>* ptr_in, size_t sizet_n, T* ptr_re, T* ptr_im)
+{
+    const T* ptr_pair = reinterpret_cast <const T*> (ptr_in);
+    for (size_t sizet_i = 0; sizet_i < sizet_n; sizet_i++)
+    {
+        ptr_re[sizet_i] = ptr_pair[2 * sizet_i];
+        ptr_im[sizet_i] = ptr_pair[2 * sizet_i + 1];
+    }
+}
+
+/**
+ * @brief Interleaves the planes into the complex numbers
+ *
+ * @ingroup Math
+ */
+template <class T> SUSA_INLINE_KERNEL void planar_merge(const T* ptr_re, const T* ptr_im, size_t sizet_n, std::complex <T>* ptr_out)
+{
+    T* ptr_pair = reinterpret_cast <T*> (ptr_out);
+    for (size_t sizet_i = 0; sizet_i < sizet_n; sizet_i++)
+    {
+        ptr_pair[2 * sizet_i]     = ptr_re[sizet_i];
+        ptr_pair[2 * sizet_i + 1] = ptr_im[sizet_i];
+    }
+}
+
+/**
+ * @brief The planar complex product y = a b (the output may be an input)
+ *
+ * @ingroup Math
+ */
+template <class T> SUSA_INLINE_KERNEL void planar_mul(const T* ptr_ar, const T* ptr_ai, const T* ptr_br, const T* ptr_bi,
+  size_t sizet_n, T* ptr_yr, T* ptr_yi)
+{
+    for (size_t sizet_i = 0; sizet_i < sizet_n; sizet_i++)
+    {
+        T T_re = ptr_ar[sizet_i] * ptr_br[sizet_i] - ptr_ai[sizet_i] * ptr_bi[sizet_i];
+        T T_im = ptr_ar[sizet_i] * ptr_bi[sizet_i] + ptr_ai[sizet_i] * ptr_br[sizet_i];
+        ptr_yr[sizet_i] = T_re;
+        ptr_yi[sizet_i] = T_im;
+    }
+}
+
+/**
+ * @brief The planar complex product with the conjugate y = conj(a) b (the output may be an input)
+ *
+ * @ingroup Math
+ */
+template <class T> SUSA_INLINE_KERNEL void planar_conj_mul(const T* ptr_ar, const T* ptr_ai, const T* ptr_br, const T* ptr_bi,
+  size_t sizet_n, T* ptr_yr, T* ptr_yi)
+{
+    for (size_t sizet_i = 0; sizet_i < sizet_n; sizet_i++)
+    {
+        T T_re = ptr_ar[sizet_i] * ptr_br[sizet_i] + ptr_ai[sizet_i] * ptr_bi[sizet_i];
+        T T_im = ptr_ar[sizet_i] * ptr_bi[sizet_i] - ptr_ai[sizet_i] * ptr_br[sizet_i];
+        ptr_yr[sizet_i] = T_re;
+        ptr_yi[sizet_i] = T_im;
+    }
+}
+
+/**
+ * @brief The planar complex multiply-accumulate y += a b
+ *
+ * @ingroup Math
+ */
+template <class T> SUSA_INLINE_KERNEL void planar_mac(const T* ptr_ar, const T* ptr_ai, const T* ptr_br, const T* ptr_bi,
+  size_t sizet_n, T* ptr_yr, T* ptr_yi)
+{
+    for (size_t sizet_i = 0; sizet_i < sizet_n; sizet_i++)
+    {
+        T T_re = ptr_ar[sizet_i] * ptr_br[sizet_i] - ptr_ai[sizet_i] * ptr_bi[sizet_i];
+        T T_im = ptr_ar[sizet_i] * ptr_bi[sizet_i] + ptr_ai[sizet_i] * ptr_br[sizet_i];
+        ptr_yr[sizet_i] += T_re;
+        ptr_yi[sizet_i] += T_im;
+    }
+}
+
+/**
+ * @brief The planar magnitude squared y = |a|^2
+ *
+ * @ingroup Math
+ */
+template <class T> SUSA_INLINE_KERNEL void planar_mag(const T* ptr_ar, const T* ptr_ai, size_t sizet_n, T* ptr_y)
+{
+    for (size_t sizet_i = 0; sizet_i < sizet_n; sizet_i++) ptr_y[sizet_i] = ptr_ar[sizet_i] * ptr_ar[sizet_i] + ptr_ai[sizet_i] * ptr_ai[sizet_i];
+}
+
+//! The planar complex product of double, selected by <i>cpu_dispatch()</i>
+void planar_mul(const double* ptr_ar, const double* ptr_ai, const double* ptr_br, const double* ptr_bi,
+  size_t sizet_n, double* ptr_yr, double* ptr_yi);
+
+//! The planar complex product with the conjugate of double, selected by <i>cpu_dispatch()</i>
+void planar_conj_mul(const double* ptr_ar, const double* ptr_ai, const double* ptr_br, const double* ptr_bi,
+  size_t sizet_n, double* ptr_yr, double* ptr_yi);
+
+//! The planar complex multiply-accumulate of double, selected by <i>cpu_dispatch()</i>
+void planar_mac(const double* ptr_ar, const double* ptr_ai, const double* ptr_br, const double* ptr_bi,
+  size_t sizet_n, double* ptr_yr, double* ptr_yi);
+
+//! The planar magnitude squared of double, selected by <i>cpu_dispatch()</i>
+void planar_mag(const double* ptr_ar, const double* ptr_ai, size_t sizet_n, double* ptr_y);
+
+/**
+ * @brief The <i>cmatrix</i> class.
+ *
+ * The complex matrix in the planar layout. The arithmetic operators are
+ * element-wise as the ones of <i>matrix</i>.
+ *
+ * @ingroup TYPES
+ */
+template <class T> class cmatrix
+{
+  public:
+    //! Constructor of an empty matrix
+    cmatrix()
+    {
+    }
+
+    //! Constructor of a zero matrix
+    cmatrix(size_t sizet_rows, size_t sizet_cols)
+    : mat_re(sizet_rows, sizet_cols, T(0))
+    , mat_im(sizet_rows, sizet_cols, T(0))
+    {
+    }
+
+    //! Constructor of a zero matrix
+    explicit cmatrix(const std::tuple <size_t, size_t>& tshape)
+    : mat_re(tshape, T(0))
+    , mat_im(tshape, T(0))
+    {
+    }
+
+    /**
+     * @brief Constructor from the planes
+     *
+     * Planes of different sizes give an empty matrix.
+     */
+    cmatrix(const matrix <T>& mat_real, const matrix <T>& mat_imag)
+    {
+        bool bool_match = mat_real.shape() == mat_imag.shape();
+        SUSA_ASSERT_MESSAGE(bool_match, "the planes have different sizes.");
+        if (!bool_match) return;
+
+        mat_re = mat_real;
+        mat_im = mat_imag;
+    }
+
+    //! Constructor from an interleaved complex matrix
+    explicit cmatrix(const matrix <std::complex <T> >& mat_arg)
+    : mat_re(mat_arg.shape())
+    , mat_im(mat_arg.shape())
+    {
+        planar_split(mat_arg.data(), mat_arg.size(), mat_re.data(), mat_im.data());
+    }
+
+    //! Converts to an interleaved complex matrix
+    explicit operator matrix <std::complex <T> >() const
+    {
+        matrix <std::complex <T> > mat_ret(mat_re.shape());
+        planar_merge(mat_re.data(), mat_im.data(), mat_re.size(), mat_ret.data());
+        return mat_ret;
+    }
+
+    //! Returns the number of rows
+    size_t no_rows() const
+    {
+        return mat_re.no_rows();
+    }
+
+    //! Returns the number of columns
+    size_t no_cols() const
+    {
+        return mat_re.no_cols();
+    }
+
+    //! Returns the number of elements
+    size_t size() const
+    {
+        return mat_re.size();
+    }
+
+    //! Returns the shape
+    std::tuple <size_t, size_t> shape() const
+    {
+        return mat_re.shape();
+    }
+
+    //! Returns the real plane
+    matrix <T>& real()
+    {
+        return mat_re;
+    }
+
+    //! Returns the real plane
+    const matrix <T>& real() const
+    {
+        return mat_re;
+    }
+
+    //! Returns the imaginary plane
+    matrix <T>& imag()
+    {
+        return mat_im;
+    }
+
+    //! Returns the imaginary plane
+    const matrix <T>& imag() const
+    {
+        return mat_im;
+    }
+
+    //! Returns the element at the linear (column-major) index
+    std::complex <T> operator()(size_t sizet_elem) const
+    {
+        return std::complex <T> (mat_re(sizet_elem), mat_im(sizet_elem));
+    }
+
+    //! Returns the element at the row and the column
+    std::complex <T> operator()(size_t sizet_row, size_t sizet_col) const
+    {
+        return std::complex <T> (mat_re(sizet_row, sizet_col), mat_im(sizet_row, sizet_col));
+    }
+
+    //! Sets the element at the linear (column-major) index
+    void set(size_t sizet_elem, const std::complex <T>& cplx_arg)
+    {
+        mat_re(sizet_elem) = cplx_arg.real();
+        mat_im(sizet_elem) = cplx_arg.imag();
+    }
+
+    //! Sets the element at the row and the column
+    void set(size_t sizet_row, size_t sizet_col, const std::complex <T>& cplx_arg)
+    {
+        mat_re(sizet_row, sizet_col) = cplx_arg.real();
+        mat_im(sizet_row, sizet_col) = cplx_arg.imag();
+    }
+
+    cmatrix& operator+=(const cmatrix& mat_arg)
+    {
+        mat_re += mat_arg.mat_re;
+        mat_im += mat_arg.mat_im;
+        return *this;
+    }
+
+    cmatrix& operator-=(const cmatrix& mat_arg)
+    {
+        mat_re -= mat_arg.mat_re;
+        mat_im -= mat_arg.mat_im;
+        return *this;
+    }
+
+    //! The element-wise complex product
+    cmatrix& operator*=(const cmatrix& mat_arg)
+    {
+        SUSA_ASSERT_MESSAGE(shape() == mat_arg.shape(), "the matrices have different sizes.");
+        if (shape() != mat_arg.shape()) return *this;
+
+        planar_mul(mat_re.data(), mat_im.data(), mat_arg.mat_re.data(), mat_arg.mat_im.data(), size(), mat_re.data(), mat_im.data());
+        return *this;
+    }
+
+    //! Multiplies by a real scalar
+    cmatrix& operator*=(T T_arg)
+    {
+        mat_re *= T_arg;
+        mat_im *= T_arg;
+        return *this;
+    }
+
+    bool operator==(const cmatrix& mat_arg) const
+    {
+        return shape() == mat_arg.shape() && mat_re == mat_arg.mat_re && mat_im == mat_arg.mat_im;
+    }
+
+  private:
+    matrix <T> mat_re;
+    matrix <T> mat_im;
+};
+
+template <class T> cmatrix <T> operator+(cmatrix <T> mat_argl, const cmatrix <T>& mat_argr)
+{
+    return mat_argl += mat_argr;
+}
+
+template <class T> cmatrix <T> operator-(cmatrix <T> mat_argl, const cmatrix <T>& mat_argr)
+{
+    return mat_argl -= mat_argr;
+}
+
+template <class T> cmatrix <T> operator*(const cmatrix <T>& mat_argl, const cmatrix <T>& mat_argr)
+{
+    cmatrix <T> mat_ret(mat_argl.shape());
+
+    SUSA_ASSERT_MESSAGE(mat_argl.shape() == mat_argr.shape(), "the matrices have different sizes.");
+    if (mat_argl.shape() != mat_argr.shape()) return mat_ret;
+
+    planar_mul(mat_argl.real().data(), mat_argl.imag().data(), mat_argr.real().data(), mat_argr.imag().data(),
+               mat_ret.size(), mat_ret.real().data(), mat_ret.imag().data());
+    return mat_ret;
+}
+
+template <class T> cmatrix <T> operator*(cmatrix <T> mat_arg, T T_arg)
+{
+    return mat_arg *= T_arg;
+}
+
+/**
+ * @brief The element-wise product with the conjugate, conj(a) b
+ *
+ * e.g. the matched filter or the channel compensation of the OFDM subcarriers.
+ *
+ * @ingroup Math
+ */
+template <class T> cmatrix <T> conj_mul(const cmatrix <T>& mat_argl, const cmatrix <T>& mat_argr)
+{
+    cmatrix <T> mat_ret(mat_argl.shape());
+
+    SUSA_ASSERT_MESSAGE(mat_argl.shape() == mat_argr.shape(), "the matrices have different sizes.");
+    if (mat_argl.shape() != mat_argr.shape()) return mat_ret;
+
+    planar_conj_mul(mat_argl.real().data(), mat_argl.imag().data(), mat_argr.real().data(), mat_argr.imag().data(),
+                    mat_ret.size(), mat_ret.real().data(), mat_ret.imag().data());
+    return mat_ret;
+}
+
+/**
+ * @brief The element-wise multiply-accumulate, acc += a b
+ *
+ * @param mat_acc the accumulator
+ * @param mat_argl the left operand
+ * @param mat_argr the right operand
+ * @return false if the sizes mismatch (the accumulator is kept)
+ * @ingroup Math
+ */
+template <class T> bool mac(cmatrix <T>& mat_acc, const cmatrix <T>& mat_argl, const cmatrix <T>& mat_argr)
+{
+    bool bool_match = mat_acc.shape() == mat_argl.shape() && mat_argl.shape() == mat_argr.shape();
+    SUSA_ASSERT_MESSAGE(bool_match, "the matrices have different sizes.");
+    if (!bool_match) return false;
+
+    planar_mac(mat_argl.real().data(), mat_argl.imag().data(), mat_argr.real().data(), mat_argr.imag().data(),
+               mat_acc.size(), mat_acc.real().data(), mat_acc.imag().data());
+    return true;
+}
+
+/**
+ * @brief Magnitude squared
+ *
+ * @ingroup Math
+ */
+template <class T> matrix <T> mag(const cmatrix <T>& mat_arg)
+{
+    matrix <T> mat_ret(mat_arg.shape());
+    planar_mag(mat_arg.real().data(), mat_arg.imag().data(), mat_arg.size(), mat_ret.data());
+    return mat_ret;
+}
+
+/**
+ * @brief Conjugate
+ *
+ * @ingroup Math
+ */
+template <class T> cmatrix <T> conj(const cmatrix <T>& mat_arg)
+{
+    return cmatrix <T> (mat_arg.real(), T(0) - mat_arg.imag());
+}
+
+}      // NAMESPACE SUSA
+#endif // SUSA_CMATRIX_H
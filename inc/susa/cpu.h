@@ -0,0 +1,264 @@
+/*
+ * This file is part of Susa.
+ *
+ * Susa is free software: you can redistribute it and/or modify
+ * it under the terms of the Lesser GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * at your option) any later version.
+ *
+ * Susa is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * Lesser GNU General Public License for more details.
+ *
+ * You should have received a copy of the Lesser GNU General Public License
+ * along with Susa.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file cpu.h
+ * @brief The runtime selection of the kernels by the CPU features (declaration).
+ *
+ * The hot kernels are compiled several times, once for every instruction set,
+ * from the same portable loops. The best variant that the CPU supports is
+ * selected at the first use, or the variant named by the <i>SUSA_ISA</i>
+ * environment variable (generic, sse2, avx2, avx512 or neon). All the variants
+ * compute the same operations in the same order, i.e. the results are identical.
+ *
+ * @author Behrooz Kamary
+ * @version 1.0.0
+ *
+ * @defgroup CPU CPU Dispatch
+ */
+
+#ifndef SUSA_CPU_H
+#define SUSA_CPU_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include "metric.h"
+
+//! Forces the inlining of a kernel into the dispatched variants
+#if defined(__GNUC__) || defined(__clang__)
+#define SUSA_INLINE_KERNEL inline __attribute__((always_inline))
+#else
+#define SUSA_INLINE_KERNEL inline
+#endif
+
+//! Declares that the buffers of a kernel do not overlap
+#if defined(__GNUC__) || defined(__clang__) || defined(_MSC_VER)
+#define SUSA_RESTRICT __restrict
+#else
+#define SUSA_RESTRICT
+#endif
+
+namespace susa {
+
+/**
+ * @brief The instruction sets of the kernel variants.
+ *
+ * @ingroup CPU
+ */
+enum cpu_isa
+{
+    ISA_GENERIC,
+    ISA_SSE2,
+    ISA_AVX2,
+    ISA_AVX512,
+    ISA_NEON
+};
+
+/**
+ * @brief The table of the kernels of an instruction set.
+ *
+ * @ingroup CPU
+ */
+struct cpu_kernels
+{
+    //! The instruction set
+    cpu_isa isa;
+
+    //! The FIR kernel, see <i>fir_kernel()</i>
+    void (*fir_f64)(const double* ptr_b, size_t size_b, const double* ptr_x, size_t size_x,
+      double* ptr_y, size_t size_first, size_t size_last);
+
+    //! The add-compare-select of a radix-2 Viterbi stage, see <i>viterbi_acs()</i>
+    void (*viterbi_acs_f32)(const float* ptr_metric, const float* ptr_bm, uint32_t uint_half, float* ptr_next,
+      uint8_t* ptr_mask, uint64_t* ptr_dec);
+
+    //! The saturating fixed-point add-compare-selects, see <i>viterbi_acs()</i>
+    void (*viterbi_acs_i16)(const int16_t* ptr_metric, const int16_t* ptr_bm, uint32_t uint_half, int16_t* ptr_next,
+      uint8_t* ptr_mask, uint64_t* ptr_dec);
+    void (*viterbi_acs_i8)(const int8_t* ptr_metric, const int8_t* ptr_bm, uint32_t uint_half, int8_t* ptr_next,
+      uint8_t* ptr_mask, uint64_t* ptr_dec);
+
+    //! The planar complex kernels, see <i>planar_mul()</i>, <i>planar_conj_mul()</i> and <i>planar_mac()</i>
+    void (*planar_mul_f64)(const double* ptr_ar, const double* ptr_ai, const double* ptr_br, const double* ptr_bi,
+      size_t sizet_n, double* ptr_yr, double* ptr_yi);
+    void (*planar_conj_mul_f64)(const double* ptr_ar, const double* ptr_ai, const double* ptr_br, const double* ptr_bi,
+      size_t sizet_n, double* ptr_yr, double* ptr_yi);
+    void (*planar_mac_f64)(const double* ptr_ar, const double* ptr_ai, const double* ptr_br, const double* ptr_bi,
+      size_t sizet_n, double* ptr_yr, double* ptr_yi);
+
+    //! The planar magnitude squared, see <i>planar_mag()</i>
+    void (*planar_mag_f64)(const double* ptr_ar, const double* ptr_ai, size_t sizet_n, double* ptr_y);
+
+    //! The max-log LLRs of a square QAM axis, see <i>qam_max_log_llr()</i>
+    void (*qam_max_log_llr_f64)(const double* ptr_x, size_t sizet_n, uint32_t uint_side, uint32_t uint_bpa,
+      double dbl_scale, double* ptr_llr);
+};
+
+/**
+ * @brief Checks whether the CPU and the build support an instruction set.
+ *
+ * @ingroup CPU
+ */
+bool cpu_supports(cpu_isa isa);
+
+/**
+ * @brief Returns the best instruction set that is supported.
+ *
+ * @ingroup CPU
+ */
+cpu_isa cpu_best_isa();
+
+/**
+ * @brief Returns the name of an instruction set e.g. "avx2".
+ *
+ * @ingroup CPU
+ */
+const char* cpu_isa_name(cpu_isa isa);
+
+/**
+ * @brief Returns the kernels of an instruction set.
+ *
+ * @return the table or nullptr if the instruction set is not supported
+ * @ingroup CPU
+ */
+const cpu_kernels* cpu_kernels_for(cpu_isa isa);
+
+/**
+ * @brief Returns the selected kernels.
+ *
+ * The selection is made at the first call, either by the <i>SUSA_ISA</i>
+ * environment variable or by <i>cpu_best_isa()</i>.
+ *
+ * @ingroup CPU
+ */
+const cpu_kernels& cpu_dispatch();
+
+/**
+ * @brief Overrides the selected kernels.
+ *
+ * @param isa the instruction set
+ * @return false if the instruction set is not supported (the selection is kept)
+ * @ingroup CPU
+ */
+bool cpu_select(cpu_isa isa);
+
+/**
+ * @brief Permutes the branch metrics of a radix-2 Viterbi stage per butterfly.
+ *
+ * The metrics of the code words of the butterflies are gathered once per stage into
+ * the four contiguous planes of <i>uint_half</i> metrics that <i>viterbi_acs()</i> reads,
+ * i.e. the metric of <i>ptr_out00[j]</i>, <i>ptr_out10[j]</i>, <i>ptr_out01[j]</i> and
+ * <i>ptr_out11[j]</i> in this order.
+ *
+ * @param ptr_branch the branch metrics of the code words
+ * @param ptr_out00 the code word from the state <i>2j</i> with the input zero
+ * @param ptr_out10 the code word from the state <i>2j + 1</i> with the input zero
+ * @param ptr_out01 the code word from the state <i>2j</i> with the input one
+ * @param ptr_out11 the code word from the state <i>2j + 1</i> with the input one
+ * @param uint_half the half of the number of states
+ * @param ptr_bm the planes of the branch metrics, <i>4 uint_half</i> elements
+ *
+ * @ingroup CPU
+ */
+template <typename M> inline void viterbi_permute(const M* ptr_branch, const uint8_t* ptr_out00, const uint8_t* ptr_out10,
+  const uint8_t* ptr_out01, const uint8_t* ptr_out11, uint32_t uint_half, M* ptr_bm)
+{
+    for (uint32_t uint_j = 0; uint_j < uint_half; uint_j++)
+    {
+        ptr_bm[uint_j]                 = ptr_branch[ptr_out00[uint_j]];
+        ptr_bm[uint_j + uint_half]     = ptr_branch[ptr_out10[uint_j]];
+        ptr_bm[uint_j + 2 * uint_half] = ptr_branch[ptr_out01[uint_j]];
+        ptr_bm[uint_j + 3 * uint_half] = ptr_branch[ptr_out11[uint_j]];
+    }
+}
+
+/**
+ * @brief The add-compare-select of a radix-2 Viterbi stage.
+ *
+ * The states <i>2j</i> and <i>2j + 1</i> go to <i>j</i> with the input zero and to
+ * <i>j + half</i> with the input one. The loop over the butterflies reads contiguous
+ * branch metrics (see <i>viterbi_permute()</i>) and stores a decision byte per state,
+ * hence it is vectorised with as many lanes as the metric type fits in a register.
+ * The bytes are packed afterwards into the bits of <i>ptr_dec</i>, one for the odd
+ * predecessor. The additions of the fixed-point metrics saturate, see <i>metric_traits</i>.
+ *
+ * @param ptr_metric the path metrics of the stage
+ * @param ptr_bm the planes of the branch metrics of <i>viterbi_permute()</i>
+ * @param uint_half the half of the number of states
+ * @param ptr_next the path metrics of the next stage
+ * @param ptr_mask the decision bytes, <i>2 uint_half</i> elements
+ * @param ptr_dec the decision bits
+ *
+ * @ingroup CPU
+ */
+template <typename M> SUSA_INLINE_KERNEL void viterbi_acs(const M* SUSA_RESTRICT ptr_metric, const M* SUSA_RESTRICT ptr_bm,
+  uint32_t uint_half, M* SUSA_RESTRICT ptr_next, uint8_t* SUSA_RESTRICT ptr_mask, uint64_t* ptr_dec)
+{
+    const M* ptr_bm00 = ptr_bm;
+    const M* ptr_bm10 = ptr_bm + uint_half;
+    const M* ptr_bm01 = ptr_bm + 2 * uint_half;
+    const M* ptr_bm11 = ptr_bm + 3 * uint_half;
+
+    // the indices do not wrap, i.e. the accesses are affine
+    for (size_t sizet_j = 0; sizet_j < uint_half; sizet_j++)
+    {
+        M t_m0 = ptr_metric[2 * sizet_j];
+        M t_m1 = ptr_metric[2 * sizet_j + 1];
+
+        M t_a0 = metric_traits <M>::add(t_m0, ptr_bm00[sizet_j]);
+        M t_a1 = metric_traits <M>::add(t_m1, ptr_bm10[sizet_j]);
+        M t_b0 = metric_traits <M>::add(t_m0, ptr_bm01[sizet_j]);
+        M t_b1 = metric_traits <M>::add(t_m1, ptr_bm11[sizet_j]);
+
+        uint8_t uint_da = t_a1 > t_a0;
+        uint8_t uint_db = t_b1 > t_b0;
+
+        ptr_next[sizet_j]             = t_a1 > t_a0 ? t_a1 : t_a0;
+        ptr_next[sizet_j + uint_half] = t_b1 > t_b0 ? t_b1 : t_b0;
+        ptr_mask[sizet_j]             = uint_da;
+        ptr_mask[sizet_j + uint_half] = uint_db;
+    }
+
+    // 64 decisions per word, the eight bytes of a group are gathered into its top byte
+    // by a multiplication (the bytes are 0 or 1 hence the partial products do not carry)
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    const uint64_t uint_gather = 0x8040201008040201ull;
+#else
+    const uint64_t uint_gather = 0x0102040810204080ull;
+#endif
+    const size_t sizet_states = 2 * static_cast <size_t> (uint_half);
+    for (size_t sizet_w = 0; sizet_w < (sizet_states + 63) / 64; sizet_w++)
+    {
+        uint8_t uint_word[64] = {0};
+        size_t  sizet_bits    = sizet_states - 64 * sizet_w < 64 ? sizet_states - 64 * sizet_w : 64;
+        std::memcpy(uint_word, ptr_mask + 64 * sizet_w, sizet_bits);
+
+        uint64_t uint_dec = 0;
+        for (uint32_t uint_g = 0; uint_g < 8; uint_g++)
+        {
+            uint64_t uint_bytes;
+            std::memcpy(&uint_bytes, uint_word + 8 * uint_g, 8);
+            uint_dec |= ((uint_bytes * uint_gather) >> 56) << (8 * uint_g);
+        }
+        ptr_dec[sizet_w] = uint_dec;
+    }
+}
+
+}      // NAMESPACE SUSA
+#endif // SUSA_CPU_H
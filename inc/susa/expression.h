@@ -0,0 +1,331 @@
+/*
+ * This file is part of Susa.
+ *
+ * Susa is free software: you can redistribute it and/or modify
+ * it under the terms of the Lesser GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * at your option) any later version.
+ *
+ * Susa is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * Lesser GNU General Public License for more details.
+ *
+ * You should have received a copy of the Lesser GNU General Public License
+ * along with Susa.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file expression.h
+ * @brief Lazy element-wise expressions (declaration and definition).
+ *
+ * This file contains the expression templates that let an element-wise
+ * arithmetic expression over matrices be built without evaluating it.
+ * The whole expression is evaluated in a single loop when it is assigned
+ * to a <i>matrix</i>. An expression is started by wrapping a matrix with
+ * <i>susa::lazy()</i>, e.g.
+ * <i>mat_y = susa::lazy(mat_a) * dbl_a + susa::lazy(mat_x) * dbl_b - mat_c;</i>
+ * The eager operators of the <i>matrix</i> class are not affected, i.e. a
+ * sub-expression of matrices only, such as <i>mat_x * dbl_b</i>, is evaluated
+ * into a temporary matrix. Every operand that is multiplied or divided by a
+ * scalar has to be wrapped to avoid the intermediate matrices.
+ *
+ * The leaves refer to the matrices, hence an expression should be evaluated
+ * in the statement that builds it and not be stored (e.g. by <i>auto</i>);
+ * a stored expression may refer to a destroyed temporary.
+ *
+ * @author Behrooz Kamary
+ * @version 1.0.0
+ */
+
+#ifndef SUSA_EXPRESSION_H
+#define SUSA_EXPRESSION_H
+
+#include <susa/debug.h>
+
+namespace susa
+{
+
+template <class T> class matrix;
+
+/**
+ * @brief The base of all lazy expressions.
+ *
+ * It is a CRTP base, i.e. <i>E</i> is the concrete expression node.
+ * A node provides the shape of the expression and the evaluation of
+ * a single element given its linear (column-major) index.
+ *
+ * @ingroup TYPES
+ */
+template <class T, class E> class expression
+{
+  public:
+    //! Returns the concrete expression
+    const E& self() const
+    {
+        return static_cast<const E&>(*this);
+    }
+
+    //! Evaluates the element at the linear index
+    T elem(size_t sizet_elem) const
+    {
+        return self().elem(sizet_elem);
+    }
+
+    //! Returns the number of rows
+    size_t no_rows() const
+    {
+        return self().no_rows();
+    }
+
+    //! Returns the number of columns
+    size_t no_cols() const
+    {
+        return self().no_cols();
+    }
+
+    //! Returns the number of elements
+    size_t size() const
+    {
+        return self().no_rows() * self().no_cols();
+    }
+};
+
+/**
+ * @brief An expression leaf that refers to a matrix.
+ *
+ * The leaf does not own the elements, hence the referred matrix
+ * should outlive the expression.
+ *
+ * @ingroup TYPES
+ */
+template <class T> class expr_leaf : public expression <T, expr_leaf <T> >
+{
+  private:
+    const T* T_data;
+    size_t   sizet_rows;
+    size_t   sizet_cols;
+
+  public:
+    explicit expr_leaf(const matrix <T>& mat_arg)
+    : T_data(mat_arg.data())
+    , sizet_rows(mat_arg.no_rows())
+    , sizet_cols(mat_arg.no_cols())
+    {}
+
+    T elem(size_t sizet_elem) const
+    {
+        return T_data[sizet_elem];
+    }
+
+    size_t no_rows() const
+    {
+        return sizet_rows;
+    }
+
+    size_t no_cols() const
+    {
+        return sizet_cols;
+    }
+};
+
+//! Element-wise addition functor
+struct expr_add
+{
+    template <class T> static T apply(const T& T_argl, const T& T_argr)
+    {
+        return T_argl + T_argr;
+    }
+};
+
+//! Element-wise subtraction functor
+struct expr_sub
+{
+    template <class T> static T apply(const T& T_argl, const T& T_argr)
+    {
+        return T_argl - T_argr;
+    }
+};
+
+//! Element-wise multiplication functor
+struct expr_mul
+{
+    template <class T> static T apply(const T& T_argl, const T& T_argr)
+    {
+        return T_argl * T_argr;
+    }
+};
+
+//! Element-wise division functor
+struct expr_div
+{
+    template <class T> static T apply(const T& T_argl, const T& T_argr)
+    {
+        return T_argl / T_argr;
+    }
+};
+
+/**
+ * @brief An element-wise binary expression of two expressions.
+ *
+ * The operands are held by value; since the nodes are light-weight
+ * this keeps the temporary nodes of a chained expression alive.
+ *
+ * @ingroup TYPES
+ */
+template <class T, class L, class R, class OP> class expr_binary : public expression <T, expr_binary <T, L, R, OP> >
+{
+  private:
+    L expr_argl;
+    R expr_argr;
+
+  public:
+    expr_binary(const L& expr_l, const R& expr_r)
+    : expr_argl(expr_l)
+    , expr_argr(expr_r)
+    {
+        SUSA_ASSERT_MESSAGE(expr_l.no_rows() == expr_r.no_rows() && expr_l.no_cols() == expr_r.no_cols(),
+          "the matrices have different sizes.");
+    }
+
+    T elem(size_t sizet_elem) const
+    {
+        return OP::apply(expr_argl.elem(sizet_elem), expr_argr.elem(sizet_elem));
+    }
+
+    size_t no_rows() const
+    {
+        return expr_argl.no_rows();
+    }
+
+    size_t no_cols() const
+    {
+        return expr_argl.no_cols();
+    }
+};
+
+/**
+ * @brief An element-wise binary expression of an expression and a scalar.
+ *
+ * @ingroup TYPES
+ */
+template <class T, class E, class OP, bool SCALAR_LEFT> class expr_scalar : public expression <T, expr_scalar <T, E, OP, SCALAR_LEFT> >
+{
+  private:
+    E expr_arg;
+    T T_arg;
+
+  public:
+    expr_scalar(const E& expr_e, T T_s)
+    : expr_arg(expr_e)
+    , T_arg(T_s)
+    {}
+
+    T elem(size_t sizet_elem) const
+    {
+        return SCALAR_LEFT ? OP::apply(T_arg, expr_arg.elem(sizet_elem))
+                           : OP::apply(expr_arg.elem(sizet_elem), T_arg);
+    }
+
+    size_t no_rows() const
+    {
+        return expr_arg.no_rows();
+    }
+
+    size_t no_cols() const
+    {
+        return expr_arg.no_cols();
+    }
+};
+
+/**
+ * @brief An element-wise negation of an expression.
+ *
+ * @ingroup TYPES
+ */
+template <class T, class E> class expr_negate : public expression <T, expr_negate <T, E> >
+{
+  private:
+    E expr_arg;
+
+  public:
+    explicit expr_negate(const E& expr_e)
+    : expr_arg(expr_e)
+    {}
+
+    T elem(size_t sizet_elem) const
+    {
+        return -expr_arg.elem(sizet_elem);
+    }
+
+    size_t no_rows() const
+    {
+        return expr_arg.no_rows();
+    }
+
+    size_t no_cols() const
+    {
+        return expr_arg.no_cols();
+    }
+};
+
+/**
+ * @brief Starts a lazy element-wise expression
+ *
+ * @param mat_arg the matrix operand
+ * @return an expression leaf that refers to the input matrix
+ * @ingroup TYPES
+ */
+template <class T> expr_leaf <T> lazy(const matrix <T>& mat_arg)
+{
+    return expr_leaf <T> (mat_arg);
+}
+
+//! The type of a scalar operand, it is not deduced hence e.g. an int literal is converted
+template <class T> struct expr_scalar_type { typedef T type; };
+
+// The operators below are defined for each OP in { +, -, *, / } and
+// for every combination where at least one operand is an expression.
+#define SUSA_EXPR_OPERATOR(SYM, OP)                                                                    \
+template <class T, class L, class R>                                                                   \
+expr_binary <T, L, R, OP> operator SYM (const expression <T, L>& expr_l, const expression <T, R>& expr_r) \
+{                                                                                                      \
+    return expr_binary <T, L, R, OP> (expr_l.self(), expr_r.self());                                   \
+}                                                                                                      \
+template <class T, class L>                                                                            \
+expr_binary <T, L, expr_leaf <T>, OP> operator SYM (const expression <T, L>& expr_l, const matrix <T>& mat_r) \
+{                                                                                                      \
+    return expr_binary <T, L, expr_leaf <T>, OP> (expr_l.self(), expr_leaf <T> (mat_r));              \
+}                                                                                                      \
+template <class T, class R>                                                                            \
+expr_binary <T, expr_leaf <T>, R, OP> operator SYM (const matrix <T>& mat_l, const expression <T, R>& expr_r) \
+{                                                                                                      \
+    return expr_binary <T, expr_leaf <T>, R, OP> (expr_leaf <T> (mat_l), expr_r.self());              \
+}                                                                                                      \
+template <class T, class L>                                                                            \
+expr_scalar <T, L, OP, false> operator SYM (const expression <T, L>& expr_l, typename expr_scalar_type <T>::type T_r) \
+{                                                                                                      \
+    return expr_scalar <T, L, OP, false> (expr_l.self(), T_r);                                         \
+}                                                                                                      \
+template <class T, class R>                                                                            \
+expr_scalar <T, R, OP, true> operator SYM (typename expr_scalar_type <T>::type T_l, const expression <T, R>& expr_r) \
+{                                                                                                      \
+    return expr_scalar <T, R, OP, true> (expr_r.self(), T_l);                                          \
+}
+
+SUSA_EXPR_OPERATOR(+, expr_add)
+SUSA_EXPR_OPERATOR(-, expr_sub)
+SUSA_EXPR_OPERATOR(*, expr_mul)
+SUSA_EXPR_OPERATOR(/, expr_div)
+
+#undef SUSA_EXPR_OPERATOR
+
+//! Element-wise negation of an expression
+template <class T, class E> expr_negate <T, E> operator-(const expression <T, E>& expr_arg)
+{
+    return expr_negate <T, E> (expr_arg.self());
+}
+
+}      // NAMESPACE SUSA
+
+#endif // SUSA_EXPRESSION_H
@@ -18,6 +18,15 @@
 /**
  * @file fft.h
  * @brief Fast Fourier Transform (FFT) (declaration and definition).
+ *
+ * This file contains the planned FFT engine. An <i>fft_plan</i> precomputes
+ * the twiddle factors and the bit-reversal permutation of a transform size
+ * once, hence a plan should be created once and reused for all the transforms
+ * of that size. The power of two sizes use fused radix-2<sup>2</sup> butterflies
+ * and the other sizes use the Bluestein (chirp-z) algorithm on top of a power of
+ * two plan. The <i>rfft_plan</i> computes the real-input transforms using a half
+ * size complex transform.
+ *
  * @author Behrooz Kamary
  * @version 1.0.0
  */
@@ -25,8 +34,123 @@
 #ifndef SUSA_FFT_H
 #define SUSA_FFT_H
 
+#include <memory>
+
 namespace susa {
 
+/**
+ * @brief The FFT plan class.
+ *
+ * It computes the unnormalized forward transform
+ * <i>X(k) = sum x(n) exp(-2 pi i k n / N)</i> and the inverse transform
+ * that is scaled by <i>1/N</i>. The transforms are done in place.
+ * A plan is immutable after construction, hence it can be shared by threads.
+ *
+ * @ingroup Signal
+ */
+template <class T> class fft_plan
+{
+  public:
+    /**
+     * @brief Constructor
+     *
+     * @param sizet_size the transform size (any positive size)
+     */
+    explicit fft_plan(size_t sizet_size);
+
+    //! Returns the transform size
+    size_t size() const;
+
+    //! In place forward transform of <i>size()</i> contiguous elements
+    void forward(std::complex <T>* ptr_data) const;
+
+    //! In place inverse transform of <i>size()</i> contiguous elements
+    void inverse(std::complex <T>* ptr_data) const;
+
+    /**
+     * @brief In place forward transform
+     *
+     * A vector of <i>size()</i> elements is transformed as a whole and a matrix
+     * with <i>size()</i> rows is transformed column-wise (batched).
+     *
+     * @param mat_arg the input and the output
+     * @return false if the dimensions do not match the plan
+     */
+    bool forward(matrix <std::complex <T> >& mat_arg) const;
+
+    /**
+     * @brief In place inverse transform
+     *
+     * @param mat_arg the input and the output (see <i>forward()</i>)
+     * @return false if the dimensions do not match the plan
+     */
+    bool inverse(matrix <std::complex <T> >& mat_arg) const;
+
+  private:
+    size_t                                  sizet_size;
+
+    // the power of two sizes
+    std::vector <std::complex <T> >         vec_twiddle;
+    std::vector <size_t>                    vec_reverse;
+
+    // the Bluestein algorithm
+    std::vector <std::complex <T> >         vec_chirp;
+    std::vector <std::complex <T> >         vec_filter;
+    std::shared_ptr <const fft_plan <T> >   ptr_inner;
+
+    template <bool INVERSE> void radix2(std::complex <T>* ptr_data) const;
+    void bluestein(std::complex <T>* ptr_data) const;
+    bool transform(matrix <std::complex <T> >& mat_arg, bool bool_inverse) const;
+};
+
+/**
+ * @brief The real-input FFT plan class.
+ *
+ * The forward transform of a real vector of N elements returns the
+ * N/2 + 1 non-redundant bins of its Hermitian spectrum and the inverse
+ * transform reconstructs the real vector from them. An even size is computed
+ * with a complex transform of size N/2.
+ *
+ * @ingroup Signal
+ */
+template <class T> class rfft_plan
+{
+  public:
+    /**
+     * @brief Constructor
+     *
+     * @param sizet_size the size of the real input
+     */
+    explicit rfft_plan(size_t sizet_size);
+
+    //! Returns the size of the real input
+    size_t size() const;
+
+    /**
+     * @brief Real to complex forward transform
+     *
+     * @param mat_arg a vector of <i>size()</i> elements or a matrix of <i>size()</i> rows (column-wise)
+     * @return the bins 0 to <i>size()/2</i> of each transformed vector
+     */
+    matrix <std::complex <T> > forward(const matrix <T>& mat_arg) const;
+
+    /**
+     * @brief Complex to real inverse transform
+     *
+     * @param mat_arg a vector of <i>size()/2 + 1</i> bins or a matrix of <i>size()/2 + 1</i> rows
+     * @return the real vectors of <i>size()</i> elements
+     */
+    matrix <T> inverse(const matrix <std::complex <T> >& mat_arg) const;
+
+  private:
+    size_t                              sizet_size;
+    fft_plan <T>                        plan_complex;
+    std::vector <std::complex <T> >     vec_twiddle;
+
+    void forward(const T* ptr_in, std::complex <T>* ptr_out, std::complex <T>* ptr_work) const;
+    void inverse(const std::complex <T>* ptr_in, T* ptr_out, std::complex <T>* ptr_work) const;
+};
+
 /**
  * @brief The Fast Fourier Transform (FFT) class.
  *
@@ -35,61 +159,423 @@ namespace susa {
 template <class T> class fft {
   public:
     /**
-    * @brief Fast Fourier Transform (FFT) using the radix2 algorithm
+    * @brief Fast Fourier Transform (FFT)
     *
-    * @todo It only supports 2^N input size. It should cope with any vector size.
-    * @param vec_arg Input STL vector
+    * It builds an <i>fft_plan</i> for each call; use a plan directly
+    * to transform many vectors of the same size.
+    *
+    * @param vec_arg Input STL vector of complex values (any size)
     * @return returns STL vector
     */
-    std::vector <T> radix2(std::vector <T> vec_arg);
-  private:
-    std::vector <T> bit_reverse(std::vector <T>);
+    std::vector <T> radix2(const std::vector <T>& vec_arg);
 };
 
+// Implementation
 
-template <class T> std::vector <T> fft<T>::radix2(std::vector <T> vec_arg)
+// complex multiplication without the IEEE special case handling of std::complex
+template <class T> inline std::complex <T> fft_mul(const std::complex <T>& cplx_a, const std::complex <T>& cplx_b)
 {
-    unsigned short int N = vec_arg.size();
-    std::vector <T> vec_BitReverse = bit_reverse(vec_arg);
-    T tTemp = 0;
-    int l   = 0;
-    unsigned short int usiStage = susa::log2(N);
+    return std::complex <T> (cplx_a.real() * cplx_b.real() - cplx_a.imag() * cplx_b.imag(),
+                             cplx_a.real() * cplx_b.imag() + cplx_a.imag() * cplx_b.real());
+}
+
+template <class T> fft_plan <T>::fft_plan(size_t sizet_size)
+: sizet_size(sizet_size)
+{
+    SUSA_ASSERT_MESSAGE(sizet_size > 0, "the FFT size should be positive.");
 
-    for (int i = 0; i < usiStage; i++) {                    // Stage counter
-        for (int j = 0; j < (1 << (usiStage - i - 1)); j++)
-        {     // Seperated butterflies
-            l = (j == 0) ? j:j * (1 << (i + 1));
-            for (int k=0; k<(1<<i); k++)
-            {              // Adjacent butterflies
-                tTemp = vec_BitReverse[k+l];
-                vec_BitReverse[k + l] = tTemp + vec_BitReverse[k +(1 << i) + l] *
-                  exp(std::complex<double>(0,(-2 * k * PI * (1 << (usiStage - i - 1))) / N));
+    if ((sizet_size & (sizet_size - 1)) == 0)
+    {
+        size_t sizet_stages = 0;
+        while ((size_t(1) << sizet_stages) < sizet_size) sizet_stages++;
+
+        // the radix-2^2 passes use the twiddles up to w^3 i.e. three quarters of the circle
+        vec_twiddle.resize(3 * sizet_size / 4);
+        for (size_t sizet_k = 0; sizet_k < vec_twiddle.size(); sizet_k++)
+        {
+            double dbl_angle = -2.0 * PI * (double)sizet_k / (double)sizet_size;
+            vec_twiddle[sizet_k] = std::complex <T> ((T)std::cos(dbl_angle), (T)std::sin(dbl_angle));
+        }
 
-                vec_BitReverse[k + (1 << i) + l] = tTemp - vec_BitReverse[k + (1 << i) + l] *
-                  exp(std::complex<double>(0,(-2 * k * PI * (1 << (usiStage - i - 1))) / N));
+        vec_reverse.resize(sizet_size);
+        for (size_t sizet_i = 0; sizet_i < sizet_size; sizet_i++)
+        {
+            size_t sizet_rev = 0;
+            for (size_t sizet_bit = 0; sizet_bit < sizet_stages; sizet_bit++)
+            {
+                sizet_rev |= ((sizet_i >> sizet_bit) & 1) << (sizet_stages - sizet_bit - 1);
             }
+            vec_reverse[sizet_i] = sizet_rev;
         }
     }
-    return vec_BitReverse;
+    else
+    {
+        size_t sizet_inner = 1;
+        while (sizet_inner < 2 * sizet_size - 1) sizet_inner <<= 1;
+        ptr_inner = std::make_shared <const fft_plan <T> > (sizet_inner);
+
+        // the k^2 is reduced modulo 2N to keep the chirp phase accurate
+        vec_chirp.resize(sizet_size);
+        for (size_t sizet_k = 0; sizet_k < sizet_size; sizet_k++)
+        {
+            size_t sizet_sq   = (sizet_k * sizet_k) % (2 * sizet_size);
+            double dbl_angle  = -PI * (double)sizet_sq / (double)sizet_size;
+            vec_chirp[sizet_k] = std::complex <T> ((T)std::cos(dbl_angle), (T)std::sin(dbl_angle));
+        }
+
+        vec_filter.assign(sizet_inner, std::complex <T> (0));
+        vec_filter[0] = std::conj(vec_chirp[0]);
+        for (size_t sizet_k = 1; sizet_k < sizet_size; sizet_k++)
+        {
+            vec_filter[sizet_k]               = std::conj(vec_chirp[sizet_k]);
+            vec_filter[sizet_inner - sizet_k] = std::conj(vec_chirp[sizet_k]);
+        }
+        ptr_inner->forward(vec_filter.data());
+
+        // the inverse transform of the convolution is left unscaled
+        T T_scale = T(1) / (T)sizet_inner;
+        for (size_t sizet_k = 0; sizet_k < sizet_inner; sizet_k++) vec_filter[sizet_k] *= T_scale;
+    }
 }
 
-template <class T> std::vector <T> fft<T>::bit_reverse(std::vector <T> vec_arg)
+template <class T> size_t fft_plan <T>::size() const
 {
-    unsigned int N = vec_arg.size();
-    unsigned short int intBR;
-    T TSwap=0;
+    return sizet_size;
+}
+
+template <class T> template <bool INVERSE> void fft_plan <T>::radix2(std::complex <T>* ptr_data) const
+{
+    const size_t sizet_n = sizet_size;
+
+    for (size_t sizet_i = 0; sizet_i < sizet_n; sizet_i++)
+    {
+        size_t sizet_rev = vec_reverse[sizet_i];
+        if (sizet_i < sizet_rev) std::swap(ptr_data[sizet_i], ptr_data[sizet_rev]);
+    }
+
+    // a single radix-2 stage if the number of stages is odd
+    size_t sizet_span = 1;
+    size_t sizet_stages = 0;
+    while ((size_t(1) << sizet_stages) < sizet_n) sizet_stages++;
+
+    if (sizet_stages % 2 == 1)
+    {
+        for (size_t sizet_i = 0; sizet_i < sizet_n; sizet_i += 2)
+        {
+            std::complex <T> cplx_a = ptr_data[sizet_i];
+            std::complex <T> cplx_b = ptr_data[sizet_i + 1];
+            ptr_data[sizet_i]       = cplx_a + cplx_b;
+            ptr_data[sizet_i + 1]   = cplx_a - cplx_b;
+        }
+        sizet_span = 2;
+    }
+
+    // each radix-2^2 pass fuses the two radix-2 stages from span to 4 * span, i.e. a radix-4
+    // butterfly with the twiddles w, w^2 and w^3 of the size 4 * span (3 complex multiplies)
+    for (; sizet_span < sizet_n; sizet_span *= 4)
+    {
+        size_t sizet_step = sizet_n / (4 * sizet_span);
+
+        for (size_t sizet_base = 0; sizet_base < sizet_n; sizet_base += 4 * sizet_span)
+        {
+            std::complex <T>* ptr_block = ptr_data + sizet_base;
+
+            for (size_t sizet_j = 0; sizet_j < sizet_span; sizet_j++)
+            {
+                std::complex <T> cplx_w1 = vec_twiddle[sizet_j * sizet_step];
+                std::complex <T> cplx_w2 = vec_twiddle[2 * sizet_j * sizet_step];
+                std::complex <T> cplx_w3 = vec_twiddle[3 * sizet_j * sizet_step];
+                if (INVERSE)
+                {
+                    cplx_w1 = std::conj(cplx_w1);
+                    cplx_w2 = std::conj(cplx_w2);
+                    cplx_w3 = std::conj(cplx_w3);
+                }
+
+                std::complex <T> cplx_x0 = ptr_block[sizet_j];
+                std::complex <T> cplx_x1 = fft_mul(cplx_w2, ptr_block[sizet_j + sizet_span]);
+                std::complex <T> cplx_x2 = fft_mul(cplx_w1, ptr_block[sizet_j + 2 * sizet_span]);
+                std::complex <T> cplx_x3 = fft_mul(cplx_w3, ptr_block[sizet_j + 3 * sizet_span]);
+
+                std::complex <T> cplx_a0 = cplx_x0 + cplx_x1;
+                std::complex <T> cplx_a1 = cplx_x0 - cplx_x1;
+                std::complex <T> cplx_b0 = cplx_x2 + cplx_x3;
+                std::complex <T> cplx_b1 = cplx_x2 - cplx_x3;
 
+                // multiplication by -i (forward) or +i (inverse)
+                cplx_b1 = INVERSE ? std::complex <T> (-cplx_b1.imag(), cplx_b1.real())
+                                  : std::complex <T> (cplx_b1.imag(), -cplx_b1.real());
 
-    for (unsigned short int i=1; i < N/2; i++ ) {
-        intBR = 0;
-        for (unsigned short int j=0; j < susa::log2(N); j++) {
-            intBR = intBR | (( i >> j)&1)<<(susa::log2(N)-j-1);
+                ptr_block[sizet_j]                  = cplx_a0 + cplx_b0;
+                ptr_block[sizet_j + 2 * sizet_span] = cplx_a0 - cplx_b0;
+                ptr_block[sizet_j + sizet_span]     = cplx_a1 + cplx_b1;
+                ptr_block[sizet_j + 3 * sizet_span] = cplx_a1 - cplx_b1;
+            }
         }
-        TSwap = vec_arg[i];
-        vec_arg[i] = vec_arg[intBR];
-        vec_arg[intBR] = TSwap;
     }
-    return vec_arg;
+}
+
+template <class T> void fft_plan <T>::bluestein(std::complex <T>* ptr_data) const
+{
+    size_t sizet_inner = ptr_inner->size();
+    std::vector <std::complex <T> > vec_work(sizet_inner, std::complex <T> (0));
+
+    for (size_t sizet_k = 0; sizet_k < sizet_size; sizet_k++)
+    {
+        vec_work[sizet_k] = fft_mul(ptr_data[sizet_k], vec_chirp[sizet_k]);
+    }
+
+    ptr_inner->template radix2 <false> (vec_work.data());
+    for (size_t sizet_k = 0; sizet_k < sizet_inner; sizet_k++)
+    {
+        vec_work[sizet_k] = fft_mul(vec_work[sizet_k], vec_filter[sizet_k]);
+    }
+    ptr_inner->template radix2 <true> (vec_work.data());
+
+    for (size_t sizet_k = 0; sizet_k < sizet_size; sizet_k++)
+    {
+        ptr_data[sizet_k] = fft_mul(vec_work[sizet_k], vec_chirp[sizet_k]);
+    }
+}
+
+template <class T> void fft_plan <T>::forward(std::complex <T>* ptr_data) const
+{
+    if (ptr_inner) bluestein(ptr_data);
+    else radix2 <false> (ptr_data);
+}
+
+template <class T> void fft_plan <T>::inverse(std::complex <T>* ptr_data) const
+{
+    T T_scale = T(1) / (T)sizet_size;
+
+    if (ptr_inner)
+    {
+        // the inverse is the conjugate of the forward transform of the conjugate
+        for (size_t sizet_k = 0; sizet_k < sizet_size; sizet_k++) ptr_data[sizet_k] = std::conj(ptr_data[sizet_k]);
+        bluestein(ptr_data);
+        for (size_t sizet_k = 0; sizet_k < sizet_size; sizet_k++) ptr_data[sizet_k] = std::conj(ptr_data[sizet_k]) * T_scale;
+    }
+    else
+    {
+        radix2 <true> (ptr_data);
+        for (size_t sizet_k = 0; sizet_k < sizet_size; sizet_k++) ptr_data[sizet_k] *= T_scale;
+    }
+}
+
+template <class T> bool fft_plan <T>::transform(matrix <std::complex <T> >& mat_arg, bool bool_inverse) const
+{
+    SUSA_PROFILE_SCOPE("fft.transform");
+
+    size_t sizet_batch;
+
+    if ((mat_arg.no_rows() == 1 || mat_arg.no_cols() == 1) && mat_arg.size() == sizet_size) sizet_batch = 1;
+    else if (mat_arg.no_rows() == sizet_size) sizet_batch = mat_arg.no_cols();
+    else
+    {
+        SUSA_ASSERT_MESSAGE(false, "the matrix dimensions do not match the FFT size.");
+        return false;
+    }
+
+    std::complex <T>* ptr_data = mat_arg.data();
+
+    // the batches are spread over the threads when there is enough work
+    size_t sizet_grain = (1 << 16) / sizet_size + 1;
+    parallel_for(0, sizet_batch, sizet_grain, [&](size_t sizet_first, size_t sizet_last)
+    {
+        for (size_t sizet_col = sizet_first; sizet_col < sizet_last; sizet_col++)
+        {
+            if (bool_inverse) inverse(ptr_data + sizet_col * sizet_size);
+            else forward(ptr_data + sizet_col * sizet_size);
+        }
+    });
+
+    return true;
+}
+
+template <class T> bool fft_plan <T>::forward(matrix <std::complex <T> >& mat_arg) const
+{
+    return transform(mat_arg, false);
+}
+
+template <class T> bool fft_plan <T>::inverse(matrix <std::complex <T> >& mat_arg) const
+{
+    return transform(mat_arg, true);
+}
+
+// rfft_plan
+
+template <class T> rfft_plan <T>::rfft_plan(size_t sizet_size)
+: sizet_size(sizet_size)
+, plan_complex(sizet_size % 2 == 0 ? sizet_size / 2 : sizet_size)
+{
+    if (sizet_size % 2 == 0)
+    {
+        size_t sizet_half = sizet_size / 2;
+        vec_twiddle.resize(sizet_half + 1);
+        for (size_t sizet_k = 0; sizet_k <= sizet_half; sizet_k++)
+        {
+            double dbl_angle = -2.0 * PI * (double)sizet_k / (double)sizet_size;
+            vec_twiddle[sizet_k] = std::complex <T> ((T)std::cos(dbl_angle), (T)std::sin(dbl_angle));
+        }
+    }
+}
+
+template <class T> size_t rfft_plan <T>::size() const
+{
+    return sizet_size;
+}
+
+template <class T> void rfft_plan <T>::forward(const T* ptr_in, std::complex <T>* ptr_out,
+  std::complex <T>* ptr_work) const
+{
+    if (sizet_size % 2 == 1)
+    {
+        for (size_t sizet_n = 0; sizet_n < sizet_size; sizet_n++) ptr_work[sizet_n] = std::complex <T> (ptr_in[sizet_n], 0);
+        plan_complex.forward(ptr_work);
+        for (size_t sizet_k = 0; sizet_k <= sizet_size / 2; sizet_k++) ptr_out[sizet_k] = ptr_work[sizet_k];
+        return;
+    }
+
+    // the even and the odd samples are packed into a half size complex vector
+    size_t sizet_half = sizet_size / 2;
+    for (size_t sizet_n = 0; sizet_n < sizet_half; sizet_n++)
+    {
+        ptr_work[sizet_n] = std::complex <T> (ptr_in[2 * sizet_n], ptr_in[2 * sizet_n + 1]);
+    }
+    plan_complex.forward(ptr_work);
+
+    for (size_t sizet_k = 0; sizet_k <= sizet_half; sizet_k++)
+    {
+        std::complex <T> cplx_z  = ptr_work[sizet_k % sizet_half];
+        std::complex <T> cplx_zc = std::conj(ptr_work[(sizet_half - sizet_k) % sizet_half]);
+        std::complex <T> cplx_e  = (cplx_z + cplx_zc) * T(0.5);
+        std::complex <T> cplx_d  = cplx_z - cplx_zc;
+        std::complex <T> cplx_o  = std::complex <T> (cplx_d.imag() * T(0.5), -cplx_d.real() * T(0.5));
+        ptr_out[sizet_k] = cplx_e + fft_mul(vec_twiddle[sizet_k], cplx_o);
+    }
+}
+
+template <class T> void rfft_plan <T>::inverse(const std::complex <T>* ptr_in, T* ptr_out,
+  std::complex <T>* ptr_work) const
+{
+    if (sizet_size % 2 == 1)
+    {
+        // the Hermitian symmetry completes the spectrum
+        for (size_t sizet_k = 0; sizet_k <= sizet_size / 2; sizet_k++)
+        {
+            ptr_work[sizet_k] = ptr_in[sizet_k];
+            if (sizet_k > 0) ptr_work[sizet_size - sizet_k] = std::conj(ptr_in[sizet_k]);
+        }
+        plan_complex.inverse(ptr_work);
+        for (size_t sizet_n = 0; sizet_n < sizet_size; sizet_n++) ptr_out[sizet_n] = ptr_work[sizet_n].real();
+        return;
+    }
+
+    size_t sizet_half = sizet_size / 2;
+    for (size_t sizet_k = 0; sizet_k < sizet_half; sizet_k++)
+    {
+        std::complex <T> cplx_x  = ptr_in[sizet_k];
+        std::complex <T> cplx_xh = std::conj(ptr_in[sizet_half - sizet_k]);
+        std::complex <T> cplx_e  = (cplx_x + cplx_xh) * T(0.5);
+        std::complex <T> cplx_o  = fft_mul((cplx_x - cplx_xh) * T(0.5), std::conj(vec_twiddle[sizet_k]));
+        ptr_work[sizet_k] = cplx_e + std::complex <T> (-cplx_o.imag(), cplx_o.real());
+    }
+    plan_complex.inverse(ptr_work);
+
+    for (size_t sizet_n = 0; sizet_n < sizet_half; sizet_n++)
+    {
+        ptr_out[2 * sizet_n]     = ptr_work[sizet_n].real();
+        ptr_out[2 * sizet_n + 1] = ptr_work[sizet_n].imag();
+    }
+}
+
+template <class T> matrix <std::complex <T> > rfft_plan <T>::forward(const matrix <T>& mat_arg) const
+{
+    size_t sizet_bins = sizet_size / 2 + 1;
+    matrix <std::complex <T> > mat_ret;
+    size_t sizet_batch;
+
+    if (mat_arg.no_rows() == 1 && mat_arg.size() == sizet_size)
+    {
+        mat_ret = matrix <std::complex <T> > (1, sizet_bins);
+        sizet_batch = 1;
+    }
+    else if (mat_arg.no_rows() == sizet_size)
+    {
+        mat_ret = matrix <std::complex <T> > (sizet_bins, mat_arg.no_cols());
+        sizet_batch = mat_arg.no_cols();
+    }
+    else
+    {
+        SUSA_ASSERT_MESSAGE(false, "the matrix dimensions do not match the FFT size.");
+        return mat_ret;
+    }
+
+    const T* ptr_in = mat_arg.data();
+    std::complex <T>* ptr_out = mat_ret.data();
+
+    size_t sizet_grain = (1 << 16) / sizet_size + 1;
+    parallel_for(0, sizet_batch, sizet_grain, [&](size_t sizet_first, size_t sizet_last)
+    {
+        std::vector <std::complex <T> > vec_work(plan_complex.size());
+        for (size_t sizet_col = sizet_first; sizet_col < sizet_last; sizet_col++)
+        {
+            forward(ptr_in + sizet_col * sizet_size, ptr_out + sizet_col * sizet_bins, vec_work.data());
+        }
+    });
+
+    return mat_ret;
+}
+
+template <class T> matrix <T> rfft_plan <T>::inverse(const matrix <std::complex <T> >& mat_arg) const
+{
+    size_t sizet_bins = sizet_size / 2 + 1;
+    matrix <T> mat_ret;
+    size_t sizet_batch;
+
+    if (mat_arg.no_rows() == 1 && mat_arg.size() == sizet_bins)
+    {
+        mat_ret = matrix <T> (1, sizet_size);
+        sizet_batch = 1;
+    }
+    else if (mat_arg.no_rows() == sizet_bins)
+    {
+        mat_ret = matrix <T> (sizet_size, mat_arg.no_cols());
+        sizet_batch = mat_arg.no_cols();
+    }
+    else
+    {
+        SUSA_ASSERT_MESSAGE(false, "the matrix dimensions do not match the FFT size.");
+        return mat_ret;
+    }
+
+    const std::complex <T>* ptr_in = mat_arg.data();
+    T* ptr_out = mat_ret.data();
+
+    size_t sizet_grain = (1 << 16) / sizet_size + 1;
+    parallel_for(0, sizet_batch, sizet_grain, [&](size_t sizet_first, size_t sizet_last)
+    {
+        std::vector <std::complex <T> > vec_work(plan_complex.size());
+        for (size_t sizet_col = sizet_first; sizet_col < sizet_last; sizet_col++)
+        {
+            inverse(ptr_in + sizet_col * sizet_bins, ptr_out + sizet_col * sizet_size, vec_work.data());
+        }
+    });
+
+    return mat_ret;
+}
+
+// fft
+
+template <class T> std::vector <T> fft<T>::radix2(const std::vector <T>& vec_arg)
+{
+    std::vector <T> vec_ret(vec_arg);
+    if (vec_ret.empty()) return vec_ret;
+
+    fft_plan <typename T::value_type> plan(vec_ret.size());
+    plan.forward(vec_ret.data());
+
+    return vec_ret;
 }
 
 } // NAMESPACE SUSA
@@ -0,0 +1,687 @@
+/*
+ * This file is part of Susa.
+ *
+ * Susa is free software: you can redistribute it and/or modify
+ * it under the terms of the Lesser GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * at your option) any later version.
+ *
+ * Susa is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * Lesser GNU General Public License for more details.
+ *
+ * You should have received a copy of the Lesser GNU General Public License
+ * along with Susa.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file filters.h
+ * @brief Stateful streaming filters (declaration and definition).
+ *
+ * The filters of this file keep their state between the <i>process()</i> calls,
+ * hence a long stream can be filtered block by block with a fixed memory footprint.
+ * They use the coefficient convention of <i>susa::filter()</i>, i.e.
+ * y(n) = b(0)*x(n) + ... + b(nb)*x(n-nb) - a(1)*y(n-1) - ... - a(na)*y(n-na)
+ * where a(0) is assumed to be one.
+ *
+ * @author Behrooz Kamary
+ * @version 1.0.0
+ */
+
+#ifndef SUSA_FILTERS_H
+#define SUSA_FILTERS_H
+
+namespace susa {
+
+/**
+ * @brief FIR kernel
+ *
+ * Computes the samples <i>size_first</i> to <i>size_last - 1</i> of the convolution
+ * y(n) = b(0)*x(n) + ... + b(nb-1)*x(n-nb+1) where x is zero outside its samples.
+ * The output is computed in cache sized blocks, and for each tap the samples with
+ * a complete window are updated in a single multiply-accumulate loop over contiguous
+ * samples without a branch, hence the loop is vectorized by the compiler.
+ *
+ * @param ptr_b the filter coefficients
+ * @param size_b number of coefficients
+ * @param ptr_x the input samples
+ * @param size_x number of input samples
+ * @param ptr_y the output, i.e. y(size_first) ... y(size_last - 1)
+ * @param size_first the first output sample
+ * @param size_last one past the last output sample
+ *
+ * @ingroup Signal
+ */
+template <class T, class TT> SUSA_INLINE_KERNEL void fir_kernel(const TT* ptr_b, size_t size_b, const T* ptr_x, size_t size_x,
+  T* ptr_y, size_t size_first, size_t size_last);
+
+/**
+ * @brief FIR kernel of the real samples
+ *
+ * The variant of <i>fir_kernel()</i> that is selected by <i>cpu_dispatch()</i>.
+ *
+ * @ingroup Signal
+ */
+void fir_kernel(const double* ptr_b, size_t size_b, const double* ptr_x, size_t size_x,
+  double* ptr_y, size_t size_first, size_t size_last);
+
+/**
+ * @brief IIR kernel in the transposed direct form II
+ *
+ * @param ptr_b the MA coefficients (<i>size_order + 1</i>)
+ * @param ptr_a the AR coefficients (<i>size_order + 1</i>), a(0) is not used
+ * @param ptr_state the delay elements (<i>size_order</i>) that are updated
+ * @param size_order the filter order
+ * @param ptr_x the input samples or nullptr for a zero input
+ * @param ptr_y the output samples (may be the input)
+ * @param size_n number of samples
+ *
+ * @ingroup Signal
+ */
+template <class T, class TT> void iir_kernel(const TT* ptr_b, const TT* ptr_a, T* ptr_state, size_t size_order,
+  const T* ptr_x, T* ptr_y, size_t size_n);
+
+/**
+ * @brief The streaming Finite Impulse Response (FIR) filter class.
+ *
+ * The state is the delay line of the past inputs.
+ *
+ * @ingroup Signal
+ */
+template <class T, class TT = T> class fir_filter
+{
+  public:
+    //! Constructor of a pass-through filter
+    fir_filter();
+
+    /**
+     * @brief Constructor
+     *
+     * @param mat_b the filter coefficients (a vector)
+     */
+    explicit fir_filter(const matrix <TT>& mat_b);
+
+    //! Returns the number of coefficients
+    size_t no_taps() const;
+
+    //! Clears the delay line (zero initial conditions)
+    void reset();
+
+    /**
+     * @brief Seeds the delay line
+     *
+     * @param mat_state the past inputs, the most recent first i.e. x(-1), x(-2), ...
+     * up to <i>no_taps() - 1</i> elements, the missing ones are zero.
+     * @return false if the state is longer than the delay line
+     */
+    bool set_state(const matrix <T>& mat_state);
+
+    //! Returns the past inputs, the most recent first
+    matrix <T> get_state() const;
+
+    //! Filters a single sample
+    T process(T T_in);
+
+    /**
+     * @brief Filters a block of contiguous samples
+     *
+     * @param ptr_in the input samples
+     * @param ptr_out the output samples (may be the input)
+     * @param sizet_size number of samples
+     */
+    void process(const T* ptr_in, T* ptr_out, size_t sizet_size);
+
+    /**
+     * @brief Filters a block into a caller-provided output
+     *
+     * The output is only reallocated if its size differs from the input.
+     *
+     * @param mat_in the input vector
+     * @param mat_out the output vector with the shape of the input
+     */
+    void process(const matrix <T>& mat_in, matrix <T>& mat_out);
+
+    //! Filters a block
+    matrix <T> process(const matrix <T>& mat_in);
+
+  private:
+    std::vector <TT>    vec_taps;
+    std::vector <T>     vec_work;       // the past inputs (oldest first) followed by the block
+};
+
+/**
+ * @brief The streaming Infinite Impulse Response (IIR) filter class.
+ *
+ * It is realized in the transposed direct form II.
+ * The state is the content of the max(na, nb) delay elements.
+ *
+ * @ingroup Signal
+ */
+template <class T, class TT = T> class iir_filter
+{
+  public:
+    //! Constructor of a pass-through filter
+    iir_filter();
+
+    /**
+     * @brief Constructor
+     *
+     * @param mat_b Moving Average (MA) coefficients
+     * @param mat_a Autoregressive (AR) coefficients, a(0) is assumed to be one
+     */
+    iir_filter(const matrix <TT>& mat_b, const matrix <TT>& mat_a);
+
+    //! Returns the filter order i.e. the number of delay elements
+    size_t order() const;
+
+    //! Clears the delay elements (zero initial conditions)
+    void reset();
+
+    /**
+     * @brief Seeds the delay elements
+     *
+     * @param mat_state the delay elements, up to <i>order()</i> elements, the missing ones are zero.
+     * @return false if the state is longer than the order
+     */
+    bool set_state(const matrix <T>& mat_state);
+
+    //! Returns the delay elements
+    matrix <T> get_state() const;
+
+    //! Filters a single sample
+    T process(T T_in);
+
+    /**
+     * @brief Filters a block of contiguous samples
+     *
+     * @param ptr_in the input samples
+     * @param ptr_out the output samples (may be the input)
+     * @param sizet_size number of samples
+     */
+    void process(const T* ptr_in, T* ptr_out, size_t sizet_size);
+
+    /**
+     * @brief Filters a block into a caller-provided output
+     *
+     * The output is only reallocated if its size differs from the input.
+     *
+     * @param mat_in the input vector
+     * @param mat_out the output vector with the shape of the input
+     */
+    void process(const matrix <T>& mat_in, matrix <T>& mat_out);
+
+    //! Filters a block
+    matrix <T> process(const matrix <T>& mat_in);
+
+  private:
+    std::vector <TT>    vec_b;
+    std::vector <TT>    vec_a;
+    std::vector <T>     vec_state;
+};
+
+/**
+ * @brief The streaming polyphase rational resampler class.
+ *
+ * It resamples by the rate <i>L/M</i> where <i>h</i> is the prototype filter. From a reset,
+ * <i>N</i> inputs produce <i>ceil(N L / M)</i> outputs, i.e. every <i>M</i>-th sample of
+ * <i>filter(h, 1, upsample(x, L))</i> starting with the first one. These are the samples of
+ * <i>downsample(filter(h, 1, upsample(x, L)), M)</i>, which floors the length, followed by
+ * a last sample when <i>M</i> does not divide <i>N L</i>. The prototype is split into <i>L</i> phases of <i>ceil(nh / L)</i> taps
+ * and only the kept output samples are computed, hence neither the zero-stuffed signal
+ * nor the discarded outputs are ever formed.
+ *
+ * @ingroup Signal
+ */
+template <class T, class TT = double> class polyphase_resampler
+{
+  public:
+    /**
+     * @brief Constructor
+     *
+     * @param uint_up the interpolation factor <i>L</i>
+     * @param uint_down the decimation factor <i>M</i>
+     * @param mat_h the prototype filter at the rate <i>L</i> times the input rate
+     */
+    polyphase_resampler(size_t uint_up, size_t uint_down, const matrix <TT>& mat_h);
+
+    /**
+     * @brief Constructor with a Root-Raised Cosine prototype
+     *
+     * The prototype is <i>RRCosine::get()</i> of <i>uint_span * L + 1</i> taps
+     * for <i>L</i> samples per symbol.
+     *
+     * @param uint_up the interpolation factor <i>L</i>
+     * @param uint_down the decimation factor <i>M</i>
+     * @param dbl_alpha the roll-off factor
+     * @param uint_span the filter span in symbols
+     */
+    polyphase_resampler(size_t uint_up, size_t uint_down, double dbl_alpha = 0.5, size_t uint_span = 8);
+
+    //! Returns the interpolation factor
+    size_t up() const;
+
+    //! Returns the decimation factor
+    size_t down() const;
+
+    //! Returns the number of taps per phase
+    size_t no_taps() const;
+
+    //! Clears the delay line and restarts the output phase
+    void reset();
+
+    //! Returns the number of output samples that <i>sizet_size</i> next inputs produce
+    size_t no_outputs(size_t sizet_size) const;
+
+    /**
+     * @brief Resamples a block of contiguous samples
+     *
+     * @param ptr_in the input samples
+     * @param sizet_size number of input samples
+     * @param ptr_out the output samples, <i>no_outputs(sizet_size)</i> elements
+     * @return number of output samples
+     */
+    size_t process(const T* ptr_in, size_t sizet_size, T* ptr_out);
+
+    //! Resamples a block (a vector), the output has the orientation of the input
+    matrix <T> process(const matrix <T>& mat_in);
+
+  private:
+    size_t              uint_up;
+    size_t              uint_down;
+    size_t              sizet_taps;
+    std::vector <TT>    vec_phases;     // phase p is h(p + (K-1)L), ..., h(p + L), h(p)
+    std::vector <T>     vec_work;       // the past inputs (oldest first) followed by the block
+    size_t              sizet_phase;    // the phase of the next output
+    size_t              sizet_index;    // the input of the next output relative to the block
+
+    void init(const matrix <TT>& mat_h);
+};
+
+// KERNELS
+
+// multiply-accumulate without the IEEE special case handling of std::complex
+template <class T, class TT> SUSA_INLINE_KERNEL T filter_mac(const T& T_acc, const TT& T_b, const T& T_x)
+{
+    return T_acc + T_x * T_b;
+}
+
+template <class T> SUSA_INLINE_KERNEL std::complex <T> filter_mac(const std::complex <T>& T_acc, const std::complex <T>& T_b,
+  const std::complex <T>& T_x)
+{
+    return std::complex <T> (T_acc.real() + T_x.real() * T_b.real() - T_x.imag() * T_b.imag(),
+                             T_acc.imag() + T_x.real() * T_b.imag() + T_x.imag() * T_b.real());
+}
+
+template <class T, class TT> SUSA_INLINE_KERNEL void fir_kernel(const TT* ptr_b, size_t size_b, const T* ptr_x, size_t size_x,
+  T* ptr_y, size_t size_first, size_t size_last)
+{
+    const size_t size_block = 256;
+
+    for (size_t size_begin = size_first; size_begin < size_last; size_begin += size_block)
+    {
+        size_t size_end = std::min(size_begin + size_block, size_last);
+        T*     ptr_out  = ptr_y + (size_begin - size_first);
+
+        for (size_t size_n = 0; size_n < size_end - size_begin; size_n++) ptr_out[size_n] = T(0);
+
+        for (size_t size_k = 0; size_k < size_b; size_k++)
+        {
+            // the outputs of the block for which x(n - k) exists: k <= n < size_x + k
+            size_t size_lo = std::max(size_begin, size_k);
+            size_t size_hi = std::min(size_end, size_x + size_k);
+            if (size_lo >= size_hi) continue;
+
+            const T* ptr_in  = ptr_x + (size_lo - size_k);
+            T*       ptr_acc = ptr_out + (size_lo - size_begin);
+            const TT T_b     = ptr_b[size_k];
+
+            for (size_t size_n = 0; size_n < size_hi - size_lo; size_n++)
+            {
+                ptr_acc[size_n] = filter_mac(ptr_acc[size_n], T_b, ptr_in[size_n]);
+            }
+        }
+    }
+}
+
+template <class T, class TT> void iir_kernel(const TT* ptr_b, const TT* ptr_a, T* ptr_state, size_t size_order,
+  const T* ptr_x, T* ptr_y, size_t size_n)
+{
+    if (size_order == 0)
+    {
+        for (size_t size_i = 0; size_i < size_n; size_i++) ptr_y[size_i] = ptr_x == nullptr ? T(0) : ptr_x[size_i] * ptr_b[0];
+        return;
+    }
+
+    for (size_t size_i = 0; size_i < size_n; size_i++)
+    {
+        T T_x   = ptr_x == nullptr ? T(0) : ptr_x[size_i];
+        T T_out = filter_mac(ptr_state[0], ptr_b[0], T_x);
+
+        for (size_t size_k = 1; size_k < size_order; size_k++)
+        {
+            ptr_state[size_k - 1] = ptr_state[size_k] + T_x * ptr_b[size_k] - T_out * ptr_a[size_k];
+        }
+        ptr_state[size_order - 1] = T_x * ptr_b[size_order] - T_out * ptr_a[size_order];
+
+        ptr_y[size_i] = T_out;
+    }
+}
+
+// FIR
+
+template <class T, class TT> fir_filter <T, TT>::fir_filter()
+: vec_taps(1, TT(1))
+{
+}
+
+template <class T, class TT> fir_filter <T, TT>::fir_filter(const matrix <TT>& mat_b)
+{
+    SUSA_ASSERT_MESSAGE(mat_b.size() > 0, "the filter has no coefficients.");
+
+    if (mat_b.size() == 0)
+    {
+        vec_taps.assign(1, TT(1));
+        return;
+    }
+
+    vec_taps.assign(mat_b.data(), mat_b.data() + mat_b.size());
+    vec_work.assign(vec_taps.size() - 1, T(0));
+}
+
+template <class T, class TT> size_t fir_filter <T, TT>::no_taps() const
+{
+    return vec_taps.size();
+}
+
+template <class T, class TT> void fir_filter <T, TT>::reset()
+{
+    vec_work.assign(vec_taps.size() - 1, T(0));
+}
+
+template <class T, class TT> bool fir_filter <T, TT>::set_state(const matrix <T>& mat_state)
+{
+    size_t sizet_len = vec_taps.size() - 1;
+
+    SUSA_ASSERT_MESSAGE(mat_state.size() <= sizet_len, "the state is longer than the delay line.");
+    if (mat_state.size() > sizet_len) return false;
+
+    reset();
+    for (size_t sizet_k = 0; sizet_k < mat_state.size(); sizet_k++) vec_work[sizet_len - 1 - sizet_k] = mat_state(sizet_k);
+
+    return true;
+}
+
+template <class T, class TT> matrix <T> fir_filter <T, TT>::get_state() const
+{
+    size_t sizet_len = vec_taps.size() - 1;
+    matrix <T> mat_ret;
+    if (sizet_len == 0) return mat_ret;
+
+    mat_ret = matrix <T> (sizet_len, 1);
+    for (size_t sizet_k = 0; sizet_k < sizet_len; sizet_k++) mat_ret(sizet_k) = vec_work[sizet_len - 1 - sizet_k];
+
+    return mat_ret;
+}
+
+template <class T, class TT> T fir_filter <T, TT>::process(T T_in)
+{
+    T T_out;
+    process(&T_in, &T_out, 1);
+    return T_out;
+}
+
+template <class T, class TT> void fir_filter <T, TT>::process(const T* ptr_in, T* ptr_out, size_t sizet_size)
+{
+    SUSA_PROFILE_SCOPE("filters.fir");
+
+    size_t sizet_len = vec_taps.size() - 1;
+
+    // the block is appended to the past inputs so that all the windows are contiguous
+    vec_work.resize(sizet_len + sizet_size);
+    std::copy(ptr_in, ptr_in + sizet_size, vec_work.begin() + sizet_len);
+
+    fir_kernel(vec_taps.data(), vec_taps.size(), vec_work.data(), vec_work.size(), ptr_out, sizet_len, sizet_len + sizet_size);
+
+    // the capacity is kept for the next block
+    std::copy(vec_work.begin() + sizet_size, vec_work.end(), vec_work.begin());
+    vec_work.resize(sizet_len);
+}
+
+template <class T, class TT> void fir_filter <T, TT>::process(const matrix <T>& mat_in, matrix <T>& mat_out)
+{
+    if (mat_out.no_rows() != mat_in.no_rows() || mat_out.no_cols() != mat_in.no_cols())
+    {
+        mat_out = matrix <T> (mat_in.no_rows(), mat_in.no_cols());
+    }
+
+    process(mat_in.data(), mat_out.data(), mat_in.size());
+}
+
+template <class T, class TT> matrix <T> fir_filter <T, TT>::process(const matrix <T>& mat_in)
+{
+    matrix <T> mat_out;
+    process(mat_in, mat_out);
+    return mat_out;
+}
+
+// IIR
+
+template <class T, class TT> iir_filter <T, TT>::iir_filter()
+: vec_b(1, TT(1))
+, vec_a(1, TT(1))
+{
+}
+
+template <class T, class TT> iir_filter <T, TT>::iir_filter(const matrix <TT>& mat_b, const matrix <TT>& mat_a)
+{
+    SUSA_ASSERT_MESSAGE(mat_b.size() > 0, "the filter has no MA coefficients.");
+
+    size_t sizet_len = std::max(std::max(mat_b.size(), mat_a.size()), size_t(1));
+
+    vec_b.assign(sizet_len, TT(0));
+    vec_a.assign(sizet_len, TT(0));
+    for (size_t sizet_k = 0; sizet_k < mat_b.size(); sizet_k++) vec_b[sizet_k] = mat_b(sizet_k);
+    for (size_t sizet_k = 1; sizet_k < mat_a.size(); sizet_k++) vec_a[sizet_k] = mat_a(sizet_k);
+    vec_a[0] = TT(1);
+
+    vec_state.assign(sizet_len - 1, T(0));
+}
+
+template <class T, class TT> size_t iir_filter <T, TT>::order() const
+{
+    return vec_state.size();
+}
+
+template <class T, class TT> void iir_filter <T, TT>::reset()
+{
+    std::fill(vec_state.begin(), vec_state.end(), T(0));
+}
+
+template <class T, class TT> bool iir_filter <T, TT>::set_state(const matrix <T>& mat_state)
+{
+    SUSA_ASSERT_MESSAGE(mat_state.size() <= vec_state.size(), "the state is longer than the filter order.");
+    if (mat_state.size() > vec_state.size()) return false;
+
+    reset();
+    for (size_t sizet_k = 0; sizet_k < mat_state.size(); sizet_k++) vec_state[sizet_k] = mat_state(sizet_k);
+
+    return true;
+}
+
+template <class T, class TT> matrix <T> iir_filter <T, TT>::get_state() const
+{
+    matrix <T> mat_ret;
+    if (vec_state.empty()) return mat_ret;
+
+    mat_ret = matrix <T> (vec_state.size(), 1);
+    for (size_t sizet_k = 0; sizet_k < vec_state.size(); sizet_k++) mat_ret(sizet_k) = vec_state[sizet_k];
+
+    return mat_ret;
+}
+
+template <class T, class TT> T iir_filter <T, TT>::process(T T_in)
+{
+    T T_out;
+    process(&T_in, &T_out, 1);
+    return T_out;
+}
+
+template <class T, class TT> void iir_filter <T, TT>::process(const T* ptr_in, T* ptr_out, size_t sizet_size)
+{
+    SUSA_PROFILE_SCOPE("filters.iir");
+
+    iir_kernel(vec_b.data(), vec_a.data(), vec_state.data(), vec_state.size(), ptr_in, ptr_out, sizet_size);
+}
+
+template <class T, class TT> void iir_filter <T, TT>::process(const matrix <T>& mat_in, matrix <T>& mat_out)
+{
+    if (mat_out.no_rows() != mat_in.no_rows() || mat_out.no_cols() != mat_in.no_cols())
+    {
+        mat_out = matrix <T> (mat_in.no_rows(), mat_in.no_cols());
+    }
+
+    process(mat_in.data(), mat_out.data(), mat_in.size());
+}
+
+template <class T, class TT> matrix <T> iir_filter <T, TT>::process(const matrix <T>& mat_in)
+{
+    matrix <T> mat_out;
+    process(mat_in, mat_out);
+    return mat_out;
+}
+
+// POLYPHASE RESAMPLER
+
+template <class T, class TT> polyphase_resampler <T, TT>::polyphase_resampler(size_t uint_up, size_t uint_down, const matrix <TT>& mat_h)
+: uint_up(uint_up)
+, uint_down(uint_down)
+{
+    init(mat_h);
+}
+
+template <class T, class TT> polyphase_resampler <T, TT>::polyphase_resampler(size_t uint_up, size_t uint_down, double dbl_alpha, size_t uint_span)
+: uint_up(uint_up)
+, uint_down(uint_down)
+{
+    RRCosine rrc(uint_up, 1, dbl_alpha, uint_span * uint_up + 1);
+    matrix <double> mat_rrc = rrc.get();
+
+    matrix <TT> mat_h(mat_rrc.no_rows(), mat_rrc.no_cols());
+    for (size_t sizet_i = 0; sizet_i < mat_rrc.size(); sizet_i++) mat_h(sizet_i) = mat_rrc(sizet_i);
+
+    init(mat_h);
+}
+
+template <class T, class TT> void polyphase_resampler <T, TT>::init(const matrix <TT>& mat_h)
+{
+    SUSA_ASSERT_MESSAGE(uint_up > 0 && uint_down > 0, "the resampling factors must be positive.");
+    SUSA_ASSERT_MESSAGE(mat_h.size() > 0, "the prototype filter has no coefficients.");
+
+    if (uint_up == 0) uint_up = 1;
+    if (uint_down == 0) uint_down = 1;
+
+    // the prototype is zero padded to K * L taps
+    sizet_taps = mat_h.size() == 0 ? 1 : (mat_h.size() + uint_up - 1) / uint_up;
+    vec_phases.assign(uint_up * sizet_taps, TT(0));
+
+    for (size_t sizet_p = 0; sizet_p < uint_up; sizet_p++)
+    {
+        TT* ptr_phase = vec_phases.data() + sizet_p * sizet_taps;
+        for (size_t sizet_k = 0; sizet_k < sizet_taps; sizet_k++)
+        {
+            size_t sizet_i = sizet_p + sizet_k * uint_up;
+            if (sizet_i < mat_h.size()) ptr_phase[sizet_taps - 1 - sizet_k] = mat_h(sizet_i);
+        }
+    }
+    if (mat_h.size() == 0) vec_phases.assign(uint_up, TT(1));
+
+    reset();
+}
+
+template <class T, class TT> size_t polyphase_resampler <T, TT>::up() const
+{
+    return uint_up;
+}
+
+template <class T, class TT> size_t polyphase_resampler <T, TT>::down() const
+{
+    return uint_down;
+}
+
+template <class T, class TT> size_t polyphase_resampler <T, TT>::no_taps() const
+{
+    return sizet_taps;
+}
+
+template <class T, class TT> void polyphase_resampler <T, TT>::reset()
+{
+    vec_work.assign(sizet_taps - 1, T(0));
+    sizet_phase = 0;
+    sizet_index = 0;
+}
+
+template <class T, class TT> size_t polyphase_resampler <T, TT>::no_outputs(size_t sizet_size) const
+{
+    // the outputs at the rate L with the index n in [sizet_index * L + sizet_phase, sizet_size * L)
+    size_t sizet_first = sizet_index * uint_up + sizet_phase;
+    size_t sizet_last  = sizet_size * uint_up;
+    return sizet_first < sizet_last ? (sizet_last - sizet_first + uint_down - 1) / uint_down : 0;
+}
+
+template <class T, class TT> size_t polyphase_resampler <T, TT>::process(const T* ptr_in, size_t sizet_size, T* ptr_out)
+{
+    SUSA_PROFILE_SCOPE("filters.resampler");
+
+    size_t sizet_len = sizet_taps - 1;
+
+    vec_work.resize(sizet_len + sizet_size);
+    std::copy(ptr_in, ptr_in + sizet_size, vec_work.begin() + sizet_len);
+
+    const T* ptr_work = vec_work.data();
+    size_t   sizet_no = 0;
+
+    // the window of the input i is x(i - K + 1) ... x(i), i.e. the work buffer at i
+    while (sizet_index < sizet_size)
+    {
+        const TT* ptr_phase = vec_phases.data() + sizet_phase * sizet_taps;
+        const T*  ptr_win   = ptr_work + sizet_index;
+
+        T T_acc = T(0);
+        for (size_t sizet_k = 0; sizet_k < sizet_taps; sizet_k++) T_acc = filter_mac(T_acc, ptr_phase[sizet_k], ptr_win[sizet_k]);
+        ptr_out[sizet_no++] = T_acc;
+
+        sizet_phase += uint_down;
+        sizet_index += sizet_phase / uint_up;
+        sizet_phase %= uint_up;
+    }
+    sizet_index -= sizet_size;
+
+    std::copy(vec_work.begin() + sizet_size, vec_work.end(), vec_work.begin());
+    vec_work.resize(sizet_len);
+
+    return sizet_no;
+}
+
+template <class T, class TT> matrix <T> polyphase_resampler <T, TT>::process(const matrix <T>& mat_in)
+{
+    SUSA_ASSERT_MESSAGE(mat_in.no_rows() == 1 || mat_in.no_cols() == 1, "the input must be a vector.");
+
+    size_t sizet_no = no_outputs(mat_in.size());
+    matrix <T> mat_out;
+    if (sizet_no == 0)
+    {
+        process(mat_in.data(), mat_in.size(), nullptr);
+        return mat_out;
+    }
+
+    if (mat_in.no_rows() == 1 && mat_in.no_cols() > 1) mat_out = matrix <T> (1, sizet_no);
+    else mat_out = matrix <T> (sizet_no, 1);
+
+    process(mat_in.data(), mat_in.size(), mat_out.data());
+
+    return mat_out;
+}
+
+} // NAMESPACE SUSA
+#endif // SUSA_FILTERS_H
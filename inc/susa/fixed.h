@@ -0,0 +1,440 @@
+/*
+ * This file is part of Susa.
+ *
+ * Susa is free software: you can redistribute it and/or modify
+ * it under the terms of the Lesser GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * at your option) any later version.
+ *
+ * Susa is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * Lesser GNU General Public License for more details.
+ *
+ * You should have received a copy of the Lesser GNU General Public License
+ * along with Susa.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file fixed.h
+ * @brief Fixed-size small matrix (declaration and definition).
+ *
+ * The elements are stored in the object in the column-major order and the
+ * dimensions are compile-time constants, hence a <i>fixed_matrix</i> lives on
+ * the stack and its loops are unrolled by the compiler. It suits the tiny
+ * matrices of the inner loops e.g. the MIMO channels of a subcarrier.
+ *
+ * @author Behrooz Kamary
+ * @version 1.0.0
+ */
+
+#ifndef SUSA_FIXED_H
+#define SUSA_FIXED_H
+
+namespace susa {
+
+/**
+ * @brief The <i>fixed_matrix</i> class.
+ *
+ * The arithmetic operators are element-wise as the ones of <i>matrix</i>,
+ * <i>matmul()</i> is the matrix product.
+ *
+ * @ingroup TYPES
+ */
+template <class T, size_t R, size_t C> class fixed_matrix
+{
+    static_assert(R > 0 && C > 0, "the dimensions of a fixed matrix shall be positive.");
+
+  public:
+    //! Constructor of a zero matrix
+    fixed_matrix()
+    {
+        for (size_t sizet_i = 0; sizet_i < R * C; sizet_i++) T_data[sizet_i] = T(0);
+    }
+
+    //! Constructor of a matrix with all the elements equal to the value
+    explicit fixed_matrix(T T_init)
+    {
+        for (size_t sizet_i = 0; sizet_i < R * C; sizet_i++) T_data[sizet_i] = T_init;
+    }
+
+    /**
+     * @brief Constructor from the elements in the reading order
+     *
+     * The elements are given row by row as in the string constructor of
+     * <i>matrix</i>, e.g. {1, 2, 3, 4} is [1 2; 3 4]. The missing elements are zero.
+     */
+    fixed_matrix(std::initializer_list <T> list_arg)
+    {
+        SUSA_ASSERT_MESSAGE(list_arg.size() <= R * C, "too many elements for the fixed matrix.");
+
+        typename std::initializer_list <T>::const_iterator it = list_arg.begin();
+        for (size_t sizet_i = 0; sizet_i < R * C; sizet_i++)
+        {
+            T& T_el = T_data[(sizet_i % C) * R + sizet_i / C];
+            T_el = it != list_arg.end() ? *it++ : T(0);
+        }
+    }
+
+    /**
+     * @brief Constructor from a matrix of the same dimensions
+     *
+     * A matrix of other dimensions gives a zero matrix.
+     */
+    explicit fixed_matrix(const matrix <T>& mat_arg)
+    {
+        bool bool_match = mat_arg.no_rows() == R && mat_arg.no_cols() == C;
+        SUSA_ASSERT_MESSAGE(bool_match, "the matrix dimensions do not match the fixed matrix.");
+
+        for (size_t sizet_i = 0; sizet_i < R * C; sizet_i++) T_data[sizet_i] = bool_match ? mat_arg.data()[sizet_i] : T(0);
+    }
+
+    //! Converts to a matrix
+    explicit operator matrix <T>() const
+    {
+        matrix <T> mat_ret(R, C);
+        for (size_t sizet_i = 0; sizet_i < R * C; sizet_i++) mat_ret.data()[sizet_i] = T_data[sizet_i];
+        return mat_ret;
+    }
+
+    //! Returns the number of rows
+    static constexpr size_t no_rows()
+    {
+        return R;
+    }
+
+    //! Returns the number of columns
+    static constexpr size_t no_cols()
+    {
+        return C;
+    }
+
+    //! Returns the number of elements
+    static constexpr size_t size()
+    {
+        return R * C;
+    }
+
+    //! Returns the element at the row and the column
+    T& operator()(size_t sizet_row, size_t sizet_col)
+    {
+        SUSA_ASSERT_MESSAGE(sizet_row < R && sizet_col < C, "one or more indices is/are out of range.");
+        return T_data[sizet_col * R + sizet_row];
+    }
+
+    //! Returns the element at the row and the column
+    const T& operator()(size_t sizet_row, size_t sizet_col) const
+    {
+        SUSA_ASSERT_MESSAGE(sizet_row < R && sizet_col < C, "one or more indices is/are out of range.");
+        return T_data[sizet_col * R + sizet_row];
+    }
+
+    //! Returns the element at the linear (column-major) index
+    T& operator()(size_t sizet_elem)
+    {
+        SUSA_ASSERT_MESSAGE(sizet_elem < R * C, "the index is out of range.");
+        return T_data[sizet_elem];
+    }
+
+    //! Returns the element at the linear (column-major) index
+    const T& operator()(size_t sizet_elem) const
+    {
+        SUSA_ASSERT_MESSAGE(sizet_elem < R * C, "the index is out of range.");
+        return T_data[sizet_elem];
+    }
+
+    //! Returns the storage
+    T* data()
+    {
+        return T_data;
+    }
+
+    //! Returns the storage
+    const T* data() const
+    {
+        return T_data;
+    }
+
+    fixed_matrix& operator+=(const fixed_matrix& mat_arg)
+    {
+        for (size_t sizet_i = 0; sizet_i < R * C; sizet_i++) T_data[sizet_i] += mat_arg.T_data[sizet_i];
+        return *this;
+    }
+
+    fixed_matrix& operator-=(const fixed_matrix& mat_arg)
+    {
+        for (size_t sizet_i = 0; sizet_i < R * C; sizet_i++) T_data[sizet_i] -= mat_arg.T_data[sizet_i];
+        return *this;
+    }
+
+    fixed_matrix& operator*=(const fixed_matrix& mat_arg)
+    {
+        for (size_t sizet_i = 0; sizet_i < R * C; sizet_i++) T_data[sizet_i] *= mat_arg.T_data[sizet_i];
+        return *this;
+    }
+
+    fixed_matrix& operator+=(T T_arg)
+    {
+        for (size_t sizet_i = 0; sizet_i < R * C; sizet_i++) T_data[sizet_i] += T_arg;
+        return *this;
+    }
+
+    fixed_matrix& operator-=(T T_arg)
+    {
+        for (size_t sizet_i = 0; sizet_i < R * C; sizet_i++) T_data[sizet_i] -= T_arg;
+        return *this;
+    }
+
+    fixed_matrix& operator*=(T T_arg)
+    {
+        for (size_t sizet_i = 0; sizet_i < R * C; sizet_i++) T_data[sizet_i] *= T_arg;
+        return *this;
+    }
+
+    fixed_matrix& operator/=(T T_arg)
+    {
+        for (size_t sizet_i = 0; sizet_i < R * C; sizet_i++) T_data[sizet_i] /= T_arg;
+        return *this;
+    }
+
+    bool operator==(const fixed_matrix& mat_arg) const
+    {
+        for (size_t sizet_i = 0; sizet_i < R * C; sizet_i++)
+        {
+            if (!(T_data[sizet_i] == mat_arg.T_data[sizet_i])) return false;
+        }
+        return true;
+    }
+
+    bool operator!=(const fixed_matrix& mat_arg) const
+    {
+        return !(*this == mat_arg);
+    }
+
+  private:
+    T T_data[R * C];
+};
+
+//! A fixed-size column vector
+template <class T, size_t N> using fixed_vector = fixed_matrix <T, N, 1>;
+
+template <class T, size_t R, size_t C> fixed_matrix <T, R, C> operator+(fixed_matrix <T, R, C> mat_argl, const fixed_matrix <T, R, C>& mat_argr)
+{
+    return mat_argl += mat_argr;
+}
+
+template <class T, size_t R, size_t C> fixed_matrix <T, R, C> operator-(fixed_matrix <T, R, C> mat_argl, const fixed_matrix <T, R, C>& mat_argr)
+{
+    return mat_argl -= mat_argr;
+}
+
+template <class T, size_t R, size_t C> fixed_matrix <T, R, C> operator*(fixed_matrix <T, R, C> mat_argl, const fixed_matrix <T, R, C>& mat_argr)
+{
+    return mat_argl *= mat_argr;
+}
+
+template <class T, size_t R, size_t C> fixed_matrix <T, R, C> operator*(fixed_matrix <T, R, C> mat_arg, T T_arg)
+{
+    return mat_arg *= T_arg;
+}
+
+template <class T, size_t R, size_t C> fixed_matrix <T, R, C> operator*(T T_arg, fixed_matrix <T, R, C> mat_arg)
+{
+    return mat_arg *= T_arg;
+}
+
+template <class T, size_t R, size_t C> fixed_matrix <T, R, C> operator/(fixed_matrix <T, R, C> mat_arg, T T_arg)
+{
+    return mat_arg /= T_arg;
+}
+
+template <class T, size_t R, size_t C> std::ostream& operator<<(std::ostream& outStream, const fixed_matrix <T, R, C>& mat_arg)
+{
+    for (size_t sizet_row = 0; sizet_row < R; sizet_row++)
+    {
+        for (size_t sizet_col = 0; sizet_col < C; sizet_col++) outStream << mat_arg(sizet_row, sizet_col) << " ";
+        outStream << std::endl;
+    }
+    return outStream;
+}
+
+/**
+ * @brief The product of fixed matrices
+ *
+ * @ingroup LALG
+ */
+template <class T, size_t R, size_t K, size_t C> fixed_matrix <T, R, C> matmul(const fixed_matrix <T, R, K>& mat_argl,
+  const fixed_matrix <T, K, C>& mat_argr)
+{
+    fixed_matrix <T, R, C> mat_ret;
+
+    for (size_t sizet_col = 0; sizet_col < C; sizet_col++)
+    {
+        for (size_t sizet_k = 0; sizet_k < K; sizet_k++)
+        {
+            const T T_b = mat_argr(sizet_k, sizet_col);
+            for (size_t sizet_row = 0; sizet_row < R; sizet_row++) mat_ret(sizet_row, sizet_col) += mat_argl(sizet_row, sizet_k) * T_b;
+        }
+    }
+
+    return mat_ret;
+}
+
+/**
+ * @brief Transpose of a fixed matrix
+ *
+ * @ingroup LALG
+ */
+template <class T, size_t R, size_t C> fixed_matrix <T, C, R> transpose(const fixed_matrix <T, R, C>& mat_arg)
+{
+    fixed_matrix <T, C, R> mat_ret;
+    transpose_tiled <false> (R, C, mat_arg.data(), mat_ret.data());
+    return mat_ret;
+}
+
+/**
+ * @brief Conjugate transpose of a fixed matrix
+ *
+ * @ingroup LALG
+ */
+template <class T, size_t R, size_t C> fixed_matrix <T, C, R> ctranspose(const fixed_matrix <T, R, C>& mat_arg)
+{
+    fixed_matrix <T, C, R> mat_ret;
+    transpose_tiled <true> (R, C, mat_arg.data(), mat_ret.data());
+    return mat_ret;
+}
+
+// the closed-form determinants
+template <class T> inline T fixed_det2(T a, T b, T c, T d)
+{
+    return a * d - b * c;
+}
+
+template <class T> inline T fixed_det3(const T* p, size_t r0, size_t r1, size_t r2, size_t c0, size_t c1, size_t c2, size_t n)
+{
+    return p[c0 * n + r0] * fixed_det2(p[c1 * n + r1], p[c2 * n + r1], p[c1 * n + r2], p[c2 * n + r2])
+         - p[c1 * n + r0] * fixed_det2(p[c0 * n + r1], p[c2 * n + r1], p[c0 * n + r2], p[c2 * n + r2])
+         + p[c2 * n + r0] * fixed_det2(p[c0 * n + r1], p[c1 * n + r1], p[c0 * n + r2], p[c1 * n + r2]);
+}
+
+template <class T> inline T fixed_det(const fixed_matrix <T, 1, 1>& mat_arg)
+{
+    return mat_arg(0);
+}
+
+template <class T> inline T fixed_det(const fixed_matrix <T, 2, 2>& mat_arg)
+{
+    return fixed_det2(mat_arg(0, 0), mat_arg(0, 1), mat_arg(1, 0), mat_arg(1, 1));
+}
+
+template <class T> inline T fixed_det(const fixed_matrix <T, 3, 3>& mat_arg)
+{
+    return fixed_det3(mat_arg.data(), 0, 1, 2, 0, 1, 2, 3);
+}
+
+template <class T> inline T fixed_det(const fixed_matrix <T, 4, 4>& mat_arg)
+{
+    // Laplace expansion along the first row with the 2x2 minors of the last two rows
+    const T* p = mat_arg.data();
+    T s0 = fixed_det2(p[2], p[6], p[3], p[7]);
+    T s1 = fixed_det2(p[2], p[10], p[3], p[11]);
+    T s2 = fixed_det2(p[2], p[14], p[3], p[15]);
+    T s3 = fixed_det2(p[6], p[10], p[7], p[11]);
+    T s4 = fixed_det2(p[6], p[14], p[7], p[15]);
+    T s5 = fixed_det2(p[10], p[14], p[11], p[15]);
+
+    return p[0]  * (p[5] * s5 - p[9] * s4 + p[13] * s3)
+         - p[4]  * (p[1] * s5 - p[9] * s2 + p[13] * s1)
+         + p[8]  * (p[1] * s4 - p[5] * s2 + p[13] * s0)
+         - p[12] * (p[1] * s3 - p[5] * s1 + p[9] * s0);
+}
+
+/**
+ * @brief Determinant of a fixed square matrix (up to 4x4) in the closed form
+ *
+ * @ingroup LALG
+ */
+template <class T, size_t N> T det(const fixed_matrix <T, N, N>& mat_arg)
+{
+    static_assert(N <= 4, "the closed-form determinant is for up to 4x4 matrices.");
+    return fixed_det(mat_arg);
+}
+
+// the closed-form adjugates, i.e. the transposed cofactors
+template <class T> inline fixed_matrix <T, 1, 1> fixed_adjugate(const fixed_matrix <T, 1, 1>&)
+{
+    return fixed_matrix <T, 1, 1> (T(1));
+}
+
+template <class T> inline fixed_matrix <T, 2, 2> fixed_adjugate(const fixed_matrix <T, 2, 2>& mat_arg)
+{
+    return fixed_matrix <T, 2, 2> {mat_arg(1, 1), -mat_arg(0, 1), -mat_arg(1, 0), mat_arg(0, 0)};
+}
+
+// the minor of a 3x3 or a 4x4 matrix without a row and a column
+template <class T> inline T fixed_minor(const T* p, const size_t* sizet_r, const size_t* sizet_c, std::integral_constant <size_t, 3>)
+{
+    return fixed_det2(p[sizet_c[0] * 3 + sizet_r[0]], p[sizet_c[1] * 3 + sizet_r[0]], p[sizet_c[0] * 3 + sizet_r[1]], p[sizet_c[1] * 3 + sizet_r[1]]);
+}
+
+template <class T> inline T fixed_minor(const T* p, const size_t* sizet_r, const size_t* sizet_c, std::integral_constant <size_t, 4>)
+{
+    return fixed_det3(p, sizet_r[0], sizet_r[1], sizet_r[2], sizet_c[0], sizet_c[1], sizet_c[2], 4);
+}
+
+template <class T, size_t N> inline fixed_matrix <T, N, N> fixed_adjugate(const fixed_matrix <T, N, N>& mat_arg)
+{
+    static_assert(N == 3 || N == 4, "the closed-form adjugate is for up to 4x4 matrices.");
+
+    // the cofactor (i, j) is the signed minor without the row i and the column j
+    fixed_matrix <T, N, N> mat_ret;
+    for (size_t sizet_i = 0; sizet_i < N; sizet_i++)
+    {
+        for (size_t sizet_j = 0; sizet_j < N; sizet_j++)
+        {
+            size_t sizet_r[N - 1], sizet_c[N - 1];
+            for (size_t sizet_k = 0, sizet_m = 0; sizet_k < N; sizet_k++) if (sizet_k != sizet_i) sizet_r[sizet_m++] = sizet_k;
+            for (size_t sizet_k = 0, sizet_m = 0; sizet_k < N; sizet_k++) if (sizet_k != sizet_j) sizet_c[sizet_m++] = sizet_k;
+
+            T T_minor = fixed_minor(mat_arg.data(), sizet_r, sizet_c, std::integral_constant <size_t, N> ());
+            mat_ret(sizet_j, sizet_i) = (sizet_i + sizet_j) % 2 ? -T_minor : T_minor;
+        }
+    }
+
+    return mat_ret;
+}
+
+/**
+ * @brief Inverse of a fixed square matrix (up to 4x4) in the closed form
+ *
+ * The inverse is the adjugate over the determinant.
+ *
+ * @param mat_arg the input square matrix
+ * @return the inverse or a zero matrix if the input is singular
+ * @ingroup LALG
+ */
+template <class T, size_t N> fixed_matrix <T, N, N> inv(const fixed_matrix <T, N, N>& mat_arg)
+{
+    T T_det = det(mat_arg);
+    SUSA_ASSERT_MESSAGE(T_det != T(0), "the matrix is singular.");
+    if (T_det == T(0)) return fixed_matrix <T, N, N> ();
+
+    return fixed_adjugate(mat_arg) * (T(1) / T_det);
+}
+
+/**
+ * @brief Solves the linear system A X = B of a fixed square matrix (up to 4x4)
+ *
+ * @param mat_a the square matrix
+ * @param mat_b the right hand sides
+ * @return the solution or a zero matrix if A is singular
+ * @ingroup LALG
+ */
+template <class T, size_t N, size_t K> fixed_matrix <T, N, K> linsolve(const fixed_matrix <T, N, N>& mat_a,
+  const fixed_matrix <T, N, K>& mat_b)
+{
+    return matmul(inv(mat_a), mat_b);
+}
+
+}      // NAMESPACE SUSA
+#endif // SUSA_FIXED_H
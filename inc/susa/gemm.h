@@ -0,0 +1,343 @@
+/*
+ * This file is part of Susa.
+ *
+ * Susa is free software: you can redistribute it and/or modify
+ * it under the terms of the Lesser GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * at your option) any later version.
+ *
+ * Susa is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * Lesser GNU General Public License for more details.
+ *
+ * You should have received a copy of the Lesser GNU General Public License
+ * along with Susa.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file gemm.h
+ * @brief General matrix multiplication kernel (declaration and definition).
+ *
+ * The kernel follows the well known layered approach: the right-hand-side
+ * is packed in (KC x NC) blocks that live in the last level cache, the
+ * left-hand-side is packed in (MC x KC) blocks that live in L2 and a
+ * register tiled (MR x NR) micro-kernel runs over the L1 resident panels.
+ * The (MC x KC) blocks are distributed over the threads of the Susa pool.
+ * All operands are column-major with leading dimensions.
+ *
+ * @author Behrooz Kamary
+ * @version 1.0.0
+ */
+
+#ifndef SUSA_GEMM_H
+#define SUSA_GEMM_H
+
+#include <complex>
+#include <vector>
+#include <susa/thread.h>
+
+namespace susa
+{
+
+/**
+ * @brief Tile and block sizes of the GEMM kernel.
+ *
+ * MR x NR is the register tile of the micro-kernel, KC x NR (right)
+ * and MR x KC (left) panels should fit in L1, MC x KC in L2 and
+ * KC x NC in the last level cache.
+ *
+ * @ingroup LALG
+ */
+template <class T> struct gemm_traits
+{
+    static const size_t MR = 4;
+    static const size_t NR = 4;
+    static const size_t KC = 256;
+    static const size_t MC = 64;
+    static const size_t NC = 2048;
+};
+
+template <> struct gemm_traits <float>
+{
+    static const size_t MR = 16;
+    static const size_t NR = 4;
+    static const size_t KC = 384;
+    static const size_t MC = 128;
+    static const size_t NC = 4096;
+};
+
+template <> struct gemm_traits <double>
+{
+    static const size_t MR = 8;
+    static const size_t NR = 4;
+    static const size_t KC = 256;
+    static const size_t MC = 96;
+    static const size_t NC = 2048;
+};
+
+template <> struct gemm_traits <std::complex <double> >
+{
+    static const size_t MR = 4;
+    static const size_t NR = 2;
+    static const size_t KC = 128;
+    static const size_t MC = 64;
+    static const size_t NC = 1024;
+};
+
+/**
+ * @brief The GEMM micro-kernel.
+ *
+ * It accumulates the product of a packed (MR x kc) panel and
+ * a packed (kc x NR) panel into the (MR x NR) column-major tile.
+ *
+ * @ingroup LALG
+ */
+template <class T> struct gemm_kernel
+{
+    static void run(size_t sizet_kc, const T* ptr_a, const T* ptr_b, T* ptr_acc)
+    {
+        const size_t sizet_mr = gemm_traits <T>::MR;
+        const size_t sizet_nr = gemm_traits <T>::NR;
+
+        for (size_t sizet_p = 0; sizet_p < sizet_kc; sizet_p++)
+        {
+            for (size_t sizet_j = 0; sizet_j < sizet_nr; sizet_j++)
+            {
+                T T_b = ptr_b[sizet_j];
+                for (size_t sizet_i = 0; sizet_i < sizet_mr; sizet_i++)
+                {
+                    ptr_acc[sizet_i + sizet_j * sizet_mr] += ptr_a[sizet_i] * T_b;
+                }
+            }
+            ptr_a += sizet_mr;
+            ptr_b += sizet_nr;
+        }
+    }
+};
+
+// The complex product is expanded by hand on the real and the imaginary
+// parts. This avoids the NaN recovery of the built-in complex product
+// and keeps the accumulation in plain real arithmetic.
+template <class T> struct gemm_kernel <std::complex <T> >
+{
+    static void run(size_t sizet_kc, const std::complex <T>* ptr_a, const std::complex <T>* ptr_b, std::complex <T>* ptr_acc)
+    {
+        const size_t sizet_mr = gemm_traits <std::complex <T> >::MR;
+        const size_t sizet_nr = gemm_traits <std::complex <T> >::NR;
+
+        T T_re[sizet_mr * sizet_nr];
+        T T_im[sizet_mr * sizet_nr];
+
+        for (size_t sizet_i = 0; sizet_i < sizet_mr * sizet_nr; sizet_i++)
+        {
+            T_re[sizet_i] = ptr_acc[sizet_i].real();
+            T_im[sizet_i] = ptr_acc[sizet_i].imag();
+        }
+
+        const T* ptr_ra = reinterpret_cast <const T*> (ptr_a);
+        const T* ptr_rb = reinterpret_cast <const T*> (ptr_b);
+
+        for (size_t sizet_p = 0; sizet_p < sizet_kc; sizet_p++)
+        {
+            for (size_t sizet_j = 0; sizet_j < sizet_nr; sizet_j++)
+            {
+                T T_br = ptr_rb[2 * sizet_j];
+                T T_bi = ptr_rb[2 * sizet_j + 1];
+                for (size_t sizet_i = 0; sizet_i < sizet_mr; sizet_i++)
+                {
+                    T T_ar = ptr_ra[2 * sizet_i];
+                    T T_ai = ptr_ra[2 * sizet_i + 1];
+                    T_re[sizet_i + sizet_j * sizet_mr] += T_ar * T_br - T_ai * T_bi;
+                    T_im[sizet_i + sizet_j * sizet_mr] += T_ar * T_bi + T_ai * T_br;
+                }
+            }
+            ptr_ra += 2 * sizet_mr;
+            ptr_rb += 2 * sizet_nr;
+        }
+
+        for (size_t sizet_i = 0; sizet_i < sizet_mr * sizet_nr; sizet_i++)
+        {
+            ptr_acc[sizet_i] = std::complex <T> (T_re[sizet_i], T_im[sizet_i]);
+        }
+    }
+};
+
+// packs the (mc x kc) block of the left-hand-side into MR row panels
+template <class T> void gemm_pack_a(size_t sizet_mc, size_t sizet_kc, const T* ptr_a, size_t sizet_lda, T* ptr_pack)
+{
+    const size_t sizet_mr = gemm_traits <T>::MR;
+
+    for (size_t sizet_ir = 0; sizet_ir < sizet_mc; sizet_ir += sizet_mr)
+    {
+        size_t sizet_rows = sizet_mc - sizet_ir < sizet_mr ? sizet_mc - sizet_ir : sizet_mr;
+        for (size_t sizet_p = 0; sizet_p < sizet_kc; sizet_p++)
+        {
+            const T* ptr_col = ptr_a + sizet_ir + sizet_p * sizet_lda;
+            size_t sizet_i = 0;
+            for (; sizet_i < sizet_rows; sizet_i++) *ptr_pack++ = ptr_col[sizet_i];
+            for (; sizet_i < sizet_mr; sizet_i++) *ptr_pack++ = T(0);
+        }
+    }
+}
+
+// packs the (kc x nc) block of the right-hand-side into NR column panels
+template <class T> void gemm_pack_b(size_t sizet_kc, size_t sizet_nc, const T* ptr_b, size_t sizet_ldb, T* ptr_pack)
+{
+    const size_t sizet_nr = gemm_traits <T>::NR;
+
+    for (size_t sizet_jr = 0; sizet_jr < sizet_nc; sizet_jr += sizet_nr)
+    {
+        size_t sizet_cols = sizet_nc - sizet_jr < sizet_nr ? sizet_nc - sizet_jr : sizet_nr;
+        for (size_t sizet_p = 0; sizet_p < sizet_kc; sizet_p++)
+        {
+            size_t sizet_j = 0;
+            for (; sizet_j < sizet_cols; sizet_j++) *ptr_pack++ = ptr_b[sizet_p + (sizet_jr + sizet_j) * sizet_ldb];
+            for (; sizet_j < sizet_nr; sizet_j++) *ptr_pack++ = T(0);
+        }
+    }
+}
+
+// runs the macro-kernel over a packed (mc x kc) and a packed (kc x nc) block
+template <class T> void gemm_macro(size_t sizet_mc, size_t sizet_nc, size_t sizet_kc, T T_alpha,
+    const T* ptr_apack, const T* ptr_bpack, T T_beta, T* ptr_c, size_t sizet_ldc)
+{
+    const size_t sizet_mr = gemm_traits <T>::MR;
+    const size_t sizet_nr = gemm_traits <T>::NR;
+
+    T T_acc[sizet_mr * sizet_nr];
+
+    for (size_t sizet_jr = 0; sizet_jr < sizet_nc; sizet_jr += sizet_nr)
+    {
+        size_t sizet_cols = sizet_nc - sizet_jr < sizet_nr ? sizet_nc - sizet_jr : sizet_nr;
+
+        for (size_t sizet_ir = 0; sizet_ir < sizet_mc; sizet_ir += sizet_mr)
+        {
+            size_t sizet_rows = sizet_mc - sizet_ir < sizet_mr ? sizet_mc - sizet_ir : sizet_mr;
+
+            for (size_t sizet_i = 0; sizet_i < sizet_mr * sizet_nr; sizet_i++) T_acc[sizet_i] = T(0);
+
+            gemm_kernel <T>::run(sizet_kc, ptr_apack + sizet_ir * sizet_kc, ptr_bpack + sizet_jr * sizet_kc, T_acc);
+
+            T* ptr_tile = ptr_c + sizet_ir + sizet_jr * sizet_ldc;
+            for (size_t sizet_j = 0; sizet_j < sizet_cols; sizet_j++)
+            {
+                for (size_t sizet_i = 0; sizet_i < sizet_rows; sizet_i++)
+                {
+                    T& T_c = ptr_tile[sizet_i + sizet_j * sizet_ldc];
+                    // beta equal to zero overwrites uninitialized outputs
+                    T_c = T_beta == T(0) ? T_alpha * T_acc[sizet_i + sizet_j * sizet_mr]
+                                         : T_alpha * T_acc[sizet_i + sizet_j * sizet_mr] + T_beta * T_c;
+                }
+            }
+        }
+    }
+}
+
+/**
+ * @brief General matrix multiplication
+ *
+ * Computes C = alpha * A * B + beta * C where A is (m x k), B is (k x n)
+ * and C is (m x n), all of them column-major. When beta is zero C is not
+ * read, hence it may be uninitialized.
+ *
+ * @param sizet_m number of rows of A and C
+ * @param sizet_n number of columns of B and C
+ * @param sizet_k number of columns of A and rows of B
+ * @param T_alpha the scale of the product
+ * @param ptr_a the left-hand-side
+ * @param sizet_lda the leading dimension of A
+ * @param ptr_b the right-hand-side
+ * @param sizet_ldb the leading dimension of B
+ * @param T_beta the scale of C
+ * @param ptr_c the output
+ * @param sizet_ldc the leading dimension of C
+ * @ingroup LALG
+ */
+template <class T> void gemm(size_t sizet_m, size_t sizet_n, size_t sizet_k,
+    T T_alpha, const T* ptr_a, size_t sizet_lda, const T* ptr_b, size_t sizet_ldb,
+    T T_beta, T* ptr_c, size_t sizet_ldc)
+{
+    SUSA_PROFILE_SCOPE("gemm");
+
+    if (sizet_m == 0 || sizet_n == 0) return;
+
+    // small products do not pay off the packing
+    if (sizet_k == 0 || sizet_m * sizet_n * sizet_k <= 32768)
+    {
+        for (size_t sizet_j = 0; sizet_j < sizet_n; sizet_j++)
+        {
+            T* ptr_col = ptr_c + sizet_j * sizet_ldc;
+            for (size_t sizet_i = 0; sizet_i < sizet_m; sizet_i++)
+            {
+                ptr_col[sizet_i] = T_beta == T(0) ? T(0) : T_beta * ptr_col[sizet_i];
+            }
+
+            for (size_t sizet_p = 0; sizet_p < sizet_k; sizet_p++)
+            {
+                T T_b = T_alpha * ptr_b[sizet_p + sizet_j * sizet_ldb];
+                const T* ptr_acol = ptr_a + sizet_p * sizet_lda;
+                for (size_t sizet_i = 0; sizet_i < sizet_m; sizet_i++)
+                {
+                    ptr_col[sizet_i] += ptr_acol[sizet_i] * T_b;
+                }
+            }
+        }
+        return;
+    }
+
+    const size_t sizet_mr = gemm_traits <T>::MR;
+    const size_t sizet_nr = gemm_traits <T>::NR;
+    const size_t sizet_kc_max = gemm_traits <T>::KC;
+    const size_t sizet_nc_max = gemm_traits <T>::NC;
+    size_t sizet_mc_max = gemm_traits <T>::MC;
+
+    // enough row blocks to keep every thread busy
+    size_t sizet_threads = get_num_threads();
+    if (sizet_threads > 1 && sizet_m * sizet_n * sizet_k >= 262144)
+    {
+        size_t sizet_share = (sizet_m + sizet_threads - 1) / sizet_threads;
+        sizet_share = ((sizet_share + sizet_mr - 1) / sizet_mr) * sizet_mr;
+        if (sizet_share < sizet_mc_max) sizet_mc_max = sizet_share;
+    }
+
+    size_t sizet_kc_top = sizet_k < sizet_kc_max ? sizet_k : sizet_kc_max;
+    size_t sizet_nc_top = sizet_n < sizet_nc_max ? sizet_n : sizet_nc_max;
+    std::vector <T> vec_bpack(sizet_kc_top * (((sizet_nc_top + sizet_nr - 1) / sizet_nr) * sizet_nr));
+
+    size_t sizet_blocks = (sizet_m + sizet_mc_max - 1) / sizet_mc_max;
+
+    for (size_t sizet_jc = 0; sizet_jc < sizet_n; sizet_jc += sizet_nc_max)
+    {
+        size_t sizet_nc = sizet_n - sizet_jc < sizet_nc_max ? sizet_n - sizet_jc : sizet_nc_max;
+
+        for (size_t sizet_pc = 0; sizet_pc < sizet_k; sizet_pc += sizet_kc_max)
+        {
+            size_t sizet_kc = sizet_k - sizet_pc < sizet_kc_max ? sizet_k - sizet_pc : sizet_kc_max;
+            T T_beta_pc = sizet_pc == 0 ? T_beta : T(1);
+
+            gemm_pack_b(sizet_kc, sizet_nc, ptr_b + sizet_pc + sizet_jc * sizet_ldb, sizet_ldb, vec_bpack.data());
+
+            const T* ptr_bpack = vec_bpack.data();
+
+            parallel_for(0, sizet_blocks, 1, [&](size_t sizet_first, size_t sizet_last)
+            {
+                std::vector <T> vec_apack(sizet_kc * (((sizet_mc_max + sizet_mr - 1) / sizet_mr) * sizet_mr));
+
+                for (size_t sizet_block = sizet_first; sizet_block < sizet_last; sizet_block++)
+                {
+                    size_t sizet_ic = sizet_block * sizet_mc_max;
+                    size_t sizet_mc = sizet_m - sizet_ic < sizet_mc_max ? sizet_m - sizet_ic : sizet_mc_max;
+
+                    gemm_pack_a(sizet_mc, sizet_kc, ptr_a + sizet_ic + sizet_pc * sizet_lda, sizet_lda, vec_apack.data());
+                    gemm_macro(sizet_mc, sizet_nc, sizet_kc, T_alpha, vec_apack.data(), ptr_bpack,
+                        T_beta_pc, ptr_c + sizet_ic + sizet_jc * sizet_ldc, sizet_ldc);
+                }
+            });
+        }
+    }
+}
+
+}      // NAMESPACE SUSA
+
+#endif // SUSA_GEMM_H
@@ -0,0 +1,387 @@
+/*
+ * This file is part of Susa.
+ *
+ * Susa is free software: you can redistribute it and/or modify
+ * it under the terms of the Lesser GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * at your option) any later version.
+ *
+ * Susa is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * Lesser GNU General Public License for more details.
+ *
+ * You should have received a copy of the Lesser GNU General Public License
+ * along with Susa.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file io.h
+ * @brief Binary and memory-mapped serialization in the NumPy format (declaration and definition).
+ *
+ * The files follow the <i>.npy</i> layout: a magic string, a version, a
+ * header dictionary with the element type, the order and the shape, and
+ * the raw elements. The matrices and the arrays are stored in the Fortran
+ * (column-major) order, hence <i>numpy.load()</i> returns the same
+ * elements at the same indices and the data is written as it is in memory.
+ *
+ * @author Behrooz Kamary
+ * @version 1.0.0
+ *
+ * @defgroup IO Input and Output
+ */
+
+#ifndef SUSA_IO_H
+#define SUSA_IO_H
+
+namespace susa {
+
+//! The element type of the NumPy format
+template <class T> struct npy_type
+{
+    static const char   kind      = std::is_same <T, bool>::value ? 'b'
+                                  : std::is_floating_point <T>::value ? 'f'
+                                  : std::is_signed <T>::value ? 'i' : 'u';
+    static const size_t component = sizeof(T);
+};
+
+//! The element type of the NumPy format for the complex numbers
+template <class T> struct npy_type <std::complex <T> >
+{
+    static const char   kind      = 'c';
+    static const size_t component = sizeof(T);
+};
+
+/**
+ * @brief The header of a NumPy file
+ *
+ * @ingroup IO
+ */
+struct npy_header
+{
+    std::string          str_descr;     //!< the element type e.g. "<f8"
+    bool                 bool_fortran;  //!< true for the column-major order
+    std::vector <size_t> vec_shape;     //!< the dimensions
+    size_t               sizet_offset;  //!< the position of the first element in the file
+};
+
+/**
+ * @brief Returns the NumPy type description of an element
+ *
+ * @param char_kind the kind of the type ('b', 'i', 'u', 'f' or 'c')
+ * @param sizet_bytes the size of an element in bytes
+ * @param bool_swapped the byte order that is not the order of this machine
+ * @ingroup IO
+ */
+std::string npy_descr(char char_kind, size_t sizet_bytes, bool bool_swapped = false);
+
+//! Returns the NumPy type description of a type
+template <class T> std::string npy_descr()
+{
+    return npy_descr(npy_type <T>::kind, sizeof(T));
+}
+
+/**
+ * @brief Writes the magic string, the version and the header dictionary
+ *
+ * The header is padded so that the elements start at a multiple of 64 bytes.
+ *
+ * @param os the output stream
+ * @param header the header (the offset is ignored)
+ * @ingroup IO
+ */
+bool write_npy_header(std::ostream& os, const npy_header& header);
+
+/**
+ * @brief Reads the magic string, the version and the header dictionary
+ *
+ * @param is the input stream, it is left at the first element
+ * @param header the parsed header
+ * @ingroup IO
+ */
+bool read_npy_header(std::istream& is, npy_header& header);
+
+/**
+ * @brief Reverses the bytes of the components of the elements
+ *
+ * @param ptr_data the elements
+ * @param sizet_count the number of the components
+ * @param sizet_bytes the size of a component in bytes
+ * @ingroup IO
+ */
+void swap_bytes(void* ptr_data, size_t sizet_count, size_t sizet_bytes);
+
+/**
+ * @brief Saves a matrix in a NumPy file
+ *
+ * @param str_path the file name
+ * @param mat_arg the matrix
+ * @return true on success
+ * @ingroup IO
+ */
+template <class T> bool save_npy(const std::string& str_path, const matrix <T>& mat_arg);
+
+/**
+ * @brief Loads a matrix from a NumPy file
+ *
+ * The element type of the file shall be the type of the matrix in either byte order.
+ * A one dimensional file is a column vector and a C-order file is reordered.
+ *
+ * @param str_path the file name
+ * @param mat_arg the matrix
+ * @return true on success
+ * @ingroup IO
+ */
+template <class T> bool load_npy(const std::string& str_path, matrix <T>& mat_arg);
+
+/**
+ * @brief Saves an array in a NumPy file
+ *
+ * @param str_path the file name
+ * @param arr_arg the array
+ * @return true on success
+ * @ingroup IO
+ */
+template <class T, size_t N> bool save_npy(const std::string& str_path, const array <T, N>& arr_arg);
+
+/**
+ * @brief Loads an array from a NumPy file
+ *
+ * @param str_path the file name
+ * @param arr_arg the array
+ * @return true on success
+ * @ingroup IO
+ */
+template <class T, size_t N> bool load_npy(const std::string& str_path, array <T, N>& arr_arg);
+
+/**
+ * @brief The <i>mapped_npy</i> class.
+ *
+ * It maps a NumPy file into the memory read-only and exposes its elements
+ * without a copy, hence a large file opens in a constant time and the
+ * operating system pages in what is touched. The views are valid while
+ * the file stays open.
+ *
+ * @ingroup IO
+ */
+class mapped_npy
+{
+  public:
+    //! Constructor
+    mapped_npy();
+
+    //! Constructor that opens a file
+    explicit mapped_npy(const std::string& str_path);
+
+    //! Destructor
+    ~mapped_npy() noexcept;
+
+    mapped_npy(const mapped_npy&) = delete;
+    mapped_npy& operator=(const mapped_npy&) = delete;
+
+    /**
+     * @brief Maps a file
+     *
+     * @param str_path the file name
+     * @return true on success
+     */
+    bool open(const std::string& str_path);
+
+    //! Unmaps the file
+    void close();
+
+    //! Returns true if a file is mapped
+    bool is_open() const
+    {
+        return ptr_map != nullptr;
+    }
+
+    //! Returns the header of the file
+    const npy_header& header() const
+    {
+        return npy_head;
+    }
+
+    //! Returns the number of elements
+    size_t size() const;
+
+    /**
+     * @brief Returns the elements
+     *
+     * @return nullptr if the element type or the byte order of the file differs
+     */
+    template <class T> const T* data() const;
+
+    /**
+     * @brief Returns a view of a file of one or two dimensions
+     *
+     * A C-order file is viewed with the swapped strides.
+     *
+     * @return an empty view if the type or the shape is not viewable
+     */
+    template <class T> matrix_view <const T> view() const;
+
+  private:
+    void*       ptr_map;
+    size_t      sizet_bytes;
+    npy_header  npy_head;
+};
+
+// Implementation
+
+//! the position of an element of a C-order file in the column-major order of the strides
+inline size_t npy_fortran_index(size_t sizet_c, const std::vector <size_t>& vec_shape, const std::vector <size_t>& vec_stride)
+{
+    size_t sizet_index = 0;
+
+    for (size_t sizet_axis = vec_shape.size(); sizet_axis-- > 0;)
+    {
+        sizet_index += (sizet_c % vec_shape[sizet_axis]) * vec_stride[sizet_axis];
+        sizet_c     /= vec_shape[sizet_axis];
+    }
+
+    return sizet_index;
+}
+
+/**
+ * @brief Reads the elements of a NumPy file into a column-major buffer
+ *
+ * The byte order is corrected and a C-order file is reordered.
+ */
+template <class T> bool read_npy_data(std::istream& is, const npy_header& header, T* ptr_data, size_t sizet_num)
+{
+    bool bool_swapped = header.str_descr == npy_descr(npy_type <T>::kind, sizeof(T), true) && sizeof(T) > 1;
+    if (header.str_descr != npy_descr <T> () && !bool_swapped) return false;
+
+    if (header.bool_fortran || header.vec_shape.size() < 2)
+    {
+        is.read(reinterpret_cast <char*> (ptr_data), sizet_num * sizeof(T));
+        if (!is) return false;
+    }
+    else
+    {
+        std::vector <T>      vec_c(sizet_num);
+        std::vector <size_t> vec_stride(header.vec_shape.size(), 1);
+        for (size_t sizet_axis = 1; sizet_axis < vec_stride.size(); sizet_axis++)
+        {
+            vec_stride[sizet_axis] = vec_stride[sizet_axis - 1] * header.vec_shape[sizet_axis - 1];
+        }
+
+        is.read(reinterpret_cast <char*> (vec_c.data()), sizet_num * sizeof(T));
+        if (!is) return false;
+        for (size_t sizet_i = 0; sizet_i < sizet_num; sizet_i++)
+        {
+            ptr_data[npy_fortran_index(sizet_i, header.vec_shape, vec_stride)] = vec_c[sizet_i];
+        }
+    }
+
+    if (bool_swapped) swap_bytes(ptr_data, sizet_num * sizeof(T) / npy_type <T>::component, npy_type <T>::component);
+
+    return true;
+}
+
+template <class T> bool save_npy(const std::string& str_path, const matrix <T>& mat_arg)
+{
+    std::ofstream ofs(str_path.c_str(), std::ios::binary);
+    SUSA_ASSERT_MESSAGE(ofs.good(), "the file can not be created.");
+    if (!ofs.good()) return false;
+
+    npy_header header = {npy_descr <T> (), true, {mat_arg.no_rows(), mat_arg.no_cols()}, 0};
+    if (!write_npy_header(ofs, header)) return false;
+
+    ofs.write(reinterpret_cast <const char*> (mat_arg.data()), mat_arg.size() * sizeof(T));
+
+    return ofs.good();
+}
+
+template <class T> bool load_npy(const std::string& str_path, matrix <T>& mat_arg)
+{
+    std::ifstream ifs(str_path.c_str(), std::ios::binary);
+    SUSA_ASSERT_MESSAGE(ifs.good(), "the file can not be opened.");
+
+    npy_header header;
+    if (!ifs.good() || !read_npy_header(ifs, header)) return false;
+
+    SUSA_ASSERT_MESSAGE(header.vec_shape.size() <= 2, "the file has more than two dimensions.");
+    if (header.vec_shape.size() > 2) return false;
+
+    size_t sizet_rows = header.vec_shape.size() > 0 ? header.vec_shape[0] : 1;
+    size_t sizet_cols = header.vec_shape.size() > 1 ? header.vec_shape[1] : 1;
+
+    matrix <T> mat_ret(sizet_rows, sizet_cols);
+    bool bool_ok = read_npy_data(ifs, header, mat_ret.data(), mat_ret.size());
+    SUSA_ASSERT_MESSAGE(bool_ok, "the element type or the size of the file does not match.");
+    if (!bool_ok) return false;
+
+    mat_arg = std::move(mat_ret);
+    return true;
+}
+
+template <class T, size_t N> bool save_npy(const std::string& str_path, const array <T, N>& arr_arg)
+{
+    std::ofstream ofs(str_path.c_str(), std::ios::binary);
+    SUSA_ASSERT_MESSAGE(ofs.good(), "the file can not be created.");
+    if (!ofs.good()) return false;
+
+    npy_header header = {npy_descr <T> (), true, std::vector <size_t> (arr_arg.no_dims()), 0};
+    for (size_t sizet_axis = 0; sizet_axis < arr_arg.no_dims(); sizet_axis++) header.vec_shape[sizet_axis] = arr_arg.dim(sizet_axis);
+    if (!write_npy_header(ofs, header)) return false;
+
+    ofs.write(reinterpret_cast <const char*> (arr_arg.data()), arr_arg.size() * sizeof(T));
+
+    return ofs.good();
+}
+
+template <class T, size_t N> bool load_npy(const std::string& str_path, array <T, N>& arr_arg)
+{
+    std::ifstream ifs(str_path.c_str(), std::ios::binary);
+    SUSA_ASSERT_MESSAGE(ifs.good(), "the file can not be opened.");
+
+    npy_header header;
+    if (!ifs.good() || !read_npy_header(ifs, header)) return false;
+
+    SUSA_ASSERT_MESSAGE(N == 0 || header.vec_shape.size() == N, "the rank of the file differs from the rank of the array.");
+    if (N != 0 && header.vec_shape.size() != N) return false;
+
+    array <T, N> arr_ret(header.vec_shape);
+    bool bool_ok = read_npy_data(ifs, header, arr_ret.data(), arr_ret.size());
+    SUSA_ASSERT_MESSAGE(bool_ok, "the element type or the size of the file does not match.");
+    if (!bool_ok) return false;
+
+    arr_arg = arr_ret;
+    return true;
+}
+
+template <class T> const T* mapped_npy::data() const
+{
+    if (ptr_map == nullptr || npy_head.str_descr != npy_descr <T> ()) return nullptr;
+
+    const char* ptr_first = static_cast <const char*> (ptr_map) + npy_head.sizet_offset;
+    SUSA_ASSERT_MESSAGE(reinterpret_cast <uintptr_t> (ptr_first) % alignof(T) == 0, "the elements are not aligned.");
+    if (reinterpret_cast <uintptr_t> (ptr_first) % alignof(T) != 0) return nullptr;
+
+    return reinterpret_cast <const T*> (ptr_first);
+}
+
+template <class T> matrix_view <const T> mapped_npy::view() const
+{
+    const T* ptr_data = data <T> ();
+    size_t   sizet_dims = npy_head.vec_shape.size();
+
+    SUSA_ASSERT_MESSAGE(ptr_data != nullptr, "the element type of the file differs.");
+    SUSA_ASSERT_MESSAGE(sizet_dims <= 2, "the file has more than two dimensions.");
+    if (ptr_data == nullptr || sizet_dims > 2) return matrix_view <const T> ();
+
+    size_t sizet_rows = sizet_dims > 0 ? npy_head.vec_shape[0] : 1;
+    size_t sizet_cols = sizet_dims > 1 ? npy_head.vec_shape[1] : 1;
+
+    if (npy_head.bool_fortran || sizet_dims < 2)
+    {
+        return matrix_view <const T> (ptr_data, sizet_rows, sizet_cols, 1, sizet_rows);
+    }
+
+    return matrix_view <const T> (ptr_data, sizet_rows, sizet_cols, sizet_cols, 1);
+}
+
+}       // NAMESPACE SUSA
+#endif  // SUSA_IO_H
@@ -59,26 +59,123 @@ template <class T> matrix <T> matmul(const matrix <T> &mat_argl, const matrix <T
 
     if (mat_argl.no_cols() == mat_argr.no_rows())
     {
-        mat_ret = matrix <T> (sizet_rows, sizet_cols, 0);
-        for (size_t sizet_row = 0; sizet_row < sizet_rows; sizet_row++)
+        mat_ret = matrix <T> (sizet_rows, sizet_cols);
+        gemm <T> (sizet_rows, sizet_cols, mat_argl.sizet_cols,
+                  T(1), mat_argl._matrix, mat_argl.sizet_rows,
+                  mat_argr._matrix, mat_argr.sizet_rows,
+                  T(0), mat_ret._matrix, mat_ret.sizet_rows);
+    }
+    else
+    {
+        SUSA_ABORT("the matrices' dimensions mismatch.");
+    }
+
+    return mat_ret;
+}
+
+//! the tile size of the transpose kernels
+const size_t TRANSPOSE_TILE = 16;
+
+/**
+ * @brief The tiled transpose kernel
+ *
+ * Writes the (conjugate) transpose of the column-major source to the destination
+ * in square tiles, hence the strided writes of a tile stay in a few cache lines.
+ *
+ * @param sizet_rows number of rows of the source
+ * @param sizet_cols number of columns of the source
+ * @param ptr_src the source
+ * @param ptr_dst the destination, sizet_cols by sizet_rows
+ * @ingroup LALG
+ */
+template <bool CONJ, class T> void transpose_tiled(size_t sizet_rows, size_t sizet_cols, const T* ptr_src, T* ptr_dst)
+{
+    for (size_t sizet_c0 = 0; sizet_c0 < sizet_cols; sizet_c0 += TRANSPOSE_TILE)
+    {
+        size_t sizet_c1 = std::min(sizet_c0 + TRANSPOSE_TILE, sizet_cols);
+
+        for (size_t sizet_r0 = 0; sizet_r0 < sizet_rows; sizet_r0 += TRANSPOSE_TILE)
         {
-            for (size_t sizet_col = 0; sizet_col < sizet_cols; sizet_col++)
+            size_t sizet_r1 = std::min(sizet_r0 + TRANSPOSE_TILE, sizet_rows);
+
+            for (size_t sizet_c = sizet_c0; sizet_c < sizet_c1; sizet_c++)
             {
-                for (size_t sizet_index = 0; sizet_index < mat_argl.no_cols(); sizet_index++)
+                const T* ptr_col = ptr_src + sizet_c * sizet_rows;
+                for (size_t sizet_r = sizet_r0; sizet_r < sizet_r1; sizet_r++)
                 {
-                    mat_ret._matrix[sizet_row + sizet_col * mat_ret.sizet_rows] +=
-                            mat_argl._matrix[sizet_row + sizet_index * mat_argl.sizet_rows]
-                            * mat_argr._matrix[sizet_index + sizet_col * mat_argr.sizet_rows];
+                    ptr_dst[sizet_c + sizet_r * sizet_cols] = CONJ ? conjugate(ptr_col[sizet_r]) : ptr_col[sizet_r];
                 }
             }
         }
     }
-    else
+}
+
+/**
+ * @brief The in-place transpose kernel
+ *
+ * A square matrix swaps its tiles across the diagonal. A rectangular one follows
+ * the cycles of the permutation r + c * rows -> c + r * cols with one visit bit per element.
+ *
+ * @param sizet_rows number of rows
+ * @param sizet_cols number of columns
+ * @param ptr_data the column-major data
+ * @ingroup LALG
+ */
+template <bool CONJ, class T> void transpose_inplace_kernel(size_t sizet_rows, size_t sizet_cols, T* ptr_data)
+{
+    const size_t sizet_size = sizet_rows * sizet_cols;
+
+    if (sizet_rows == sizet_cols)
     {
-        SUSA_ABORT("the matrices' dimensions mismatch.");
+        const size_t sizet_n = sizet_rows;
+        for (size_t sizet_c0 = 0; sizet_c0 < sizet_n; sizet_c0 += TRANSPOSE_TILE)
+        {
+            size_t sizet_c1 = std::min(sizet_c0 + TRANSPOSE_TILE, sizet_n);
+            for (size_t sizet_r0 = sizet_c0; sizet_r0 < sizet_n; sizet_r0 += TRANSPOSE_TILE)
+            {
+                size_t sizet_r1 = std::min(sizet_r0 + TRANSPOSE_TILE, sizet_n);
+                for (size_t sizet_c = sizet_c0; sizet_c < sizet_c1; sizet_c++)
+                {
+                    // the diagonal tile swaps its strictly lower part only
+                    size_t sizet_first = sizet_r0 == sizet_c0 ? sizet_c + 1 : sizet_r0;
+                    for (size_t sizet_r = sizet_first; sizet_r < sizet_r1; sizet_r++)
+                    {
+                        T T_lower = ptr_data[sizet_r + sizet_c * sizet_n];
+                        T T_upper = ptr_data[sizet_c + sizet_r * sizet_n];
+                        ptr_data[sizet_r + sizet_c * sizet_n] = CONJ ? conjugate(T_upper) : T_upper;
+                        ptr_data[sizet_c + sizet_r * sizet_n] = CONJ ? conjugate(T_lower) : T_lower;
+                    }
+                }
+            }
+        }
+
+        if (CONJ)
+        {
+            for (size_t sizet_i = 0; sizet_i < sizet_n; sizet_i++) ptr_data[sizet_i * (sizet_n + 1)] = conjugate(ptr_data[sizet_i * (sizet_n + 1)]);
+        }
+
+        return;
     }
 
-    return mat_ret;
+    std::vector <bool> vec_visited(sizet_size, false);
+
+    for (size_t sizet_start = 0; sizet_start < sizet_size; sizet_start++)
+    {
+        if (vec_visited[sizet_start]) continue;
+
+        // the element at k moves to (k % rows) * cols + k / rows
+        size_t sizet_k = sizet_start;
+        T      T_carry = ptr_data[sizet_k];
+        do
+        {
+            size_t sizet_next = (sizet_k % sizet_rows) * sizet_cols + sizet_k / sizet_rows;
+            T      T_next     = ptr_data[sizet_next];
+            ptr_data[sizet_next]  = CONJ ? conjugate(T_carry) : T_carry;
+            vec_visited[sizet_next] = true;
+            T_carry  = T_next;
+            sizet_k  = sizet_next;
+        } while (sizet_k != sizet_start);
+    }
 }
 
 /**
@@ -90,8 +187,6 @@ template <class T> matrix <T> matmul(const matrix <T> &mat_argl, const matrix <T
  */
 template <class T> matrix <T> transpose(const matrix <T> &mat_arg)
 {
-    size_t sizet_rows = mat_arg.no_rows();
-    size_t sizet_cols = mat_arg.no_cols();
     matrix <T> mat_ret;
 
     SUSA_ASSERT(mat_arg._matrix != NULL);
@@ -101,66 +196,68 @@ template <class T> matrix <T> transpose(const matrix <T> &mat_arg)
         return mat_ret;
     }
 
-    mat_ret = matrix <T> (sizet_cols, sizet_rows);
-
-    for (size_t sizet_col = 0; sizet_col < sizet_cols; sizet_col++)
-    {
-        for (size_t sizet_row = 0; sizet_row < sizet_rows; sizet_row++)
-        {
-            mat_ret(sizet_col,sizet_row) = mat_arg(sizet_row,sizet_col);
-        }
-    }
+    mat_ret = matrix <T> (mat_arg.sizet_cols, mat_arg.sizet_rows);
+    transpose_tiled <false> (mat_arg.sizet_rows, mat_arg.sizet_cols, mat_arg._matrix, mat_ret._matrix);
 
     return mat_ret;
 }
 
+/**
+ * @brief Conjugate transpose operator
+ *
+ * The conjugation is fused with the transpose, e.g. to form H^H. It is the
+ * transpose of a real matrix.
+ *
+ * @param mat_arg the input matrix
+ * @return returns conjugate transpose of the input matrices
+ * @ingroup LALG
+ */
+template <class T> matrix <T> ctranspose(const matrix <T> &mat_arg)
+{
+    matrix <T> mat_ret;
+
+    if (mat_arg.size() == 0) return mat_ret;
+
+    mat_ret = matrix <T> (mat_arg.no_cols(), mat_arg.no_rows());
+    transpose_tiled <true> (mat_arg.no_rows(), mat_arg.no_cols(), mat_arg.data(), mat_ret.data());
+
+    return mat_ret;
+}
 
 /**
- * @brief Determinant
+ * @brief In-place transpose
  *
- * @param mat_arg
- * @return returns determinant of the input matrices
+ * @param mat_arg the matrix to be transposed in its own storage
  * @ingroup LALG
  */
-template <class T> double det(const matrix <T> &mat_arg)
+template <class T> void transpose_inplace(matrix <T> &mat_arg)
 {
-    double dbl_ret = 0.0;
+    if (mat_arg.size() == 0) return;
 
     size_t sizet_rows = mat_arg.no_rows();
     size_t sizet_cols = mat_arg.no_cols();
+    transpose_inplace_kernel <false> (sizet_rows, sizet_cols, mat_arg.data());
 
-    if (sizet_rows == sizet_cols)
-    {
-        if (sizet_rows == 1)
-        { // 1 x 1
-            dbl_ret = mat_arg(0);
-        }
-        else if (sizet_rows == 2)
-        { // 2 x 2
-            dbl_ret = mat_arg(0, 0) * mat_arg(1, 1) - mat_arg(1, 0) * mat_arg(0, 1);
-        }
-        else
-        { // 3 x 3 and more
-            for (size_t  sizet_col = 0; sizet_col < sizet_cols; sizet_col++)
-            {
-                matrix <T> mat_minor = mat_arg.shrink(0, sizet_col);
-                if (mat_minor.size() == mat_arg.size())
-                {
-                    // If for any reason something goes wrong in the minor() it returns the matrix without any action.
-                    // Therefore size of the input argument and the returned argument would the same. This case cause infinite
-                    // iterations. To stop such an unwanted loop this if() returns from the method.
-                    // THIS METHOD IS NOT STABLE BUT WORKS.
-                    SUSA_LOG_ERR("falling into an infinite loop avoided.");
-                    return dbl_ret;
-                }
-                dbl_ret +=  (-2 * (int)(sizet_col % 2) + 1) * mat_arg(0, sizet_col) * det(mat_minor);
-            }
-        }
-    }
-
-    return dbl_ret;
+    // the same number of elements keeps the storage
+    mat_arg.resize(sizet_cols, sizet_rows);
 }
 
+/**
+ * @brief In-place conjugate transpose
+ *
+ * @param mat_arg the matrix to be transposed in its own storage
+ * @ingroup LALG
+ */
+template <class T> void ctranspose_inplace(matrix <T> &mat_arg)
+{
+    if (mat_arg.size() == 0) return;
+
+    size_t sizet_rows = mat_arg.no_rows();
+    size_t sizet_cols = mat_arg.no_cols();
+    transpose_inplace_kernel <true> (sizet_rows, sizet_cols, mat_arg.data());
+
+    mat_arg.resize(sizet_cols, sizet_rows);
+}
 
 
 /**
@@ -38,6 +38,8 @@
 
 #include <susa/debug.h>
 #include <susa/memory.h>
+#include <susa/expression.h>
+#include <susa/view.h>
 
 namespace susa
 {
@@ -88,7 +90,8 @@ template <class T> class matrix : public susa::memory <T>
     size_t  sizet_rows;
     size_t  sizet_cols;
 
-    T* T_fake;
+    // the target of out of range element references
+    T T_fake;
 
     // UTILITY METHODS
 
@@ -153,6 +156,15 @@ template <class T> class matrix : public susa::memory <T>
      */
     matrix(std::string str_string);
 
+    /**
+     * @brief Constructor
+     *
+     * evaluates a lazy element-wise expression in a single pass.
+     *
+     * @param expr_arg the expression
+     */
+    template <class E> matrix(const expression <T, E>& expr_arg);
+
     //! Returns the value of a specific (row, column)
     T get(size_t sizet_row, size_t sizet_col) const;
 
@@ -206,6 +218,26 @@ template <class T> class matrix : public susa::memory <T>
      */
     bool set_col(size_t col, const matrix <T>& mat_arg);
 
+    /**
+     * @brief set a row
+     *
+     * evaluates a view or a lazy expression into a row
+     *
+     * @param row the row index
+     * @param expr_arg the input vector expression
+     */
+    template <class E> bool set_row(size_t row, const expression <T, E>& expr_arg);
+
+    /**
+     * @brief set a column
+     *
+     * evaluates a view or a lazy expression into a column
+     *
+     * @param col the column index
+     * @param expr_arg the input vector expression
+     */
+    template <class E> bool set_col(size_t col, const expression <T, E>& expr_arg);
+
     /**
      * @brief swap two columns of the matrix
      */
@@ -240,18 +272,90 @@ template <class T> class matrix : public susa::memory <T>
     //! Considers the matrix object as a vector and return mid part of that vector
     matrix <T> mid(size_t sizet_begin, size_t sizet_end) const;
 
+    //! Returns a view of the whole matrix
+    matrix_view <T> view();
+
+    //! Returns a view of the whole matrix
+    matrix_view <const T> view() const;
+
+    //! Returns a view of the indicated row (no copy)
+    matrix_view <T> row_view(size_t sizet_row);
+
+    //! Returns a view of the indicated row (no copy)
+    matrix_view <const T> row_view(size_t sizet_row) const;
+
+    //! Returns a view of the indicated column (no copy)
+    matrix_view <T> col_view(size_t sizet_col);
+
+    //! Returns a view of the indicated column (no copy)
+    matrix_view <const T> col_view(size_t sizet_col) const;
+
+    //! Returns a view of a sub-block (no copy)
+    matrix_view <T> block_view(size_t sizet_row, size_t sizet_col, size_t sizet_no_rows, size_t sizet_no_cols);
+
+    //! Returns a view of a sub-block (no copy)
+    matrix_view <const T> block_view(size_t sizet_row, size_t sizet_col, size_t sizet_no_rows, size_t sizet_no_cols) const;
+
+    //! Considers the matrix object as a vector and returns a view of its left side
+    matrix_view <T> left_view(size_t sizet_left);
+
+    //! Considers the matrix object as a vector and returns a view of its left side
+    matrix_view <const T> left_view(size_t sizet_left) const;
+
+    //! Considers the matrix object as a vector and returns a view of its right side
+    matrix_view <T> right_view(size_t sizet_right);
+
+    //! Considers the matrix object as a vector and returns a view of its right side
+    matrix_view <const T> right_view(size_t sizet_right) const;
+
+    //! Considers the matrix object as a vector and returns a view of its mid part
+    matrix_view <T> mid_view(size_t sizet_begin, size_t sizet_end);
+
+    //! Considers the matrix object as a vector and returns a view of its mid part
+    matrix_view <const T> mid_view(size_t sizet_begin, size_t sizet_end) const;
+
     //! Element wise Assignment by Addition operator
-    matrix <T> operator+=( const matrix <T> &mat_arg );
+    matrix <T>& operator+=( const matrix <T> &mat_arg );
 
     //! Element wise Assignment by Subtraction
-    matrix <T> operator-=( const matrix <T> &mat_arg );
+    matrix <T>& operator-=( const matrix <T> &mat_arg );
+
+    //! Element wise Assignment by Multiplication
+    matrix <T>& operator*=( const matrix <T> &mat_arg );
+
+    //! Element wise Assignment by Division
+    matrix <T>& operator/=( const matrix <T> &mat_arg );
+
+    //! Assignment by Addition of a scalar
+    matrix <T>& operator+=( T T_arg );
+
+    //! Assignment by Subtraction of a scalar
+    matrix <T>& operator-=( T T_arg );
+
+    //! Assignment by Multiplication by a scalar
+    matrix <T>& operator*=( T T_arg );
+
+    //! Assignment by Division by a scalar
+    matrix <T>& operator/=( T T_arg );
 
     //! Element wise Assignment operator
     matrix <T>& operator=( const matrix <T> &mat_arg );
 
+    //! Move Assignment operator
+    matrix <T>& operator=( matrix <T> &&mat_arg ) noexcept;
+
     //! Element wise Assignment operator
     matrix <T>& operator=( std::string str_string );
 
+    //! Evaluates a lazy element-wise expression into this matrix
+    template <class E> matrix <T>& operator=( const expression <T, E>& expr_arg );
+
+    //! Element wise Assignment by Addition of a lazy expression
+    template <class E> matrix <T>& operator+=( const expression <T, E>& expr_arg );
+
+    //! Element wise Assignment by Subtraction of a lazy expression
+    template <class E> matrix <T>& operator-=( const expression <T, E>& expr_arg );
+
     //! Element wise Subtraction operator
     friend matrix <T> operator-<>( const matrix <T> &mat_argl, T T_arg);
 
@@ -355,7 +459,6 @@ template <class T> class matrix : public susa::memory <T>
 
 template <class T> matrix <T>::matrix()
 : susa::memory<T>()
-, T_fake(new T)
 {
   sizet_rows = 0;
   sizet_cols = 0;
@@ -363,7 +466,6 @@ template <class T> matrix <T>::matrix()
 
 template <class T> matrix <T>::matrix(size_t sizet_rows, size_t sizet_cols, T Tinitial)
 : susa::memory<T>()
-, T_fake(new T)
 {
 
   SUSA_ASSERT(sizet_cols > 0 && sizet_rows > 0);
@@ -382,7 +484,6 @@ template <class T> matrix <T>::matrix(size_t sizet_rows, size_t sizet_cols, T Ti
 
 template <class T> matrix <T>::matrix( size_t sizet_rows, size_t sizet_cols )
 : susa::memory<T>()
-, T_fake(new T)
 {
     SUSA_ASSERT(sizet_cols > 0 && sizet_rows > 0);
 
@@ -394,7 +495,6 @@ template <class T> matrix <T>::matrix( size_t sizet_rows, size_t sizet_cols )
 
 template <class T> matrix <T>::matrix(const matrix <T> &mat_arg)
 : susa::memory <T> (mat_arg)
-, T_fake(new T)
 {
 
   if (this->_matrix != nullptr)
@@ -412,7 +512,6 @@ template <class T> matrix <T>::matrix(const matrix <T> &mat_arg)
 
 template <class T> matrix <T>::matrix(const std::tuple<size_t, size_t>& tshape)
 : susa::memory<T>()
-, T_fake(new T)
 {
     size_t sizet_rows;
     size_t sizet_cols;
@@ -429,7 +528,6 @@ template <class T> matrix <T>::matrix(const std::tuple<size_t, size_t>& tshape)
 
 template <class T> matrix <T>::matrix(const std::tuple<size_t, size_t>& tshape, T Tinitial)
 : susa::memory<T>()
-, T_fake(new T)
 {
     size_t sizet_rows;
     size_t sizet_cols;
@@ -453,13 +551,12 @@ template <class T> matrix <T>::matrix(matrix<T>&& mat_arg) noexcept
 {
   sizet_rows          = mat_arg.sizet_rows;
   sizet_cols          = mat_arg.sizet_cols;
-  T_fake              = mat_arg.T_fake;
-  mat_arg.T_fake      = nullptr;
+  mat_arg.sizet_rows  = 0;
+  mat_arg.sizet_cols  = 0;
 }
 
 
 template <class T> matrix <T>::matrix(std::string str_string)
-: T_fake(new T)
 {
   sizet_rows     = 0;
   sizet_cols     = 0;
@@ -468,9 +565,17 @@ template <class T> matrix <T>::matrix(std::string str_string)
   parser(str_string);
 }
 
+template <class T> template <class E> matrix <T>::matrix(const expression <T, E>& expr_arg)
+: susa::memory<T>()
+{
+  sizet_rows = 0;
+  sizet_cols = 0;
+
+  *this = expr_arg;
+}
+
 template <class T> matrix <T>::~matrix() noexcept
 {
-    delete T_fake;
 }
 
 // Public methods
@@ -597,6 +702,34 @@ template <class T> bool matrix <T>::set_col(size_t col, const matrix <T>& mat_ar
     return true;
 }
 
+template <class T> template <class E> bool matrix <T>::set_row(size_t row, const expression <T, E>& expr_arg)
+{
+    SUSA_ASSERT_MESSAGE(row < sizet_rows && expr_arg.size() >= sizet_cols, "dimension mismatch");
+    if (row >= sizet_rows || expr_arg.size() < sizet_cols) return false;
+
+    const E& expr = expr_arg.self();
+    for (size_t indx = 0; indx < sizet_cols; indx++)
+    {
+        this->_matrix[get_lindex(row,indx)] = expr.elem(indx);
+    }
+
+    return true;
+}
+
+template <class T> template <class E> bool matrix <T>::set_col(size_t col, const expression <T, E>& expr_arg)
+{
+    SUSA_ASSERT_MESSAGE(col < sizet_cols && expr_arg.size() >= sizet_rows, "dimension mismatch");
+    if (col >= sizet_cols || expr_arg.size() < sizet_rows) return false;
+
+    const E& expr = expr_arg.self();
+    for (size_t indx = 0; indx < sizet_rows; indx++)
+    {
+        this->_matrix[get_lindex(indx,col)] = expr.elem(indx);
+    }
+
+    return true;
+}
+
 template <class T> void matrix <T>::swap_cols(size_t col_a, size_t col_b)
 {
     T T_tmp;
@@ -630,12 +763,9 @@ template <class T> matrix <T> matrix <T>::shrink(size_t sizet_elim_row, size_t s
     size_t sizet_new_col;
     size_t sizet_new_row;
 
-    //TODO: it should be verified; this condition may be incorrect
-    SUSA_ASSERT_MESSAGE(sizet_cols > 1 && sizet_rows > 1
-      && sizet_elim_row >= 0 && sizet_elim_col >= 0,
-      "the input arguments error.");
+    SUSA_ASSERT_MESSAGE(sizet_cols > 1 && sizet_rows > 1, "the input arguments error.");
 
-    if (sizet_cols > 1 && sizet_rows > 1 && sizet_elim_row >= 0 && sizet_elim_col >= 0)
+    if (sizet_cols > 1 && sizet_rows > 1)
     {
         mat_ret = matrix <T> (sizet_rows - 1,sizet_cols - 1);
     }
@@ -754,6 +884,80 @@ template <class T> matrix <T> matrix <T>::mid(size_t sizet_begin, size_t sizet_e
     return mat_ret;
 }
 
+// Views
+
+template <class T> matrix_view <T> matrix <T>::view()
+{
+    return matrix_view <T> (*this);
+}
+
+template <class T> matrix_view <const T> matrix <T>::view() const
+{
+    return matrix_view <const T> (*this);
+}
+
+template <class T> matrix_view <T> matrix <T>::row_view(size_t sizet_row)
+{
+    return view().row(sizet_row);
+}
+
+template <class T> matrix_view <const T> matrix <T>::row_view(size_t sizet_row) const
+{
+    return view().row(sizet_row);
+}
+
+template <class T> matrix_view <T> matrix <T>::col_view(size_t sizet_col)
+{
+    return view().col(sizet_col);
+}
+
+template <class T> matrix_view <const T> matrix <T>::col_view(size_t sizet_col) const
+{
+    return view().col(sizet_col);
+}
+
+template <class T> matrix_view <T> matrix <T>::block_view(size_t sizet_row, size_t sizet_col,
+  size_t sizet_no_rows, size_t sizet_no_cols)
+{
+    return view().block(sizet_row, sizet_col, sizet_no_rows, sizet_no_cols);
+}
+
+template <class T> matrix_view <const T> matrix <T>::block_view(size_t sizet_row, size_t sizet_col,
+  size_t sizet_no_rows, size_t sizet_no_cols) const
+{
+    return view().block(sizet_row, sizet_col, sizet_no_rows, sizet_no_cols);
+}
+
+template <class T> matrix_view <T> matrix <T>::left_view(size_t sizet_left)
+{
+    return view().left(sizet_left);
+}
+
+template <class T> matrix_view <const T> matrix <T>::left_view(size_t sizet_left) const
+{
+    return view().left(sizet_left);
+}
+
+template <class T> matrix_view <T> matrix <T>::right_view(size_t sizet_right)
+{
+    return view().right(sizet_right);
+}
+
+template <class T> matrix_view <const T> matrix <T>::right_view(size_t sizet_right) const
+{
+    return view().right(sizet_right);
+}
+
+template <class T> matrix_view <T> matrix <T>::mid_view(size_t sizet_begin, size_t sizet_end)
+{
+    return view().mid(sizet_begin, sizet_end);
+}
+
+template <class T> matrix_view <const T> matrix <T>::mid_view(size_t sizet_begin, size_t sizet_end) const
+{
+    return view().mid(sizet_begin, sizet_end);
+}
+
 // Operators
 
 //  ()
@@ -769,7 +973,7 @@ template <class T> T &matrix<T>::operator ()( size_t sizet_row, size_t sizet_col
       return this->_matrix[get_lindex(sizet_row,sizet_col)];
   }
 
-  return *T_fake;
+  return T_fake;
 }
 
 template <class T> T matrix<T>::operator ()( size_t sizet_row, size_t sizet_col ) const
@@ -789,7 +993,7 @@ template <class T> T &matrix<T>::operator ()( size_t sizet_elem )
       return this->_matrix[sizet_elem];
     }
 
-    return *T_fake;
+    return T_fake;
 }
 
 template <class T> T matrix<T>::operator ()( size_t sizet_elem ) const
@@ -1109,46 +1313,111 @@ template <class T> matrix<T> operator/( const matrix <T> &mat_argl, T T_arg )
 }
 
 
-//  -=
-template <class T> matrix<T> matrix <T>::operator-=(const matrix <T> &mat_arg)
-{
-
-    SUSA_ASSERT(this->_matrix != NULL);
-
-    SUSA_ASSERT_MESSAGE((mat_arg.sizet_rows == sizet_rows)
-      && (mat_arg.sizet_cols == sizet_cols),
-      "the matrices have different sizes.");
-
-    if ((mat_arg.sizet_rows == sizet_rows) && (mat_arg.sizet_cols == sizet_cols) && this->_matrix != NULL)
+// Compound assignments
+#define SUSA_MATRIX_COMPOUND(SYM)                                                            \
+template <class T> matrix<T>& matrix <T>::operator SYM (const matrix <T> &mat_arg)           \
+{                                                                                            \
+    SUSA_ASSERT(this->_matrix != NULL);                                                      \
+                                                                                             \
+    SUSA_ASSERT_MESSAGE((mat_arg.sizet_rows == sizet_rows)                                   \
+      && (mat_arg.sizet_cols == sizet_cols),                                                 \
+      "the matrices have different sizes.");                                                 \
+                                                                                             \
+    if ((mat_arg.sizet_rows == sizet_rows) && (mat_arg.sizet_cols == sizet_cols) && this->_matrix != NULL) \
+    {                                                                                        \
+        for (size_t sizet_index = 0; sizet_index < this->sizet_objects; sizet_index++)       \
+        {                                                                                    \
+            this->_matrix[sizet_index] SYM mat_arg._matrix[sizet_index];                     \
+        }                                                                                    \
+    }                                                                                        \
+                                                                                             \
+    return *this;                                                                            \
+}                                                                                            \
+                                                                                             \
+template <class T> matrix<T>& matrix <T>::operator SYM (T T_arg)                             \
+{                                                                                            \
+    for (size_t sizet_index = 0; sizet_index < this->sizet_objects; sizet_index++)           \
+    {                                                                                        \
+        this->_matrix[sizet_index] SYM T_arg;                                                \
+    }                                                                                        \
+                                                                                             \
+    return *this;                                                                            \
+}
+
+SUSA_MATRIX_COMPOUND(+=)
+SUSA_MATRIX_COMPOUND(-=)
+SUSA_MATRIX_COMPOUND(*=)
+SUSA_MATRIX_COMPOUND(/=)
+
+#undef SUSA_MATRIX_COMPOUND
+
+// Operators on expiring operands reuse the storage of the operand.
+// The (rvalue, rvalue) overloads resolve the ambiguity of the mixed ones.
+#define SUSA_MATRIX_RVALUE_OPERATOR(SYM)                                                     \
+template <class T> matrix<T> operator SYM (matrix <T> &&mat_argl, const matrix <T> &mat_argr) \
+{                                                                                            \
+    mat_argl SYM##= mat_argr;                                                                \
+    return std::move(mat_argl);                                                              \
+}                                                                                            \
+                                                                                             \
+template <class T> matrix<T> operator SYM (matrix <T> &&mat_argl, matrix <T> &&mat_argr)      \
+{                                                                                            \
+    mat_argl SYM##= mat_argr;                                                                \
+    return std::move(mat_argl);                                                              \
+}                                                                                            \
+                                                                                             \
+template <class T> matrix<T> operator SYM (const matrix <T> &mat_argl, matrix <T> &&mat_argr) \
+{                                                                                            \
+    SUSA_ASSERT_MESSAGE(mat_argl.shape() == mat_argr.shape(), "the matrices have different sizes."); \
+    if (mat_argl.shape() == mat_argr.shape())                                                \
+    {                                                                                        \
+        const T* ptr_l = mat_argl.data();                                                    \
+        T* ptr_r = mat_argr.data();                                                          \
+        for (size_t sizet_index = 0; sizet_index < mat_argr.size(); sizet_index++)           \
+        {                                                                                    \
+            ptr_r[sizet_index] = ptr_l[sizet_index] SYM ptr_r[sizet_index];                  \
+        }                                                                                    \
+    }                                                                                        \
+    return std::move(mat_argr);                                                              \
+}                                                                                            \
+                                                                                             \
+template <class T> matrix<T> operator SYM (matrix <T> &&mat_argl, T T_arg)                   \
+{                                                                                            \
+    mat_argl SYM##= T_arg;                                                                   \
+    return std::move(mat_argl);                                                              \
+}
+
+SUSA_MATRIX_RVALUE_OPERATOR(+)
+SUSA_MATRIX_RVALUE_OPERATOR(-)
+SUSA_MATRIX_RVALUE_OPERATOR(*)
+SUSA_MATRIX_RVALUE_OPERATOR(/)
+
+#undef SUSA_MATRIX_RVALUE_OPERATOR
+
+template <class T> matrix<T> operator+(T T_arg, matrix <T> &&mat_argr)
+{
+    mat_argr += T_arg;
+    return std::move(mat_argr);
+}
+
+template <class T> matrix<T> operator*(T T_arg, matrix <T> &&mat_argr)
+{
+    T* ptr_r = mat_argr.data();
+    for (size_t sizet_index = 0; sizet_index < mat_argr.size(); sizet_index++)
     {
-        for (size_t sizet_index = 0; sizet_index < this->sizet_objects; sizet_index++)
-        {
-            this->_matrix[sizet_index] -= mat_arg._matrix[sizet_index];
-        }
+        ptr_r[sizet_index] = T_arg * ptr_r[sizet_index];
     }
-
-    return *this;
+    return std::move(mat_argr);
 }
 
-//  +=
-template <class T> matrix<T> matrix <T>::operator+=(const matrix <T> &mat_arg)
+template <class T> matrix<T> operator-(T T_arg, matrix <T> &&mat_argr)
 {
-
-    SUSA_ASSERT(this->_matrix != NULL);
-
-    SUSA_ASSERT_MESSAGE((mat_arg.sizet_rows == sizet_rows)
-      && (mat_arg.sizet_cols == sizet_cols),
-      "the matrices have different sizes.");
-
-    if ((mat_arg.sizet_rows == sizet_rows) && (mat_arg.sizet_cols == sizet_cols) && this->_matrix != NULL)
+    T* ptr_r = mat_argr.data();
+    for (size_t sizet_index = 0; sizet_index < mat_argr.size(); sizet_index++)
     {
-        for (size_t sizet_index = 0; sizet_index < this->sizet_objects; sizet_index++)
-        {
-            this->_matrix[sizet_index] += mat_arg._matrix[sizet_index];
-        }
+        ptr_r[sizet_index] = T_arg - ptr_r[sizet_index];
     }
-
-    return *this;
+    return std::move(mat_argr);
 }
 
 //  =
@@ -1170,12 +1439,91 @@ template <class T> matrix<T>& matrix <T>::operator=( const matrix <T> &mat_arg )
     return *this;
 }
 
+template <class T> matrix<T>& matrix <T>::operator=( matrix <T> &&mat_arg ) noexcept
+{
+    if (this != &mat_arg)
+    {
+        susa::memory<T>::operator=(std::move(mat_arg));
+
+        sizet_rows         = mat_arg.sizet_rows;
+        sizet_cols         = mat_arg.sizet_cols;
+        mat_arg.sizet_rows = 0;
+        mat_arg.sizet_cols = 0;
+    }
+
+    return *this;
+}
+
 template <class T> matrix<T>& matrix <T>::operator=( std::string str_string )
 {
     parser(str_string);
     return *this;
 }
 
+// The elements of an expression are evaluated at the same index they
+// are stored into, therefore the destination may appear in the expression.
+// Such an expression has the destination shape and no reallocation happens.
+template <class T> template <class E> matrix<T>& matrix <T>::operator=( const expression <T, E>& expr_arg )
+{
+    const E& expr = expr_arg.self();
+    size_t sizet_size = expr.no_rows() * expr.no_cols();
+
+    if (sizet_rows != expr.no_rows() || sizet_cols != expr.no_cols())
+    {
+        // the expression may view this matrix, hence a new buffer is filled
+        matrix <T> mat_ret(expr.no_rows(), expr.no_cols());
+        for (size_t sizet_index = 0; sizet_index < sizet_size; sizet_index++)
+        {
+            mat_ret._matrix[sizet_index] = expr.elem(sizet_index);
+        }
+
+        return (*this = std::move(mat_ret));
+    }
+
+    for (size_t sizet_index = 0; sizet_index < sizet_size; sizet_index++)
+    {
+        this->_matrix[sizet_index] = expr.elem(sizet_index);
+    }
+
+    return *this;
+}
+
+template <class T> template <class E> matrix<T>& matrix <T>::operator+=( const expression <T, E>& expr_arg )
+{
+    const E& expr = expr_arg.self();
+
+    SUSA_ASSERT_MESSAGE(expr.no_rows() == sizet_rows && expr.no_cols() == sizet_cols,
+      "the matrices have different sizes.");
+
+    if (expr.no_rows() == sizet_rows && expr.no_cols() == sizet_cols)
+    {
+        for (size_t sizet_index = 0; sizet_index < this->sizet_objects; sizet_index++)
+        {
+            this->_matrix[sizet_index] += expr.elem(sizet_index);
+        }
+    }
+
+    return *this;
+}
+
+template <class T> template <class E> matrix<T>& matrix <T>::operator-=( const expression <T, E>& expr_arg )
+{
+    const E& expr = expr_arg.self();
+
+    SUSA_ASSERT_MESSAGE(expr.no_rows() == sizet_rows && expr.no_cols() == sizet_cols,
+      "the matrices have different sizes.");
+
+    if (expr.no_rows() == sizet_rows && expr.no_cols() == sizet_cols)
+    {
+        for (size_t sizet_index = 0; sizet_index < this->sizet_objects; sizet_index++)
+        {
+            this->_matrix[sizet_index] -= expr.elem(sizet_index);
+        }
+    }
+
+    return *this;
+}
+
 inline std::ostream& operator<<(std::ostream& os, char c)
 {
     return std::is_signed<char>::value ? os << static_cast<int>(c): os << static_cast<unsigned int>(c);
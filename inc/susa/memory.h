@@ -27,6 +27,7 @@
 
 #include <cstdlib>
 #include <susa/debug.h>
+#include <susa/allocator.h>
 
 namespace susa
 {
@@ -35,6 +36,9 @@ namespace susa
 * @brief The <i>memory</i> class.
 *
 * <i>memory</i> is a base memory manager class for Susa types.
+* A new buffer is acquired from the allocator of the calling thread
+* (see <i>set_allocator()</i>) and it is resized and released through
+* the same allocator.
 *
 * @ingroup TYPES
 *
@@ -42,9 +46,10 @@ namespace susa
 template <class T> class memory
 {
     protected:
-        T*     _matrix;
-        size_t sizet_bytes;
-        size_t sizet_objects;
+        T*         _matrix;
+        size_t     sizet_bytes;
+        size_t     sizet_objects;
+        allocator* ptr_alloc;
 
         /**
          * Allocates a memory space without initialization.
@@ -72,9 +77,18 @@ template <class T> class memory
         //! Copy Constructor for rvalues
         memory(memory <T> &&mat_arg) noexcept;
 
+        //! Move assignment operator
+        memory& operator=(memory <T> &&mat_arg) noexcept;
+
 
         //! Returns the number of allocated objects.
         size_t size() const;
+
+        //! Returns the pointer to the allocated objects
+        T* data();
+
+        //! Returns the pointer to the allocated objects
+        const T* data() const;
 };
 
 template <class T> memory<T>::memory()
@@ -82,6 +96,7 @@ template <class T> memory<T>::memory()
     _matrix        = nullptr;
     sizet_bytes    = 0;
     sizet_objects  = 0;
+    ptr_alloc      = nullptr;
 }
 
 template <class T> memory<T>::~memory() noexcept
@@ -94,6 +109,7 @@ template <class T> memory<T>::memory(const memory <T>& mat_arg)
     _matrix           = nullptr;
     sizet_objects     = 0;
     sizet_bytes       = 0;
+    ptr_alloc         = nullptr;
 
     size_t sizet_size = mat_arg.sizet_objects;
 
@@ -148,23 +164,26 @@ template <class T> void memory<T>::allocate(size_t sizet_size)
 
     if (sizet_objects == sizet_size) return;
 
-    sizet_objects = sizet_size;
-    sizet_bytes   = sizet_size * sizeof(T);
+    if (sizet_size == 0)
+    {
+        deallocate();
+        return;
+    }
+
+    size_t sizet_new_bytes = sizet_size * sizeof(T);
+    SUSA_PROFILE_ALLOCATION(sizet_new_bytes);
 
     if (_matrix == nullptr)
     {
-        void* block = std::malloc(sizet_bytes);
+        ptr_alloc   = get_allocator();
+        void* block = ptr_alloc->allocate(sizet_new_bytes);
         SUSA_ASSERT_MESSAGE(block != nullptr, "memory allocation failed.");
         if (block == nullptr) std::exit(EXIT_FAILURE);
         _matrix = static_cast<T*>(block);
     }
-    else if (sizet_size == 0)
-    {
-        deallocate();
-    }
     else
     {
-        void* block = std::realloc((void*)_matrix, sizet_bytes);
+        void* block = ptr_alloc->reallocate((void*)_matrix, sizet_bytes, sizet_new_bytes);
 
         SUSA_ASSERT_MESSAGE(block != nullptr, "memory allocation failed.");
 
@@ -176,13 +195,16 @@ template <class T> void memory<T>::allocate(size_t sizet_size)
 
         _matrix = static_cast<T*>(block);
     }
+
+    sizet_objects = sizet_size;
+    sizet_bytes   = sizet_new_bytes;
 }
 
 template <class T> void memory<T>::deallocate()
 {
     if (_matrix != nullptr)
     {
-        std::free(_matrix);
+        ptr_alloc->deallocate(_matrix, sizet_bytes);
         _matrix       = nullptr;
         sizet_objects = 0;
         sizet_bytes   = 0;
@@ -195,6 +217,16 @@ template <class T> size_t memory <T>::size() const
 }
 
 
+template <class T> inline T* memory <T>::data()
+{
+    return _matrix;
+}
+
+template <class T> inline const T* memory <T>::data() const
+{
+    return _matrix;
+}
+
 template <class T> memory <T>::memory(memory&& mat_arg) noexcept
 {
 
@@ -202,11 +234,31 @@ template <class T> memory <T>::memory(memory&& mat_arg) noexcept
   this->sizet_bytes   = mat_arg.sizet_bytes;
 
   this->_matrix         = mat_arg._matrix;
+  this->ptr_alloc       = mat_arg.ptr_alloc;
   mat_arg._matrix       = nullptr;
   mat_arg.sizet_objects = 0;
   mat_arg.sizet_bytes   = 0;
 
 }
 
+template <class T> memory <T>& memory <T>::operator=(memory&& mat_arg) noexcept
+{
+    if (this != &mat_arg)
+    {
+        deallocate();
+
+        this->sizet_objects   = mat_arg.sizet_objects;
+        this->sizet_bytes     = mat_arg.sizet_bytes;
+        this->_matrix         = mat_arg._matrix;
+        this->ptr_alloc       = mat_arg.ptr_alloc;
+
+        mat_arg._matrix       = nullptr;
+        mat_arg.sizet_objects = 0;
+        mat_arg.sizet_bytes   = 0;
+    }
+
+    return *this;
+}
+
 }
 #endif
@@ -0,0 +1,175 @@
+/*
+ * This file is part of Susa.
+ *
+ * Susa is free software: you can redistribute it and/or modify
+ * it under the terms of the Lesser GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * at your option) any later version.
+ *
+ * Susa is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * Lesser GNU General Public License for more details.
+ *
+ * You should have received a copy of the Lesser GNU General Public License
+ * along with Susa.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file metric.h
+ * @brief The metric types of the trellis decoders (declaration and definition).
+ *
+ * The path metrics of the decoders are either floating-point or saturating
+ * fixed-point numbers. The fixed-point additions saturate to the range of the
+ * type, as in the hardware decoders, and the decoders renormalize the metrics
+ * before they can reach the upper bound.
+ *
+ * @author Behrooz Kamary
+ * @version 1.0.0
+ *
+ * @defgroup Metric Decoder Metrics
+ */
+
+#ifndef SUSA_METRIC_H
+#define SUSA_METRIC_H
+
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+
+namespace susa {
+
+/**
+ * @brief The arithmetic of the saturating fixed-point metrics.
+ *
+ * The sums are clipped to the range of <i>T</i>. They are computed in the width
+ * of <i>T</i> with the overflow taken from the signs, hence the add-compare-select
+ * of the Viterbi decoder packs 8 (int16_t) or 16 (int8_t) metrics per 128 bits.
+ *
+ * @ingroup Metric
+ */
+template <typename T> struct metric_traits
+{
+    static_assert(std::is_integral <T>::value && std::is_signed <T>::value && sizeof(T) <= 2,
+      "the fixed-point metrics are signed integers of up to 16 bits.");
+
+    //! the metrics saturate
+    static const bool is_fixed = true;
+
+    //! the metric of the impossible states
+    static T lowest() { return std::numeric_limits <T>::min(); }
+
+    //! the largest metric
+    static T highest() { return std::numeric_limits <T>::max(); }
+
+    //! clips a 32-bit value to the range of the metric
+    static T saturate(int32_t int_x)
+    {
+        return static_cast <T> (int_x < lowest() ? lowest() : (int_x > highest() ? highest() : int_x));
+    }
+
+    //! the saturating sum
+    static T add(T t_a, T t_b)
+    {
+        U u_a = static_cast <U> (t_a), u_b = static_cast <U> (t_b), u_s = static_cast <U> (u_a + u_b);
+        return select(static_cast <U> (~(u_a ^ u_b) & (u_a ^ u_s)), u_a, u_s);
+    }
+
+    //! the saturating difference
+    static T sub(T t_a, T t_b)
+    {
+        U u_a = static_cast <U> (t_a), u_b = static_cast <U> (t_b), u_s = static_cast <U> (u_a - u_b);
+        return select(static_cast <U> ((u_a ^ u_b) & (u_a ^ u_s)), u_a, u_s);
+    }
+
+  private:
+    // the sums wrap in the unsigned type of the same width, i.e. a vector lane holds as many
+    // metrics as the width of T allows rather than those of 32 bits
+    typedef typename std::make_unsigned <T>::type U;
+    static const unsigned int uint_sign = 8 * sizeof(T) - 1;
+
+    // the sign bit of u_flag is set on an overflow, which has the sign of the first operand
+    // and is clipped to max + 1 (i.e. min) for a negative one and to max otherwise
+    static T select(U u_flag, U u_a, U u_s)
+    {
+        U u_mask  = static_cast <U> (static_cast <T> (u_flag) >> uint_sign);
+        U u_bound = static_cast <U> ((u_a >> uint_sign) + static_cast <U> (highest()));
+        return static_cast <T> ((u_bound & u_mask) | (u_s & static_cast <U> (~u_mask)));
+    }
+};
+
+//! The floating-point metrics
+template <> struct metric_traits <float>
+{
+    static const bool is_fixed = false;
+    static float lowest() { return -1e30f; }
+    static float highest() { return 1e30f; }
+    static float saturate(float flt_x) { return flt_x; }
+    static float add(float flt_a, float flt_b) { return flt_a + flt_b; }
+    static float sub(float flt_a, float flt_b) { return flt_a - flt_b; }
+};
+
+//! The double precision metrics
+template <> struct metric_traits <double>
+{
+    static const bool is_fixed = false;
+    static double lowest() { return -1e100; }
+    static double highest() { return 1e100; }
+    static double saturate(double dbl_x) { return dbl_x; }
+    static double add(double dbl_a, double dbl_b) { return dbl_a + dbl_b; }
+    static double sub(double dbl_a, double dbl_b) { return dbl_a - dbl_b; }
+};
+
+/**
+ * @brief The quantizer of the soft inputs of the decoders.
+ *
+ * A soft value <i>x</i> is mapped to round(x * scale) clipped to the symmetric
+ * range of a signed integer of <i>uint_bits</i> bits, i.e. [-(2^(b-1) - 1), 2^(b-1) - 1].
+ * Zero bits takes the range of the metric type. The floating-point metrics are
+ * only scaled unless the number of bits is set.
+ *
+ * @ingroup Metric
+ */
+struct llr_quantizer
+{
+    //! the steps per unit of the soft values
+    double   dbl_scale;
+
+    //! the width of the quantized values including the sign (zero for the width of the metric)
+    uint32_t uint_bits;
+
+    /**
+     * @brief Constructor
+     *
+     * @param dbl_scale the steps per unit of the soft values
+     * @param uint_bits the width of the quantized values including the sign
+     */
+    explicit llr_quantizer(double dbl_scale = 1, uint32_t uint_bits = 0)
+    : dbl_scale(dbl_scale), uint_bits(uint_bits)
+    {}
+
+    //! the largest magnitude of the quantized values of a metric type
+    template <typename T> T range() const
+    {
+        const double dbl_full = metric_traits <T>::is_fixed ? static_cast <double> (metric_traits <T>::highest()) : 0;
+        if (uint_bits == 0 || uint_bits > 31) return static_cast <T> (dbl_full);
+
+        double dbl_range = static_cast <double> ((1u << (uint_bits - 1)) - 1);
+        return static_cast <T> (metric_traits <T>::is_fixed && dbl_range > dbl_full ? dbl_full : dbl_range);
+    }
+
+    //! quantizes a soft value
+    template <typename T> T quantize(double dbl_x) const
+    {
+        double dbl_q = dbl_x * dbl_scale;
+        if (!metric_traits <T>::is_fixed && uint_bits == 0) return static_cast <T> (dbl_q);
+
+        double dbl_range = static_cast <double> (range <T> ());
+        dbl_q = std::floor(dbl_q + 0.5);
+        return static_cast <T> (dbl_q > dbl_range ? dbl_range : (dbl_q < -dbl_range ? -dbl_range : dbl_q));
+    }
+};
+
+}      // NAMESPACE SUSA
+#endif // SUSA_METRIC_H
@@ -39,8 +39,69 @@ namespace susa {
  */
 matrix <int8_t> bpsk(const matrix <uint8_t> &mat_arg);
 
+/**
+ * @brief The max-log LLRs of the Gray mapped bits of a square QAM axis
+ *
+ * The levels of an axis are <i>l - (side - 1) / 2</i> and the level <i>l</i> carries
+ * the Gray code of <i>l</i>, the most significant bit first. The loop over the values
+ * has no branches, hence it is vectorised, and the LLRs of the bit <i>b</i> are stored
+ * as the plane <i>ptr_llr + b * sizet_n</i>. A NaN value is sliced to the level zero
+ * and gives NaN LLRs.
+ *
+ * @param ptr_x the axis values, e.g. the interleaved real and imaginary parts
+ * @param sizet_n the number of values
+ * @param uint_side the number of levels of the axis
+ * @param uint_bpa the number of bits of the axis
+ * @param T_scale the inverse of the noise variance
+ * @param ptr_llr the planes of the LLRs
+ *
+ * @ingroup Communications
+ */
+template <class T> SUSA_INLINE_KERNEL void qam_max_log_llr(const T* ptr_x, size_t sizet_n, uint32_t uint_side, uint32_t uint_bpa,
+  T T_scale, T* ptr_llr)
+{
+    const T       T_offset = T(0.5) * (T(uint_side) - 1);
+    const T       T_last   = T(uint_side) - T(0.5);
+    const int32_t int_side = static_cast <int32_t> (uint_side);
+    const T       T_far    = std::numeric_limits <T>::max();
 
+    for (uint32_t uint_b = 0; uint_b < uint_bpa; uint_b++)
+    {
+        // the Gray bit j toggles between the levels p - 1 and p for p = 2^j (mod 2^(j+1))
+        const int32_t int_half   = int32_t(1) << (uint_bpa - 1 - uint_b);
+        const int32_t int_period = int_half << 1;
+        T*            ptr_plane  = ptr_llr + uint_b * sizet_n;
+
+        for (size_t sizet_i = 0; sizet_i < sizet_n; sizet_i++)
+        {
+            // the nearest level, the clipped value is not negative i.e. the truncation is the floor;
+            // the comparisons are false for NaN, hence it is clipped too and the conversion is defined
+            T T_level = ptr_x[sizet_i] + T(0.5) * T(uint_side);
+            T_level   = T_level >= 0 ? T_level : T(0);
+            T_level   = T_level <= T_last ? T_level : T_last;
+
+            int32_t int_near = static_cast <int32_t> (T_level);
+            int32_t int_low  = int_near - ((int_near - int_half) & (int_period - 1));
+            int32_t int_high = int_low + int_period;
 
+            T T_near  = ptr_x[sizet_i] - T(int_near) + T_offset;
+            T T_below = ptr_x[sizet_i] - T(int_low - 1) + T_offset;
+            T T_above = ptr_x[sizet_i] - T(int_high) + T_offset;
+
+            // the squares are not conditional, otherwise the trapping math keeps the branches
+            T_below *= T_below;
+            T_above *= T_above;
+            T T_other_below = int_low >= int_half ? T_below : T_far;
+            T T_other_above = int_high < int_side ? T_above : T_far;
+            T T_llr = ((T_other_below < T_other_above ? T_other_below : T_other_above) - T_near * T_near) * T_scale;
+
+            ptr_plane[sizet_i] = (((int_near ^ (int_near >> 1)) >> (uint_bpa - 1 - uint_b)) & 0x1) ? T_llr : -T_llr;
+        }
+    }
+}
+
+//! The max-log LLRs of a square QAM axis of double, selected by <i>cpu_dispatch()</i>
+void qam_max_log_llr(const double* ptr_x, size_t sizet_n, uint32_t uint_side, uint32_t uint_bpa, double dbl_scale, double* ptr_llr);
 
 /**
  * @brief QAM Modulation
@@ -50,11 +111,20 @@ matrix <int8_t> bpsk(const matrix <uint8_t> &mat_arg);
 class qam {
 
   public:
+
+    //! The metric of the soft demapper
+    enum llr_metric
+    {
+        MAX_LOG,    //!< the nearest symbols of each bit value
+        EXACT       //!< the sums over all the symbols of each bit value
+    };
+
     /**
      * @brief The constructor of the QAM modulation class
-     * @param uint_m The modulation order, e.g., 4,8,16,64,256
+     * @param uint_m The modulation order of a square QAM, e.g., 4, 16, 64, 256; zero (the default)
+     *               and the other orders leave the object without symbols
      */
-    qam(unsigned int uint_m);
+    qam(unsigned int uint_m = 0);
 
     ~qam();
 
@@ -70,23 +140,120 @@ class qam {
      */
     double get_noise_deviation(double dbl_arg);
 
+    /**
+     * @brief Gray mapped modulation of square QAM
+     *
+     * Each symbol takes log2(M) bits, the first half is the Gray code of the
+     * real (in-phase) level and the second half is the Gray code of the imaginary
+     * (quadrature) level, the most significant bit first.
+     *
+     * @param mat_bits the bits (zero or one), log2(M) bits per symbol
+     * @return a column vector of the symbols
+     */
     matrix < std::complex <double> > modulate_bits(matrix <char> mat_bits);
 
+    /**
+     * @brief Hard demodulation to the Gray mapped bits of <i>modulate_bits()</i>
+     *
+     * @param mat_symbols the received symbols
+     * @return a column vector of log2(M) bits per symbol
+     */
     matrix <char>   demodulate_bits(const matrix < std::complex <double> >& mat_symbols);
 
+    /**
+     * @brief Hard demodulation to the Gray mapped bits into a preallocated buffer
+     *
+     * @param mat_symbols the received symbols
+     * @param mat_bits the output, resized to log2(M) bits per symbol if it does not fit
+     */
+    void demodulate_bits(const matrix < std::complex <double> >& mat_symbols, matrix <char>& mat_bits);
+
+    /**
+     * @brief Hard demodulation to the symbol indices
+     *
+     * The index of a symbol is its position in the constellation matrix, see <i>get_constellation()</i>.
+     *
+     * @param mat_symbols the received symbols
+     * @return the indices with the shape of the input
+     */
     matrix <int>    demodulate_symbols(const matrix < std::complex <double> >& mat_symbols);
 
+    /**
+     * @brief Hard demodulation to the symbol indices into a preallocated buffer
+     *
+     * @param mat_symbols the received symbols
+     * @param mat_indices the output, resized to the shape of the input if it does not fit
+     */
+    void demodulate_symbols(const matrix < std::complex <double> >& mat_symbols, matrix <int>& mat_indices);
+
+    /**
+     * @brief The nearest constellation symbol
+     *
+     * The real and the imaginary parts are rounded independently onto the levels
+     * of the square grid, hence the cost does not depend on the modulation order.
+     *
+     * @param complex_arg the received symbol
+     */
     std::complex <double> demodulate_symbol(std::complex <double> complex_arg);
 
+    /**
+     * @brief Soft demodulation to the Log-Likelihood Ratios of the Gray mapped bits
+     *
+     * The real and the imaginary parts carry their bits independently, hence the
+     * demapper works on the levels of one axis. The max-log LLR of a bit is the
+     * difference of the distances to the nearest level and to the nearest level with
+     * the other bit value, which is found in O(1) on a Gray mapped axis. The exact LLRs
+     * sum the likelihoods of the levels of an axis. The LLRs are ln(P(1)/P(0)) in the
+     * order of <i>modulate_bits()</i>, i.e. positive for a one bit as the soft input of
+     * <i>ccode::decode_viterbi()</i>; <i>ccode::decode_bcjr_log()</i> takes them with
+     * Eb/N0 set to 0.25 (unit channel reliability).
+     *
+     * @param mat_symbols the received symbols
+     * @param dbl_noise_var the variance N0 of the complex noise
+     * @param metric the exact or the max-log metric
+     * @return a column vector of log2(M) LLRs per symbol
+     */
+    matrix <double> demodulate_llr(const matrix < std::complex <double> >& mat_symbols, double dbl_noise_var,
+      llr_metric metric = MAX_LOG);
+
+    /**
+     * @brief Soft demodulation into a preallocated buffer
+     *
+     * @param mat_symbols the received symbols
+     * @param dbl_noise_var the variance N0 of the complex noise
+     * @param mat_llr the output, resized to log2(M) LLRs per symbol if it does not fit
+     * @param metric the exact or the max-log metric
+     */
+    void demodulate_llr(const matrix < std::complex <double> >& mat_symbols, double dbl_noise_var, matrix <double>& mat_llr,
+      llr_metric metric = MAX_LOG);
+
   private:
     double          dbl_es;          // Energy per symbol
     double          dbl_eb;          // Energy per bit
     unsigned int    uint_bps;        // Number of bits per symbol
     unsigned int    uint_m;          // Number of symbols in constellation
 
+    unsigned int    uint_side;       // Number of levels per axis
+    unsigned int    uint_bpa;        // Number of bits per axis
+
     matrix < std::complex <double> > mat_s;
     matrix < std::complex <double> > mat_axis;
 
+    std::vector <unsigned int> vec_gray_level;  // the level of a Gray code
+
+    //! the exact LLRs of the bits of an axis, the scratch holds a value per level
+    void axis_llr(double dbl_arg, double dbl_scale, double* ptr_scratch, double* ptr_llr) const;
+
+    //! the nearest level of an axis
+    unsigned int slice(double dbl_arg) const
+    {
+        // the comparisons are false for NaN, hence it is clipped too and the conversion is defined
+        double dbl_level = std::floor(dbl_arg + 0.5 * uint_side);
+        dbl_level = dbl_level >= 0 ? dbl_level : 0;
+        dbl_level = dbl_level <= uint_side - 1 ? dbl_level : uint_side - 1;
+        return static_cast <unsigned int> (dbl_level);
+    }
+
     unsigned int log2(unsigned int uint_x);
 
 };
@@ -0,0 +1,201 @@
+/*
+ * This file is part of Susa.
+ *
+ * Susa is free software: you can redistribute it and/or modify
+ * it under the terms of the Lesser GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * at your option) any later version.
+ *
+ * Susa is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * Lesser GNU General Public License for more details.
+ *
+ * You should have received a copy of the Lesser GNU General Public License
+ * along with Susa.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file montecarlo.h
+ * @brief A parallel Monte Carlo error rate runner (declaration and definition).
+ * @author Behrooz Kamary
+ * @version 1.0.0
+ */
+
+#ifndef SUSA_MONTECARLO_H
+#define SUSA_MONTECARLO_H
+
+namespace susa {
+
+/**
+ * @brief The error counter of Monte Carlo trials
+ *
+ * @ingroup Communications
+ */
+struct mc_count
+{
+    uint64_t uint_errors;   //!< number of the erroneous samples (bits, symbols or frames)
+    uint64_t uint_samples;  //!< number of the observed samples
+};
+
+/**
+ * @brief The estimate of a simulation point
+ *
+ * @ingroup Communications
+ */
+struct mc_point
+{
+    double   dbl_snr;       //!< the simulation parameter, e.g. Eb/N0 in dB
+    uint64_t uint_errors;   //!< number of the erroneous samples
+    uint64_t uint_samples;  //!< number of the observed samples
+    uint64_t uint_trials;   //!< number of the trials
+
+    //! Returns the error rate
+    double rate() const;
+
+    /**
+     * @brief Returns the half width of the confidence interval of the error rate
+     *
+     * The normal approximation of the binomial distribution is used.
+     *
+     * @param dbl_z the quantile of the standard normal distribution (1.96 for 95%)
+     */
+    double half_width(double dbl_z = 1.96) const;
+};
+
+/**
+ * @brief The <i>montecarlo</i> class.
+ *
+ * It estimates error rates by repeating a trial (generate, modulate, pass the channel,
+ * demodulate and count the errors) on the thread pool. The trials are grouped in batches
+ * and the idle threads fetch the next batch, hence the load stays balanced when the trials
+ * have different costs. Every batch has its own generator stream keyed by the seed, the point
+ * index and the batch index, and the counters are merged in the batch order, hence the
+ * results do not depend on the number of threads. A point stops at the first batch that
+ * reaches the target number of errors, the target confidence or the maximum number of trials.
+ *
+ * @ingroup Communications
+ */
+class montecarlo
+{
+  public:
+    /**
+     * @brief Constructor
+     *
+     * @param uint_max_trials the maximum number of trials per point
+     * @param uint_target_errors a point stops once this number of errors is observed
+     * @param sizet_batch number of trials per batch
+     * @param uint_seed the seed of the generators
+     */
+    montecarlo(uint64_t uint_max_trials, uint64_t uint_target_errors = 100, size_t sizet_batch = 16,
+      unsigned int uint_seed = 5489);
+
+    /**
+     * @brief Stops a point once the confidence interval is narrow
+     *
+     * @param dbl_relative the half width of the interval relative to the error rate (zero disables it)
+     * @param dbl_z the quantile of the standard normal distribution (1.96 for 95%)
+     */
+    void set_confidence(double dbl_relative, double dbl_z = 1.96);
+
+    //! Sets the number of batches between two stop checks (it does not affect the results)
+    void set_round(size_t sizet_round);
+
+    /**
+     * @brief Simulates a point
+     *
+     * The trial is called concurrently as <i>mc_count func(double dbl_snr, rng& rng_gen)</i>,
+     * hence it may only read the shared objects and it shall draw all of its random numbers
+     * from <i>rng_gen</i>.
+     *
+     * @param dbl_snr the simulation parameter passed to the trial
+     * @param func the trial
+     * @param sizet_point the index of the point that selects the random streams
+     */
+    template <class F> mc_point run(double dbl_snr, F func, size_t sizet_point = 0) const;
+
+    /**
+     * @brief Simulates a sweep of points
+     *
+     * @param mat_snr the simulation parameters, e.g. Eb/N0 in dB
+     * @param func the trial, see <i>run()</i>
+     */
+    template <class F> std::vector <mc_point> sweep(const matrix <double>& mat_snr, F func) const;
+
+    //! Returns the random stream of a batch of a point
+    uint64_t batch_stream(size_t sizet_point, uint64_t uint_batch) const;
+
+  private:
+    uint64_t     uint_max_trials;
+    uint64_t     uint_target_errors;
+    size_t       sizet_batch;
+    size_t       sizet_round;
+    unsigned int uint_seed;
+    double       dbl_relative;
+    double       dbl_z;
+
+    //! the stop criteria of a point
+    bool is_done(const mc_point& point) const;
+};
+
+template <class F> mc_point montecarlo::run(double dbl_snr, F func, size_t sizet_point) const
+{
+    mc_point point = {dbl_snr, 0, 0, 0};
+
+    std::vector <mc_count> vec_counts(sizet_round);
+    std::vector <uint64_t> vec_trials(sizet_round);
+    thread_pool& pool = get_thread_pool();
+    uint64_t uint_batch = 0;
+
+    while (!is_done(point))
+    {
+        uint64_t uint_first   = uint_batch * sizet_batch;
+        uint64_t uint_batches = (uint_max_trials - uint_first + sizet_batch - 1) / sizet_batch;
+        size_t   sizet_tasks  = uint_batches < sizet_round ? uint_batches : sizet_round;
+
+        pool.run(sizet_tasks, [&](size_t sizet_task)
+        {
+            uint64_t uint_begin = (uint_batch + sizet_task) * sizet_batch;
+            uint64_t uint_end   = std::min <uint64_t> (uint_begin + sizet_batch, uint_max_trials);
+            rng      rng_gen(uint_seed, batch_stream(sizet_point, uint_batch + sizet_task));
+            mc_count count = {0, 0};
+
+            for (uint64_t uint_trial = uint_begin; uint_trial < uint_end; uint_trial++)
+            {
+                mc_count trial = func(dbl_snr, rng_gen);
+                count.uint_errors  += trial.uint_errors;
+                count.uint_samples += trial.uint_samples;
+            }
+
+            vec_counts[sizet_task] = count;
+            vec_trials[sizet_task] = uint_end - uint_begin;
+        });
+
+        // the merge in the batch order makes the stop point independent of the scheduling
+        for (size_t sizet_task = 0; sizet_task < sizet_tasks && !is_done(point); sizet_task++)
+        {
+            point.uint_errors  += vec_counts[sizet_task].uint_errors;
+            point.uint_samples += vec_counts[sizet_task].uint_samples;
+            point.uint_trials  += vec_trials[sizet_task];
+        }
+
+        uint_batch += sizet_tasks;
+    }
+
+    return point;
+}
+
+template <class F> std::vector <mc_point> montecarlo::sweep(const matrix <double>& mat_snr, F func) const
+{
+    std::vector <mc_point> vec_points;
+
+    for (size_t sizet_point = 0; sizet_point < mat_snr.size(); sizet_point++)
+    {
+        vec_points.push_back(run(mat_snr(sizet_point), func, sizet_point));
+    }
+
+    return vec_points;
+}
+
+}       // NAMESPACE SUSA
+#endif  // SUSA_MONTECARLO_H
@@ -52,8 +52,8 @@ class mt {
 
   private:
     matrix <double>       mat_probabilities;
-    matrix <unsigned int> mat_sort_indices;
-    matrix <double>       mat_prob_sorted;
+    std::vector <double>  vec_alias_prob;  /* the Walker/Vose alias table */
+    std::vector <uint32_t> vec_alias;
     uint32_t*             uint_mt; /* the array for the state vector  */
     int                   mti;   /* mti==N+1 means mt[N] is not initialized */
 
@@ -68,6 +68,9 @@ class mt {
     double genrand_real3(void);        // generates uniform real in (0,1) (32-bit resolution).
     double genrand_res53(void);        // generates uniform real in [0,1) with 53-bit resolution.
 
+    // draws from an alias table with one uniform number and one comparison
+    unsigned int alias_sample(const double* ptr_prob, const uint32_t* ptr_alias, size_t sizet_size);
+
   public:
     //! Constructor
     mt(void);
@@ -79,6 +82,16 @@ class mt {
      */
     mt(uint32_t uint_seed);
 
+    /**
+     * @brief Constructor of a stream
+     *
+     * The state is initialized by <i>init_by_array()</i> from the key (seed, stream).
+     *
+     * @param uint_seed the random number generator initial seed
+     * @param uint_stream the stream index
+     */
+    mt(uint32_t uint_seed, uint64_t uint_stream);
+
     //! Destructor
     ~mt();
 
@@ -104,14 +117,32 @@ class mt {
 
     matrix <double> rand(unsigned int uint_num);
 
+    /**
+     * @brief Sets the probabilities of the preset non-uniform distribution
+     *
+     * The Walker/Vose alias table is built once in O(K), hence a draw of
+     * <i>nonuniform()</i> costs O(1) whatever the number of outcomes.
+     *
+     * @param mat_probabilities the (not necessarily normalized) probabilities of the outcomes
+     */
     void set_probabilities(matrix <double> mat_probabilities);
 
+    /**
+     * @brief Draws from a non-uniform distribution
+     *
+     * A single draw inverts the cumulative distribution in O(K).
+     *
+     * @param mat_probabilities the probabilities of the outcomes
+     */
     unsigned int nonuniform(matrix <double> mat_probabilities);
 
+    //! Draws from the preset distribution in O(1)
     unsigned int nonuniform();
-    
+
+    //! Draws a column vector from a non-uniform distribution through a temporary alias table
     matrix <unsigned int> nonuniform(matrix <double> mat_probabilities, unsigned int uint_length);
-    
+
+    //! Draws a column vector from the preset distribution in O(1) per sample
     matrix <unsigned int> nonuniform(unsigned int uint_length);
 };
 
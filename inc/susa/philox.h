@@ -0,0 +1,143 @@
+/*
+ * This file is part of Susa.
+ *
+ * Susa is free software: you can redistribute it and/or modify
+ * it under the terms of the Lesser GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * at your option) any later version.
+ *
+ * Susa is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * Lesser GNU General Public License for more details.
+ *
+ * You should have received a copy of the Lesser GNU General Public License
+ * along with Susa.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file philox.h
+ * @brief Counter-based random number generator (declaration).
+ * @author Behrooz Kamary
+ * @version 1.0.0
+ */
+
+#ifndef SUSA_PHILOX_H
+#define SUSA_PHILOX_H
+
+#include <cstdint>
+
+namespace susa {
+
+/**
+ * @brief The Philox4x32-10 counter-based random number generator class.
+ *
+ * The n-th block of four 32 bit outputs is the ten-round Philox bijection of the
+ * counter (n, stream) under the key (seed). There is no state to advance, hence
+ * <i>seek()</i> jumps anywhere in a stream in constant time and the streams of
+ * different indices are independent by construction. A thread or a task that
+ * draws from <i>stream(i)</i> produces the same numbers whatever the number of
+ * threads. See <i>J. K. Salmon et al., Parallel random numbers: as easy as 1, 2, 3, SC11</i>.
+ * The methods mirror the interface of <i>rng</i>.
+ *
+ * @ingroup RNG
+ */
+class philox
+{
+  public:
+    /**
+     * @brief Constructor
+     *
+     * @param uint_seed the seed i.e. the key of the bijection
+     * @param uint_stream the stream index
+     */
+    explicit philox(uint64_t uint_seed = 0, uint64_t uint_stream = 0);
+
+    /**
+     * @brief Initializes the generator
+     *
+     * @param uint_seed the seed i.e. the key of the bijection
+     * @param uint_stream the stream index
+     */
+    void init(uint64_t uint_seed, uint64_t uint_stream = 0);
+
+    /**
+     * @brief Returns the generator of another stream with the same seed
+     *
+     * @param uint_stream the stream index
+     */
+    philox stream(uint64_t uint_stream) const;
+
+    /**
+     * @brief Moves to a position of the stream
+     *
+     * @param uint_position the index of the next 32 bit output
+     */
+    void seek(uint64_t uint_position);
+
+    //! Skips a number of 32 bit outputs
+    void discard(uint64_t uint_num);
+
+    //! Returns the index of the next 32 bit output
+    uint64_t position() const
+    {
+        return uint_counter * 4 + uint_index - 4;
+    }
+
+    //! uniformly distributed random 32 bit unsigned integer
+    uint32_t rand_uint();
+
+    //! gaussian distributed random double with mean value equal to zero and unit variance
+    double randn();
+
+    //! uniformly distributed random double in (0, 1)
+    double rand();
+
+    /**
+     * @brief uniformly distributed random unsigned integers
+     *
+     * @param uint_mask used to mask output numbers
+     */
+    unsigned int rand_mask(unsigned int uint_mask);
+
+    /**
+     * @brief uniformly distributed random unsigned integers
+     *
+     * @param uint_mask used to mask output numbers
+     * @param uint_num number of output samples
+     */
+    matrix <unsigned int> rand_mask(unsigned int uint_mask, unsigned int uint_num);
+
+    //! a column vector of gaussian distributed random doubles
+    matrix <double> randn(unsigned int uint_num);
+
+    //! a column vector of uniformly distributed random doubles
+    matrix <double> rand(unsigned int uint_num);
+
+    //! a matrix of uniformly distributed random doubles
+    matrix <double> rand(unsigned int uint_rows, unsigned int uint_cols);
+
+    //! a column vector of Bernoulli random samples
+    matrix <unsigned char> bernoulli(size_t size_num);
+
+    /**
+     * @brief The Philox4x32-10 bijection
+     *
+     * @param ptr_counter the four words of the counter
+     * @param ptr_key the two words of the key
+     * @param ptr_out the four output words
+     */
+    static void block(const uint32_t* ptr_counter, const uint32_t* ptr_key, uint32_t* ptr_out);
+
+  private:
+    uint32_t uint_key[2];
+    uint64_t uint_stream;
+    uint64_t uint_counter;   // the index of the next block
+    uint32_t uint_buffer[4];
+    uint32_t uint_index;     // the next output in the buffer (four for an empty buffer)
+
+    void generate_block();
+};
+
+}      // NAMESPACE SUSA
+#endif // SUSA_PHILOX_H
@@ -0,0 +1,185 @@
+/*
+ * This file is part of Susa.
+ *
+ * Susa is free software: you can redistribute it and/or modify
+ * it under the terms of the Lesser GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * at your option) any later version.
+ *
+ * Susa is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * Lesser GNU General Public License for more details.
+ *
+ * You should have received a copy of the Lesser GNU General Public License
+ * along with Susa.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file profile.h
+ * @brief Scoped timers and counters of the hot paths (declaration).
+ *
+ * A <i>SUSA_PROFILE_SCOPE("bcjr.forward")</i> measures the enclosing scope
+ * with the steady clock and counts the buffers allocated in it. Every thread
+ * accumulates into its own table without a lock, the tables are merged only
+ * when a report is requested. The times and the allocations are inclusive,
+ * i.e. a scope contains its nested scopes.
+ *
+ * The macros compile to nothing when <i>SUSA_NDEBUG</i> or <i>SUSA_NO_PROFILE</i>
+ * is defined.
+ *
+ * @author Behrooz Kamary
+ * @version 1.0.0
+ *
+ * @defgroup Profile Profiling
+ */
+
+#ifndef SUSA_PROFILE_H
+#define SUSA_PROFILE_H
+
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace susa {
+
+//! The maximum number of the distinct scope names
+static const size_t PROFILE_MAX_SITES = 256;
+
+/**
+ * @brief The accumulated measurement of a scope.
+ *
+ * @ingroup Profile
+ */
+struct profile_record
+{
+    std::string str_name;       //!< the scope name
+    uint64_t    uint_calls;     //!< the number of calls (or the counter value)
+    uint64_t    uint_nanos;     //!< the total time in nanoseconds
+    uint64_t    uint_allocs;    //!< the number of buffer allocations
+    uint64_t    uint_bytes;     //!< the allocated bytes
+
+    //! Returns the total time in seconds
+    double total() const
+    {
+        return uint_nanos * 1e-9;
+    }
+
+    //! Returns the average time of a call in seconds
+    double average() const
+    {
+        return uint_calls == 0 ? 0 : total() / uint_calls;
+    }
+};
+
+/**
+ * @brief A registered scope name.
+ *
+ * The sites with the same name share a record, e.g. the instantiations
+ * of a template.
+ *
+ * @ingroup Profile
+ */
+class profile_site
+{
+  public:
+    //! Registers the name (thread-safe)
+    explicit profile_site(const char* char_name);
+
+    //! Returns the record index
+    size_t id() const
+    {
+        return sizet_id;
+    }
+
+  private:
+    size_t sizet_id;
+};
+
+/**
+ * @brief The timer of a scope.
+ *
+ * @ingroup Profile
+ */
+class profile_scope
+{
+  public:
+    explicit profile_scope(const profile_site& site);
+    ~profile_scope();
+
+    profile_scope(const profile_scope&) = delete;
+    profile_scope& operator=(const profile_scope&) = delete;
+
+  private:
+    typedef std::chrono::steady_clock clock;
+
+    size_t              sizet_id;
+    uint64_t            uint_allocs;
+    uint64_t            uint_bytes;
+    clock::time_point   tp_start;
+};
+
+/**
+ * @brief Adds to the counter of a site on the calling thread.
+ *
+ * @param site the site
+ * @param uint_value the increment
+ * @ingroup Profile
+ */
+void profile_count(const profile_site& site, uint64_t uint_value);
+
+/**
+ * @brief Counts a buffer allocation on the calling thread.
+ *
+ * @param sizet_bytes the buffer size in bytes
+ * @ingroup Profile
+ */
+void profile_allocation(size_t sizet_bytes);
+
+/**
+ * @brief Merges the tables of all the threads.
+ *
+ * The threads that are still running are read while they accumulate,
+ * the result is exact once they are idle.
+ *
+ * @return the records of the sites that were called, in the registration order
+ * @ingroup Profile
+ */
+std::vector <profile_record> profile_report();
+
+/**
+ * @brief Writes the report as a table sorted by the total time.
+ *
+ * @param os the output stream
+ * @ingroup Profile
+ */
+void profile_print(std::ostream& os = std::cout);
+
+/**
+ * @brief Clears the tables of all the threads.
+ *
+ * @ingroup Profile
+ */
+void profile_reset();
+
+}      // NAMESPACE SUSA
+
+#define SUSA_PROFILE_JOIN_(A, B) A##B
+#define SUSA_PROFILE_JOIN(A, B) SUSA_PROFILE_JOIN_(A, B)
+
+#if defined(SUSA_NDEBUG) || defined(SUSA_NO_PROFILE)
+#define SUSA_PROFILE_SCOPE(NAME) ((void)0)
+#define SUSA_PROFILE_COUNT(NAME, VALUE) ((void)0)
+#define SUSA_PROFILE_ALLOCATION(BYTES) ((void)0)
+#else
+#define SUSA_PROFILE_SCOPE(NAME) \
+    static const susa::profile_site SUSA_PROFILE_JOIN(susa_profile_site_, __LINE__)(NAME); \
+    susa::profile_scope SUSA_PROFILE_JOIN(susa_profile_scope_, __LINE__)(SUSA_PROFILE_JOIN(susa_profile_site_, __LINE__))
+#define SUSA_PROFILE_COUNT(NAME, VALUE) \
+    do { static const susa::profile_site susa_profile_counter(NAME); susa::profile_count(susa_profile_counter, VALUE); } while (0)
+#define SUSA_PROFILE_ALLOCATION(BYTES) (susa::profile_allocation(BYTES))
+#endif
+
+#endif // SUSA_PROFILE_H
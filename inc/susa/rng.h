@@ -60,6 +60,18 @@ class rng {
      */
     rng(unsigned int uint_seed);
 
+    /**
+     * @brief Constructor of a stream
+     *
+     * The state is initialized from the key (seed, stream) as in the reference
+     * <i>init_by_array()</i> of MT19937, hence the streams of a seed start from
+     * unrelated states. The <i>philox</i> generator gives provably independent streams.
+     *
+     * @param uint_seed RNG initial seed
+     * @param uint_stream the stream index
+     */
+    rng(unsigned int uint_seed, uint64_t uint_stream);
+
     /**
      * @brief Initializes the RNG
      *
@@ -67,6 +79,14 @@ class rng {
      */
     void init(unsigned int uint_seed);
 
+    /**
+     * @brief Initializes the RNG with a stream
+     *
+     * @param uint_seed RNG initial seed
+     * @param uint_stream the stream index
+     */
+    void init(unsigned int uint_seed, uint64_t uint_stream);
+
     /**
      * @brief gaussian distributed random double
      * with mean value equal to zero and unit variance.
@@ -136,6 +156,52 @@ class rng {
      */
     matrix <unsigned char> bernoulli(size_t size_num);
 
+    /**
+     * @brief Packed Bernoulli random samples
+     *
+     * Every 64 bit word is filled from two 32 bit draws, hence a sample costs
+     * 1/32 of a draw instead of a draw per sample of <i>bernoulli()</i>.
+     *
+     * @param sizet_num number of samples
+     * @return the equiprobable bits
+     */
+    bitvec bernoulli_packed(size_t sizet_num);
+
+    //! Fills a bit vector with equiprobable bits
+    void fill_bits(bitvec& bv_arg);
+
+    /**
+     * @brief Fills a matrix with uniformly distributed random numbers in [0, 1]
+     *
+     * The generator state is tempered in blocks straight into the buffer. The numbers
+     * are the ones that successive calls of <i>rand()</i> would return.
+     *
+     * @param mat_arg the matrix to be filled
+     */
+    void fill_uniform(matrix <double>& mat_arg);
+
+    //! Fills a matrix with uniformly distributed random numbers in [0, 1]
+    void fill_uniform(matrix <float>& mat_arg);
+
+    /**
+     * @brief Fills a matrix with gaussian distributed random numbers
+     *
+     * The Ziggurat method of Marsaglia and Tsang with 128 layers is used, hence most
+     * of the samples cost one 32 bit draw, one comparison and one multiplication.
+     * The numbers differ from the ones of <i>randn()</i>.
+     *
+     * @param mat_arg the matrix to be filled with zero mean and unit variance samples
+     */
+    void fill_normal(matrix <double>& mat_arg);
+
+    /**
+     * @brief Fills a matrix with circularly symmetric complex gaussian random numbers
+     *
+     * @param mat_arg the matrix to be filled
+     * @param dbl_sigma the standard deviation of the real and the imaginary parts
+     */
+    void fill_complex_normal(matrix <std::complex <double> >& mat_arg, double dbl_sigma = 1);
+
     enum
     {
         W = 32,
@@ -169,6 +235,12 @@ class rng {
     void generate_numbers();
     unsigned int extract_number();
 
+    //! tempers the state in blocks into a buffer
+    void fill_uint(uint32_t* ptr_out, size_t sizet_num);
+
+    //! fills a buffer with Ziggurat normal samples
+    void fill_normal(double* ptr_out, size_t sizet_num, size_t sizet_stride, double dbl_sigma);
+
 
     unsigned int GetUInt();
     unsigned int GetNonUniform(double* pr, unsigned int n);
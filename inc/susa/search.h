@@ -34,9 +34,12 @@ namespace susa {
 /**
  * @brief Finds the <i>uint_num</i> least elements of the input vector.
  *
- * @param mat_arg Input vector
+ * The selection is a partial sort in O(n + k log k) time. A matrix is processed column-wise.
+ *
+ * @param mat_arg Input vector or matrix
  * @param uint_num Number of elements to be find before the routine terminates
- * @return Returns a vector that contains indeces of elements in the input vector that have least values.
+ * @return Returns a vector that contains indeces of elements in the input vector that have least values
+ * in the ascending order, or the row indices of every column of a matrix.
  *
  * @ingroup Search
  */
@@ -58,12 +61,14 @@ template <class T> matrix <unsigned int> select_limited_least(const matrix <T> &
 
 
 /**
- * @brief Finds the <i>uint_num</i> greatest elements of the input vector among a selected number of
- elements that their indeces are specified by <i>mat_limited_index</i>.
+ * @brief Finds the <i>uint_num</i> greatest elements of the input vector.
  *
- * @param mat_arg Input vector
+ * The selection is a partial sort in O(n + k log k) time. A matrix is processed column-wise.
+ *
+ * @param mat_arg Input vector or matrix
  * @param uint_num Number of elements to be find before the routine terminates
- * @return Returns a vector that contains indeces of elements in the input vector that have least values.
+ * @return Returns a vector that contains indeces of elements in the input vector that have greatest values
+ * in the descending order, or the row indices of every column of a matrix.
  *
  * @ingroup Search
  */
@@ -80,158 +85,305 @@ template <class T> matrix <unsigned int> select_most(const matrix <T> &mat_arg,
  */
 template <class T> susa::bitset find(const matrix <T> &mat_arg, T &T_arg);
 
+/**
+ * @brief The compressed sparse row (CSR) adjacency of a weighted directed graph
+ *
+ * The edges leaving the vertex <i>u</i> are the targets and the weights in
+ * [offset(u), offset(u + 1)).
+ *
+ * @ingroup Search
+ */
+template <class T> class csr_graph
+{
+  public:
+    //! Constructor of an empty graph
+    csr_graph();
+
+    /**
+     * @brief Constructor from an edge list
+     *
+     * @param uint_nodes number of vertices
+     * @param vec_from the source vertex of every edge
+     * @param vec_to the target vertex of every edge
+     * @param vec_weights the nonnegative weight of every edge
+     */
+    csr_graph(unsigned int uint_nodes, const std::vector <unsigned int>& vec_from,
+      const std::vector <unsigned int>& vec_to, const std::vector <T>& vec_weights);
+
+    /**
+     * @brief Constructor from a dense weight matrix
+     *
+     * @param mat_graph the square weight matrix, a zero weight is no edge
+     */
+    explicit csr_graph(const matrix <T>& mat_graph);
+
+    /**
+     * @brief Constructor from a sparse weight matrix
+     *
+     * @param mat_graph the square weight matrix, a stored entry is an edge
+     */
+    explicit csr_graph(const sparse_matrix <T>& mat_graph);
+
+    //! Returns the number of vertices
+    unsigned int no_nodes() const
+    {
+        return vec_offsets.size() - 1;
+    }
+
+    //! Returns the number of edges
+    size_t no_edges() const
+    {
+        return vec_targets.size();
+    }
+
+    //! Returns the first edge of a vertex
+    size_t offset(unsigned int uint_node) const
+    {
+        return vec_offsets[uint_node];
+    }
+
+    //! Returns the target vertex of an edge
+    unsigned int target(size_t sizet_edge) const
+    {
+        return vec_targets[sizet_edge];
+    }
+
+    //! Returns the weight of an edge
+    T weight(size_t sizet_edge) const
+    {
+        return vec_weights[sizet_edge];
+    }
+
+  private:
+    std::vector <size_t>       vec_offsets;
+    std::vector <unsigned int> vec_targets;
+    std::vector <T>            vec_weights;
+};
+
+/**
+ * @brief A binary min-heap of vertices with decrease-key
+ *
+ * The keys live outside of the heap and the position of every vertex
+ * in the heap is tracked, hence a key may decrease in O(log n).
+ *
+ * @ingroup Search
+ */
+template <class T> class indexed_heap
+{
+  public:
+    /**
+     * @brief Constructor
+     *
+     * @param vec_keys the keys of the vertices
+     */
+    explicit indexed_heap(const std::vector <T>& vec_keys);
+
+    //! Returns true if the heap is empty
+    bool empty() const
+    {
+        return vec_heap.empty();
+    }
+
+    //! Inserts a vertex or moves it up after its key decreased
+    void push(unsigned int uint_node);
+
+    //! Removes and returns the vertex with the least key
+    unsigned int pop();
+
+  private:
+    const std::vector <T>&     vec_keys;
+    std::vector <unsigned int> vec_heap;
+    std::vector <unsigned int> vec_position;
+
+    void sift_up(size_t sizet_i);
+    void sift_down(size_t sizet_i);
+};
+
+//! the predecessor of a vertex that has none
+const unsigned int DIJKSTRA_NONE = std::numeric_limits <unsigned int>::max();
+
+/**
+ * @brief Dijkstra finds the shortest paths from a source
+ *
+ * The vertices are settled in the order of their distances from a binary heap with
+ * decrease-key, hence it takes O((V + E) log V) time and O(V) memory besides the graph.
+ * A sum of integer weights saturates at the largest value instead of overflowing.
+ *
+ * @param  graph       The graph with nonnegative weights
+ * @param  uint_source The starting vertex in the graph
+ * @param  vec_dist    The distances, the largest value (or infinity) if a vertex is unreachable
+ * @param  vec_prev    The predecessors on the shortest paths, <i>DIJKSTRA_NONE</i> for the source and the unreachable vertices
+ * @param  uint_target The search stops once this vertex is settled (<i>DIJKSTRA_NONE</i> settles all of them)
+ *
+ * @return true if the target (or any vertex) was reached
+ * @ingroup Search
+ */
+template <class T> bool dijkstra(const csr_graph <T>& graph, unsigned int uint_source, std::vector <T>& vec_dist,
+  std::vector <unsigned int>& vec_prev, unsigned int uint_target = DIJKSTRA_NONE);
+
 /**
  * @brief Dijkstra finds the shortest path
  * @param  mat_graph   The input path weights' matrix i.e. graph edges
  * @param  uint_source The starting vertex in the graph
  *
- * @return The path cost for all vertices of the graph
+ * @return The predecessors on the shortest paths, the source and the unreachable vertices are their own predecessors
  * @ingroup Search
  */
 template <class T> matrix <unsigned int> dijkstra(const matrix <T> &mat_graph, unsigned int uint_source);
 
 /**
- * @brief Bubble sort
+ * @brief Sorts the elements in the ascending order (introsort)
  *
- * @return The the elements in decending order.
+ * A vector is sorted as a whole, the columns of a matrix are sorted separately.
+ *
+ * @param mat_arg Input matrix
+ * @return The sorted elements in the shape of the input.
+ * @ingroup Search
  */
 template <class T> matrix <T> sort(const matrix <T> &mat_arg);
 
+/**
+ * @brief Sorts the elements in the ascending order keeping the order of the equal elements
+ *
+ * @param mat_arg Input matrix
+ * @return The sorted elements in the shape of the input.
+ * @ingroup Search
+ */
+template <class T> matrix <T> stable_sort(const matrix <T> &mat_arg);
 
 /**
- * @brief Bubble sort
+ * @brief Sorts the indices of the elements (argsort)
  *
- * @return The <i>indecies</i> of the elements in decending order.
+ * @param mat_arg Input matrix
+ * @return The <i>indices</i> of the elements in the ascending order of their values,
+ * a column vector for a vector input or the row indices of every column for a matrix.
+ * @ingroup Search
  */
 template <class T> matrix <unsigned int> sort_indices(const matrix <T> &mat_arg);
 
+/**
+ * @brief Sorts the indices of the elements keeping the order of the equal elements
+ *
+ * @param mat_arg Input matrix
+ * @return The <i>indices</i> in the shape of <i>sort_indices()</i>.
+ * @ingroup Search
+ */
+template <class T> matrix <unsigned int> stable_sort_indices(const matrix <T> &mat_arg);
 
-// Implementation
-template <class T> matrix <unsigned int> select_least(const matrix <T> &mat_arg, unsigned int uint_num)
-{
-
-    //TODO support matrices
-    SUSA_ASSERT_MESSAGE(mat_arg.is_vector(), "this method supports one dimensional matrices (vectors) only.");
-
-    unsigned int uint_size = mat_arg.size();
-    matrix <T> mat_ret     = mat_arg;
-    matrix <unsigned int> mat_index(uint_num, 1);
 
-    SUSA_ASSERT_MESSAGE(uint_size > uint_num, "The number of elements to be selected is larger than the matrix size.");
+// Implementation
 
-    if (uint_size < uint_num)
+/**
+ * @brief Sorts a range of indices by the values they point at
+ */
+template <class T> void sort_index_range(const T* ptr_value, unsigned int* ptr_first, unsigned int* ptr_last, bool bool_stable)
+{
+    if (bool_stable)
     {
-        return mat_index;
+        std::stable_sort(ptr_first, ptr_last, [ptr_value](unsigned int uint_a, unsigned int uint_b)
+        {
+            return ptr_value[uint_a] < ptr_value[uint_b];
+        });
     }
-
-    unsigned int uint_min_index;
-    T T_min;
-
-    for (unsigned int uint_i = 0; uint_i < uint_num; uint_i++)
+    else
     {
-        uint_min_index = uint_i;
-        T_min = mat_ret(uint_i);
-        for (unsigned int uint_j = 0; uint_j < uint_size; uint_j++)
+        std::sort(ptr_first, ptr_last, [ptr_value](unsigned int uint_a, unsigned int uint_b)
         {
-            if (mat_ret(uint_j) < T_min)
-            {
-                uint_min_index = uint_j;
-                T_min = mat_ret(uint_j);
-            }
-        }
-
-        mat_index(uint_i) = uint_min_index;
-
-        mat_ret(uint_min_index) = std::numeric_limits<T>::max();
+            return ptr_value[uint_a] < ptr_value[uint_b];
+        });
     }
-
-    return mat_index;
 }
 
-template <class T> matrix <unsigned int> select_limited_least(const matrix <T> &mat_arg,
-                                         const matrix <unsigned int> &mat_limited_index,
-                                         unsigned int uint_num)
+/**
+ * @brief Moves the indices of the <i>uint_num</i> least (or greatest) values to the front in order
+ *
+ * <i>nth_element</i> partitions the range in linear time and only the selected head is sorted.
+ * The equal values are ordered by their indices.
+ */
+template <class T> void select_index_range(const T* ptr_value, unsigned int* ptr_first, unsigned int* ptr_last,
+  unsigned int uint_num, bool bool_most)
 {
+    unsigned int* ptr_nth = ptr_first + std::min <size_t> (uint_num, ptr_last - ptr_first);
 
-    //TODO support matrices
-    SUSA_ASSERT_MESSAGE(mat_arg.is_vector(), "this method supports one dimensional matrices (vectors) only.");
-
-    unsigned int uint_size = mat_arg.size();
-    matrix <T> mat_ret     = mat_arg;
-    matrix <unsigned int> mat_index(uint_num, 1);
+    auto cmp_least = [ptr_value](unsigned int uint_a, unsigned int uint_b)
+    {
+        return ptr_value[uint_a] < ptr_value[uint_b] || (!(ptr_value[uint_b] < ptr_value[uint_a]) && uint_a < uint_b);
+    };
+    auto cmp_most = [ptr_value](unsigned int uint_a, unsigned int uint_b)
+    {
+        return ptr_value[uint_b] < ptr_value[uint_a] || (!(ptr_value[uint_a] < ptr_value[uint_b]) && uint_a < uint_b);
+    };
 
-    SUSA_ASSERT_MESSAGE(uint_size > uint_num, "The number of elements to be selected is larger than the matrix size.");
-    if (uint_size < uint_num)
+    if (bool_most)
+    {
+        if (ptr_nth < ptr_last) std::nth_element(ptr_first, ptr_nth, ptr_last, cmp_most);
+        std::sort(ptr_first, ptr_nth, cmp_most);
+    }
+    else
     {
-        return mat_index;
+        if (ptr_nth < ptr_last) std::nth_element(ptr_first, ptr_nth, ptr_last, cmp_least);
+        std::sort(ptr_first, ptr_nth, cmp_least);
     }
+}
 
-    unsigned int uint_min_index;
-    T T_min;
+//! column-wise selection behind <i>select_least()</i> and <i>select_most()</i>
+template <class T> matrix <unsigned int> select_columns(const matrix <T> &mat_arg, unsigned int uint_num, bool bool_most)
+{
+    size_t sizet_rows = mat_arg.is_vector() ? mat_arg.size() : mat_arg.no_rows();
+    size_t sizet_cols = mat_arg.is_vector() ? 1 : mat_arg.no_cols();
 
-    for( unsigned int uint_i = 0; uint_i < uint_num; uint_i++)
-    {
-        uint_min_index = uint_i;
-        T_min = mat_ret(uint_i);
-        for (unsigned int uint_j = 0; uint_j < mat_limited_index.size(); uint_j++)
-        {
-            if (mat_ret(mat_limited_index(uint_j)) < T_min)
-            {
-                uint_min_index = mat_limited_index(uint_j);
-                T_min = mat_ret(mat_limited_index(uint_j));
-            }
-        }
+    SUSA_ASSERT_MESSAGE(uint_num <= sizet_rows, "The number of elements to be selected is larger than the matrix size.");
+    if (uint_num > sizet_rows || uint_num == 0) return matrix <unsigned int> ();
 
-        mat_index(uint_i) = uint_min_index;
+    matrix <unsigned int>       mat_index(uint_num, sizet_cols);
+    std::vector <unsigned int>  vec_index(sizet_rows);
 
-        mat_ret(uint_min_index) = std::numeric_limits<T>::max();
+    for (size_t sizet_col = 0; sizet_col < sizet_cols; sizet_col++)
+    {
+        for (size_t sizet_i = 0; sizet_i < sizet_rows; sizet_i++) vec_index[sizet_i] = sizet_i;
+        select_index_range(mat_arg.data() + sizet_col * sizet_rows, vec_index.data(), vec_index.data() + sizet_rows,
+          uint_num, bool_most);
+        std::copy(vec_index.begin(), vec_index.begin() + uint_num, mat_index.data() + sizet_col * uint_num);
     }
 
     return mat_index;
 }
 
-template <class T> matrix <unsigned int> select_most(const matrix <T> &mat_arg, unsigned int uint_num)
+template <class T> matrix <unsigned int> select_least(const matrix <T> &mat_arg, unsigned int uint_num)
 {
+    return select_columns(mat_arg, uint_num, false);
+}
 
-    //TODO support matrices
+template <class T> matrix <unsigned int> select_limited_least(const matrix <T> &mat_arg,
+                                         const matrix <unsigned int> &mat_limited_index,
+                                         unsigned int uint_num)
+{
     SUSA_ASSERT_MESSAGE(mat_arg.is_vector(), "this method supports one dimensional matrices (vectors) only.");
+    SUSA_ASSERT_MESSAGE(mat_limited_index.size() >= uint_num,
+      "The number of elements to be selected is larger than the number of candidates.");
 
-    unsigned int uint_size = mat_arg.size();
-    matrix <T> mat_ret     = mat_arg;
-    matrix <unsigned int> mat_index(uint_num, 1);
-
+    if (mat_limited_index.size() < uint_num || uint_num == 0) return matrix <unsigned int> ();
 
-    SUSA_ASSERT_MESSAGE(uint_size > uint_num,
-      "The number of elements to be selected is larger than the matrix size.");
-    if (uint_size < uint_num)
+    std::vector <unsigned int> vec_index(mat_limited_index.data(), mat_limited_index.data() + mat_limited_index.size());
+    for (size_t sizet_i = 0; sizet_i < vec_index.size(); sizet_i++)
     {
-        return mat_index;
+        SUSA_ASSERT_MESSAGE(vec_index[sizet_i] < mat_arg.size(), "the candidate index is out of range.");
+        if (vec_index[sizet_i] >= mat_arg.size()) return matrix <unsigned int> ();
     }
 
-    unsigned int uint_max_index;
-    T T_max;
+    select_index_range(mat_arg.data(), vec_index.data(), vec_index.data() + vec_index.size(), uint_num, false);
 
-    for( unsigned int uint_i = 0; uint_i < uint_num; uint_i++)
-    {
-        uint_max_index = uint_i;
-        T_max = mat_ret(uint_i);
-        for (unsigned int uint_j = 0; uint_j < uint_size; uint_j++)
-        {
-            if (mat_ret(uint_j) > T_max)
-            {
-                uint_max_index = uint_j;
-                T_max = mat_ret(uint_j);
-            }
-        }
-
-        mat_index(uint_i) = uint_max_index;
-
-        mat_ret(uint_max_index) = std::numeric_limits<T>::min();
-    }
+    matrix <unsigned int> mat_index(uint_num, 1);
+    std::copy(vec_index.begin(), vec_index.begin() + uint_num, mat_index.data());
 
     return mat_index;
 }
 
+template <class T> matrix <unsigned int> select_most(const matrix <T> &mat_arg, unsigned int uint_num)
+{
+    return select_columns(mat_arg, uint_num, true);
+}
+
 
 template <class T> susa::bitset find(const matrix <T> &mat_arg, T &T_arg)
 {
@@ -250,130 +402,283 @@ template <class T> susa::bitset find(const matrix <T> &mat_arg, T &T_arg)
 }
 
 
-template <class T> matrix <unsigned int> dijkstra(const matrix <T> &mat_graph, unsigned int uint_src)
+template <class T> csr_graph<T>::csr_graph()
+: vec_offsets(1, 0)
 {
+}
 
-  SUSA_ASSERT_MESSAGE(mat_graph.is_square(), "the weight matrix must be square.");
-
-  if (!mat_graph.is_square()) return (matrix <unsigned int> ());
+template <class T> csr_graph<T>::csr_graph(unsigned int uint_nodes, const std::vector <unsigned int>& vec_from,
+  const std::vector <unsigned int>& vec_to, const std::vector <T>& vec_weights)
+: vec_offsets(uint_nodes + 1, 0)
+{
+    SUSA_ASSERT_MESSAGE(vec_from.size() == vec_to.size() && vec_from.size() == vec_weights.size(),
+      "the edge lists have different lengths.");
 
-  unsigned int uint_num_nodes = mat_graph.no_cols();
-  susa::matrix <unsigned int> dist(uint_num_nodes, 1, std::numeric_limits<int>::max());
-  susa::matrix <unsigned int> prev(uint_num_nodes, 1);
+    size_t sizet_edges = std::min(vec_from.size(), std::min(vec_to.size(), vec_weights.size()));
 
-  dist(uint_src) = 0;
+    // a graph with an edge out of range is rejected i.e. it is left empty
+    for (size_t sizet_e = 0; sizet_e < sizet_edges; sizet_e++)
+    {
+        bool bool_valid = vec_from[sizet_e] < uint_nodes && vec_to[sizet_e] < uint_nodes;
+        SUSA_ASSERT_MESSAGE(bool_valid, "the vertex is out of range.");
+        if (!bool_valid)
+        {
+            vec_offsets.assign(1, 0);
+            return;
+        }
+    }
 
-  susa::bitset nset(uint_num_nodes);
-  nset.set();
+    // a counting sort of the edges by their source vertex
+    for (size_t sizet_e = 0; sizet_e < sizet_edges; sizet_e++) vec_offsets[vec_from[sizet_e] + 1]++;
 
+    for (unsigned int uint_u = 0; uint_u < uint_nodes; uint_u++) vec_offsets[uint_u + 1] += vec_offsets[uint_u];
 
-  unsigned int uint_min       = 0;
-  unsigned int uint_min_index = 0;
-  unsigned int uint_alt       = 0;
-  while (nset.any())
-  {
+    vec_targets.resize(sizet_edges);
+    this->vec_weights.resize(sizet_edges);
+    std::vector <size_t> vec_fill(vec_offsets.begin(), vec_offsets.end() - 1);
 
-    uint_min = std::numeric_limits <unsigned int>::max();
-    for (unsigned int uint_index = 0; uint_index < uint_num_nodes; uint_index++)
+    for (size_t sizet_e = 0; sizet_e < sizet_edges; sizet_e++)
     {
-      if (nset.exists(uint_index) && dist(uint_index) < uint_min)
-      {
-        uint_min_index = uint_index;
-        uint_min = dist(uint_index);
-      }
+        size_t sizet_at = vec_fill[vec_from[sizet_e]]++;
+        vec_targets[sizet_at]       = vec_to[sizet_e];
+        this->vec_weights[sizet_at] = vec_weights[sizet_e];
     }
+}
 
-    nset.reset(uint_min_index);
+template <class T> csr_graph<T>::csr_graph(const matrix <T>& mat_graph)
+: vec_offsets(1, 0)
+{
+    SUSA_ASSERT_MESSAGE(mat_graph.is_square(), "the weight matrix must be square.");
+    if (!mat_graph.is_square()) return;
 
+    unsigned int uint_nodes = mat_graph.no_rows();
+    vec_offsets.reserve(uint_nodes + 1);
 
-    for (unsigned int uint_i = 0; uint_i < uint_num_nodes; uint_i++)
+    for (unsigned int uint_u = 0; uint_u < uint_nodes; uint_u++)
     {
-      if (mat_graph(uint_min_index,uint_i)) // if zero then there is no way
-      {
-        uint_alt = dist(uint_min_index) + mat_graph(uint_min_index,uint_i);
-        if (uint_alt < dist(uint_i))
+        for (unsigned int uint_v = 0; uint_v < uint_nodes; uint_v++)
         {
-          dist(uint_i) = uint_alt;
-          prev(uint_i) = uint_min_index;
+            // if zero then there is no way
+            if (mat_graph(uint_u, uint_v) != T(0))
+            {
+                vec_targets.push_back(uint_v);
+                vec_weights.push_back(mat_graph(uint_u, uint_v));
+            }
         }
-      }
+        vec_offsets.push_back(vec_targets.size());
     }
-  }
+}
 
-  return prev;
+template <class T> csr_graph<T>::csr_graph(const sparse_matrix <T>& mat_graph)
+: vec_offsets(1, 0)
+{
+    SUSA_ASSERT_MESSAGE(mat_graph.no_rows() == mat_graph.no_cols(), "the weight matrix must be square.");
+    if (mat_graph.no_rows() != mat_graph.no_cols()) return;
+
+    // the CSR storage is the adjacency list as it is
+    sparse_matrix <T> mat_csr = mat_graph.to_csr();
+    vec_offsets = mat_csr.outer_ptr();
+    vec_targets = mat_csr.inner_index();
+    vec_weights = mat_csr.values();
 }
 
+template <class T> indexed_heap<T>::indexed_heap(const std::vector <T>& vec_keys)
+: vec_keys(vec_keys)
+, vec_position(vec_keys.size(), std::numeric_limits <unsigned int>::max())
+{
+}
 
-template <class T> matrix <unsigned int> sort_indices(const matrix <T> &mat_arg)
+template <class T> void indexed_heap<T>::push(unsigned int uint_node)
 {
+    if (vec_position[uint_node] == std::numeric_limits <unsigned int>::max())
+    {
+        vec_position[uint_node] = vec_heap.size();
+        vec_heap.push_back(uint_node);
+    }
 
-    //TODO support matrices
-    SUSA_ASSERT_MESSAGE(mat_arg.is_vector(), "this method supports one dimensional matrices (vectors) only.");
+    sift_up(vec_position[uint_node]);
+}
 
-    unsigned int uint_size = mat_arg.size();
+template <class T> unsigned int indexed_heap<T>::pop()
+{
+    unsigned int uint_top = vec_heap.front();
+    vec_position[uint_top] = std::numeric_limits <unsigned int>::max();
 
-    matrix <T>   mat_elements = mat_arg;
-    matrix <unsigned int> mat_indices(uint_size, 1);
+    unsigned int uint_last = vec_heap.back();
+    vec_heap.pop_back();
 
-    T            T_max        = mat_arg(max(mat_arg)(0));
-    unsigned int uint_indx    = 0;
-    unsigned int uint_indx_e  = 0;
+    if (!vec_heap.empty())
+    {
+        vec_heap[0] = uint_last;
+        vec_position[uint_last] = 0;
+        sift_down(0);
+    }
 
+    return uint_top;
+}
 
+template <class T> void indexed_heap<T>::sift_up(size_t sizet_i)
+{
+    unsigned int uint_node = vec_heap[sizet_i];
 
-    while(T_max != mat_elements(min(mat_elements)(0)) && uint_indx < uint_size)
+    while (sizet_i > 0)
     {
-        mat_indices(uint_indx) = min(mat_elements)(0);
-        mat_elements(mat_indices(uint_indx)) = T_max;
-        uint_indx++;
+        size_t sizet_parent = (sizet_i - 1) / 2;
+        if (!(vec_keys[uint_node] < vec_keys[vec_heap[sizet_parent]])) break;
+
+        vec_heap[sizet_i] = vec_heap[sizet_parent];
+        vec_position[vec_heap[sizet_i]] = sizet_i;
+        sizet_i = sizet_parent;
     }
 
-    for (unsigned int uint_indx_i = uint_indx; uint_indx_i < uint_size; uint_indx_i++)
+    vec_heap[sizet_i] = uint_node;
+    vec_position[uint_node] = sizet_i;
+}
+
+template <class T> void indexed_heap<T>::sift_down(size_t sizet_i)
+{
+    unsigned int uint_node = vec_heap[sizet_i];
+    size_t       sizet_size = vec_heap.size();
+
+    while (2 * sizet_i + 1 < sizet_size)
     {
-        while (uint_indx_e < uint_size)
-        {
-            if (mat_arg(uint_indx_e) == T_max)
-            {
-                mat_indices(uint_indx_i) = uint_indx_e;
-                uint_indx_e++;
-                break;
-            }
-            uint_indx_e++;
-        }
+        size_t sizet_child = 2 * sizet_i + 1;
+        if (sizet_child + 1 < sizet_size && vec_keys[vec_heap[sizet_child + 1]] < vec_keys[vec_heap[sizet_child]]) sizet_child++;
+        if (!(vec_keys[vec_heap[sizet_child]] < vec_keys[uint_node])) break;
+
+        vec_heap[sizet_i] = vec_heap[sizet_child];
+        vec_position[vec_heap[sizet_i]] = sizet_i;
+        sizet_i = sizet_child;
     }
 
-    return mat_indices;
+    vec_heap[sizet_i] = uint_node;
+    vec_position[uint_node] = sizet_i;
 }
 
-template <class T> matrix <T> sort(const matrix <T> &mat_arg)
+template <class T> bool dijkstra(const csr_graph <T>& graph, unsigned int uint_source, std::vector <T>& vec_dist,
+  std::vector <unsigned int>& vec_prev, unsigned int uint_target)
 {
+    const unsigned int uint_nodes = graph.no_nodes();
+    const T T_inf = std::numeric_limits <T>::has_infinity ? std::numeric_limits <T>::infinity() : std::numeric_limits <T>::max();
 
-    //TODO support matrices
-    SUSA_ASSERT_MESSAGE(mat_arg.is_vector(), "this method supports one dimensional matrices (vectors) only.");
+    vec_dist.assign(uint_nodes, T_inf);
+    vec_prev.assign(uint_nodes, DIJKSTRA_NONE);
+
+    SUSA_ASSERT_MESSAGE(uint_source < uint_nodes, "the source vertex is out of range.");
+    if (uint_source >= uint_nodes) return false;
 
-    unsigned int uint_size   = mat_arg.size();
-    matrix <T>   mat_return  = mat_arg;
-    T T_swap;
-    bool bool_changed = false;
+    std::vector <char> vec_settled(uint_nodes, 0);
+    indexed_heap <T>   heap(vec_dist);
 
-    for (unsigned int uint_indx = 0; uint_indx < uint_size; uint_indx++)
+    vec_dist[uint_source] = T(0);
+    heap.push(uint_source);
+
+    while (!heap.empty())
     {
-        for (unsigned int uint_indx_ = uint_indx + 1; uint_indx_ < uint_size; uint_indx_++)
+        unsigned int uint_u = heap.pop();
+        vec_settled[uint_u] = 1;
+
+        if (uint_u == uint_target) return true;
+
+        const T T_du = vec_dist[uint_u];
+        for (size_t sizet_e = graph.offset(uint_u); sizet_e < graph.offset(uint_u + 1); sizet_e++)
         {
-            if (mat_return(uint_indx_) < mat_return(uint_indx))
+            unsigned int uint_v = graph.target(sizet_e);
+            T            T_w    = graph.weight(sizet_e);
+            if (vec_settled[uint_v] || T_w > T_inf - T_du) continue;
+
+            T T_alt = T_du + T_w;
+            if (T_alt < vec_dist[uint_v])
             {
-                T_swap = mat_return(uint_indx);
-                mat_return(uint_indx) = mat_return(uint_indx_);
-                mat_return(uint_indx_) = T_swap;
-                bool_changed = true;
+                vec_dist[uint_v] = T_alt;
+                vec_prev[uint_v] = uint_u;
+                heap.push(uint_v);
             }
         }
-        if (!bool_changed) break;
-        bool_changed = false;
+    }
+
+    return uint_target == DIJKSTRA_NONE;
+}
+
+template <class T> matrix <unsigned int> dijkstra(const matrix <T> &mat_graph, unsigned int uint_src)
+{
+
+  SUSA_ASSERT_MESSAGE(mat_graph.is_square(), "the weight matrix must be square.");
+
+  if (!mat_graph.is_square()) return (matrix <unsigned int> ());
+
+  unsigned int uint_num_nodes = mat_graph.no_cols();
+  std::vector <T>            vec_dist;
+  std::vector <unsigned int> vec_prev;
+
+  dijkstra(csr_graph <T> (mat_graph), uint_src, vec_dist, vec_prev);
+
+  susa::matrix <unsigned int> prev(uint_num_nodes, 1);
+  for (unsigned int uint_i = 0; uint_i < uint_num_nodes; uint_i++)
+  {
+    prev(uint_i) = vec_prev[uint_i] == DIJKSTRA_NONE ? uint_i : vec_prev[uint_i];
+  }
+
+  return prev;
+}
+
+
+//! column-wise argsort behind <i>sort_indices()</i> and <i>stable_sort_indices()</i>
+template <class T> matrix <unsigned int> sort_index_columns(const matrix <T> &mat_arg, bool bool_stable)
+{
+    size_t sizet_rows = mat_arg.is_vector() ? mat_arg.size() : mat_arg.no_rows();
+    size_t sizet_cols = mat_arg.is_vector() ? 1 : mat_arg.no_cols();
+
+    if (mat_arg.size() == 0) return matrix <unsigned int> ();
+
+    matrix <unsigned int> mat_indices(sizet_rows, sizet_cols);
+
+    for (size_t sizet_col = 0; sizet_col < sizet_cols; sizet_col++)
+    {
+        unsigned int* ptr_first = mat_indices.data() + sizet_col * sizet_rows;
+        for (size_t sizet_i = 0; sizet_i < sizet_rows; sizet_i++) ptr_first[sizet_i] = sizet_i;
+        sort_index_range(mat_arg.data() + sizet_col * sizet_rows, ptr_first, ptr_first + sizet_rows, bool_stable);
+    }
+
+    return mat_indices;
+}
+
+//! column-wise sort behind <i>sort()</i> and <i>stable_sort()</i>
+template <class T> matrix <T> sort_columns(const matrix <T> &mat_arg, bool bool_stable)
+{
+    size_t     sizet_rows = mat_arg.is_vector() ? mat_arg.size() : mat_arg.no_rows();
+    size_t     sizet_cols = mat_arg.is_vector() ? 1 : mat_arg.no_cols();
+    matrix <T> mat_return = mat_arg;
+
+    for (size_t sizet_col = 0; sizet_col < sizet_cols; sizet_col++)
+    {
+        T* ptr_first = mat_return.data() + sizet_col * sizet_rows;
+        if (bool_stable) std::stable_sort(ptr_first, ptr_first + sizet_rows);
+        else std::sort(ptr_first, ptr_first + sizet_rows);
     }
 
     return mat_return;
 }
 
+template <class T> matrix <unsigned int> sort_indices(const matrix <T> &mat_arg)
+{
+    return sort_index_columns(mat_arg, false);
+}
+
+template <class T> matrix <unsigned int> stable_sort_indices(const matrix <T> &mat_arg)
+{
+    return sort_index_columns(mat_arg, true);
+}
+
+template <class T> matrix <T> sort(const matrix <T> &mat_arg)
+{
+    return sort_columns(mat_arg, false);
+}
+
+template <class T> matrix <T> stable_sort(const matrix <T> &mat_arg)
+{
+    return sort_columns(mat_arg, true);
+}
+
 }      // NAMESPACE SUSA
 #endif // SUSA_SEARCH_H
@@ -22,8 +22,6 @@
  * @version 1.0.0
  *
  * @defgroup Signal Signal Processing
- *
- * @todo <i>filter</i> and <i>conv</i> do not support all input matrices' sizes. it looks complicated to solve.
  */
 
 #ifndef SIGNAL_H
@@ -53,11 +51,54 @@ template <class T> matrix <T> upsample(const matrix <T> &mat_arg, size_t uint_u)
  */
 template <class T> matrix <T> downsample(const matrix <T> &mat_arg, size_t uint_d);
 
+/**
+ * @brief Sets the length from which the convolutions use the FFT
+ *
+ * <i>conv</i> and the FIR (single AR coefficient) <i>filter</i> of the floating point
+ * and complex types use the overlap-save FFT convolution when both the filter and the
+ * input vectors have at least this length. The default is 64; the maximum
+ * <i>size_t</i> value disables the FFT convolution.
+ *
+ * @param sizet_threshold the minimum filter and input length
+ *
+ * @ingroup Signal
+ */
+void set_fft_conv_threshold(size_t sizet_threshold);
+
+/**
+ * @brief Returns the length from which the convolutions use the FFT
+ *
+ * @ingroup Signal
+ */
+size_t get_fft_conv_threshold();
+
+/**
+ * @brief Overlap-save FIR convolution
+ *
+ * y(n) = b(0)*x(n) + b(1)*x(n-1) + ... + b(nb-1)*x(n-nb+1) for n < size_y
+ * where x is zero outside its <i>size_x</i> samples. The FFT size is
+ * a power of two about four times the filter length.
+ *
+ * @param ptr_b the filter coefficients
+ * @param size_b number of filter coefficients
+ * @param ptr_x the input samples
+ * @param size_x number of input samples
+ * @param ptr_y the output samples
+ * @param size_y number of output samples
+ *
+ * @ingroup Signal
+ */
+template <class T, class TT> void overlap_save(const TT* ptr_b, size_t size_b, const T* ptr_x, size_t size_x, T* ptr_y, size_t size_y);
+
 /**
  * @brief Filter
  *
  * y(n) = b(1)*x(n) + b(2)*x(n-1) + ... + b(nb+1)*x(n-nb) - a(2)*y(n-1) - ... - a(na+1)*y(n-na)
  *
+ * A matrix input is filtered column-wise. The FIR filters of the floating
+ * point and complex types use the FFT (see <i>set_fft_conv_threshold()</i>),
+ * the shorter ones use <i>fir_kernel()</i> and the IIR filters <i>iir_kernel()</i>.
+ *
  * @param mat_arg_b Moving Average (MA) coefficients
  * @param mat_arg_a Autoregressive (AR) coefficients.
  * @param mat_arg_x Input data to be filtered.
@@ -71,9 +112,12 @@ template <class T, class TT> matrix <T> filter(const matrix <TT>& mat_arg_b, con
 /**
  * @brief Convolution
  *
+ * A matrix is convolved column-wise with a vector, and two matrices with the
+ * same number of columns are convolved column by column.
+ *
  * @param mat_arg_a
  * @param mat_arg_b
- * @return convolution of the two input vectors
+ * @return convolution of the two inputs
  *
  * @ingroup Signal
  */
@@ -117,7 +161,7 @@ template <class T> matrix <T> toeplitz(const matrix <T>& mat_col);
 
 template <class T> matrix <T> upsample(const matrix <T> &mat_arg, size_t uint_u)
 {
-    matrix <T> mat_tmp(uint_u * mat_arg.no_rows(), mat_arg.no_cols());
+    matrix <T> mat_tmp(uint_u * mat_arg.no_rows(), mat_arg.no_cols(), T(0));
 
     for (size_t size_col = 0; size_col < mat_arg.no_cols(); size_col++)
     {
@@ -145,88 +189,208 @@ template <class T> matrix <T> downsample(const matrix <T> &mat_arg, size_t uint_
     return mat_tmp;
 }
 
-// FILTER
+// OVERLAP-SAVE
 
-template <class T, class TT> matrix <T> filter( const matrix <TT>& mat_arg_b, const matrix <TT>& mat_arg_a, const matrix <T>& mat_arg_x, size_t size_length)
+// conversions between the FFT buffers and the (real or complex) sample types
+template <class T> struct fft_value
 {
+    template <class R> static T from(const std::complex <R>& cplx_arg)
+    {
+        return (T)cplx_arg.real();
+    }
 
-    size_t      size_ret_len = 0;
-    matrix <T>  mat_y;
-
-    size_t size_b       = mat_arg_b.size();
-    size_t size_a       = mat_arg_a.size();
-    size_t size_x_rows  = mat_arg_x.no_rows();
-    size_t size_x_cols  = mat_arg_x.no_cols();
-    size_t size_x       = mat_arg_x.size();
+    static T real(const T& T_arg)
+    {
+        return T_arg;
+    }
+};
 
-    T x;
-    T y;
+template <class T> struct fft_value <std::complex <T> >
+{
+    template <class R> static std::complex <T> from(const std::complex <R>& cplx_arg)
+    {
+        return std::complex <T> (cplx_arg);
+    }
 
-    if (size_x_cols > 1 && size_x_rows > 1)
+    static T real(const std::complex <T>& T_arg)
     {
-        size_ret_len = size_x_rows + size_length;
-        mat_y = matrix <T> (size_ret_len, size_x_cols, 0);
-        size_t size_y_rows = mat_y.no_rows();
+        return T_arg.real();
+    }
+};
+
+template <class T, class TT> void overlap_save(const TT* ptr_b, size_t size_b, const T* ptr_x, size_t size_x, T* ptr_y, size_t size_y)
+{
+    typedef typename real_type <T>::type R;
+
+    size_t size_conv  = size_x + size_b - 1;
+    size_t size_valid = size_y < size_conv ? size_y : size_conv;
+
+    for (size_t size_i = size_valid; size_i < size_y; size_i++) ptr_y[size_i] = T(0);
+    if (size_valid == 0) return;
+
+    // the FFT needs not be larger than the whole convolution
+    size_t size_n = 1;
+    while (size_n < 4 * size_b) size_n <<= 1;
+    size_t size_full = 1;
+    while (size_full < size_conv) size_full <<= 1;
+    if (size_full < size_n) size_n = size_full;
 
-        for (size_t size_col = 0; size_col < size_x_cols; size_col++)
+    size_t size_step = size_n - size_b + 1;
+
+    fft_plan <R> plan(size_n);
+
+    std::vector <std::complex <R> > vec_h(size_n, std::complex <R> (0));
+    for (size_t size_k = 0; size_k < size_b; size_k++) vec_h[size_k] = std::complex <R> (ptr_b[size_k]);
+    plan.forward(vec_h.data());
+
+    // two real blocks are transformed at once as the real and the imaginary parts
+    const bool bool_pack = !is_complex <T>::value && !is_complex <TT>::value;
+    size_t size_blocks = bool_pack ? 2 : 1;
+
+    std::vector <std::complex <R> > vec_buf(size_n);
+
+    for (size_t size_begin = 0; size_begin < size_valid; size_begin += size_blocks * size_step)
+    {
+        for (size_t size_j = 0; size_j < size_n; size_j++)
         {
-            for (size_t i = 0 ; i < size_ret_len; i++)
+            std::complex <R> cplx_v(0);
+            for (size_t size_blk = 0; size_blk < size_blocks; size_blk++)
             {
-                for (size_t k = 0; k < size_b; k++)
+                // input index: begin + blk * step + j - (b - 1)
+                size_t size_pos = size_begin + size_blk * size_step + size_j;
+                if (size_pos + 1 < size_b || size_pos + 1 - size_b >= size_x) continue;
+
+                if (bool_pack)
                 {
-                    x = (i < (size_x_rows + k) && ((i + 1) > k)) ? mat_arg_x(i - k, size_col) : 0;
-                    mat_y(i, size_col) += x * mat_arg_b(k);
+                    R R_x = (R)fft_value <T>::real(ptr_x[size_pos + 1 - size_b]);
+                    cplx_v += size_blk == 0 ? std::complex <R> (R_x, 0) : std::complex <R> (0, R_x);
                 }
-                for (size_t k = 1; k < size_a; k++)
+                else
                 {
-                    y = (i < (size_y_rows + k) && ((i + 1) > k)) ? mat_y(i - k, size_col) : 0;
-                    mat_y(i, size_col) -= y * mat_arg_a(k);
+                    cplx_v = std::complex <R> (ptr_x[size_pos + 1 - size_b]);
                 }
             }
+            vec_buf[size_j] = cplx_v;
         }
-    }
-    else if (size_x_cols == 1 && size_x_rows > 1)
-    {
-        // for column vector
-        size_ret_len = size_x + size_length;
-        mat_y = matrix <T> (size_ret_len, 1, 0);
-        size_t size_y      = mat_y.size();
 
-        for (size_t i = 0; i< size_ret_len; i++)
+        plan.forward(vec_buf.data());
+        for (size_t size_j = 0; size_j < size_n; size_j++) vec_buf[size_j] = fft_mul(vec_buf[size_j], vec_h[size_j]);
+        plan.inverse(vec_buf.data());
+
+        for (size_t size_blk = 0; size_blk < size_blocks; size_blk++)
         {
-            for (size_t k = 0; k < size_b; k++)
+            size_t size_first = size_begin + size_blk * size_step;
+            for (size_t size_j = 0; size_j < size_step && size_first + size_j < size_valid; size_j++)
             {
-                x = (i < (size_x + k) && ((i + 1) > k)) ? mat_arg_x(i - k) : 0;
-                mat_y(i) += x * mat_arg_b(k);
-            }
-            for (size_t k = 1; k < size_a; k++)
-            {
-                y = (i < (size_y + k) && ((i + 1) > k)) ? mat_y(i - k) : 0;
-                mat_y(i) -= y * mat_arg_a(k);
+                const std::complex <R>& cplx_y = vec_buf[size_b - 1 + size_j];
+                ptr_y[size_first + size_j] = size_blk == 0 ? fft_value <T>::from(cplx_y)
+                                                           : fft_value <T>::from(std::complex <R> (cplx_y.imag(), 0));
             }
         }
     }
-    else if (size_x_cols > 1 && size_x_rows == 1)
+}
+
+// the FFT convolution is only used for the floating point and complex types
+template <class T, class TT> bool filter_fft(const matrix <TT>&, const matrix <T>&, matrix <T>&, size_t, std::false_type)
+{
+    return false;
+}
+
+template <class T, class TT> bool filter_fft(const matrix <TT>& mat_arg_b, const matrix <T>& mat_arg_x, matrix <T>& mat_y,
+  size_t size_length, std::true_type)
+{
+    bool   bool_matrix = mat_arg_x.no_rows() > 1 && mat_arg_x.no_cols() > 1;
+    size_t size_len    = bool_matrix ? mat_arg_x.no_rows() : mat_arg_x.size();
+    size_t size_batch  = bool_matrix ? mat_arg_x.no_cols() : 1;
+    size_t size_ret    = size_len + size_length;
+
+    if (mat_arg_x.no_rows() == 1) mat_y = matrix <T> (1, size_ret);
+    else mat_y = matrix <T> (size_ret, size_batch);
+
+    const TT* ptr_b = mat_arg_b.data();
+    const T*  ptr_x = mat_arg_x.data();
+    T*        ptr_y = mat_y.data();
+    size_t    size_b = mat_arg_b.size();
+
+    parallel_for(0, size_batch, 1, [&](size_t size_first, size_t size_last)
+    {
+        for (size_t size_col = size_first; size_col < size_last; size_col++)
+        {
+            overlap_save(ptr_b, size_b, ptr_x + size_col * size_len, size_len, ptr_y + size_col * size_ret, size_ret);
+        }
+    });
+
+    return true;
+}
+
+// FILTER
+
+template <class T, class TT> matrix <T> filter( const matrix <TT>& mat_arg_b, const matrix <TT>& mat_arg_a, const matrix <T>& mat_arg_x, size_t size_length)
+{
+    SUSA_PROFILE_SCOPE("signal.filter");
+
+    size_t      size_ret_len = 0;
+    matrix <T>  mat_y;
+
+    size_t size_b       = mat_arg_b.size();
+    size_t size_a       = mat_arg_a.size();
+    size_t size_x_rows  = mat_arg_x.no_rows();
+    size_t size_x_cols  = mat_arg_x.no_cols();
+    size_t size_x       = mat_arg_x.size();
+
+    size_t size_vec = (size_x_cols > 1 && size_x_rows > 1) ? size_x_rows : size_x;
+    typedef std::integral_constant <bool, std::is_floating_point <typename real_type <T>::type>::value
+                                       && std::is_floating_point <typename real_type <TT>::type>::value> fft_type;
+
+    if (size_a <= 1 && size_x > 1 && size_b > 0
+        && size_b >= get_fft_conv_threshold() && size_vec >= get_fft_conv_threshold()
+        && filter_fft(mat_arg_b, mat_arg_x, mat_y, size_length, fft_type()))
     {
-        // for row vector
-        size_ret_len = mat_arg_x.size() + size_length;
-        mat_y = matrix <T> (1, size_ret_len, 0);
-        size_t size_y      = mat_y.size();
+        return mat_y;
+    }
+
+    if (size_x == 0) return mat_y;
 
-        for (size_t i = 0 ; i < size_ret_len; i++)
+    // a vector or each column of a matrix is a contiguous run of samples
+    size_t size_batch = (size_x_cols > 1 && size_x_rows > 1) ? size_x_cols : 1;
+    size_ret_len      = size_vec + size_length;
+
+    if (size_x_rows == 1 && size_x_cols > 1) mat_y = matrix <T> (1, size_ret_len);
+    else mat_y = matrix <T> (size_ret_len, size_batch);
+
+    const T* ptr_x = mat_arg_x.data();
+    T*       ptr_y = mat_y.data();
+
+    if (size_a <= 1)
+    {
+        const TT* ptr_b = mat_arg_b.data();
+        parallel_for(0, size_batch, 1, [&](size_t size_first, size_t size_last)
         {
-            for (size_t k = 0; k < size_b; k++)
-            {
-                x = (i < (size_x + k) && ((i + 1) > k)) ? mat_arg_x(i - k) : 0;
-                mat_y(i) += x * mat_arg_b(k);
-            }
-            for (size_t k = 1; k < size_a; k++)
+            for (size_t size_col = size_first; size_col < size_last; size_col++)
             {
-                y = (i < (size_y + k) && ((i + 1) > k)) ? mat_y(i - k) : 0;
-                mat_y(i) -= y * mat_arg_a(k);
+                fir_kernel(ptr_b, size_b, ptr_x + size_col * size_vec, size_vec, ptr_y + size_col * size_ret_len, 0, size_ret_len);
             }
+        });
+    }
+    else
+    {
+        // the transposed direct form II with the coefficients padded to the same length
+        size_t size_order = std::max(size_a, size_b) - 1;
+        std::vector <TT> vec_b(size_order + 1, TT(0));
+        std::vector <TT> vec_a(size_order + 1, TT(0));
+        for (size_t size_k = 0; size_k < size_b; size_k++) vec_b[size_k] = mat_arg_b(size_k);
+        for (size_t size_k = 1; size_k < size_a; size_k++) vec_a[size_k] = mat_arg_a(size_k);
+
+        std::vector <T> vec_state(size_order);
+        for (size_t size_col = 0; size_col < size_batch; size_col++)
+        {
+            T* ptr_out = ptr_y + size_col * size_ret_len;
+            std::fill(vec_state.begin(), vec_state.end(), T(0));
+            iir_kernel(vec_b.data(), vec_a.data(), vec_state.data(), size_order, ptr_x + size_col * size_vec, ptr_out, size_vec);
+            iir_kernel(vec_b.data(), vec_a.data(), vec_state.data(), size_order, static_cast <const T*> (nullptr), ptr_out + size_vec, size_length);
         }
     }
+
     return mat_y;
 }
 
@@ -257,13 +421,12 @@ template <class T> matrix <T> conv(const matrix <T>& mat_arg_a, const matrix <T>
         mat_ret = mat_arg_a(0) * mat_arg_b;
     } else if ((mat_arg_b.no_cols() > 1 && mat_arg_b.no_rows() > 1) && (mat_arg_a.no_cols() > 1 && mat_arg_a.no_rows() > 1) && (mat_arg_a.no_cols() == mat_arg_b.no_cols()))
     {
-        SUSA_ASSERT_MESSAGE(false, "unsupported codition.");
+        // column by column
+        size_length = mat_arg_b.no_rows() - 1;
+        mat_ret = matrix <T> (mat_arg_a.no_rows() + size_length, mat_arg_a.no_cols());
         for (size_t size_col = 0; size_col < mat_arg_a.no_cols(); size_col++)
         {
-            size_length = mat_arg_a.no_rows() - 1;
-            // TODO: set_row and set_col missing in susa::matrix
-            // 2009-02-22
-            // I need a [set_row/set_col] to complete this part
+            mat_ret.set_col(size_col, filter(mat_arg_b.col(size_col), matrix <T> (1,1,1), mat_arg_a.col(size_col), size_length));
         }
     }
     else
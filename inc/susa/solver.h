@@ -91,14 +91,28 @@ template <class T> class lup
      */
     lup(const matrix<T>& mat_arg, double dbl_tolerance = 1e-4);
 
+    /**
+     * @brief constructor
+     *
+     * The matrix is moved in and the object keeps it apart from the factors,
+     * hence a temporary can be passed and both decompositions read the input.
+     *
+     * @param mat_arg the input square matrix
+     * @param dbl_tolerance the tolerance of pivoting
+     */
+    lup(matrix<T>&& mat_arg, double dbl_tolerance = 1e-4);
+
+    // the input is referenced, a copy would refer to the input of another object
+    lup(const lup&) = delete;
+    lup& operator=(const lup&) = delete;
+
     //! destructor
     ~lup();
 
     /**
      * @brief decomposition
      *
-     * Doolittle algorithm implementation
-     * @param mat_arg the input square matrix
+     * Blocked right-looking elimination with partial pivoting (see <i>lu_factor()</i>)
      * @return true if the decomposition succeeds
      */
     bool                decompose();
@@ -113,19 +127,22 @@ template <class T> class lup
     bool                decompose_alt();
 
     /**
-     * @brief solve a linear equation of the form Ax = b
+     * @brief solve a linear equation of the form AX = B
+     *
+     * The columns of B are solved together by blocked triangular solves
+     * whose updates run on the GEMM kernel.
      *
-     * @param mat_b is the input vector
+     * @param mat_b is the input vector or a matrix of right-hand sides (one per column)
      * @return the solution to the linear equation
      */
-    matrix <T>          solve(const matrix<T>& mat_b);
+    matrix <T>          solve(const matrix<T>& mat_b) const;
 
     /**
      * @brief inverse of the square matrix
      * 
      * @return the inverse of the square matrix 
      */
-    matrix <T>          invert();
+    matrix <T>          invert() const;
 
     //! get the linear pivot vector
     const matrix<T>&    get_pivot() const { return mat_pp; }
@@ -134,6 +151,7 @@ template <class T> class lup
     const matrix<T>&    get_lu() const {return mat_lu;}
 
   private:
+    matrix <T>          mat_in;
     matrix <T>          mat_lu;
     const matrix <T>&   mat_a;
     matrix <size_t>     mat_p;
@@ -168,6 +186,16 @@ template <class T> lup<T>::lup(const matrix<T>& mat_arg, double dbl_tolerance)
     sizet_n = mat_a.no_cols();
 }
 
+template <class T> lup<T>::lup(matrix<T>&& mat_arg, double dbl_tolerance)
+: mat_in(std::move(mat_arg))
+, mat_a(mat_in)
+, dbl_tol(dbl_tolerance)
+, sizet_n(0)
+{
+    SUSA_ASSERT_MESSAGE(mat_in.is_square(), "the matrix must be square");
+    sizet_n = mat_in.no_cols();
+}
+
 template <class T> lup<T>::~lup()
 {
 
@@ -214,86 +242,297 @@ template <class T> bool lu<T>::decompose()
     return true;
 }
 
-template <class T> bool lup<T>::decompose()
+//! the block size of the blocked LU factorisation and triangular solves
+const size_t LU_BLOCK = 32;
+
+/**
+ * @brief Solves L X = B in place for a lower triangular L
+ *
+ * The diagonal blocks are solved by substitution and the rest of B is
+ * updated through the GEMM kernel.
+ *
+ * @param sizet_n the order of L
+ * @param sizet_nrhs number of columns of B
+ * @param ptr_l the column-major L (the upper part is not read)
+ * @param sizet_ldl the leading dimension of L
+ * @param ptr_b the column-major B, overwritten by X
+ * @param sizet_ldb the leading dimension of B
+ * @param bool_unit the diagonal of L is one (and it is not read)
+ * @ingroup LALG
+ */
+template <class T> void trsm_lower(size_t sizet_n, size_t sizet_nrhs, const T* ptr_l, size_t sizet_ldl,
+    T* ptr_b, size_t sizet_ldb, bool bool_unit)
 {
-    if (!mat_a.is_square()) return false;
+    for (size_t sizet_k = 0; sizet_k < sizet_n; sizet_k += LU_BLOCK)
+    {
+        size_t sizet_kb = std::min(LU_BLOCK, sizet_n - sizet_k);
 
-    mat_lu      = mat_a;
-    mat_p       = matrix<size_t>(sizet_n + 1, 1);
+        for (size_t sizet_j = 0; sizet_j < sizet_nrhs; sizet_j++)
+        {
+            T* ptr_x = ptr_b + sizet_k + sizet_j * sizet_ldb;
+            for (size_t sizet_c = 0; sizet_c < sizet_kb; sizet_c++)
+            {
+                const T* ptr_c = ptr_l + sizet_k + (sizet_k + sizet_c) * sizet_ldl;
+                if (!bool_unit) ptr_x[sizet_c] /= ptr_c[sizet_c];
+                const T  T_x   = ptr_x[sizet_c];
+                for (size_t sizet_r = sizet_c + 1; sizet_r < sizet_kb; sizet_r++) ptr_x[sizet_r] -= ptr_c[sizet_r] * T_x;
+            }
+        }
 
-    for (size_t indx = 0; indx <= sizet_n; indx++)
-    {
-        mat_p(indx) = indx;
+        size_t sizet_rest = sizet_n - sizet_k - sizet_kb;
+        gemm <T> (sizet_rest, sizet_nrhs, sizet_kb, T(-1), ptr_l + sizet_k + sizet_kb + sizet_k * sizet_ldl, sizet_ldl,
+            ptr_b + sizet_k, sizet_ldb, T(1), ptr_b + sizet_k + sizet_kb, sizet_ldb);
     }
+}
 
-    for (size_t sizet_col = 0; sizet_col < sizet_n; sizet_col++)
+/**
+ * @brief Solves U X = B in place for an upper triangular U
+ *
+ * @param sizet_n the order of U
+ * @param sizet_nrhs number of columns of B
+ * @param ptr_u the column-major U (the lower part is not read)
+ * @param sizet_ldu the leading dimension of U
+ * @param ptr_b the column-major B, overwritten by X
+ * @param sizet_ldb the leading dimension of B
+ * @ingroup LALG
+ */
+template <class T> void trsm_upper(size_t sizet_n, size_t sizet_nrhs, const T* ptr_u, size_t sizet_ldu,
+    T* ptr_b, size_t sizet_ldb)
+{
+    for (size_t sizet_end = sizet_n; sizet_end > 0;)
     {
-        T T_max = 0;
-        T T_abs = 0;
-        size_t sizet_max_row = sizet_col;
+        size_t sizet_kb = std::min(LU_BLOCK, sizet_end);
+        size_t sizet_k  = sizet_end - sizet_kb;
 
-        for (size_t sizet_row = sizet_col; sizet_row < sizet_n; sizet_row++)
+        for (size_t sizet_j = 0; sizet_j < sizet_nrhs; sizet_j++)
         {
-            T_abs = mat_a(sizet_row, sizet_col);
-            if (T_abs < 0) T_abs *= -1.0;
-            if ( T_abs > T_max)
+            T* ptr_x = ptr_b + sizet_k + sizet_j * sizet_ldb;
+            for (size_t sizet_c = sizet_kb; sizet_c-- > 0;)
             {
-                T_max = T_abs;
-                sizet_max_row = sizet_row;
+                const T* ptr_c = ptr_u + sizet_k + (sizet_k + sizet_c) * sizet_ldu;
+                ptr_x[sizet_c] /= ptr_c[sizet_c];
+                const T  T_x   = ptr_x[sizet_c];
+                for (size_t sizet_r = 0; sizet_r < sizet_c; sizet_r++) ptr_x[sizet_r] -= ptr_c[sizet_r] * T_x;
             }
         }
 
-        if (T_max < dbl_tol) return false;
+        gemm <T> (sizet_k, sizet_nrhs, sizet_kb, T(-1), ptr_u + sizet_k * sizet_ldu, sizet_ldu,
+            ptr_b + sizet_k, sizet_ldb, T(1), ptr_b, sizet_ldb);
+
+        sizet_end = sizet_k;
+    }
+}
+
+/**
+ * @brief Solves L^H X = B in place for a lower triangular L
+ *
+ * @param sizet_n the order of L
+ * @param sizet_nrhs number of columns of B
+ * @param ptr_l the column-major L (the upper part is not read)
+ * @param sizet_ldl the leading dimension of L
+ * @param ptr_b the column-major B, overwritten by X
+ * @param sizet_ldb the leading dimension of B
+ * @param bool_unit the diagonal of L is one (and it is not read)
+ * @ingroup LALG
+ */
+template <class T> void trsm_lower_herm(size_t sizet_n, size_t sizet_nrhs, const T* ptr_l, size_t sizet_ldl,
+    T* ptr_b, size_t sizet_ldb, bool bool_unit)
+{
+    std::vector <T> vec_lh;
 
-        if (sizet_max_row != sizet_col)
+    for (size_t sizet_end = sizet_n; sizet_end > 0;)
+    {
+        size_t sizet_kb = std::min(LU_BLOCK, sizet_end);
+        size_t sizet_k  = sizet_end - sizet_kb;
+
+        for (size_t sizet_j = 0; sizet_j < sizet_nrhs; sizet_j++)
         {
-            std::swap(mat_p(sizet_max_row), mat_p(sizet_col));
-            mat_lu.swap_rows(sizet_max_row, sizet_col);
-            mat_p(sizet_n)++;
+            T* ptr_x = ptr_b + sizet_k + sizet_j * sizet_ldb;
+            for (size_t sizet_c = sizet_kb; sizet_c-- > 0;)
+            {
+                // the row of L^H is the column of L
+                const T* ptr_c = ptr_l + sizet_k + (sizet_k + sizet_c) * sizet_ldl;
+                T T_sum = ptr_x[sizet_c];
+                for (size_t sizet_r = sizet_c + 1; sizet_r < sizet_kb; sizet_r++) T_sum -= conjugate(ptr_c[sizet_r]) * ptr_x[sizet_r];
+                ptr_x[sizet_c] = bool_unit ? T_sum : T_sum / conjugate(ptr_c[sizet_c]);
+            }
         }
 
-        for (size_t sizet_row = sizet_col + 1; sizet_row < sizet_n; sizet_row++)
+        if (sizet_k > 0)
         {
-            mat_lu(sizet_row, sizet_col) /= mat_lu(sizet_col, sizet_col);
-
-            for (size_t sizet_col_in = sizet_col + 1; sizet_col_in < sizet_n; sizet_col_in++)
+            // the block column of L^H above the diagonal block
+            vec_lh.resize(sizet_k * sizet_kb);
+            for (size_t sizet_c = 0; sizet_c < sizet_kb; sizet_c++)
             {
-                mat_lu(sizet_row, sizet_col_in) -= mat_lu(sizet_row, sizet_col) * mat_lu(sizet_col, sizet_col_in);
+                for (size_t sizet_r = 0; sizet_r < sizet_k; sizet_r++)
+                {
+                    vec_lh[sizet_r + sizet_c * sizet_k] = conjugate(ptr_l[sizet_k + sizet_c + sizet_r * sizet_ldl]);
+                }
             }
+
+            gemm <T> (sizet_k, sizet_nrhs, sizet_kb, T(-1), vec_lh.data(), sizet_k,
+                ptr_b + sizet_k, sizet_ldb, T(1), ptr_b, sizet_ldb);
         }
+
+        sizet_end = sizet_k;
     }
+}
 
-    return true;
+/**
+ * @brief The lower triangle of C = C - W L^H
+ *
+ * The lower triangle is updated in block columns of <i>LU_BLOCK</i>, hence the
+ * strictly upper blocks are not computed.
+ *
+ * @param sizet_m number of rows of W and L and the order of C
+ * @param sizet_k number of columns of W and L
+ * @param ptr_w the column-major W
+ * @param sizet_ldw the leading dimension of W
+ * @param ptr_l the column-major L
+ * @param sizet_ldl the leading dimension of L
+ * @param ptr_c the column-major C
+ * @param sizet_ldc the leading dimension of C
+ * @ingroup LALG
+ */
+template <class T> void herk_lower(size_t sizet_m, size_t sizet_k, const T* ptr_w, size_t sizet_ldw,
+    const T* ptr_l, size_t sizet_ldl, T* ptr_c, size_t sizet_ldc)
+{
+    if (sizet_m == 0 || sizet_k == 0) return;
+
+    std::vector <T> vec_lh(sizet_k * sizet_m);
+    for (size_t sizet_j = 0; sizet_j < sizet_m; sizet_j++)
+    {
+        for (size_t sizet_p = 0; sizet_p < sizet_k; sizet_p++)
+        {
+            vec_lh[sizet_p + sizet_j * sizet_k] = conjugate(ptr_l[sizet_j + sizet_p * sizet_ldl]);
+        }
+    }
+
+    for (size_t sizet_j = 0; sizet_j < sizet_m; sizet_j += LU_BLOCK)
+    {
+        size_t sizet_jb = std::min(LU_BLOCK, sizet_m - sizet_j);
+        gemm <T> (sizet_m - sizet_j, sizet_jb, sizet_k, T(-1), ptr_w + sizet_j, sizet_ldw,
+            vec_lh.data() + sizet_j * sizet_k, sizet_k, T(1), ptr_c + sizet_j + sizet_j * sizet_ldc, sizet_ldc);
+    }
 }
 
-template <class T> matrix<T> lup<T>::solve(const matrix<T> &mat_b)
+/**
+ * @brief In-place LU factorisation with partial pivoting
+ *
+ * Computes PA = LU in the storage of A (the unit diagonal of L is not stored).
+ * The columns are factorised in panels of <i>LU_BLOCK</i> columns, the block row of U
+ * is solved by <i>trsm_lower()</i> and the trailing submatrix is updated through
+ * the GEMM kernel, hence most of the work runs at the speed of (and on the threads of)
+ * the matrix multiplication. Row <i>i</i> of PA is row <i>mat_p(i)</i> of A and
+ * <i>mat_p(n)</i> holds the number of row exchanges.
+ *
+ * @param mat_a the input square matrix, overwritten by L and U
+ * @param mat_p the permutation (n + 1 elements)
+ * @param dbl_tolerance the factorisation fails on a pivot not larger than it in magnitude
+ * @return true if the decomposition succeeds
+ * @ingroup LALG
+ */
+template <class T> bool lu_factor(matrix<T>& mat_a, matrix<size_t>& mat_p, double dbl_tolerance = 1e-4)
 {
-    matrix<T> mat_ret(sizet_n, 1, 0);
+    if (!mat_a.is_square()) return false;
+
+    const size_t sizet_n = mat_a.no_rows();
+    T*           ptr_a   = mat_a.data();
 
-    if (sizet_n == 0 || !mat_b.is_vector() || mat_b.size() != sizet_n) return mat_ret;
+    mat_p = matrix<size_t>(sizet_n + 1, 1);
+    for (size_t indx = 0; indx < sizet_n; indx++) mat_p(indx) = indx;
+    mat_p(sizet_n) = 0;
 
-    for (size_t sizet_row = 0; sizet_row < sizet_n; sizet_row++)
+    for (size_t sizet_k = 0; sizet_k < sizet_n; sizet_k += LU_BLOCK)
     {
-        mat_ret(sizet_row) = mat_b(mat_p(sizet_row));
+        size_t sizet_kb = std::min(LU_BLOCK, sizet_n - sizet_k);
 
-        for (size_t sizet_col = 0; sizet_col < sizet_row; sizet_col++)
+        // the unblocked factorisation of the panel
+        for (size_t sizet_col = sizet_k; sizet_col < sizet_k + sizet_kb; sizet_col++)
         {
-            mat_ret(sizet_row) -= mat_lu(sizet_row, sizet_col) * mat_ret(sizet_col);
+            T*     ptr_col       = ptr_a + sizet_col * sizet_n;
+            double dbl_max       = 0;
+            size_t sizet_max_row = sizet_col;
+
+            for (size_t sizet_row = sizet_col; sizet_row < sizet_n; sizet_row++)
+            {
+                double dbl_abs = std::abs(ptr_col[sizet_row]);
+                if (dbl_abs > dbl_max)
+                {
+                    dbl_max       = dbl_abs;
+                    sizet_max_row = sizet_row;
+                }
+            }
+
+            if (!(dbl_max > dbl_tolerance)) return false;
+
+            if (sizet_max_row != sizet_col)
+            {
+                std::swap(mat_p(sizet_max_row), mat_p(sizet_col));
+                mat_a.swap_rows(sizet_max_row, sizet_col);
+                mat_p(sizet_n)++;
+            }
+
+            const T T_pivot = ptr_col[sizet_col];
+            for (size_t sizet_row = sizet_col + 1; sizet_row < sizet_n; sizet_row++) ptr_col[sizet_row] /= T_pivot;
+
+            for (size_t sizet_in = sizet_col + 1; sizet_in < sizet_k + sizet_kb; sizet_in++)
+            {
+                T*      ptr_in = ptr_a + sizet_in * sizet_n;
+                const T T_u    = ptr_in[sizet_col];
+                for (size_t sizet_row = sizet_col + 1; sizet_row < sizet_n; sizet_row++) ptr_in[sizet_row] -= ptr_col[sizet_row] * T_u;
+            }
         }
+
+        size_t sizet_next = sizet_k + sizet_kb;
+        size_t sizet_rest = sizet_n - sizet_next;
+        if (sizet_rest == 0) break;
+
+        // U12 = inv(L11) A12 and A22 = A22 - L21 U12
+        trsm_lower <T> (sizet_kb, sizet_rest, ptr_a + sizet_k + sizet_k * sizet_n, sizet_n,
+            ptr_a + sizet_k + sizet_next * sizet_n, sizet_n, true);
+
+        gemm <T> (sizet_rest, sizet_rest, sizet_kb, T(-1), ptr_a + sizet_next + sizet_k * sizet_n, sizet_n,
+            ptr_a + sizet_k + sizet_next * sizet_n, sizet_n, T(1), ptr_a + sizet_next + sizet_next * sizet_n, sizet_n);
     }
 
+    return true;
+}
+
+template <class T> bool lup<T>::decompose()
+{
+    if (!mat_a.is_square()) return false;
+
+    mat_lu = mat_a;
 
-    for (size_t sizet_row = sizet_n; sizet_row-- > 0;)
+    return lu_factor(mat_lu, mat_p, dbl_tol);
+}
+
+template <class T> matrix<T> lup<T>::solve(const matrix<T> &mat_b) const
+{
+    bool   bool_vector = mat_b.size() == sizet_n && (mat_b.is_vector() || mat_b.no_rows() == sizet_n);
+    size_t sizet_nrhs  = bool_vector ? 1 : mat_b.no_cols();
+
+    if (sizet_n == 0 || mat_lu.size() != sizet_n * sizet_n || (!bool_vector && mat_b.no_rows() != sizet_n))
     {
+        return matrix<T>(sizet_n, 1, 0);
+    }
+
+    matrix<T> mat_ret(sizet_n, sizet_nrhs);
+    const T*  ptr_b   = mat_b.data();
+    T*        ptr_ret = mat_ret.data();
 
-        for (size_t sizet_col = sizet_row + 1; sizet_col < sizet_n; sizet_col++)
+    for (size_t sizet_j = 0; sizet_j < sizet_nrhs; sizet_j++)
+    {
+        for (size_t sizet_row = 0; sizet_row < sizet_n; sizet_row++)
         {
-            mat_ret(sizet_row) -= mat_lu(sizet_row, sizet_col) * mat_ret(sizet_col);
+            ptr_ret[sizet_row + sizet_j * sizet_n] = ptr_b[mat_p(sizet_row) + sizet_j * sizet_n];
         }
-
-        mat_ret(sizet_row) = mat_ret(sizet_row) / mat_lu(sizet_row, sizet_row);
     }
 
+    trsm_lower <T> (sizet_n, sizet_nrhs, mat_lu.data(), sizet_n, ptr_ret, sizet_n, true);
+    trsm_upper <T> (sizet_n, sizet_nrhs, mat_lu.data(), sizet_n, ptr_ret, sizet_n);
+
     return mat_ret;
 }
 
@@ -369,33 +608,586 @@ template <class T> bool lup<T>::decompose_alt()
     return true;
 }
 
-template <class T> matrix <T> lup<T>::invert()
+template <class T> matrix <T> lup<T>::invert() const
 {
-    matrix <T> ret(mat_lu.shape());
+    return solve(eye <T> (sizet_n));
+}
 
-    for (size_t j = 0; j < sizet_n; j++)
+/**
+ * @brief In-place Cholesky factorisation of a Hermitian positive-definite matrix
+ *
+ * Computes A = L L^H in the storage of A, only the lower triangle of A is read and
+ * the strictly upper triangle is set to zero. The panels of <i>LU_BLOCK</i> columns are
+ * factorised left-looking and the trailing lower triangle is updated by <i>herk_lower()</i>,
+ * hence the factorisation takes about half of the work of <i>lu_factor()</i>.
+ *
+ * @param mat_a the input square matrix, overwritten by L
+ * @param dbl_tolerance the factorisation fails on a pivot not larger than it
+ * @return true if the decomposition succeeds
+ * @ingroup LALG
+ */
+template <class T> bool cholesky_factor(matrix<T>& mat_a, double dbl_tolerance = 0)
+{
+    if (!mat_a.is_square()) return false;
+
+    const size_t sizet_n = mat_a.no_rows();
+    T*           ptr_a   = mat_a.data();
+
+    for (size_t sizet_k = 0; sizet_k < sizet_n; sizet_k += LU_BLOCK)
     {
-        for (size_t i = 0; i < sizet_n; i++)
+        size_t sizet_kb = std::min(LU_BLOCK, sizet_n - sizet_k);
+
+        for (size_t sizet_col = sizet_k; sizet_col < sizet_k + sizet_kb; sizet_col++)
         {
-            if (mat_p(i) == j) 
-                ret(i,j) = 1.0;
-            else
-                ret(i,j) = 0.0;
+            T* ptr_col = ptr_a + sizet_col * sizet_n;
 
-            for (size_t k = 0; k < i; k++)
-                ret(i,j) -= mat_lu(i,k) * ret(k,j);
+            for (size_t sizet_p = sizet_k; sizet_p < sizet_col; sizet_p++)
+            {
+                const T* ptr_p  = ptr_a + sizet_p * sizet_n;
+                const T  T_coef = conjugate(ptr_p[sizet_col]);
+                for (size_t sizet_row = sizet_col; sizet_row < sizet_n; sizet_row++) ptr_col[sizet_row] -= ptr_p[sizet_row] * T_coef;
+            }
+
+            double dbl_d = std::real(ptr_col[sizet_col]);
+            if (!(dbl_d > dbl_tolerance)) return false;
+
+            const T T_d = T(std::sqrt(dbl_d));
+            ptr_col[sizet_col] = T_d;
+            for (size_t sizet_row = sizet_col + 1; sizet_row < sizet_n; sizet_row++) ptr_col[sizet_row] /= T_d;
         }
 
-        for (size_t i = sizet_n; i-- > 0;)
+        size_t sizet_next = sizet_k + sizet_kb;
+        herk_lower <T> (sizet_n - sizet_next, sizet_kb, ptr_a + sizet_next + sizet_k * sizet_n, sizet_n,
+            ptr_a + sizet_next + sizet_k * sizet_n, sizet_n, ptr_a + sizet_next + sizet_next * sizet_n, sizet_n);
+    }
+
+    for (size_t sizet_col = 1; sizet_col < sizet_n; sizet_col++)
+    {
+        for (size_t sizet_row = 0; sizet_row < sizet_col; sizet_row++) ptr_a[sizet_row + sizet_col * sizet_n] = T(0);
+    }
+
+    return true;
+}
+
+/**
+ * @brief In-place LDL^H factorisation of a Hermitian matrix
+ *
+ * Computes A = L D L^H without pivoting in the storage of A, L is unit lower
+ * triangular and stored below the diagonal and the real D is stored on the
+ * diagonal. Only the lower triangle of A is read and the strictly upper triangle
+ * is set to zero. It needs no square roots and it also serves the quasi-definite
+ * matrices, the blocking follows <i>cholesky_factor()</i>.
+ *
+ * @param mat_a the input square matrix, overwritten by L and D
+ * @param dbl_tolerance the factorisation fails on a pivot not larger than it in magnitude
+ * @return true if the decomposition succeeds
+ * @ingroup LALG
+ */
+template <class T> bool ldl_factor(matrix<T>& mat_a, double dbl_tolerance = 0)
+{
+    if (!mat_a.is_square()) return false;
+
+    const size_t sizet_n = mat_a.no_rows();
+    T*           ptr_a   = mat_a.data();
+    std::vector <T> vec_w;
+
+    for (size_t sizet_k = 0; sizet_k < sizet_n; sizet_k += LU_BLOCK)
+    {
+        size_t sizet_kb = std::min(LU_BLOCK, sizet_n - sizet_k);
+
+        for (size_t sizet_col = sizet_k; sizet_col < sizet_k + sizet_kb; sizet_col++)
         {
-            for (size_t k = i + 1; k < sizet_n; k++)
-                ret(i,j) -= mat_lu(i,k) * ret(k,j);
+            T* ptr_col = ptr_a + sizet_col * sizet_n;
+
+            for (size_t sizet_p = sizet_k; sizet_p < sizet_col; sizet_p++)
+            {
+                const T* ptr_p  = ptr_a + sizet_p * sizet_n;
+                const T  T_coef = ptr_p[sizet_p] * conjugate(ptr_p[sizet_col]);
+                for (size_t sizet_row = sizet_col; sizet_row < sizet_n; sizet_row++) ptr_col[sizet_row] -= ptr_p[sizet_row] * T_coef;
+            }
 
-            ret(i,j) = ret(i,j) / mat_lu(i,i);
+            double dbl_d = std::real(ptr_col[sizet_col]);
+            if (!(std::abs(dbl_d) > dbl_tolerance)) return false;
+
+            const T T_d = T(dbl_d);
+            ptr_col[sizet_col] = T_d;
+            for (size_t sizet_row = sizet_col + 1; sizet_row < sizet_n; sizet_row++) ptr_col[sizet_row] /= T_d;
         }
+
+        // W = L21 D1 for the update of the trailing lower triangle
+        size_t sizet_next = sizet_k + sizet_kb;
+        size_t sizet_rest = sizet_n - sizet_next;
+        vec_w.resize(sizet_rest * sizet_kb);
+        for (size_t sizet_c = 0; sizet_c < sizet_kb; sizet_c++)
+        {
+            const T* ptr_c = ptr_a + (sizet_k + sizet_c) * sizet_n;
+            for (size_t sizet_r = 0; sizet_r < sizet_rest; sizet_r++)
+            {
+                vec_w[sizet_r + sizet_c * sizet_rest] = ptr_c[sizet_next + sizet_r] * ptr_c[sizet_k + sizet_c];
+            }
+        }
+
+        herk_lower <T> (sizet_rest, sizet_kb, vec_w.data(), sizet_rest,
+            ptr_a + sizet_next + sizet_k * sizet_n, sizet_n, ptr_a + sizet_next + sizet_next * sizet_n, sizet_n);
     }
 
-    return ret;
+    for (size_t sizet_col = 1; sizet_col < sizet_n; sizet_col++)
+    {
+        for (size_t sizet_row = 0; sizet_row < sizet_col; sizet_row++) ptr_a[sizet_row + sizet_col * sizet_n] = T(0);
+    }
+
+    return true;
+}
+
+/**
+ * @brief Cholesky decomposition of Hermitian positive-definite matrices
+ *
+ * It serves the real and the <i>std::complex</i> types, e.g. the MMSE
+ * matrices H^H H + sigma^2 I.
+ *
+ * @ingroup LALG
+ */
+template <class T> class cholesky
+{
+  public:
+
+    /**
+     * @brief constructor
+     *
+     * @param mat_arg the input Hermitian matrix (only the lower triangle is read)
+     * @param dbl_tolerance the decomposition fails on a pivot not larger than it
+     */
+    cholesky(const matrix<T>& mat_arg, double dbl_tolerance = 0);
+
+    /**
+     * @brief constructor
+     *
+     * The matrix is moved in and the object keeps it apart from the factors.
+     *
+     * @param mat_arg the input Hermitian matrix (only the lower triangle is read)
+     * @param dbl_tolerance the decomposition fails on a pivot not larger than it
+     */
+    cholesky(matrix<T>&& mat_arg, double dbl_tolerance = 0);
+
+    // the input is referenced, a copy would refer to the input of another object
+    cholesky(const cholesky&) = delete;
+    cholesky& operator=(const cholesky&) = delete;
+
+    /**
+     * @brief decomposition A = L L^H
+     *
+     * @return true if the matrix is positive-definite
+     */
+    bool                decompose();
+
+    /**
+     * @brief solve a linear equation of the form AX = B
+     *
+     * @param mat_b is the input vector or a matrix of right-hand sides (one per column)
+     * @return the solution to the linear equation
+     */
+    matrix <T>          solve(const matrix<T>& mat_b) const;
+
+    /**
+     * @brief rank-1 update of the decomposition to the one of A + x x^H
+     *
+     * It takes O(n^2) operations, e.g. to add an observation to a sliding window
+     *
+     * @param mat_x the vector x
+     * @return true if the update succeeds
+     */
+    bool                update(const matrix<T>& mat_x);
+
+    /**
+     * @brief rank-1 downdate of the decomposition to the one of A - x x^H
+     *
+     * @param mat_x the vector x
+     * @return true if the result is positive-definite (otherwise the decomposition is lost)
+     */
+    bool                downdate(const matrix<T>& mat_x);
+
+    //! get the lower triangular L after calling cholesky::decompose
+    const matrix<T>&    get_lower() const { return mat_l; }
+
+  private:
+    matrix <T>          mat_in;
+    matrix <T>          mat_l;
+    const matrix <T>&   mat_a;
+
+    double              dbl_tol;
+    size_t              sizet_n;
+
+    //! the rotations of the update (sign one) and the downdate (sign minus one)
+    bool                rank_one(const matrix<T>& mat_x, double dbl_sign);
+};
+
+/**
+ * @brief LDL^H decomposition of Hermitian matrices
+ *
+ * @ingroup LALG
+ */
+template <class T> class ldl
+{
+  public:
+
+    /**
+     * @brief constructor
+     *
+     * @param mat_arg the input Hermitian matrix (only the lower triangle is read)
+     * @param dbl_tolerance the decomposition fails on a pivot not larger than it in magnitude
+     */
+    ldl(const matrix<T>& mat_arg, double dbl_tolerance = 0);
+
+    /**
+     * @brief constructor
+     *
+     * The matrix is moved in and the object keeps it apart from the factors.
+     *
+     * @param mat_arg the input Hermitian matrix (only the lower triangle is read)
+     * @param dbl_tolerance the decomposition fails on a pivot not larger than it in magnitude
+     */
+    ldl(matrix<T>&& mat_arg, double dbl_tolerance = 0);
+
+    // the input is referenced, a copy would refer to the input of another object
+    ldl(const ldl&) = delete;
+    ldl& operator=(const ldl&) = delete;
+
+    /**
+     * @brief decomposition A = L D L^H
+     *
+     * @return true if the decomposition succeeds
+     */
+    bool                decompose();
+
+    /**
+     * @brief solve a linear equation of the form AX = B
+     *
+     * @param mat_b is the input vector or a matrix of right-hand sides (one per column)
+     * @return the solution to the linear equation
+     */
+    matrix <T>          solve(const matrix<T>& mat_b) const;
+
+    /**
+     * @brief rank-1 modification of the decomposition to the one of A + alpha x x^H
+     *
+     * A negative alpha downdates the decomposition.
+     *
+     * @param mat_x the vector x
+     * @param dbl_alpha the real scale
+     * @return true if no pivot vanishes (otherwise the decomposition is lost)
+     */
+    bool                update(const matrix<T>& mat_x, double dbl_alpha = 1);
+
+    //! get L (below the diagonal) and D (on the diagonal) after calling ldl::decompose
+    const matrix<T>&    get_ldl() const { return mat_ldl; }
+
+  private:
+    matrix <T>          mat_in;
+    matrix <T>          mat_ldl;
+    const matrix <T>&   mat_a;
+
+    double              dbl_tol;
+    size_t              sizet_n;
+};
+
+template <class T> cholesky<T>::cholesky(const matrix<T>& mat_arg, double dbl_tolerance)
+: mat_a(mat_arg)
+, dbl_tol(dbl_tolerance)
+, sizet_n(0)
+{
+    SUSA_ASSERT_MESSAGE(mat_arg.is_square(), "the matrix must be square");
+    sizet_n = mat_a.no_cols();
+}
+
+template <class T> cholesky<T>::cholesky(matrix<T>&& mat_arg, double dbl_tolerance)
+: mat_in(std::move(mat_arg))
+, mat_a(mat_in)
+, dbl_tol(dbl_tolerance)
+, sizet_n(0)
+{
+    SUSA_ASSERT_MESSAGE(mat_in.is_square(), "the matrix must be square");
+    sizet_n = mat_in.no_cols();
+}
+
+template <class T> bool cholesky<T>::decompose()
+{
+    if (!mat_a.is_square()) return false;
+
+    mat_l = mat_a;
+
+    return cholesky_factor(mat_l, dbl_tol);
+}
+
+template <class T> matrix<T> cholesky<T>::solve(const matrix<T> &mat_b) const
+{
+    bool bool_vector = mat_b.size() == sizet_n && (mat_b.is_vector() || mat_b.no_rows() == sizet_n);
+
+    if (sizet_n == 0 || mat_l.size() != sizet_n * sizet_n || (!bool_vector && mat_b.no_rows() != sizet_n))
+    {
+        return matrix<T>(sizet_n, 1, 0);
+    }
+
+    size_t    sizet_nrhs = bool_vector ? 1 : mat_b.no_cols();
+    matrix<T> mat_ret(sizet_n, sizet_nrhs);
+    std::copy(mat_b.data(), mat_b.data() + mat_ret.size(), mat_ret.data());
+
+    trsm_lower <T> (sizet_n, sizet_nrhs, mat_l.data(), sizet_n, mat_ret.data(), sizet_n, false);
+    trsm_lower_herm <T> (sizet_n, sizet_nrhs, mat_l.data(), sizet_n, mat_ret.data(), sizet_n, false);
+
+    return mat_ret;
+}
+
+template <class T> bool cholesky<T>::update(const matrix<T>& mat_x)
+{
+    return rank_one(mat_x, 1);
+}
+
+template <class T> bool cholesky<T>::downdate(const matrix<T>& mat_x)
+{
+    return rank_one(mat_x, -1);
+}
+
+template <class T> bool cholesky<T>::rank_one(const matrix<T>& mat_x, double dbl_sign)
+{
+    if (sizet_n == 0 || mat_l.size() != sizet_n * sizet_n || mat_x.size() != sizet_n) return false;
+
+    std::vector <T> vec_x(mat_x.data(), mat_x.data() + sizet_n);
+    T* ptr_l = mat_l.data();
+
+    for (size_t sizet_k = 0; sizet_k < sizet_n; sizet_k++)
+    {
+        T*     ptr_col = ptr_l + sizet_k * sizet_n;
+        double dbl_lkk = std::real(ptr_col[sizet_k]);
+        double dbl_r2  = dbl_lkk * dbl_lkk + dbl_sign * std::norm(vec_x[sizet_k]);
+
+        if (!(dbl_r2 > dbl_tol)) return false;
+
+        // the (hyperbolic) rotation that zeroes x(k)
+        double dbl_r = std::sqrt(dbl_r2);
+        T      T_c   = T(dbl_r / dbl_lkk);
+        T      T_s   = vec_x[sizet_k] / T(dbl_lkk);
+        T      T_sc  = T(dbl_sign) * conjugate(T_s);
+
+        ptr_col[sizet_k] = T(dbl_r);
+        for (size_t sizet_i = sizet_k + 1; sizet_i < sizet_n; sizet_i++)
+        {
+            ptr_col[sizet_i] = (ptr_col[sizet_i] + T_sc * vec_x[sizet_i]) / T_c;
+            vec_x[sizet_i]   = T_c * vec_x[sizet_i] - T_s * ptr_col[sizet_i];
+        }
+    }
+
+    return true;
+}
+
+template <class T> ldl<T>::ldl(const matrix<T>& mat_arg, double dbl_tolerance)
+: mat_a(mat_arg)
+, dbl_tol(dbl_tolerance)
+, sizet_n(0)
+{
+    SUSA_ASSERT_MESSAGE(mat_arg.is_square(), "the matrix must be square");
+    sizet_n = mat_a.no_cols();
+}
+
+template <class T> ldl<T>::ldl(matrix<T>&& mat_arg, double dbl_tolerance)
+: mat_in(std::move(mat_arg))
+, mat_a(mat_in)
+, dbl_tol(dbl_tolerance)
+, sizet_n(0)
+{
+    SUSA_ASSERT_MESSAGE(mat_in.is_square(), "the matrix must be square");
+    sizet_n = mat_in.no_cols();
+}
+
+template <class T> bool ldl<T>::decompose()
+{
+    if (!mat_a.is_square()) return false;
+
+    mat_ldl = mat_a;
+
+    return ldl_factor(mat_ldl, dbl_tol);
+}
+
+template <class T> matrix<T> ldl<T>::solve(const matrix<T> &mat_b) const
+{
+    bool bool_vector = mat_b.size() == sizet_n && (mat_b.is_vector() || mat_b.no_rows() == sizet_n);
+
+    if (sizet_n == 0 || mat_ldl.size() != sizet_n * sizet_n || (!bool_vector && mat_b.no_rows() != sizet_n))
+    {
+        return matrix<T>(sizet_n, 1, 0);
+    }
+
+    size_t    sizet_nrhs = bool_vector ? 1 : mat_b.no_cols();
+    matrix<T> mat_ret(sizet_n, sizet_nrhs);
+    std::copy(mat_b.data(), mat_b.data() + mat_ret.size(), mat_ret.data());
+    T*     ptr_ret    = mat_ret.data();
+
+    trsm_lower <T> (sizet_n, sizet_nrhs, mat_ldl.data(), sizet_n, ptr_ret, sizet_n, true);
+
+    for (size_t sizet_j = 0; sizet_j < sizet_nrhs; sizet_j++)
+    {
+        for (size_t sizet_i = 0; sizet_i < sizet_n; sizet_i++) ptr_ret[sizet_i + sizet_j * sizet_n] /= mat_ldl(sizet_i, sizet_i);
+    }
+
+    trsm_lower_herm <T> (sizet_n, sizet_nrhs, mat_ldl.data(), sizet_n, ptr_ret, sizet_n, true);
+
+    return mat_ret;
+}
+
+template <class T> bool ldl<T>::update(const matrix<T>& mat_x, double dbl_alpha)
+{
+    if (sizet_n == 0 || mat_ldl.size() != sizet_n * sizet_n || mat_x.size() != sizet_n) return false;
+
+    // method C1 of Gill, Golub, Murray and Saunders (1974)
+    std::vector <T> vec_x(mat_x.data(), mat_x.data() + sizet_n);
+    T* ptr_l = mat_ldl.data();
+
+    for (size_t sizet_k = 0; sizet_k < sizet_n; sizet_k++)
+    {
+        T*     ptr_col = ptr_l + sizet_k * sizet_n;
+        T      T_p     = vec_x[sizet_k];
+        double dbl_d   = std::real(ptr_col[sizet_k]);
+        double dbl_dn  = dbl_d + dbl_alpha * std::norm(T_p);
+
+        if (!(std::abs(dbl_dn) > dbl_tol)) return false;
+
+        T T_beta  = T(dbl_alpha / dbl_dn) * conjugate(T_p);
+        dbl_alpha = dbl_alpha * dbl_d / dbl_dn;
+
+        ptr_col[sizet_k] = T(dbl_dn);
+        for (size_t sizet_i = sizet_k + 1; sizet_i < sizet_n; sizet_i++)
+        {
+            vec_x[sizet_i]   -= T_p * ptr_col[sizet_i];
+            ptr_col[sizet_i] += T_beta * vec_x[sizet_i];
+        }
+    }
+
+    return true;
+}
+
+/**
+ * @brief The LU factorisation of a copy in the working type of the determinants
+ *
+ * @param mat_arg the input square matrix
+ * @param mat_lu the factorisation
+ * @param mat_p the permutation
+ * @return false if the matrix is singular
+ * @ingroup LALG
+ */
+template <class W, class T> bool det_factor(const matrix <T>& mat_arg, matrix <W>& mat_lu, matrix <size_t>& mat_p)
+{
+    mat_lu = matrix <W> (mat_arg.no_rows(), mat_arg.no_cols());
+    for (size_t sizet_i = 0; sizet_i < mat_arg.size(); sizet_i++) mat_lu(sizet_i) = W(mat_arg(sizet_i));
+
+    return lu_factor(mat_lu, mat_p, 0);
+}
+
+/**
+ * @brief Determinant
+ *
+ * It is the product of the pivots of the LU factorisation with the sign of the
+ * row exchanges, hence it takes O(n^3) operations. The integer matrices are
+ * factorised in double precision.
+ *
+ * @param mat_arg the input square matrix
+ * @return returns determinant of the input matrices (zero for a non-square matrix)
+ * @ingroup LALG
+ */
+template <class T> double det(const matrix <T> &mat_arg)
+{
+    typedef typename std::conditional <std::is_floating_point <T>::value, T, double>::type W;
+
+    size_t sizet_n = mat_arg.no_rows();
+    if (!mat_arg.is_square() || sizet_n == 0) return 0;
+
+    matrix <W>      mat_lu;
+    matrix <size_t> mat_p;
+    if (!det_factor(mat_arg, mat_lu, mat_p)) return 0;
+
+    double dbl_ret = mat_p(sizet_n) % 2 ? -1 : 1;
+    for (size_t sizet_i = 0; sizet_i < sizet_n; sizet_i++) dbl_ret *= mat_lu(sizet_i, sizet_i);
+
+    return dbl_ret;
+}
+
+//! Determinant of a complex matrix
+template <class T> std::complex <T> det(const matrix <std::complex <T> > &mat_arg)
+{
+    size_t sizet_n = mat_arg.no_rows();
+    if (!mat_arg.is_square() || sizet_n == 0) return 0;
+
+    matrix <std::complex <T> > mat_lu;
+    matrix <size_t>            mat_p;
+    if (!det_factor(mat_arg, mat_lu, mat_p)) return 0;
+
+    std::complex <T> cplx_ret = T(mat_p(sizet_n) % 2 ? -1 : 1);
+    for (size_t sizet_i = 0; sizet_i < sizet_n; sizet_i++) cplx_ret *= mat_lu(sizet_i, sizet_i);
+
+    return cplx_ret;
+}
+
+/**
+ * @brief Logarithm of the absolute value of the determinant
+ *
+ * The logarithms of the pivots are summed, hence it neither overflows nor underflows
+ * where the determinant would.
+ *
+ * @param mat_arg the input square matrix
+ * @param T_sign the sign (the unit phase of a complex matrix) of the determinant, zero if singular
+ * @return log|det(A)|, minus infinity if the matrix is singular
+ * @ingroup LALG
+ */
+template <class T> double logdet(const matrix <T> &mat_arg, T& T_sign)
+{
+    typedef typename std::conditional <std::is_integral <T>::value, double, T>::type W;
+
+    size_t sizet_n = mat_arg.no_rows();
+    T_sign = T(0);
+    if (!mat_arg.is_square() || sizet_n == 0) return -std::numeric_limits <double>::infinity();
+
+    matrix <W>      mat_lu;
+    matrix <size_t> mat_p;
+    if (!det_factor(mat_arg, mat_lu, mat_p)) return -std::numeric_limits <double>::infinity();
+
+    W      W_sign  = W(mat_p(sizet_n) % 2 ? -1 : 1);
+    double dbl_ret = 0;
+    for (size_t sizet_i = 0; sizet_i < sizet_n; sizet_i++)
+    {
+        double dbl_abs = std::abs(mat_lu(sizet_i, sizet_i));
+        dbl_ret += std::log(dbl_abs);
+        W_sign  *= mat_lu(sizet_i, sizet_i) / W(dbl_abs);
+    }
+
+    T_sign = T(W_sign);
+    return dbl_ret;
+}
+
+//! Logarithm of the absolute value of the determinant
+template <class T> double logdet(const matrix <T> &mat_arg)
+{
+    T T_sign;
+    return logdet(mat_arg, T_sign);
+}
+
+/**
+ * @brief Logarithm of the determinant of a Hermitian positive-definite matrix
+ *
+ * It is twice the sum of the logarithms of the diagonal of the Cholesky factor,
+ * e.g. for the Gaussian log-likelihood of a covariance matrix at half of the cost
+ * of <i>logdet()</i>.
+ *
+ * @param mat_arg the input Hermitian matrix (only the lower triangle is read)
+ * @return log(det(A)), NaN if the matrix is not positive-definite
+ * @ingroup LALG
+ */
+template <class T> double logdet_hpd(const matrix <T> &mat_arg)
+{
+    matrix <T> mat_l = mat_arg;
+    if (mat_l.size() == 0 || !cholesky_factor(mat_l)) return std::numeric_limits <double>::quiet_NaN();
+
+    double dbl_ret = 0;
+    for (size_t sizet_i = 0; sizet_i < mat_l.no_rows(); sizet_i++) dbl_ret += std::log(std::real(mat_l(sizet_i, sizet_i)));
+
+    return 2 * dbl_ret;
 }
 
 /**
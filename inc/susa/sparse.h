@@ -0,0 +1,451 @@
+/*
+ * This file is part of Susa.
+ *
+ * Susa is free software: you can redistribute it and/or modify
+ * it under the terms of the Lesser GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * at your option) any later version.
+ *
+ * Susa is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * Lesser GNU General Public License for more details.
+ *
+ * You should have received a copy of the Lesser GNU General Public License
+ * along with Susa.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file sparse.h
+ * @brief Compressed sparse matrix (declaration and definition).
+ * @author Behrooz Kamary
+ * @version 1.0.0
+ */
+
+#ifndef SUSA_SPARSE_H
+#define SUSA_SPARSE_H
+
+namespace susa {
+
+//! The storage formats of the sparse matrices
+enum sparse_format
+{
+    CSR, //!< compressed sparse rows
+    CSC  //!< compressed sparse columns
+};
+
+/**
+ * @brief The <i>sparse_matrix</i> class.
+ *
+ * The non-zeros are compressed along the rows (CSR) or the columns (CSC).
+ * The <i>outer</i> dimension is the one that is compressed: the non-zeros of
+ * the outer line <i>i</i> are at [outer_ptr(i), outer_ptr(i + 1)) of <i>inner_index()</i>
+ * and <i>values()</i>, sorted by their inner index. The memory is linear in the
+ * number of non-zeros.
+ *
+ * @ingroup TYPES
+ */
+template <class T> class sparse_matrix
+{
+  public:
+    //! Constructor of an empty matrix
+    sparse_matrix();
+
+    /**
+     * @brief Constructor from triplets
+     *
+     * The values of the duplicated positions are summed. A position out of range
+     * leaves the matrix empty.
+     *
+     * @param sizet_rows number of rows
+     * @param sizet_cols number of columns
+     * @param vec_row the row of every non-zero
+     * @param vec_col the column of every non-zero
+     * @param vec_values the value of every non-zero
+     * @param format the storage format
+     */
+    sparse_matrix(size_t sizet_rows, size_t sizet_cols, const std::vector <unsigned int>& vec_row,
+      const std::vector <unsigned int>& vec_col, const std::vector <T>& vec_values, sparse_format format = CSR);
+
+    /**
+     * @brief Constructor from a dense matrix
+     *
+     * @param mat_arg the dense matrix, its zero elements are not stored
+     * @param format the storage format
+     */
+    explicit sparse_matrix(const matrix <T>& mat_arg, sparse_format format = CSR);
+
+    //! Returns the number of rows
+    size_t no_rows() const
+    {
+        return sizet_rows;
+    }
+
+    //! Returns the number of columns
+    size_t no_cols() const
+    {
+        return sizet_cols;
+    }
+
+    //! Returns the number of stored non-zeros
+    size_t nnz() const
+    {
+        return vec_values.size();
+    }
+
+    //! Returns the storage format
+    sparse_format format() const
+    {
+        return fmt;
+    }
+
+    //! Returns the offsets of the outer lines (rows of CSR, columns of CSC)
+    const std::vector <size_t>& outer_ptr() const
+    {
+        return vec_ptr;
+    }
+
+    //! Returns the inner indices (columns of CSR, rows of CSC)
+    const std::vector <unsigned int>& inner_index() const
+    {
+        return vec_index;
+    }
+
+    //! Returns the stored values
+    const std::vector <T>& values() const
+    {
+        return vec_values;
+    }
+
+    //! Returns an element (zero if it is not stored)
+    T operator()(size_t sizet_row, size_t sizet_col) const;
+
+    //! Returns the matrix in the CSR format
+    sparse_matrix <T> to_csr() const;
+
+    //! Returns the matrix in the CSC format
+    sparse_matrix <T> to_csc() const;
+
+    //! Returns the dense matrix
+    matrix <T> dense() const;
+
+    /**
+     * @brief Returns the transpose
+     *
+     * The CSR storage of a matrix is the CSC storage of its transpose,
+     * hence the transpose copies the arrays without any reordering.
+     */
+    sparse_matrix <T> transpose() const;
+
+  private:
+    size_t                     sizet_rows;
+    size_t                     sizet_cols;
+    sparse_format              fmt;
+    std::vector <size_t>       vec_ptr;
+    std::vector <unsigned int> vec_index;
+    std::vector <T>            vec_values;
+
+    //! the storage with the outer and inner dimensions exchanged
+    sparse_matrix <T> swap_format() const;
+};
+
+/**
+ * @brief Sparse-dense product
+ *
+ * A CSR matrix computes the rows of the product in parallel on the thread pool,
+ * a CSC matrix computes the columns of the dense matrix in parallel. A column
+ * vector makes it the sparse matrix-vector product (SpMV).
+ *
+ * @param mat_argl the sparse left-hand-side
+ * @param mat_argr the dense right-hand-side
+ * @ingroup LALG
+ */
+template <class T> matrix <T> matmul(const sparse_matrix <T>& mat_argl, const matrix <T>& mat_argr);
+
+/**
+ * @brief Dense-sparse product
+ *
+ * The product is computed as the transpose of <i>A^T X^T</i>, i.e. by the sparse-dense
+ * product of the transpose of the sparse matrix. The two dense transposes copy the
+ * dense matrix and the product.
+ *
+ * @param mat_argl the dense left-hand-side
+ * @param mat_argr the sparse right-hand-side
+ * @ingroup LALG
+ */
+template <class T> matrix <T> matmul(const matrix <T>& mat_argl, const sparse_matrix <T>& mat_argr);
+
+//! Transpose of a sparse matrix
+template <class T> sparse_matrix <T> transpose(const sparse_matrix <T>& mat_arg)
+{
+    return mat_arg.transpose();
+}
+
+// Implementation
+
+template <class T> sparse_matrix<T>::sparse_matrix()
+: sizet_rows(0)
+, sizet_cols(0)
+, fmt(CSR)
+, vec_ptr(1, 0)
+{
+}
+
+template <class T> sparse_matrix<T>::sparse_matrix(size_t sizet_rows, size_t sizet_cols, const std::vector <unsigned int>& vec_row,
+  const std::vector <unsigned int>& vec_col, const std::vector <T>& vec_values, sparse_format format)
+: sizet_rows(sizet_rows)
+, sizet_cols(sizet_cols)
+, fmt(format)
+{
+    SUSA_ASSERT_MESSAGE(vec_row.size() == vec_col.size() && vec_row.size() == vec_values.size(),
+      "the triplets have different lengths.");
+
+    size_t sizet_num   = std::min(vec_row.size(), std::min(vec_col.size(), vec_values.size()));
+    size_t sizet_outer = fmt == CSR ? sizet_rows : sizet_cols;
+    const std::vector <unsigned int>& vec_outer = fmt == CSR ? vec_row : vec_col;
+    const std::vector <unsigned int>& vec_inner = fmt == CSR ? vec_col : vec_row;
+
+    // the triplets with an index out of range are rejected i.e. the matrix is left empty
+    for (size_t sizet_k = 0; sizet_k < sizet_num; sizet_k++)
+    {
+        bool bool_valid = vec_row[sizet_k] < sizet_rows && vec_col[sizet_k] < sizet_cols;
+        SUSA_ASSERT_MESSAGE(bool_valid, "the index is out of range.");
+        if (!bool_valid)
+        {
+            this->sizet_rows = 0;
+            this->sizet_cols = 0;
+            vec_ptr.assign(1, 0);
+            return;
+        }
+    }
+
+    // a counting sort by the outer index
+    std::vector <size_t> vec_count(sizet_outer + 1, 0);
+    for (size_t sizet_k = 0; sizet_k < sizet_num; sizet_k++) vec_count[vec_outer[sizet_k] + 1]++;
+    for (size_t sizet_i = 0; sizet_i < sizet_outer; sizet_i++) vec_count[sizet_i + 1] += vec_count[sizet_i];
+
+    std::vector <size_t> vec_order(sizet_num);
+    std::vector <size_t> vec_fill(vec_count.begin(), vec_count.end() - 1);
+    for (size_t sizet_k = 0; sizet_k < sizet_num; sizet_k++) vec_order[vec_fill[vec_outer[sizet_k]]++] = sizet_k;
+
+    // every outer line is sorted by the inner index and the duplicates are summed
+    vec_ptr.assign(sizet_outer + 1, 0);
+    vec_index.reserve(sizet_num);
+    this->vec_values.reserve(sizet_num);
+    for (size_t sizet_i = 0; sizet_i < sizet_outer; sizet_i++)
+    {
+        std::sort(vec_order.begin() + vec_count[sizet_i], vec_order.begin() + vec_count[sizet_i + 1],
+          [&](size_t sizet_a, size_t sizet_b) { return vec_inner[sizet_a] < vec_inner[sizet_b]; });
+
+        for (size_t sizet_k = vec_count[sizet_i]; sizet_k < vec_count[sizet_i + 1]; sizet_k++)
+        {
+            size_t sizet_t = vec_order[sizet_k];
+            if (vec_index.size() > vec_ptr[sizet_i] && vec_index.back() == vec_inner[sizet_t])
+            {
+                this->vec_values.back() += vec_values[sizet_t];
+            }
+            else
+            {
+                vec_index.push_back(vec_inner[sizet_t]);
+                this->vec_values.push_back(vec_values[sizet_t]);
+            }
+        }
+        vec_ptr[sizet_i + 1] = vec_index.size();
+    }
+}
+
+template <class T> sparse_matrix<T>::sparse_matrix(const matrix <T>& mat_arg, sparse_format format)
+: sizet_rows(mat_arg.no_rows())
+, sizet_cols(mat_arg.no_cols())
+, fmt(format)
+, vec_ptr(1, 0)
+{
+    if (mat_arg.size() == 0)
+    {
+        sizet_rows = 0;
+        sizet_cols = 0;
+        return;
+    }
+
+    size_t sizet_outer = fmt == CSR ? sizet_rows : sizet_cols;
+    size_t sizet_inner = fmt == CSR ? sizet_cols : sizet_rows;
+
+    for (size_t sizet_i = 0; sizet_i < sizet_outer; sizet_i++)
+    {
+        for (size_t sizet_j = 0; sizet_j < sizet_inner; sizet_j++)
+        {
+            const T& T_value = fmt == CSR ? mat_arg(sizet_i, sizet_j) : mat_arg(sizet_j, sizet_i);
+            if (T_value != T(0))
+            {
+                vec_index.push_back(sizet_j);
+                vec_values.push_back(T_value);
+            }
+        }
+        vec_ptr.push_back(vec_index.size());
+    }
+}
+
+template <class T> T sparse_matrix<T>::operator()(size_t sizet_row, size_t sizet_col) const
+{
+    SUSA_ASSERT_MESSAGE(sizet_row < sizet_rows && sizet_col < sizet_cols, "one or more indices is/are out of range.");
+
+    size_t sizet_outer = fmt == CSR ? sizet_row : sizet_col;
+    size_t sizet_inner = fmt == CSR ? sizet_col : sizet_row;
+
+    std::vector <unsigned int>::const_iterator it_first = vec_index.begin() + vec_ptr[sizet_outer];
+    std::vector <unsigned int>::const_iterator it_last  = vec_index.begin() + vec_ptr[sizet_outer + 1];
+    std::vector <unsigned int>::const_iterator it_found = std::lower_bound(it_first, it_last, sizet_inner);
+
+    if (it_found == it_last || *it_found != sizet_inner) return T(0);
+
+    return vec_values[it_found - vec_index.begin()];
+}
+
+template <class T> sparse_matrix <T> sparse_matrix<T>::swap_format() const
+{
+    size_t sizet_outer = fmt == CSR ? sizet_rows : sizet_cols;
+    size_t sizet_inner = fmt == CSR ? sizet_cols : sizet_rows;
+
+    sparse_matrix <T> mat_ret;
+    mat_ret.sizet_rows = sizet_rows;
+    mat_ret.sizet_cols = sizet_cols;
+    mat_ret.fmt        = fmt == CSR ? CSC : CSR;
+    mat_ret.vec_ptr.assign(sizet_inner + 1, 0);
+    mat_ret.vec_index.resize(nnz());
+    mat_ret.vec_values.resize(nnz());
+
+    for (size_t sizet_k = 0; sizet_k < nnz(); sizet_k++) mat_ret.vec_ptr[vec_index[sizet_k] + 1]++;
+    for (size_t sizet_j = 0; sizet_j < sizet_inner; sizet_j++) mat_ret.vec_ptr[sizet_j + 1] += mat_ret.vec_ptr[sizet_j];
+
+    // the outer lines are visited in order, hence the new inner indices are sorted
+    std::vector <size_t> vec_fill(mat_ret.vec_ptr.begin(), mat_ret.vec_ptr.end() - 1);
+    for (size_t sizet_i = 0; sizet_i < sizet_outer; sizet_i++)
+    {
+        for (size_t sizet_k = vec_ptr[sizet_i]; sizet_k < vec_ptr[sizet_i + 1]; sizet_k++)
+        {
+            size_t sizet_at = vec_fill[vec_index[sizet_k]]++;
+            mat_ret.vec_index[sizet_at]  = sizet_i;
+            mat_ret.vec_values[sizet_at] = vec_values[sizet_k];
+        }
+    }
+
+    return mat_ret;
+}
+
+template <class T> sparse_matrix <T> sparse_matrix<T>::to_csr() const
+{
+    return fmt == CSR ? *this : swap_format();
+}
+
+template <class T> sparse_matrix <T> sparse_matrix<T>::to_csc() const
+{
+    return fmt == CSC ? *this : swap_format();
+}
+
+template <class T> matrix <T> sparse_matrix<T>::dense() const
+{
+    if (sizet_rows == 0 || sizet_cols == 0) return matrix <T> ();
+
+    matrix <T> mat_ret(sizet_rows, sizet_cols, T(0));
+    size_t sizet_outer = fmt == CSR ? sizet_rows : sizet_cols;
+
+    for (size_t sizet_i = 0; sizet_i < sizet_outer; sizet_i++)
+    {
+        for (size_t sizet_k = vec_ptr[sizet_i]; sizet_k < vec_ptr[sizet_i + 1]; sizet_k++)
+        {
+            if (fmt == CSR) mat_ret(sizet_i, vec_index[sizet_k]) = vec_values[sizet_k];
+            else mat_ret(vec_index[sizet_k], sizet_i) = vec_values[sizet_k];
+        }
+    }
+
+    return mat_ret;
+}
+
+template <class T> sparse_matrix <T> sparse_matrix<T>::transpose() const
+{
+    sparse_matrix <T> mat_ret(*this);
+    mat_ret.sizet_rows = sizet_cols;
+    mat_ret.sizet_cols = sizet_rows;
+    mat_ret.fmt        = fmt == CSR ? CSC : CSR;
+    return mat_ret;
+}
+
+template <class T> matrix <T> matmul(const sparse_matrix <T>& mat_argl, const matrix <T>& mat_argr)
+{
+    SUSA_PROFILE_SCOPE("sparse.matmul");
+    SUSA_ASSERT_MESSAGE(mat_argl.no_cols() == mat_argr.no_rows(), "the matrices' dimensions mismatch.");
+    if (mat_argl.no_cols() != mat_argr.no_rows() || mat_argl.no_rows() == 0) return matrix <T> ();
+
+    const size_t sizet_m = mat_argl.no_rows();
+    const size_t sizet_n = mat_argl.no_cols();
+    const size_t sizet_k = mat_argr.no_cols();
+
+    matrix <T> mat_ret(sizet_m, sizet_k, T(0));
+    const size_t*       ptr_ptr   = mat_argl.outer_ptr().data();
+    const unsigned int* ptr_index = mat_argl.inner_index().data();
+    const T*            ptr_value = mat_argl.values().data();
+    const T*            ptr_x     = mat_argr.data();
+    T*                  ptr_y     = mat_ret.data();
+
+    // enough non-zeros per task to pay off the scheduling
+    size_t sizet_work = mat_argl.nnz() * sizet_k + 1;
+
+    if (mat_argl.format() == CSR)
+    {
+        size_t sizet_grain = std::max <size_t> (1, 4096 * sizet_m / sizet_work);
+        parallel_for(0, sizet_m, sizet_grain, [&](size_t sizet_first, size_t sizet_last)
+        {
+            for (size_t sizet_j = 0; sizet_j < sizet_k; sizet_j++)
+            {
+                const T* ptr_xj = ptr_x + sizet_j * sizet_n;
+                T*       ptr_yj = ptr_y + sizet_j * sizet_m;
+                for (size_t sizet_r = sizet_first; sizet_r < sizet_last; sizet_r++)
+                {
+                    T T_sum = T(0);
+                    for (size_t sizet_e = ptr_ptr[sizet_r]; sizet_e < ptr_ptr[sizet_r + 1]; sizet_e++)
+                    {
+                        T_sum += ptr_value[sizet_e] * ptr_xj[ptr_index[sizet_e]];
+                    }
+                    ptr_yj[sizet_r] = T_sum;
+                }
+            }
+        });
+    }
+    else
+    {
+        // the columns of the sparse matrix scatter into a column of the product
+        size_t sizet_grain = std::max <size_t> (1, 4096 * sizet_k / sizet_work);
+        parallel_for(0, sizet_k, sizet_grain, [&](size_t sizet_first, size_t sizet_last)
+        {
+            for (size_t sizet_j = sizet_first; sizet_j < sizet_last; sizet_j++)
+            {
+                const T* ptr_xj = ptr_x + sizet_j * sizet_n;
+                T*       ptr_yj = ptr_y + sizet_j * sizet_m;
+                for (size_t sizet_c = 0; sizet_c < sizet_n; sizet_c++)
+                {
+                    const T T_x = ptr_xj[sizet_c];
+                    for (size_t sizet_e = ptr_ptr[sizet_c]; sizet_e < ptr_ptr[sizet_c + 1]; sizet_e++)
+                    {
+                        ptr_yj[ptr_index[sizet_e]] += ptr_value[sizet_e] * T_x;
+                    }
+                }
+            }
+        });
+    }
+
+    return mat_ret;
+}
+
+template <class T> matrix <T> matmul(const matrix <T>& mat_argl, const sparse_matrix <T>& mat_argr)
+{
+    SUSA_ASSERT_MESSAGE(mat_argl.no_cols() == mat_argr.no_rows(), "the matrices' dimensions mismatch.");
+    if (mat_argl.no_cols() != mat_argr.no_rows() || mat_argr.no_cols() == 0) return matrix <T> ();
+
+    // (X A)^T = A^T X^T and the CSC storage of A is the CSR storage of A^T
+    sparse_matrix <T> mat_at = mat_argr.to_csc().transpose();
+
+    return susa::transpose(matmul(mat_at, susa::transpose(mat_argl)));
+}
+
+}       // NAMESPACE SUSA
+#endif  // SUSA_SPARSE_H
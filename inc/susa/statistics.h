@@ -29,63 +29,268 @@
 
 namespace susa {
 
+/**
+* @brief The <i>running_stats</i> class.
+*
+* It accumulates the count, the mean, the variance and the extrema of a
+* sequence in one pass with the update of Welford, hence no sample is stored.
+* The moments are kept in double whatever the sample type. The states of
+* different threads combine with <i>merge()</i>, which makes the partial
+* results of the workers of a simulation reducible in any grouping.
+* An optional histogram counts the samples in equal bins of [lo, hi).
+*
+* @ingroup Statistics
+*/
+template <class T> class running_stats
+{
+  public:
+    //! Constructor without a histogram
+    running_stats();
+
+    /**
+     * @brief Constructor with a histogram
+     *
+     * @param dbl_lo the lower edge of the first bin
+     * @param dbl_hi the upper edge of the last bin
+     * @param sizet_bins number of the bins
+     */
+    running_stats(double dbl_lo, double dbl_hi, size_t sizet_bins);
+
+    //! Adds a sample
+    void push(const T& T_arg);
+
+    //! Adds all the elements of a matrix
+    void push(const matrix <T>& mat_arg);
+
+    /**
+     * @brief Adds the samples of another accumulator
+     *
+     * The moments are always merged. The histograms are merged when both have
+     * the same bins, otherwise this one keeps its own counts.
+     *
+     * @param stats_arg the partial state e.g. of another thread
+     */
+    void merge(const running_stats <T>& stats_arg);
+
+    //! Forgets all the samples and keeps the bins
+    void reset();
+
+    //! Returns the number of samples
+    uint64_t count() const
+    {
+        return uint_count;
+    }
+
+    //! Returns the mean
+    double mean() const
+    {
+        return dbl_mean;
+    }
+
+    //! Returns the population variance
+    double variance() const
+    {
+        return uint_count > 0 ? dbl_m2 / uint_count : 0;
+    }
+
+    //! Returns the unbiased sample variance
+    double sample_variance() const
+    {
+        return uint_count > 1 ? dbl_m2 / (uint_count - 1) : 0;
+    }
+
+    //! Returns the population standard deviation
+    double stdv() const
+    {
+        return std::sqrt(variance());
+    }
+
+    //! Returns the least sample
+    T min() const
+    {
+        return T_min;
+    }
+
+    //! Returns the greatest sample
+    T max() const
+    {
+        return T_max;
+    }
+
+    //! Returns the number of samples of every bin
+    const std::vector <uint64_t>& histogram() const
+    {
+        return vec_bins;
+    }
+
+    //! Returns the number of samples below the first bin
+    uint64_t no_below() const
+    {
+        return uint_below;
+    }
+
+    //! Returns the number of samples above the last bin
+    uint64_t no_above() const
+    {
+        return uint_above;
+    }
+
+  private:
+    uint64_t                uint_count;
+    double                  dbl_mean;
+    double                  dbl_m2;
+    T                       T_min;
+    T                       T_max;
+    double                  dbl_lo;
+    double                  dbl_hi;
+    std::vector <uint64_t>  vec_bins;
+    uint64_t                uint_below;
+    uint64_t                uint_above;
+};
+
 /**
 * @brief Mean of a STL vector
 *
 * @param vec_arg Input STL vector
 * @ingroup Statistics
 */
-template <class T> T mean(std::vector <T> vec_arg);
+template <class T> T mean(const std::vector <T>& vec_arg);
 
 /**
 * @brief Variance of a STL vector
 *
 * @param vec_arg Input STL vector
+* @return the population variance
 * @ingroup Statistics
 */
-template <class T> double var(std::vector <T> vec_arg);
+template <class T> double var(const std::vector <T>& vec_arg);
 
 /**
 * @brief Standard deviation of a STL vector
 *
 * @param vec_arg Input STL vector
+* @return the population standard deviation
 * @ingroup Statistics
 */
-template <class T> double stdv(std::vector <T> vec_arg);
+template <class T> double stdv(const std::vector <T>& vec_arg);
 
 
-template <class T> T mean(std::vector <T> vec_arg) {
-    T tMean=0;
-    for (int i=0; i<vec_arg.size(); i++) {
-        tMean += vec_arg[i];
-    }
+template <class T> running_stats<T>::running_stats()
+: dbl_lo(0)
+, dbl_hi(0)
+{
+    reset();
+}
+
+template <class T> running_stats<T>::running_stats(double dbl_lo, double dbl_hi, size_t sizet_bins)
+: dbl_lo(dbl_lo)
+, dbl_hi(dbl_hi)
+, vec_bins(sizet_bins, 0)
+{
+    SUSA_ASSERT_MESSAGE(dbl_hi > dbl_lo, "the histogram range is empty.");
+    reset();
+}
 
-    return (tMean/vec_arg.size());
+template <class T> void running_stats<T>::reset()
+{
+    uint_count = 0;
+    dbl_mean   = 0;
+    dbl_m2     = 0;
+    T_min      = T(0);
+    T_max      = T(0);
+    uint_below = 0;
+    uint_above = 0;
+    std::fill(vec_bins.begin(), vec_bins.end(), 0);
 }
 
+template <class T> void running_stats<T>::push(const T& T_arg)
+{
+    double dbl_x     = static_cast <double> (T_arg);
+    double dbl_delta = dbl_x - dbl_mean;
 
+    uint_count++;
+    dbl_mean += dbl_delta / uint_count;
+    dbl_m2   += dbl_delta * (dbl_x - dbl_mean);
 
-template <class T> double var(std::vector <T> vec_arg) {
-    T tMean = mean(vec_arg);
-    T tVar = 0;
-    for (int i=0; i<vec_arg.size(); i++) {
-        tVar += (vec_arg[i] - tMean)*(vec_arg[i] - tMean);
+    if (uint_count == 1 || T_arg < T_min) T_min = T_arg;
+    if (uint_count == 1 || T_max < T_arg) T_max = T_arg;
+
+    if (vec_bins.empty()) return;
+
+    if (dbl_x < dbl_lo)
+    {
+        uint_below++;
+    }
+    else if (!(dbl_x < dbl_hi))
+    {
+        uint_above++;
     }
+    else
+    {
+        size_t sizet_bin = static_cast <size_t> ((dbl_x - dbl_lo) * vec_bins.size() / (dbl_hi - dbl_lo));
+        vec_bins[std::min(sizet_bin, vec_bins.size() - 1)]++;
+    }
+}
 
-    return (tVar/vec_arg.size());
+template <class T> void running_stats<T>::push(const matrix <T>& mat_arg)
+{
+    const T* ptr_data = mat_arg.data();
+    for (size_t sizet_i = 0; sizet_i < mat_arg.size(); sizet_i++) push(ptr_data[sizet_i]);
 }
 
+template <class T> void running_stats<T>::merge(const running_stats <T>& stats_arg)
+{
+    if (stats_arg.uint_count == 0) return;
 
+    if (uint_count == 0)
+    {
+        uint_count = stats_arg.uint_count;
+        dbl_mean   = stats_arg.dbl_mean;
+        dbl_m2     = stats_arg.dbl_m2;
+        T_min      = stats_arg.T_min;
+        T_max      = stats_arg.T_max;
+    }
+    else
+    {
+        // the pairwise update of Chan, Golub and LeVeque
+        uint64_t uint_total = uint_count + stats_arg.uint_count;
+        double   dbl_delta  = stats_arg.dbl_mean - dbl_mean;
+        double   dbl_ratio  = static_cast <double> (stats_arg.uint_count) / uint_total;
 
+        dbl_mean  += dbl_delta * dbl_ratio;
+        dbl_m2    += stats_arg.dbl_m2 + dbl_delta * dbl_delta * uint_count * dbl_ratio;
+        uint_count = uint_total;
 
-template <class T> double stdv(std::vector <T> vec_arg) {
-    T tMean = mean(vec_arg);
-    T tStd = 0;
-    for (int i=0; i<vec_arg.size(); i++) {
-        tStd += (vec_arg[i] - tMean)*(vec_arg[i] - tMean);
+        if (stats_arg.T_min < T_min) T_min = stats_arg.T_min;
+        if (T_max < stats_arg.T_max) T_max = stats_arg.T_max;
     }
 
-    return (sqrt(tStd/vec_arg.size()));
+    if (vec_bins.size() != stats_arg.vec_bins.size() || dbl_lo != stats_arg.dbl_lo || dbl_hi != stats_arg.dbl_hi) return;
+
+    for (size_t sizet_b = 0; sizet_b < vec_bins.size(); sizet_b++) vec_bins[sizet_b] += stats_arg.vec_bins[sizet_b];
+    uint_below += stats_arg.uint_below;
+    uint_above += stats_arg.uint_above;
+}
+
+template <class T> T mean(const std::vector <T>& vec_arg)
+{
+    running_stats <T> stats;
+    for (size_t sizet_i = 0; sizet_i < vec_arg.size(); sizet_i++) stats.push(vec_arg[sizet_i]);
+
+    return static_cast <T> (stats.mean());
+}
+
+template <class T> double var(const std::vector <T>& vec_arg)
+{
+    running_stats <T> stats;
+    for (size_t sizet_i = 0; sizet_i < vec_arg.size(); sizet_i++) stats.push(vec_arg[sizet_i]);
+
+    return stats.variance();
+}
+
+template <class T> double stdv(const std::vector <T>& vec_arg)
+{
+    return std::sqrt(var(vec_arg));
 }
 } // NAMESPACE SUSA
 #endif // STATISTICS_H
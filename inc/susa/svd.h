@@ -51,5 +51,60 @@ int svd(const matrix <float> &mat_arg_a,
               matrix <float> &mat_arg_s,
               matrix <float> &mat_arg_v);
 
+/**
+ * @brief Singular Value Decomposition (SVD)
+ *
+ * One-sided Jacobi (Hestenes) decomposition A = U * diag(S) * V^T of a m by n real matrix.
+ * The sweeps visit the column pairs in the round-robin order, hence the rotations of a
+ * round touch disjoint columns and they run in parallel on the thread pool, while the
+ * rotations and the inner products run on contiguous columns. The singular values are
+ * computed to a high relative accuracy and they are sorted in the descending order.
+ *
+ * @param mat_arg_a The input matrix A
+ * @param mat_arg_u The left singular vectors, m by min(m,n)
+ * @param mat_arg_s The singular values, min(m,n) by 1
+ * @param mat_arg_v The right singular vectors, n by min(m,n)
+ * @return zero if the sweeps converged
+ *
+ * @ingroup LALG
+ */
+int svd(const matrix <double> &mat_arg_a,
+              matrix <double> &mat_arg_u,
+              matrix <double> &mat_arg_s,
+              matrix <double> &mat_arg_v);
+
+/**
+ * @brief Singular Value Decomposition (SVD)
+ *
+ * One-sided Jacobi decomposition A = U * diag(S) * V^H of a complex matrix (see the real one).
+ *
+ * @param mat_arg_a The input matrix A
+ * @param mat_arg_u The left singular vectors, m by min(m,n)
+ * @param mat_arg_s The singular values, min(m,n) by 1
+ * @param mat_arg_v The right singular vectors, n by min(m,n)
+ * @return zero if the sweeps converged
+ *
+ * @ingroup LALG
+ */
+int svd(const matrix <std::complex <double> > &mat_arg_a,
+              matrix <std::complex <double> > &mat_arg_u,
+              matrix <double> &mat_arg_s,
+              matrix <std::complex <double> > &mat_arg_v);
+
+/**
+ * @brief Singular values
+ *
+ * The one-sided Jacobi sweeps without the accumulation of the singular vectors.
+ *
+ * @param mat_arg_a The input matrix A
+ * @return the singular values in the descending order
+ *
+ * @ingroup LALG
+ */
+matrix <double> singular_values(const matrix <double> &mat_arg_a);
+
+//! Singular values of a complex matrix
+matrix <double> singular_values(const matrix <std::complex <double> > &mat_arg_a);
+
 } // NAMESPACE SUSA
 #endif // SUSA_SVD_H
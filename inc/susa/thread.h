@@ -0,0 +1,162 @@
+/*
+ * This file is part of Susa.
+ *
+ * Susa is free software: you can redistribute it and/or modify
+ * it under the terms of the Lesser GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * at your option) any later version.
+ *
+ * Susa is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * Lesser GNU General Public License for more details.
+ *
+ * You should have received a copy of the Lesser GNU General Public License
+ * along with Susa.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file thread.h
+ * @brief A thread pool and parallel loops (declaration).
+ * @author Behrooz Kamary
+ * @version 1.0.0
+ *
+ * @defgroup Thread Parallel Execution
+ */
+
+#ifndef SUSA_THREAD_H
+#define SUSA_THREAD_H
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace susa {
+
+/**
+ * @brief The <i>thread_pool</i> class.
+ *
+ * A fixed set of worker threads that execute the indexed tasks of a job.
+ * The calling thread takes part in the job, hence a pool of size one
+ * has no worker thread and runs the tasks serially. A job that is started
+ * from inside a task runs serially on the calling worker.
+ *
+ * @ingroup Thread
+ */
+class thread_pool
+{
+  public:
+    /**
+     * @brief Constructor
+     *
+     * @param sizet_threads number of threads (including the caller),
+     * zero selects the number of hardware threads.
+     */
+    explicit thread_pool(size_t sizet_threads = 0);
+
+    //! Destructor
+    ~thread_pool();
+
+    thread_pool(const thread_pool&) = delete;
+    thread_pool& operator=(const thread_pool&) = delete;
+
+    //! Returns the number of threads (including the caller)
+    size_t size() const;
+
+    /**
+     * @brief Runs a job and waits for its completion
+     *
+     * @param sizet_tasks number of tasks
+     * @param func the task that is called with the task index in [0, sizet_tasks)
+     */
+    void run(size_t sizet_tasks, const std::function <void (size_t)>& func);
+
+  private:
+    std::vector <std::thread>  vec_workers;
+    std::mutex                 mutex_job;
+    std::mutex                 mutex_state;
+    std::condition_variable    cv_start;
+    std::condition_variable    cv_done;
+
+    const std::function <void (size_t)>* ptr_func;
+    size_t                     sizet_tasks;
+    std::atomic <size_t>       sizet_next;
+    size_t                     sizet_busy;
+    size_t                     sizet_generation;
+    bool                       bool_stop;
+
+    void worker();
+    void execute();
+};
+
+/**
+ * @brief Returns the process-wide thread pool used by Susa routines.
+ *
+ * @ingroup Thread
+ */
+thread_pool& get_thread_pool();
+
+/**
+ * @brief Sets the number of threads of the process-wide pool.
+ *
+ * It should not be called while the pool is running a job.
+ *
+ * @param sizet_threads number of threads, zero selects the hardware threads.
+ * @ingroup Thread
+ */
+void set_num_threads(size_t sizet_threads);
+
+/**
+ * @brief Returns the number of threads of the process-wide pool.
+ *
+ * @ingroup Thread
+ */
+size_t get_num_threads();
+
+/**
+ * @brief Parallel loop
+ *
+ * Calls <i>func(sizet_begin, sizet_end)</i> for contiguous chunks that
+ * cover the range [sizet_begin, sizet_end) using the process-wide pool.
+ *
+ * @param sizet_begin the first index
+ * @param sizet_end one past the last index
+ * @param sizet_grain the minimum chunk size
+ * @param func the loop body called for each chunk
+ * @ingroup Thread
+ */
+template <class F> void parallel_for(size_t sizet_begin, size_t sizet_end, size_t sizet_grain, F func)
+{
+    if (sizet_end <= sizet_begin) return;
+
+    thread_pool& pool = get_thread_pool();
+    size_t sizet_range = sizet_end - sizet_begin;
+    size_t sizet_grain_ = sizet_grain == 0 ? 1 : sizet_grain;
+    size_t sizet_chunks = (sizet_range + sizet_grain_ - 1) / sizet_grain_;
+
+    // a few chunks per thread balance the load of uneven tasks
+    if (sizet_chunks > 4 * pool.size()) sizet_chunks = 4 * pool.size();
+
+    if (sizet_chunks < 2)
+    {
+        func(sizet_begin, sizet_end);
+        return;
+    }
+
+    size_t sizet_step = (sizet_range + sizet_chunks - 1) / sizet_chunks;
+    sizet_chunks = (sizet_range + sizet_step - 1) / sizet_step;
+
+    pool.run(sizet_chunks, [&](size_t sizet_chunk)
+    {
+        size_t sizet_first = sizet_begin + sizet_chunk * sizet_step;
+        size_t sizet_last  = sizet_first + sizet_step;
+        func(sizet_first, sizet_last < sizet_end ? sizet_last : sizet_end);
+    });
+}
+
+} // NAMESPACE SUSA
+
+#endif // SUSA_THREAD_H
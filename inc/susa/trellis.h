@@ -0,0 +1,122 @@
+/*
+ * This file is part of Susa.
+ *
+ * Susa is free software: you can redistribute it and/or modify
+ * it under the terms of the Lesser GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * at your option) any later version.
+ *
+ * Susa is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * Lesser GNU General Public License for more details.
+ *
+ * You should have received a copy of the Lesser GNU General Public License
+ * along with Susa.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file trellis.h
+ * @brief Precomputed trellis tables (declaration).
+ * @author Behrooz Kamary
+ * @version 1.0.0
+ */
+
+#ifndef SUSA_TRELLIS_H
+#define SUSA_TRELLIS_H
+
+#include <memory>
+
+namespace susa {
+
+/**
+ * @brief The <i>trellis</i> class.
+ *
+ * The flat tables of a time-invariant trellis with <i>S</i> states and <i>P</i> inputs
+ * per state. The tables are laid out as a structure of arrays, i.e. the next states
+ * (and the output labels) of all the states for a given input are contiguous and
+ * the k-th predecessors (and their inputs) of all the states are contiguous.
+ * Every state must have exactly <i>P</i> predecessors (a shift-register trellis).
+ * A trellis is immutable after construction, hence it can be shared between threads.
+ *
+ * @ingroup Communications
+ */
+class trellis
+{
+  public:
+    //! Constructor of an empty trellis
+    trellis();
+
+    /**
+     * @brief Constructor
+     *
+     * @param uint_states number of states
+     * @param uint_inputs number of inputs i.e. branches leaving a state
+     * @param vec_next the next state of (state, input) at <i>state * P + input</i>
+     * @param vec_labels the output label of (state, input) at <i>state * P + input</i>
+     */
+    trellis(uint32_t uint_states, uint32_t uint_inputs, const std::vector <uint32_t>& vec_next,
+      const std::vector <uint32_t>& vec_labels);
+
+    //! Returns the number of states
+    uint32_t no_states() const
+    {
+        return uint_states;
+    }
+
+    //! Returns the number of inputs (and predecessors) per state
+    uint32_t no_inputs() const
+    {
+        return uint_inputs;
+    }
+
+    //! Returns the next state
+    uint32_t next_state(uint32_t uint_state, uint32_t uint_input) const
+    {
+        return vec_next[uint_input * uint_states + uint_state];
+    }
+
+    //! Returns the output label of a transition
+    uint32_t label(uint32_t uint_state, uint32_t uint_input) const
+    {
+        return vec_labels[uint_input * uint_states + uint_state];
+    }
+
+    //! Returns the next states of all the states for an input
+    const uint32_t* next_states(uint32_t uint_input) const
+    {
+        return vec_next.data() + uint_input * uint_states;
+    }
+
+    //! Returns the output labels of all the states for an input
+    const uint32_t* labels(uint32_t uint_input) const
+    {
+        return vec_labels.data() + uint_input * uint_states;
+    }
+
+    //! Returns the k-th predecessors of all the states
+    const uint32_t* prev_states(uint32_t uint_k) const
+    {
+        return vec_prev.data() + uint_k * uint_states;
+    }
+
+    //! Returns the inputs of the transitions from the k-th predecessors of all the states
+    const uint32_t* prev_inputs(uint32_t uint_k) const
+    {
+        return vec_prev_inputs.data() + uint_k * uint_states;
+    }
+
+  private:
+    uint32_t                uint_states;
+    uint32_t                uint_inputs;
+    std::vector <uint32_t>  vec_next;
+    std::vector <uint32_t>  vec_labels;
+    std::vector <uint32_t>  vec_prev;
+    std::vector <uint32_t>  vec_prev_inputs;
+};
+
+//! A trellis shared read-only between the decoders
+typedef std::shared_ptr <const trellis> trellis_ptr;
+
+}       // NAMESPACE SUSA
+#endif  // SUSA_TRELLIS_H
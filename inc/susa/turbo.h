@@ -0,0 +1,162 @@
+/*
+ * This file is part of Susa.
+ *
+ * Susa is free software: you can redistribute it and/or modify
+ * it under the terms of the Lesser GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * at your option) any later version.
+ *
+ * Susa is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * Lesser GNU General Public License for more details.
+ *
+ * You should have received a copy of the Lesser GNU General Public License
+ * along with Susa.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file turbo.h
+ * @brief Parallel concatenated convolutional (turbo) codes (declaration).
+ * @author Behrooz Kamary
+ * @version 1.0.0
+ */
+
+#ifndef SUSA_TURBO_H
+#define SUSA_TURBO_H
+
+#include <functional>
+
+namespace susa {
+
+/**
+ * @brief A random interleaver
+ *
+ * @param sizet_len the frame length
+ * @param uint_seed the seed of the random number generator
+ * @return the permutation, i.e. the i-th interleaved bit is the bit <i>vec[i]</i>
+ * @ingroup Communications
+ */
+std::vector <uint32_t> random_interleaver(size_t sizet_len, unsigned int uint_seed);
+
+/**
+ * @brief Turbo Codes
+ *
+ * The parallel concatenation of two convolutional codes, the first one encodes the frame and
+ * the second one the interleaved frame. Both encoders are flushed to the zero state by
+ * their own tail bits and the code word is the output of the first encoder followed by the
+ * output of the second one.
+ *
+ * The decoder exchanges the extrinsic LLRs of the information bits between the log-domain
+ * BCJR decoders of the codes. It stops when the stop check (e.g. a CRC) passes, when the hard
+ * decisions of two iterations are the same or after the maximum number of iterations. The
+ * scratch space of the decoders is kept, hence the iterations and the frames of the same
+ * length do not allocate.
+ *
+ * The codes are referenced, i.e. they have to outlive the turbo code.
+ *
+ * @ingroup Communications
+ */
+class turbo
+{
+  public:
+
+    /**
+     * @brief Constructor
+     *
+     * @param code_1 the first constituent code
+     * @param code_2 the second constituent code
+     * @param vec_interleaver the permutation of the frame, see <i>random_interleaver()</i>
+     * @param sizet_iterations the maximum number of iterations
+     * @param metric the max* operation of the constituent decoders
+     */
+    turbo(const ccode& code_1, const ccode& code_2, const std::vector <uint32_t>& vec_interleaver,
+      size_t sizet_iterations = 8, ccode::bcjr_metric metric = ccode::LOG_MAP);
+
+    //! the number of information bits of a frame
+    size_t no_bits() const
+    {
+        return vec_interleaver.size();
+    }
+
+    //! the number of bits of a code word
+    size_t no_coded() const;
+
+    /**
+     * @brief Turbo encoder
+     *
+     * @param mat_bits the information bits of a frame
+     * @return the code word
+     */
+    matrix <uint8_t> encode(const matrix <uint8_t>& mat_bits) const;
+
+    /**
+     * @brief Iterative turbo decoder
+     *
+     * @param mat_arg the soft code word (antipodal, positive for a one bit)
+     * @param dbl_ebn0 Eb/N0 in linear scale with AWGN assumption
+     * @return the decoded information bits
+     */
+    matrix <uint8_t> decode(const matrix <double>& mat_arg, double dbl_ebn0);
+
+    /**
+     * @brief Sets the stop check of the decoder
+     *
+     * The check is called with the hard decisions after every iteration, e.g. a CRC check.
+     *
+     * @param func_stop returns true if the decisions are accepted
+     */
+    void set_stop_check(std::function <bool (const matrix <uint8_t>&)> func_stop)
+    {
+        this->func_stop = func_stop;
+    }
+
+    //! Enables the stop when the hard decisions of two iterations are the same
+    void set_early_termination(bool bool_early)
+    {
+        this->bool_early = bool_early;
+    }
+
+    //! the number of iterations of the last frame
+    size_t iterations() const
+    {
+        return sizet_iterations;
+    }
+
+    //! the a posteriori LLRs of the information bits of the last frame
+    const matrix <double>& llr() const
+    {
+        return mat_llr;
+    }
+
+  private:
+    const ccode*            ptr_code_1;
+    const ccode*            ptr_code_2;
+    std::vector <uint32_t>  vec_interleaver;
+    size_t                  sizet_max_iterations;
+    ccode::bcjr_metric      metric;
+    bool                    bool_early;
+    size_t                  sizet_iterations;
+
+    std::function <bool (const matrix <uint8_t>&)> func_stop;
+
+    // the persistent scratch space of the decoders
+    ccode::workspace        ws_1;
+    ccode::workspace        ws_2;
+    std::vector <double>    vec_la_1;       // the a priori LLRs of the first decoder
+    std::vector <double>    vec_la_2;       // the a priori LLRs of the second decoder (interleaved)
+    std::vector <double>    vec_app_1;
+    std::vector <double>    vec_app_2;
+    std::vector <uint8_t>   vec_prev;       // the decisions of the previous iteration
+    matrix <double>         mat_llr;
+    matrix <uint8_t>        mat_hard;
+
+    // the stages of a code (the frame and the tail)
+    size_t stages(const ccode& code) const
+    {
+        return vec_interleaver.size() + code.uint_m;
+    }
+};
+
+}      // NAMESPACE SUSA
+#endif // SUSA_TURBO_H
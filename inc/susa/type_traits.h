@@ -33,6 +33,10 @@ namespace susa
 
 template<class T> struct is_complex : public std::false_type {};
 template<class T> struct is_complex<std::complex<T>> : public std::true_type {};
+
+//! The real type of a (possibly complex) type
+template<class T> struct real_type { typedef T type; };
+template<class T> struct real_type<std::complex<T>> { typedef T type; };
     
 }
 
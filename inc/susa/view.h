@@ -0,0 +1,458 @@
+/*
+ * This file is part of Susa.
+ *
+ * Susa is free software: you can redistribute it and/or modify
+ * it under the terms of the Lesser GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * at your option) any later version.
+ *
+ * Susa is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * Lesser GNU General Public License for more details.
+ *
+ * You should have received a copy of the Lesser GNU General Public License
+ * along with Susa.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file view.h
+ * @brief Non-owning matrix views (declaration and definition).
+ *
+ * This file contains the <i>matrix_view</i> class that refers to the
+ * elements of a <i>matrix</i> (or any column-major buffer) with a row and
+ * a column stride. The rows, columns, vector slices and sub-blocks of a
+ * matrix are taken as views without allocating or copying the elements.
+ * A view is a lazy expression, hence it can be used with the lazy operators
+ * and it is evaluated into a matrix when it is assigned to one.
+ *
+ * @author Behrooz Kamary
+ * @version 1.0.0
+ */
+
+#ifndef SUSA_VIEW_H
+#define SUSA_VIEW_H
+
+#include <type_traits>
+
+#include <susa/debug.h>
+#include <susa/expression.h>
+
+namespace susa
+{
+
+template <class T> class matrix;
+
+/**
+ * @brief The <i>matrix_view</i> class.
+ *
+ * A view refers to <i>sizet_rows x sizet_cols</i> elements where the element
+ * (row, col) is located at <i>row * row_stride() + col * col_stride()</i> from
+ * the first element. A view of a <i>const</i> matrix has a <i>const T</i> element type.
+ * Similar to a pointer the constness of the view object does not propagate to
+ * the elements. The viewed matrix should outlive the view and it should not be
+ * resized while it is viewed.
+ *
+ * The assignment operators copy the elements into the viewed storage.
+ * The source of an assignment should not partially overlap the view.
+ *
+ * @ingroup TYPES
+ */
+template <class T> class matrix_view : public expression <typename std::remove_const <T>::type, matrix_view <T> >
+{
+  public:
+    typedef typename std::remove_const <T>::type value_type;
+
+  private:
+    T*      T_data;
+    size_t  sizet_rows;
+    size_t  sizet_cols;
+    size_t  sizet_rstride;
+    size_t  sizet_cstride;
+
+    template <class E> void assign(const expression <value_type, E>& expr_arg);
+
+  public:
+    //! Constructor of an empty view
+    matrix_view();
+
+    /**
+     * @brief Constructor
+     *
+     * @param T_first the first element
+     * @param sizet_rows number of rows
+     * @param sizet_cols number of columns
+     * @param sizet_rstride the distance between two consecutive rows
+     * @param sizet_cstride the distance between two consecutive columns
+     */
+    matrix_view(T* T_first, size_t sizet_rows, size_t sizet_cols, size_t sizet_rstride, size_t sizet_cstride);
+
+    //! Constructor that views the whole matrix
+    matrix_view(matrix <value_type>& mat_arg);
+
+    //! Constructor that views the whole constant matrix
+    matrix_view(const matrix <value_type>& mat_arg);
+
+    //! Copy constructor (the new view refers to the same elements)
+    matrix_view(const matrix_view <T>& view_arg) = default;
+
+    //! Conversion of a mutable view to a constant view
+    template <class U, class = typename std::enable_if <std::is_same <const U, T>::value && !std::is_same <U, T>::value>::type>
+    matrix_view(const matrix_view <U>& view_arg)
+    : T_data(view_arg.data())
+    , sizet_rows(view_arg.no_rows())
+    , sizet_cols(view_arg.no_cols())
+    , sizet_rstride(view_arg.row_stride())
+    , sizet_cstride(view_arg.col_stride())
+    {}
+
+    //! Returns the number of rows
+    size_t no_rows() const;
+
+    //! Returns the number of columns
+    size_t no_cols() const;
+
+    //! Returns the number of elements
+    size_t size() const;
+
+    //! Returns the distance between two consecutive rows
+    size_t row_stride() const;
+
+    //! Returns the distance between two consecutive columns
+    size_t col_stride() const;
+
+    //! Returns the first element
+    T* data() const;
+
+    //! Returns true if the elements are contiguous in column-major order
+    bool is_contiguous() const;
+
+    //! Returns true if it has a single row or a single column (and more than one element)
+    bool is_vector() const;
+
+    //! Returns true if it has a single element
+    bool is_scalar() const;
+
+    //! Returns the element at (row, column)
+    T& operator()(size_t sizet_row, size_t sizet_col) const;
+
+    //! Returns the element at the linear (column-major) index
+    T& operator()(size_t sizet_elem) const;
+
+    //! Returns the value at the linear (column-major) index
+    value_type elem(size_t sizet_elem) const;
+
+    //! Returns the indicated row
+    matrix_view <T> row(size_t sizet_row) const;
+
+    //! Returns the indicated column
+    matrix_view <T> col(size_t sizet_col) const;
+
+    /**
+     * @brief Returns a sub-block
+     *
+     * @param sizet_row the first row
+     * @param sizet_col the first column
+     * @param sizet_no_rows number of rows
+     * @param sizet_no_cols number of columns
+     */
+    matrix_view <T> block(size_t sizet_row, size_t sizet_col, size_t sizet_no_rows, size_t sizet_no_cols) const;
+
+    //! Considers the view as a vector and returns the left side of that vector
+    matrix_view <T> left(size_t sizet_left) const;
+
+    //! Considers the view as a vector and returns the right side of that vector
+    matrix_view <T> right(size_t sizet_right) const;
+
+    //! Considers the view as a vector and returns the elements from sizet_begin to sizet_end (inclusive)
+    matrix_view <T> mid(size_t sizet_begin, size_t sizet_end) const;
+
+    /**
+     * @brief Considers the view as a vector and returns every sizet_step-th element
+     *
+     * @param sizet_begin the first element
+     * @param sizet_count number of elements
+     * @param sizet_step the distance between two consecutive elements
+     */
+    matrix_view <T> strided(size_t sizet_begin, size_t sizet_count, size_t sizet_step) const;
+
+    //! Sets all the elements
+    void set_all(value_type T_arg) const;
+
+    //! Copies the elements of another view
+    matrix_view <T>& operator=(const matrix_view <T>& view_arg);
+
+    //! Copies the elements of a matrix
+    matrix_view <T>& operator=(const matrix <value_type>& mat_arg);
+
+    //! Evaluates a lazy expression into the viewed elements
+    template <class E> matrix_view <T>& operator=(const expression <value_type, E>& expr_arg);
+
+    //! Element wise Assignment by Addition
+    template <class E> matrix_view <T>& operator+=(const expression <value_type, E>& expr_arg);
+
+    //! Element wise Assignment by Subtraction
+    template <class E> matrix_view <T>& operator-=(const expression <value_type, E>& expr_arg);
+
+    //! Assignment by Multiplication by a scalar
+    matrix_view <T>& operator*=(value_type T_arg);
+
+    //! Assignment by Division by a scalar
+    matrix_view <T>& operator/=(value_type T_arg);
+};
+
+// Implementation
+
+template <class T> matrix_view <T>::matrix_view()
+: T_data(nullptr)
+, sizet_rows(0)
+, sizet_cols(0)
+, sizet_rstride(1)
+, sizet_cstride(0)
+{}
+
+template <class T> matrix_view <T>::matrix_view(T* T_first, size_t sizet_rows, size_t sizet_cols,
+  size_t sizet_rstride, size_t sizet_cstride)
+: T_data(T_first)
+, sizet_rows(sizet_rows)
+, sizet_cols(sizet_cols)
+, sizet_rstride(sizet_rstride)
+, sizet_cstride(sizet_cstride)
+{}
+
+template <class T> matrix_view <T>::matrix_view(matrix <value_type>& mat_arg)
+: T_data(mat_arg.data())
+, sizet_rows(mat_arg.no_rows())
+, sizet_cols(mat_arg.no_cols())
+, sizet_rstride(1)
+, sizet_cstride(mat_arg.no_rows())
+{}
+
+template <class T> matrix_view <T>::matrix_view(const matrix <value_type>& mat_arg)
+: T_data(mat_arg.data())
+, sizet_rows(mat_arg.no_rows())
+, sizet_cols(mat_arg.no_cols())
+, sizet_rstride(1)
+, sizet_cstride(mat_arg.no_rows())
+{}
+
+template <class T> size_t matrix_view <T>::no_rows() const
+{
+    return sizet_rows;
+}
+
+template <class T> size_t matrix_view <T>::no_cols() const
+{
+    return sizet_cols;
+}
+
+template <class T> size_t matrix_view <T>::size() const
+{
+    return sizet_rows * sizet_cols;
+}
+
+template <class T> size_t matrix_view <T>::row_stride() const
+{
+    return sizet_rstride;
+}
+
+template <class T> size_t matrix_view <T>::col_stride() const
+{
+    return sizet_cstride;
+}
+
+template <class T> T* matrix_view <T>::data() const
+{
+    return T_data;
+}
+
+template <class T> bool matrix_view <T>::is_contiguous() const
+{
+    return (sizet_rows < 2 || sizet_rstride == 1) && (sizet_cols < 2 || sizet_cstride == sizet_rows * sizet_rstride);
+}
+
+template <class T> bool matrix_view <T>::is_vector() const
+{
+    return ((sizet_rows == 1 && sizet_cols > 1) || (sizet_rows > 1 && sizet_cols == 1));
+}
+
+template <class T> bool matrix_view <T>::is_scalar() const
+{
+    return (sizet_rows == 1 && sizet_cols == 1);
+}
+
+template <class T> T& matrix_view <T>::operator()(size_t sizet_row, size_t sizet_col) const
+{
+    SUSA_ASSERT_MESSAGE(sizet_row < sizet_rows && sizet_col < sizet_cols, "one or more indices is/are out of range.");
+    return T_data[sizet_row * sizet_rstride + sizet_col * sizet_cstride];
+}
+
+template <class T> T& matrix_view <T>::operator()(size_t sizet_elem) const
+{
+    SUSA_ASSERT_MESSAGE(sizet_elem < sizet_rows * sizet_cols, "the index is out of range.");
+
+    // the vectors avoid the division of the linear index
+    if (sizet_cols == 1) return T_data[sizet_elem * sizet_rstride];
+    if (sizet_rows == 1) return T_data[sizet_elem * sizet_cstride];
+
+    return T_data[(sizet_elem % sizet_rows) * sizet_rstride + (sizet_elem / sizet_rows) * sizet_cstride];
+}
+
+template <class T> typename matrix_view <T>::value_type matrix_view <T>::elem(size_t sizet_elem) const
+{
+    return (*this)(sizet_elem);
+}
+
+template <class T> matrix_view <T> matrix_view <T>::row(size_t sizet_row) const
+{
+    SUSA_ASSERT_MESSAGE(sizet_row < sizet_rows, "the row index is out of range.");
+    if (sizet_row >= sizet_rows) return matrix_view <T> ();
+
+    return matrix_view <T> (T_data + sizet_row * sizet_rstride, 1, sizet_cols, sizet_rstride, sizet_cstride);
+}
+
+template <class T> matrix_view <T> matrix_view <T>::col(size_t sizet_col) const
+{
+    SUSA_ASSERT_MESSAGE(sizet_col < sizet_cols, "the column index is out of range.");
+    if (sizet_col >= sizet_cols) return matrix_view <T> ();
+
+    return matrix_view <T> (T_data + sizet_col * sizet_cstride, sizet_rows, 1, sizet_rstride, sizet_cstride);
+}
+
+template <class T> matrix_view <T> matrix_view <T>::block(size_t sizet_row, size_t sizet_col,
+  size_t sizet_no_rows, size_t sizet_no_cols) const
+{
+    SUSA_ASSERT_MESSAGE(sizet_row + sizet_no_rows <= sizet_rows && sizet_col + sizet_no_cols <= sizet_cols,
+      "the block exceeds the view size.");
+
+    if (sizet_row + sizet_no_rows > sizet_rows || sizet_col + sizet_no_cols > sizet_cols) return matrix_view <T> ();
+
+    return matrix_view <T> (T_data + sizet_row * sizet_rstride + sizet_col * sizet_cstride,
+                            sizet_no_rows, sizet_no_cols, sizet_rstride, sizet_cstride);
+}
+
+template <class T> matrix_view <T> matrix_view <T>::strided(size_t sizet_begin, size_t sizet_count, size_t sizet_step) const
+{
+    SUSA_ASSERT_MESSAGE(sizet_step > 0, "the step should be positive.");
+    SUSA_ASSERT_MESSAGE(sizet_count == 0 || sizet_begin + (sizet_count - 1) * sizet_step < size(),
+      "the slice exceeds the view size.");
+
+    if (sizet_step == 0 || (sizet_count > 0 && sizet_begin + (sizet_count - 1) * sizet_step >= size()))
+    {
+        return matrix_view <T> ();
+    }
+
+    if (sizet_rows == 1)
+    {
+        return matrix_view <T> (T_data + sizet_begin * sizet_cstride, 1, sizet_count,
+                                sizet_rstride, sizet_cstride * sizet_step);
+    }
+
+    if (sizet_cols == 1 || is_contiguous())
+    {
+        return matrix_view <T> (T_data + sizet_begin * sizet_rstride, sizet_count, 1,
+                                sizet_rstride * sizet_step, sizet_cstride);
+    }
+
+    SUSA_ASSERT_MESSAGE(false, "a non-contiguous matrix can not be sliced as a vector.");
+
+    return matrix_view <T> ();
+}
+
+template <class T> matrix_view <T> matrix_view <T>::left(size_t sizet_left) const
+{
+    return strided(0, sizet_left, 1);
+}
+
+template <class T> matrix_view <T> matrix_view <T>::right(size_t sizet_right) const
+{
+    SUSA_ASSERT(size() >= sizet_right);
+    if (size() < sizet_right) return matrix_view <T> ();
+
+    return strided(size() - sizet_right, sizet_right, 1);
+}
+
+template <class T> matrix_view <T> matrix_view <T>::mid(size_t sizet_begin, size_t sizet_end) const
+{
+    SUSA_ASSERT(sizet_end >= sizet_begin);
+    if (sizet_end < sizet_begin) return matrix_view <T> ();
+
+    return strided(sizet_begin, sizet_end - sizet_begin + 1, 1);
+}
+
+template <class T> void matrix_view <T>::set_all(value_type T_arg) const
+{
+    for (size_t sizet_col = 0; sizet_col < sizet_cols; sizet_col++)
+    {
+        T* T_col = T_data + sizet_col * sizet_cstride;
+        for (size_t sizet_row = 0; sizet_row < sizet_rows; sizet_row++)
+        {
+            T_col[sizet_row * sizet_rstride] = T_arg;
+        }
+    }
+}
+
+template <class T> template <class E> void matrix_view <T>::assign(const expression <value_type, E>& expr_arg)
+{
+    SUSA_ASSERT_MESSAGE(expr_arg.no_rows() == sizet_rows && expr_arg.no_cols() == sizet_cols,
+      "the view and the assigned expression have different sizes.");
+
+    if (expr_arg.no_rows() != sizet_rows || expr_arg.no_cols() != sizet_cols) return;
+
+    const E& expr = expr_arg.self();
+    size_t sizet_elem = 0;
+    for (size_t sizet_col = 0; sizet_col < sizet_cols; sizet_col++)
+    {
+        T* T_col = T_data + sizet_col * sizet_cstride;
+        for (size_t sizet_row = 0; sizet_row < sizet_rows; sizet_row++)
+        {
+            T_col[sizet_row * sizet_rstride] = expr.elem(sizet_elem++);
+        }
+    }
+}
+
+template <class T> matrix_view <T>& matrix_view <T>::operator=(const matrix_view <T>& view_arg)
+{
+    assign(view_arg);
+    return *this;
+}
+
+template <class T> matrix_view <T>& matrix_view <T>::operator=(const matrix <value_type>& mat_arg)
+{
+    assign(expr_leaf <value_type> (mat_arg));
+    return *this;
+}
+
+template <class T> template <class E> matrix_view <T>& matrix_view <T>::operator=(const expression <value_type, E>& expr_arg)
+{
+    assign(expr_arg);
+    return *this;
+}
+
+template <class T> template <class E> matrix_view <T>& matrix_view <T>::operator+=(const expression <value_type, E>& expr_arg)
+{
+    assign(*this + expr_arg.self());
+    return *this;
+}
+
+template <class T> template <class E> matrix_view <T>& matrix_view <T>::operator-=(const expression <value_type, E>& expr_arg)
+{
+    assign(*this - expr_arg.self());
+    return *this;
+}
+
+template <class T> matrix_view <T>& matrix_view <T>::operator*=(value_type T_arg)
+{
+    assign(*this * T_arg);
+    return *this;
+}
+
+template <class T> matrix_view <T>& matrix_view <T>::operator/=(value_type T_arg)
+{
+    assign(*this / T_arg);
+    return *this;
+}
+
+}      // NAMESPACE SUSA
+
+#endif // SUSA_VIEW_H
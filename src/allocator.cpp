@@ -0,0 +1,306 @@
+/*
+ * This file is part of Susa.
+ *
+ * Susa is free software: you can redistribute it and/or modify
+ * it under the terms of the Lesser GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * at your option) any later version.
+ *
+ * Susa is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * Lesser GNU General Public License for more details.
+ *
+ * You should have received a copy of the Lesser GNU General Public License
+ * along with Susa.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file allocator.cpp
+ * @brief Memory allocation policies (definition).
+ * @author Behrooz Kamary
+ * @version 1.0.0
+ */
+
+#include <cstdint>
+#include <susa.h>
+
+namespace susa
+{
+
+// allocator
+
+allocator::~allocator() {}
+
+void* allocator::reallocate(void* ptr_block, size_t sizet_old, size_t sizet_new)
+{
+    void* ptr_new = allocate(sizet_new);
+    if (ptr_new == nullptr) return nullptr;
+
+    std::memcpy(ptr_new, ptr_block, sizet_old < sizet_new ? sizet_old : sizet_new);
+    deallocate(ptr_block, sizet_old);
+
+    return ptr_new;
+}
+
+// heap_allocator
+
+void* heap_allocator::allocate(size_t sizet_bytes)
+{
+    return std::malloc(sizet_bytes);
+}
+
+void* heap_allocator::reallocate(void* ptr_block, size_t, size_t sizet_new)
+{
+    return std::realloc(ptr_block, sizet_new);
+}
+
+void heap_allocator::deallocate(void* ptr_block, size_t)
+{
+    std::free(ptr_block);
+}
+
+// aligned_allocator
+
+aligned_allocator::aligned_allocator(size_t sizet_alignment)
+{
+    SUSA_ASSERT_MESSAGE(sizet_alignment != 0 && (sizet_alignment & (sizet_alignment - 1)) == 0,
+      "the alignment must be a power of two.");
+    this->sizet_alignment = sizet_alignment < sizeof(void*) ? sizeof(void*) : sizet_alignment;
+}
+
+// The original pointer is kept just before the aligned block.
+void* aligned_allocator::allocate(size_t sizet_bytes)
+{
+    void* ptr_raw = std::malloc(sizet_bytes + sizet_alignment - 1 + sizeof(void*));
+    if (ptr_raw == nullptr) return nullptr;
+
+    uintptr_t uint_addr = reinterpret_cast <uintptr_t> (ptr_raw) + sizeof(void*);
+    uint_addr = (uint_addr + sizet_alignment - 1) & ~(static_cast <uintptr_t> (sizet_alignment) - 1);
+
+    void** ptr_aligned = reinterpret_cast <void**> (uint_addr);
+    ptr_aligned[-1] = ptr_raw;
+
+    return ptr_aligned;
+}
+
+void aligned_allocator::deallocate(void* ptr_block, size_t)
+{
+    if (ptr_block != nullptr) std::free(static_cast <void**> (ptr_block)[-1]);
+}
+
+// pool_allocator
+
+pool_allocator::pool_allocator(size_t sizet_max_block)
+: alloc_blocks(64)
+{
+    size_t sizet_classes = 1;
+    for (size_t sizet_block = sizet_min_block; sizet_block < sizet_max_block; sizet_block <<= 1) sizet_classes++;
+
+    this->sizet_max_block = sizet_min_block << (sizet_classes - 1);
+    vec_free.resize(sizet_classes);
+}
+
+pool_allocator::~pool_allocator()
+{
+    trim();
+}
+
+size_t pool_allocator::size_class(size_t sizet_bytes) const
+{
+    size_t sizet_class = 0;
+    for (size_t sizet_block = sizet_min_block; sizet_block < sizet_bytes; sizet_block <<= 1) sizet_class++;
+    return sizet_class;
+}
+
+void* pool_allocator::allocate(size_t sizet_bytes)
+{
+    if (sizet_bytes > sizet_max_block) return alloc_blocks.allocate(sizet_bytes);
+
+    size_t sizet_class = size_class(sizet_bytes);
+
+    {
+        std::lock_guard <std::mutex> lock(mutex_pool);
+        std::vector <void*>& vec_list = vec_free[sizet_class];
+        if (!vec_list.empty())
+        {
+            void* ptr_block = vec_list.back();
+            vec_list.pop_back();
+            return ptr_block;
+        }
+    }
+
+    return alloc_blocks.allocate(sizet_min_block << sizet_class);
+}
+
+void* pool_allocator::reallocate(void* ptr_block, size_t sizet_old, size_t sizet_new)
+{
+    // the block already has the capacity of its size class
+    if (sizet_old <= sizet_max_block && sizet_new <= sizet_max_block
+        && size_class(sizet_old) == size_class(sizet_new))
+    {
+        return ptr_block;
+    }
+
+    return allocator::reallocate(ptr_block, sizet_old, sizet_new);
+}
+
+void pool_allocator::deallocate(void* ptr_block, size_t sizet_bytes)
+{
+    if (ptr_block == nullptr) return;
+
+    if (sizet_bytes > sizet_max_block)
+    {
+        alloc_blocks.deallocate(ptr_block, sizet_bytes);
+        return;
+    }
+
+    std::lock_guard <std::mutex> lock(mutex_pool);
+    vec_free[size_class(sizet_bytes)].push_back(ptr_block);
+}
+
+void pool_allocator::trim()
+{
+    std::lock_guard <std::mutex> lock(mutex_pool);
+    for (size_t sizet_class = 0; sizet_class < vec_free.size(); sizet_class++)
+    {
+        for (size_t sizet_i = 0; sizet_i < vec_free[sizet_class].size(); sizet_i++)
+        {
+            alloc_blocks.deallocate(vec_free[sizet_class][sizet_i], sizet_min_block << sizet_class);
+        }
+        vec_free[sizet_class].clear();
+    }
+}
+
+// arena_allocator
+
+static const size_t sizet_arena_alignment = 64;
+
+arena_allocator::arena_allocator(size_t sizet_chunk)
+: sizet_chunk(sizet_chunk)
+, sizet_current(0)
+, sizet_offset(0)
+, sizet_used(0)
+, ptr_last(nullptr)
+, alloc_chunks(sizet_arena_alignment)
+{
+}
+
+arena_allocator::~arena_allocator()
+{
+    for (size_t sizet_i = 0; sizet_i < vec_chunks.size(); sizet_i++)
+    {
+        alloc_chunks.deallocate(vec_chunks[sizet_i].ptr_begin, vec_chunks[sizet_i].sizet_size);
+    }
+}
+
+bool arena_allocator::grow(size_t sizet_bytes)
+{
+    // reuse the chunks that are left from before the last reset
+    while (sizet_current + 1 < vec_chunks.size())
+    {
+        sizet_current++;
+        sizet_offset = 0;
+        if (vec_chunks[sizet_current].sizet_size >= sizet_bytes) return true;
+    }
+
+    chunk chunk_new;
+    chunk_new.sizet_size = sizet_bytes > sizet_chunk ? sizet_bytes : sizet_chunk;
+    chunk_new.ptr_begin  = static_cast <char*> (alloc_chunks.allocate(chunk_new.sizet_size));
+    if (chunk_new.ptr_begin == nullptr) return false;
+
+    vec_chunks.push_back(chunk_new);
+    sizet_current = vec_chunks.size() - 1;
+    sizet_offset  = 0;
+
+    return true;
+}
+
+void* arena_allocator::allocate(size_t sizet_bytes)
+{
+    size_t sizet_size = (sizet_bytes + sizet_arena_alignment - 1) & ~(sizet_arena_alignment - 1);
+
+    if (vec_chunks.empty() || vec_chunks[sizet_current].sizet_size - sizet_offset < sizet_size)
+    {
+        if (!grow(sizet_size)) return nullptr;
+    }
+
+    void* ptr_block = vec_chunks[sizet_current].ptr_begin + sizet_offset;
+    sizet_offset += sizet_size;
+    sizet_used   += sizet_size;
+    ptr_last      = ptr_block;
+
+    return ptr_block;
+}
+
+void* arena_allocator::reallocate(void* ptr_block, size_t sizet_old, size_t sizet_new)
+{
+    // the last block grows or shrinks in place if the chunk has room
+    if (ptr_block == ptr_last && ptr_block != nullptr)
+    {
+        size_t sizet_begin = static_cast <char*> (ptr_block) - vec_chunks[sizet_current].ptr_begin;
+        size_t sizet_size  = (sizet_new + sizet_arena_alignment - 1) & ~(sizet_arena_alignment - 1);
+
+        if (vec_chunks[sizet_current].sizet_size - sizet_begin >= sizet_size)
+        {
+            sizet_used   = sizet_used - (sizet_offset - sizet_begin) + sizet_size;
+            sizet_offset = sizet_begin + sizet_size;
+            return ptr_block;
+        }
+    }
+
+    void* ptr_new = allocate(sizet_new);
+    if (ptr_new == nullptr) return nullptr;
+
+    std::memcpy(ptr_new, ptr_block, sizet_old < sizet_new ? sizet_old : sizet_new);
+
+    return ptr_new;
+}
+
+void arena_allocator::deallocate(void*, size_t)
+{
+    // a block is not reclaimed on its own, a stale block of before the last reset
+    // may have the address of a live block and rewinding would release the latter
+}
+
+void arena_allocator::reset()
+{
+    sizet_current = 0;
+    sizet_offset  = 0;
+    sizet_used    = 0;
+    ptr_last      = nullptr;
+}
+
+size_t arena_allocator::used() const
+{
+    return sizet_used;
+}
+
+// selection
+
+// never destroyed since static buffers may be released after it
+static heap_allocator& default_allocator()
+{
+    static heap_allocator* ptr_heap = new heap_allocator();
+    return *ptr_heap;
+}
+
+static thread_local allocator* ptr_thread_allocator = nullptr;
+
+allocator* get_allocator()
+{
+    return ptr_thread_allocator == nullptr ? &default_allocator() : ptr_thread_allocator;
+}
+
+void set_allocator(allocator* ptr_alloc)
+{
+    ptr_thread_allocator = ptr_alloc;
+}
+
+arena_allocator& thread_arena()
+{
+    static thread_local arena_allocator alloc_arena;
+    return alloc_arena;
+}
+
+}      // NAMESPACE SUSA
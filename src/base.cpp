@@ -63,6 +63,33 @@ double qfunc(const double x)
     return (1.0 - normcdf(x));
 }
 
+// the correction ln(1 + exp(-d)) sampled at the middle of the steps of 1/16 up to 8
+static const size_t sizet_lse_steps = 16;
+static const size_t sizet_lse_size  = 128;
+
+static std::vector <double> log_sum_exp_table()
+{
+    std::vector <double> vec_table(sizet_lse_size);
+    for (size_t sizet_i = 0; sizet_i < sizet_lse_size; sizet_i++)
+    {
+        vec_table[sizet_i] = std::log1p(std::exp(-(sizet_i + 0.5) / sizet_lse_steps));
+    }
+    return vec_table;
+}
+
+double log_sum_exp(double dbl_a, double dbl_b)
+{
+    static const std::vector <double> vec_table = log_sum_exp_table();
+
+    double dbl_max  = dbl_a > dbl_b ? dbl_a : dbl_b;
+    double dbl_diff = dbl_a > dbl_b ? dbl_a - dbl_b : dbl_b - dbl_a;
+
+    // the difference of two -inf (the unreachable states) or of a NaN is NaN, it is not indexed
+    if (!(dbl_diff < static_cast <double> (sizet_lse_size) / sizet_lse_steps)) return dbl_max;
+
+    return dbl_max + vec_table[static_cast <size_t> (dbl_diff * sizet_lse_steps)];
+}
+
 unsigned int pow(unsigned int uint_b, unsigned int uint_p)
 {
     unsigned int uint_ret = 1;
@@ -0,0 +1,174 @@
+/*
+ * This file is part of Susa.
+ *
+ * Susa is free software: you can redistribute it and/or modify
+ * it under the terms of the Lesser GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * at your option) any later version.
+ *
+ * Susa is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * Lesser GNU General Public License for more details.
+ *
+ * You should have received a copy of the Lesser GNU General Public License
+ * along with Susa.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file bitvec.cpp
+ * @brief A packed bit vector (definition).
+ * @author Behrooz Kamary
+ * @version 1.0.0
+ */
+
+#include <susa.h>
+
+namespace susa
+{
+
+bitvec::bitvec()
+: sizet_bits(0)
+{
+}
+
+bitvec::bitvec(size_t sizet_bits)
+: sizet_bits(sizet_bits)
+{
+    if (sizet_bits == 0) return;
+    this->allocate(no_words());
+    reset();
+}
+
+bitvec::bitvec(const matrix <uint8_t>& mat_arg)
+: sizet_bits(mat_arg.size())
+{
+    if (sizet_bits == 0) return;
+    this->allocate(no_words());
+    reset();
+
+    const uint8_t* ptr_in = mat_arg.data();
+    for (size_t sizet_w = 0; sizet_w < no_words(); sizet_w++)
+    {
+        size_t   sizet_first = sizet_w * 64;
+        size_t   sizet_num   = std::min <size_t> (64, sizet_bits - sizet_first);
+        uint64_t uint_word   = 0;
+        for (size_t sizet_i = 0; sizet_i < sizet_num; sizet_i++)
+        {
+            uint_word |= static_cast <uint64_t> (ptr_in[sizet_first + sizet_i] != 0) << sizet_i;
+        }
+        this->_matrix[sizet_w] = uint_word;
+    }
+}
+
+uint64_t bitvec::get_bits(size_t sizet_index, unsigned int uint_num) const
+{
+    if (uint_num == 0) return 0;
+
+    size_t       sizet_word = sizet_index >> 6;
+    unsigned int uint_shift = sizet_index & 63;
+    uint64_t     uint_value = this->_matrix[sizet_word] >> uint_shift;
+
+    if (uint_shift + uint_num > 64 && sizet_word + 1 < no_words())
+    {
+        uint_value |= this->_matrix[sizet_word + 1] << (64 - uint_shift);
+    }
+
+    return uint_num == 64 ? uint_value : uint_value & ((1ull << uint_num) - 1);
+}
+
+void bitvec::set_bits(size_t sizet_index, uint64_t uint_value, unsigned int uint_num)
+{
+    if (uint_num == 0) return;
+
+    uint64_t     uint_mask  = uint_num == 64 ? ~0ull : (1ull << uint_num) - 1;
+    size_t       sizet_word = sizet_index >> 6;
+    unsigned int uint_shift = sizet_index & 63;
+
+    uint_value &= uint_mask;
+    this->_matrix[sizet_word] = (this->_matrix[sizet_word] & ~(uint_mask << uint_shift)) | (uint_value << uint_shift);
+
+    if (uint_shift + uint_num > 64)
+    {
+        unsigned int uint_rest = 64 - uint_shift;
+        this->_matrix[sizet_word + 1] = (this->_matrix[sizet_word + 1] & ~(uint_mask >> uint_rest)) | (uint_value >> uint_rest);
+    }
+}
+
+void bitvec::set()
+{
+    for (size_t sizet_w = 0; sizet_w < no_words(); sizet_w++) this->_matrix[sizet_w] = ~0ull;
+    trim();
+}
+
+void bitvec::reset()
+{
+    for (size_t sizet_w = 0; sizet_w < no_words(); sizet_w++) this->_matrix[sizet_w] = 0;
+}
+
+bool bitvec::any() const
+{
+    uint64_t uint_any = 0;
+    for (size_t sizet_w = 0; sizet_w < no_words(); sizet_w++) uint_any |= this->_matrix[sizet_w];
+    return uint_any != 0;
+}
+
+size_t bitvec::count() const
+{
+    size_t sizet_count = 0;
+    for (size_t sizet_w = 0; sizet_w < no_words(); sizet_w++) sizet_count += popcount64(this->_matrix[sizet_w]);
+    return sizet_count;
+}
+
+matrix <uint8_t> bitvec::unpack() const
+{
+    matrix <uint8_t> mat_ret(sizet_bits, 1);
+    uint8_t* ptr_out = mat_ret.data();
+
+    for (size_t sizet_i = 0; sizet_i < sizet_bits; sizet_i++) ptr_out[sizet_i] = exists(sizet_i);
+
+    return mat_ret;
+}
+
+bitvec& bitvec::operator^=(const bitvec& bv_arg)
+{
+    SUSA_ASSERT_MESSAGE(sizet_bits == bv_arg.sizet_bits, "the bit vectors have different lengths.");
+    size_t sizet_words = std::min(no_words(), bv_arg.no_words());
+
+    for (size_t sizet_w = 0; sizet_w < sizet_words; sizet_w++) this->_matrix[sizet_w] ^= bv_arg._matrix[sizet_w];
+
+    return *this;
+}
+
+bool operator==(const bitvec& bv_argl, const bitvec& bv_argr)
+{
+    if (bv_argl.sizet_bits != bv_argr.sizet_bits) return false;
+
+    for (size_t sizet_w = 0; sizet_w < bv_argl.no_words(); sizet_w++)
+    {
+        if (bv_argl._matrix[sizet_w] != bv_argr._matrix[sizet_w]) return false;
+    }
+
+    return true;
+}
+
+void bitvec::trim()
+{
+    if (sizet_bits & 63) this->_matrix[no_words() - 1] &= (1ull << (sizet_bits & 63)) - 1;
+}
+
+size_t hamming_distance(const bitvec& bv_argl, const bitvec& bv_argr)
+{
+    SUSA_ASSERT_MESSAGE(bv_argl.no_bits() == bv_argr.no_bits(), "the bit vectors have different lengths.");
+
+    size_t sizet_words = std::min(bv_argl.no_words(), bv_argr.no_words());
+    size_t sizet_errors = 0;
+    const uint64_t* ptr_l = bv_argl.data();
+    const uint64_t* ptr_r = bv_argr.data();
+
+    for (size_t sizet_w = 0; sizet_w < sizet_words; sizet_w++) sizet_errors += popcount64(ptr_l[sizet_w] ^ ptr_r[sizet_w]);
+
+    return sizet_errors;
+}
+
+}      // NAMESPACE SUSA
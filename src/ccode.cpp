@@ -31,9 +31,12 @@ namespace susa {
 
 ccode::ccode()
 {
-    uint_k = 1;
-    uint_n = 0;
-    uint_m = 0;
+    uint_k     = 1;
+    uint_n     = 0;
+    uint_m     = 0;
+    uint_mmask = 0;
+    uint_gen   = nullptr;
+    build_trellis();
 }
 
 ccode::~ccode()
@@ -55,6 +58,8 @@ ccode::ccode(uint32_t uint_n, uint32_t uint_k, uint32_t uint_m)
     this->uint_mmask = susa::pow(2, uint_m) - 1;
     this->uint_gen   = new uint32_t[uint_n];
     SUSA_ASSERT_MESSAGE(this->uint_gen != nullptr, "failed to allocate memory for generators.");
+    for (uint32_t uint_i = 0; uint_i < uint_n; uint_i++) this->uint_gen[uint_i] = 0;
+    build_trellis();
 }
 
 
@@ -64,6 +69,50 @@ void ccode::set_generator(uint32_t uint_gen, uint32_t uint_gen_indx)
 {
     SUSA_ASSERT_MESSAGE(uint_gen_indx < uint_n, "id exceeded the number of generators.");
     this->uint_gen[uint_gen_indx] = oct_to_dec(uint_gen);
+    build_trellis();
+}
+
+void ccode::build_trellis()
+{
+    uint32_t uint_states = 1 << uint_m;
+    std::vector <uint32_t> vec_next(2 * uint_states);
+    std::vector <uint32_t> vec_labels(2 * uint_states);
+
+    for (uint32_t uint_s = 0; uint_s < uint_states; uint_s++)
+    {
+        for (uint32_t uint_b = 0; uint_b < 2; uint_b++)
+        {
+            vec_next[2 * uint_s + uint_b]   = uint_m == 0 ? 0 : next_state(uint_s, uint_b == 1);
+            vec_labels[2 * uint_s + uint_b] = uint_n == 0 ? 0 : next_output(uint_s, uint_b == 1);
+        }
+    }
+
+    ptr_trellis = std::make_shared <const trellis> (uint_states, 2, vec_next, vec_labels);
+
+    // eight stages per lookup, the 8n output bits fit a word
+    vec_enc_out.clear();
+    vec_enc_next.clear();
+    if (uint_m > 8 || uint_n > 8 || uint_n == 0) return;
+
+    vec_enc_out.resize(uint_states << 8);
+    vec_enc_next.resize(uint_states << 8);
+
+    for (uint32_t uint_s = 0; uint_s < uint_states; uint_s++)
+    {
+        for (uint32_t uint_byte = 0; uint_byte < 256; uint_byte++)
+        {
+            uint32_t uint_state = uint_s;
+            uint64_t uint_out   = 0;
+            for (uint32_t uint_t = 0; uint_t < 8; uint_t++)
+            {
+                uint32_t uint_b = (uint_byte >> uint_t) & 0x1;
+                uint_out  |= static_cast <uint64_t> (vec_labels[2 * uint_state + uint_b]) << (uint_t * uint_n);
+                uint_state = vec_next[2 * uint_state + uint_b];
+            }
+            vec_enc_out[(uint_s << 8) | uint_byte]  = uint_out;
+            vec_enc_next[(uint_s << 8) | uint_byte] = static_cast <uint16_t> (uint_state);
+        }
+    }
 }
 
 uint32_t ccode::next_state(uint32_t uint_state, bool b_input)
@@ -81,17 +130,6 @@ uint32_t ccode::next_state(bool b_input)
     return uint_current_state;
 }
 
-std::vector <uint32_t> ccode::prev_states(uint32_t uint_state)
-{
-    std::vector <uint32_t> prev_states(2);
-    prev_states[0]  = (uint_state<<1);
-    prev_states[0] &= uint_mmask;
-    prev_states[1]  = (uint_state<<1) + 1;
-    prev_states[1] &= uint_mmask;
-
-    return prev_states;
-}
-
 void ccode::zero_state()
 {
     uint_current_state = 0;
@@ -163,34 +201,62 @@ matrix <uint8_t> ccode::encode(const matrix <uint8_t>& mat_arg)
     return mat_out;
 }
 
-matrix <double> ccode::decode_bcjr(const matrix <double> &mat_arg, double dbl_ebn0, double c_k)
+bitvec ccode::encode(const bitvec& bv_arg) const
 {
+    size_t   sizet_in   = bv_arg.no_bits();
+    size_t   sizet_i    = 0;
+    uint32_t uint_state = 0;
+    bitvec   bv_out(sizet_in * uint_n);
+
+    if (!vec_enc_out.empty())
+    {
+        for (; sizet_i + 8 <= sizet_in; sizet_i += 8)
+        {
+            uint32_t uint_index = (uint_state << 8) | static_cast <uint32_t> (bv_arg.get_bits(sizet_i, 8));
+            bv_out.set_bits(sizet_i * uint_n, vec_enc_out[uint_index], 8 * uint_n);
+            uint_state = vec_enc_next[uint_index];
+        }
+    }
+
+    // the tail (or every stage of a code without tables)
+    for (; sizet_i < sizet_in; sizet_i++)
+    {
+        uint32_t uint_b = bv_arg.exists(sizet_i);
+        bv_out.set_bits(sizet_i * uint_n, ptr_trellis->label(uint_state, uint_b), uint_n);
+        uint_state = ptr_trellis->next_state(uint_state, uint_b);
+    }
+
+    return bv_out;
+}
+
+matrix <double> ccode::decode_bcjr(const matrix <double> &mat_arg, double dbl_ebn0, double c_k) const
+{
+    SUSA_PROFILE_SCOPE("ccode.bcjr");
+
     double a       = 1;
     double l_c     = 4 * a * dbl_ebn0;
     double dbl_sum = 0;
 
-    zero_state();
-
     uint32_t uint_num_stages = mat_arg.size() / uint_n;
     uint32_t uint_num_states = (1 << uint_m);
 
-    // Gamma
-    matrix <double> mat_gamma(uint_num_states, uint_num_states, 0);
+    // Gamma of the valid transitions only, i.e. (state, input)
+    matrix <double> mat_gamma(uint_num_states, 2, 0);
     std::vector <matrix <double> > vec_gamma(uint_num_stages);
 
     // Alpha
     matrix <double> mat_alpha(uint_num_states, 1, 0);
-    std::vector <matrix <double> > vec_alpha(uint_num_stages + 1, matrix <double> (uint_num_states,1));
+    std::vector <matrix <double> > vec_alpha(uint_num_stages + 1, matrix <double> (uint_num_states, 1, 0));
     vec_alpha[0](0,0) = 1;
 
     // Beta
     matrix <double> mat_beta(uint_num_states, 1, 0);
-    std::vector <matrix <double> > vec_beta(uint_num_stages + 1, matrix <double> (uint_num_states,1));
+    std::vector <matrix <double> > vec_beta(uint_num_stages + 1, matrix <double> (uint_num_states, 1, 0));
     vec_beta[uint_num_stages](0,0) = 1;
 
 
     // Forward calculation of Gamma/Alpha
-    std::vector <uint32_t> vec_uint_prev_states;
+    const trellis& trel = *ptr_trellis;
 
     uint32_t uint_next_zero, uint_next_one;
     double dbl_arg = 0;
@@ -200,44 +266,40 @@ matrix <double> ccode::decode_bcjr(const matrix <double> &mat_arg, double dbl_eb
         // Gamma Calculation
         for (uint32_t uint_state = 0; uint_state < uint_num_states; uint_state++)
         {
-
-            uint_next_zero  =  this->next_state(uint_state, false);
-            uint_next_one   =  this->next_state(uint_state, true);
-
             dbl_arg = 0;
             for (uint32_t uint_i = 0; uint_i < uint_n; uint_i++)
             {
-                dbl_arg += mat_arg(uint_n * uint_stage + uint_i) * (((this->next_output(uint_state,false) >> uint_i) & 0x1) == 0 ? -1 : 1);
+                dbl_arg += mat_arg(uint_n * uint_stage + uint_i) * (((trel.label(uint_state, 0) >> uint_i) & 0x1) == 0 ? -1 : 1);
             }
 
-            mat_gamma(uint_state, uint_next_zero) = c_k * exp(0.5 * l_c * dbl_arg);
+            mat_gamma(uint_state, 0) = c_k * exp(0.5 * l_c * dbl_arg);
 
             dbl_arg = 0;
             for (uint32_t uint_i = 0; uint_i < uint_n; uint_i++)
             {
-                dbl_arg += mat_arg(uint_n * uint_stage + uint_i) * (((this->next_output(uint_state,true) >> uint_i) & 0x1) == 0 ? -1 : 1);
+                dbl_arg += mat_arg(uint_n * uint_stage + uint_i) * (((trel.label(uint_state, 1) >> uint_i) & 0x1) == 0 ? -1 : 1);
             }
 
-            mat_gamma(uint_state, uint_next_one) = c_k * exp(0.5 * l_c * dbl_arg);
+            mat_gamma(uint_state, 1) = c_k * exp(0.5 * l_c * dbl_arg);
         }
 
         vec_gamma[uint_stage] = mat_gamma;
 
 
         // Alpha Calculation
-        for (uint32_t uint_state = 0; uint_state < uint_num_states; uint_state++)
+        for (uint32_t uinti = 0; uinti < trel.no_inputs(); uinti++)
         {
-            vec_uint_prev_states = this->prev_states(uint_state);
-
-            for (uint32_t uinti = 0; uinti < vec_uint_prev_states.size(); uinti++)
-                mat_alpha(uint_state) += vec_alpha[uint_stage](vec_uint_prev_states[uinti]) * mat_gamma(vec_uint_prev_states[uinti], uint_state);
+            const uint32_t* ptr_prev   = trel.prev_states(uinti);
+            const uint32_t* ptr_inputs = trel.prev_inputs(uinti);
 
+            for (uint32_t uint_state = 0; uint_state < uint_num_states; uint_state++)
+                mat_alpha(uint_state) += vec_alpha[uint_stage](ptr_prev[uint_state]) * mat_gamma(ptr_prev[uint_state], ptr_inputs[uint_state]);
         }
 
         // Normalize the alpha
         dbl_sum = 0;
         for (uint32_t uinti = 0; uinti < mat_alpha.size(); uinti++) dbl_sum += mat_alpha(uinti);
-        mat_alpha = mat_alpha / dbl_sum;
+        mat_alpha /= dbl_sum;
 
         vec_alpha[uint_stage + 1] = mat_alpha;
         mat_alpha.set_all(0);
@@ -247,21 +309,21 @@ matrix <double> ccode::decode_bcjr(const matrix <double> &mat_arg, double dbl_eb
     // Beta Calculation
     for (uint32_t uint_stage = uint_num_stages; uint_stage > 0; uint_stage--)
     {
+        const matrix <double>& mat_gamma_stage = vec_gamma[uint_stage - 1];
+
         for (uint32_t uint_state = 0; uint_state < uint_num_states; uint_state++)
         {
-            mat_gamma = vec_gamma[uint_stage - 1];
+            uint_next_zero =  trel.next_state(uint_state, 0);
+            uint_next_one =  trel.next_state(uint_state, 1);
 
-            uint_next_zero =  this->next_state(uint_state, false);
-            uint_next_one =  this->next_state(uint_state, true);
-
-            mat_beta(uint_state) += vec_beta[uint_stage](uint_next_zero) * mat_gamma(uint_state, uint_next_zero);
-            mat_beta(uint_state) += vec_beta[uint_stage](uint_next_one) * mat_gamma(uint_state, uint_next_one);
+            mat_beta(uint_state) += vec_beta[uint_stage](uint_next_zero) * mat_gamma_stage(uint_state, 0);
+            mat_beta(uint_state) += vec_beta[uint_stage](uint_next_one) * mat_gamma_stage(uint_state, 1);
         }
 
         // Normalize the beta
         dbl_sum = 0;
         for (uint32_t uinti = 0; uinti < mat_beta.size(); uinti++) dbl_sum += mat_beta(uinti);
-        mat_beta = mat_beta / dbl_sum;
+        mat_beta /= dbl_sum;
 
         vec_beta[uint_stage - 1] = mat_beta;
 
@@ -277,19 +339,19 @@ matrix <double> ccode::decode_bcjr(const matrix <double> &mat_arg, double dbl_eb
     for (uint32_t uint_stage = 0; uint_stage < uint_num_stages; uint_stage++)
     {
 
-        mat_alpha   = vec_alpha[uint_stage];
-        mat_beta    = vec_beta[uint_stage + 1];
-        mat_gamma   = vec_gamma[uint_stage]; // Note ! code : Gamma_1 = Gamma(0)
+        const matrix <double>& mat_alpha_stage = vec_alpha[uint_stage];
+        const matrix <double>& mat_beta_stage  = vec_beta[uint_stage + 1];
+        const matrix <double>& mat_gamma_stage = vec_gamma[uint_stage]; // Note ! code : Gamma_1 = Gamma(0)
 
 
         for (uint32_t uint_state = 0; uint_state < uint_num_states; uint_state++)
         {
 
-            uint_next_zero =  this->next_state(uint_state,false);
-            uint_next_one =  this->next_state(uint_state,true);
+            uint_next_zero =  trel.next_state(uint_state, 0);
+            uint_next_one =  trel.next_state(uint_state, 1);
 
-            mat_p_zero(uint_stage) += mat_alpha(uint_state) * mat_gamma(uint_state,uint_next_zero) * mat_beta(uint_next_zero);
-            mat_p_one(uint_stage) += mat_alpha(uint_state) * mat_gamma(uint_state,uint_next_one) * mat_beta(uint_next_one);
+            mat_p_zero(uint_stage) += mat_alpha_stage(uint_state) * mat_gamma_stage(uint_state, 0) * mat_beta_stage(uint_next_zero);
+            mat_p_one(uint_stage) += mat_alpha_stage(uint_state) * mat_gamma_stage(uint_state, 1) * mat_beta_stage(uint_next_one);
         }
 
         mat_p_norm(uint_stage) = mat_p_one(uint_stage) + mat_p_zero(uint_stage);
@@ -305,6 +367,540 @@ matrix <double> ccode::decode_bcjr(const matrix <double> &mat_arg, double dbl_eb
 }
 
 
+// max* of the log-domain recursions, the exact one only for double
+template <bool EXACT, typename M> struct bcjr_op
+{
+    static M max(M t_a, M t_b) { return t_a > t_b ? t_a : t_b; }
+};
+
+template <> struct bcjr_op <true, double>
+{
+    static double max(double dbl_a, double dbl_b) { return log_sum_exp(dbl_a, dbl_b); }
+};
+
+// the branch metrics of the 2^n output labels of a stage
+static void bcjr_branch(const double* ptr_in, uint32_t uint_n, double dbl_scale, double* ptr_bm)
+{
+    for (uint32_t uint_c = 0; uint_c < (1u << uint_n); uint_c++)
+    {
+        double dbl_arg = 0;
+        for (uint32_t uint_i = 0; uint_i < uint_n; uint_i++) dbl_arg += ((uint_c >> uint_i) & 0x1) ? ptr_in[uint_i] : -ptr_in[uint_i];
+        ptr_bm[uint_c] = dbl_scale * dbl_arg;
+    }
+}
+
+// the branch metrics of the quantized values (the scale is a part of the quantizer)
+template <typename M> static void bcjr_branch(const M* ptr_in, uint32_t uint_n, double, M* ptr_bm)
+{
+    typedef typename std::conditional <metric_traits <M>::is_fixed, int32_t, M>::type accumulator;
+
+    for (uint32_t uint_c = 0; uint_c < (1u << uint_n); uint_c++)
+    {
+        accumulator t_arg = 0;
+        for (uint32_t uint_i = 0; uint_i < uint_n; uint_i++) t_arg += ((uint_c >> uint_i) & 0x1) ? ptr_in[uint_i] : -ptr_in[uint_i];
+        ptr_bm[uint_c] = metric_traits <M>::saturate(t_arg);
+    }
+}
+
+// the a priori metrics of a stage, either the constant ones or -L/2 and +L/2 of the a priori LLR
+template <typename M> static inline const M* bcjr_apriori(const M* ptr_apriori, const M* ptr_la, size_t sizet_stage, M* ptr_stage)
+{
+    if (ptr_la == nullptr) return ptr_apriori;
+
+    ptr_stage[1] = static_cast <M> (ptr_la[sizet_stage] / 2);
+    ptr_stage[0] = static_cast <M> (-ptr_stage[1]);
+    return ptr_stage;
+}
+
+// the floating-point metrics are normalized by the zero state and the fixed-point ones by
+// the maximum, i.e. only the unlikely states saturate
+template <typename M> static inline M bcjr_norm(const M* ptr_metric, uint32_t uint_states)
+{
+    return metric_traits <M>::is_fixed ? *std::max_element(ptr_metric, ptr_metric + uint_states) : ptr_metric[0];
+}
+
+// The sliding-window log-domain BCJR. The forward recursion runs continuously and the
+// backward recursion of each window starts <i>sizet_warmup</i> stages later from equal
+// metrics (or from the zero state at the end of the frame). Only the forward metrics and the
+// branch metrics of a window are stored. The a priori LLRs of the stages <i>ptr_la</i>, if any,
+// replace the constant a priori metrics.
+// The scratch vectors are resized only when they are too short, hence a worker decoding
+// many frames allocates once.
+template <bool EXACT, typename I, typename M> static void bcjr_log(const I* ptr_in, uint32_t uint_n, double dbl_scale,
+  const M* ptr_apriori, const M* ptr_la, size_t sizet_stages, const trellis& trel, size_t sizet_window, size_t sizet_warmup, M* ptr_llr,
+  std::vector <M>& vec_alpha, std::vector <M>& vec_bm, std::vector <M>& vec_bm_stage,
+  std::vector <M>& vec_beta, std::vector <M>& vec_beta_prev)
+{
+    typedef metric_traits <M> ops;
+
+    const M        t_floor     = ops::lowest();
+    const uint32_t uint_codes  = 1 << uint_n;
+    const uint32_t uint_states = trel.no_states();
+    const uint32_t* vec_next[2] = {trel.next_states(0), trel.next_states(1)};
+    const uint32_t* vec_out[2]  = {trel.labels(0), trel.labels(1)};
+
+    vec_alpha.assign((sizet_window + 1) * uint_states, t_floor);
+    vec_bm.resize(sizet_window * uint_codes);
+    vec_bm_stage.resize(uint_codes);
+    vec_beta.resize(uint_states);
+    vec_beta_prev.resize(uint_states);
+    vec_alpha[0] = 0;
+
+    M t_stage[2];
+
+    for (size_t sizet_begin = 0; sizet_begin < sizet_stages; sizet_begin += sizet_window)
+    {
+        size_t sizet_end = std::min(sizet_begin + sizet_window, sizet_stages);
+        size_t sizet_len = sizet_end - sizet_begin;
+
+        // forward
+        for (size_t sizet_j = 0; sizet_j < sizet_len; sizet_j++)
+        {
+            const M* ptr_alpha = vec_alpha.data() + sizet_j * uint_states;
+            M*       ptr_next  = vec_alpha.data() + (sizet_j + 1) * uint_states;
+            M*       ptr_gamma = vec_bm.data() + sizet_j * uint_codes;
+            const M* ptr_prior = bcjr_apriori(ptr_apriori, ptr_la, sizet_begin + sizet_j, t_stage);
+
+            bcjr_branch(ptr_in + (sizet_begin + sizet_j) * uint_n, uint_n, dbl_scale, ptr_gamma);
+            std::fill(ptr_next, ptr_next + uint_states, t_floor);
+
+            for (uint32_t uint_s = 0; uint_s < uint_states; uint_s++)
+            {
+                for (uint32_t uint_b = 0; uint_b < 2; uint_b++)
+                {
+                    M& t_to = ptr_next[vec_next[uint_b][uint_s]];
+                    t_to = bcjr_op <EXACT, M>::max(t_to, ops::add(ops::add(ptr_alpha[uint_s], ptr_prior[uint_b]), ptr_gamma[vec_out[uint_b][uint_s]]));
+                }
+            }
+
+            M t_norm = bcjr_norm(ptr_next, uint_states);
+            for (uint32_t uint_s = 0; uint_s < uint_states; uint_s++) ptr_next[uint_s] = ops::sub(ptr_next[uint_s], t_norm);
+        }
+
+        // backward, the warm-up stages first
+        size_t sizet_last = std::min(sizet_end + sizet_warmup, sizet_stages);
+        if (sizet_last == sizet_stages)
+        {
+            std::fill(vec_beta.begin(), vec_beta.end(), t_floor);
+            vec_beta[0] = 0;
+        }
+        else
+        {
+            std::fill(vec_beta.begin(), vec_beta.end(), M(0));
+        }
+
+        for (size_t sizet_stage = sizet_last; sizet_stage > sizet_begin; sizet_stage--)
+        {
+            bool bool_warmup = sizet_stage > sizet_end;
+            const M* ptr_gamma = vec_bm_stage.data();
+
+            if (bool_warmup)
+            {
+                bcjr_branch(ptr_in + (sizet_stage - 1) * uint_n, uint_n, dbl_scale, vec_bm_stage.data());
+            }
+            else
+            {
+                ptr_gamma = vec_bm.data() + (sizet_stage - 1 - sizet_begin) * uint_codes;
+            }
+
+            // the alphas of the warm-up stages are not kept
+            const M* ptr_alpha = bool_warmup ? nullptr : vec_alpha.data() + (sizet_stage - 1 - sizet_begin) * uint_states;
+            const M* ptr_prior = bcjr_apriori(ptr_apriori, ptr_la, sizet_stage - 1, t_stage);
+            M t_p[2] = {t_floor, t_floor};
+
+            for (uint32_t uint_s = 0; uint_s < uint_states; uint_s++)
+            {
+                M t_beta = t_floor;
+                for (uint32_t uint_b = 0; uint_b < 2; uint_b++)
+                {
+                    M t_branch = ops::add(ops::add(ptr_prior[uint_b], ptr_gamma[vec_out[uint_b][uint_s]]), vec_beta[vec_next[uint_b][uint_s]]);
+                    if (!bool_warmup) t_p[uint_b] = bcjr_op <EXACT, M>::max(t_p[uint_b], ops::add(ptr_alpha[uint_s], t_branch));
+                    t_beta = bcjr_op <EXACT, M>::max(t_beta, t_branch);
+                }
+                vec_beta_prev[uint_s] = t_beta;
+            }
+
+            if (!bool_warmup) ptr_llr[sizet_stage - 1] = ops::sub(t_p[1], t_p[0]);
+
+            M t_norm = bcjr_norm(vec_beta_prev.data(), uint_states);
+            for (uint32_t uint_s = 0; uint_s < uint_states; uint_s++) vec_beta[uint_s] = ops::sub(vec_beta_prev[uint_s], t_norm);
+        }
+
+        // the forward recursion continues from the end of the window
+        std::copy(vec_alpha.begin() + sizet_len * uint_states, vec_alpha.begin() + (sizet_len + 1) * uint_states, vec_alpha.begin());
+    }
+}
+
+matrix <double> ccode::decode_bcjr_log(const matrix <double> &mat_arg, double dbl_ebn0, bcjr_metric metric, double c_k) const
+{
+    return decode_bcjr_window(mat_arg, dbl_ebn0, mat_arg.size() / (uint_n == 0 ? 1 : uint_n), 0, metric, c_k);
+}
+
+matrix <double> ccode::decode_bcjr_window(const matrix <double> &mat_arg, double dbl_ebn0, size_t sizet_window, size_t sizet_warmup,
+  bcjr_metric metric, double c_k) const
+{
+    matrix <double> mat_llr;
+
+    SUSA_ASSERT_MESSAGE(uint_n > 0 && uint_n <= 8, "the number of outputs is not supported by the BCJR decoder.");
+    if (uint_n == 0 || uint_n > 8) return mat_llr;
+
+    size_t sizet_stages = mat_arg.size() / uint_n;
+    if (sizet_stages == 0) return mat_llr;
+
+    workspace ws;
+    mat_llr = matrix <double> (sizet_stages, 1);
+    bcjr(mat_arg.data(), sizet_stages, dbl_ebn0, sizet_window, sizet_warmup, metric, c_k, ws, mat_llr.data());
+
+    return mat_llr;
+}
+
+template <typename M> matrix <M> ccode::decode_bcjr_max_log(const matrix <double> &mat_arg, const llr_quantizer& quant,
+  size_t sizet_window, size_t sizet_warmup) const
+{
+    matrix <M> mat_llr;
+
+    SUSA_ASSERT_MESSAGE(uint_n > 0 && uint_n <= 8, "the number of outputs is not supported by the BCJR decoder.");
+    if (uint_n == 0 || uint_n > 8) return mat_llr;
+
+    size_t sizet_stages = mat_arg.size() / uint_n;
+    if (sizet_stages == 0) return mat_llr;
+
+    SUSA_PROFILE_SCOPE("ccode.bcjr_max_log");
+
+    if (sizet_window == 0 || sizet_window > sizet_stages) sizet_window = sizet_stages;
+
+    std::vector <M> vec_in(sizet_stages * uint_n);
+    for (size_t sizet_i = 0; sizet_i < vec_in.size(); sizet_i++) vec_in[sizet_i] = quant.quantize <M> (mat_arg(sizet_i));
+
+    const M t_apriori[2] = {0, 0};
+    std::vector <M> vec_alpha, vec_bm, vec_bm_stage, vec_beta, vec_beta_prev;
+
+    mat_llr = matrix <M> (sizet_stages, 1);
+    bcjr_log <false> (vec_in.data(), uint_n, 1.0, t_apriori, static_cast <const M*> (nullptr), sizet_stages, *ptr_trellis, sizet_window, sizet_warmup, mat_llr.data(),
+                      vec_alpha, vec_bm, vec_bm_stage, vec_beta, vec_beta_prev);
+
+    return mat_llr;
+}
+
+template matrix <float>   ccode::decode_bcjr_max_log <float>   (const matrix <double>&, const llr_quantizer&, size_t, size_t) const;
+template matrix <int16_t> ccode::decode_bcjr_max_log <int16_t> (const matrix <double>&, const llr_quantizer&, size_t, size_t) const;
+template matrix <int8_t>  ccode::decode_bcjr_max_log <int8_t>  (const matrix <double>&, const llr_quantizer&, size_t, size_t) const;
+
+matrix <double> ccode::decode_bcjr_batch(const matrix <double> &mat_frames, double dbl_ebn0, size_t sizet_window, size_t sizet_warmup,
+  bcjr_metric metric, double c_k) const
+{
+    matrix <double> mat_llr;
+
+    SUSA_ASSERT_MESSAGE(uint_n > 0 && uint_n <= 8, "the number of outputs is not supported by the BCJR decoder.");
+    if (uint_n == 0 || uint_n > 8) return mat_llr;
+
+    size_t sizet_frames = mat_frames.no_cols();
+    size_t sizet_stages = mat_frames.no_rows() / uint_n;
+    if (sizet_stages == 0 || sizet_frames == 0) return mat_llr;
+
+    mat_llr = matrix <double> (sizet_stages, sizet_frames);
+
+    parallel_for(0, sizet_frames, 1, [&](size_t sizet_first, size_t sizet_last)
+    {
+        workspace ws;
+        for (size_t sizet_f = sizet_first; sizet_f < sizet_last; sizet_f++)
+        {
+            bcjr(mat_frames.data() + sizet_f * mat_frames.no_rows(), sizet_stages, dbl_ebn0, sizet_window, sizet_warmup,
+                 metric, c_k, ws, mat_llr.data() + sizet_f * sizet_stages);
+        }
+    });
+
+    return mat_llr;
+}
+
+std::vector <matrix <double> > ccode::decode_bcjr_batch(const std::vector <matrix <double> > &vec_frames, double dbl_ebn0,
+  size_t sizet_window, size_t sizet_warmup, bcjr_metric metric, double c_k) const
+{
+    std::vector <matrix <double> > vec_llr(vec_frames.size());
+
+    SUSA_ASSERT_MESSAGE(uint_n > 0 && uint_n <= 8, "the number of outputs is not supported by the BCJR decoder.");
+    if (uint_n == 0 || uint_n > 8) return vec_llr;
+
+    for (size_t sizet_f = 0; sizet_f < vec_frames.size(); sizet_f++)
+    {
+        size_t sizet_stages = vec_frames[sizet_f].size() / uint_n;
+        if (sizet_stages > 0) vec_llr[sizet_f] = matrix <double> (sizet_stages, 1);
+    }
+
+    parallel_for(0, vec_frames.size(), 1, [&](size_t sizet_first, size_t sizet_last)
+    {
+        workspace ws;
+        for (size_t sizet_f = sizet_first; sizet_f < sizet_last; sizet_f++)
+        {
+            if (vec_llr[sizet_f].size() == 0) continue;
+            bcjr(vec_frames[sizet_f].data(), vec_llr[sizet_f].size(), dbl_ebn0, sizet_window, sizet_warmup,
+                 metric, c_k, ws, vec_llr[sizet_f].data());
+        }
+    });
+
+    return vec_llr;
+}
+
+matrix <uint8_t> ccode::decode_viterbi(const matrix <uint8_t>& mat_arg, bool bool_terminated) const
+{
+    matrix <double> mat_soft(mat_arg.no_rows(), mat_arg.no_cols());
+    for (size_t sizet_i = 0; sizet_i < mat_arg.size(); sizet_i++) mat_soft(sizet_i) = mat_arg(sizet_i) == 0 ? -1 : 1;
+
+    return decode_viterbi(mat_soft, bool_terminated);
+}
+
+matrix <uint8_t> ccode::decode_viterbi(const matrix <double>& mat_arg, bool bool_terminated) const
+{
+    matrix <uint8_t> mat_ret;
+
+    SUSA_ASSERT_MESSAGE(uint_m > 0 && uint_m < 24, "the number of memories is not supported by the Viterbi decoder.");
+    SUSA_ASSERT_MESSAGE(uint_n > 0 && uint_n <= 8, "the number of outputs is not supported by the Viterbi decoder.");
+    if (uint_m == 0 || uint_m >= 24 || uint_n == 0 || uint_n > 8) return mat_ret;
+
+    size_t sizet_stages = mat_arg.size() / uint_n;
+    if (sizet_stages == 0) return mat_ret;
+
+    workspace ws;
+    mat_ret = matrix <uint8_t> (sizet_stages, 1);
+    viterbi(mat_arg.data(), sizet_stages, bool_terminated, ws, mat_ret.data());
+
+    return mat_ret;
+}
+
+matrix <uint8_t> ccode::decode_viterbi_batch(const matrix <double>& mat_frames, bool bool_terminated) const
+{
+    matrix <uint8_t> mat_ret;
+
+    SUSA_ASSERT_MESSAGE(uint_m > 0 && uint_m < 24, "the number of memories is not supported by the Viterbi decoder.");
+    SUSA_ASSERT_MESSAGE(uint_n > 0 && uint_n <= 8, "the number of outputs is not supported by the Viterbi decoder.");
+    if (uint_m == 0 || uint_m >= 24 || uint_n == 0 || uint_n > 8) return mat_ret;
+
+    size_t sizet_frames = mat_frames.no_cols();
+    size_t sizet_stages = mat_frames.no_rows() / uint_n;
+    if (sizet_stages == 0 || sizet_frames == 0) return mat_ret;
+
+    mat_ret = matrix <uint8_t> (sizet_stages, sizet_frames);
+
+    parallel_for(0, sizet_frames, 1, [&](size_t sizet_first, size_t sizet_last)
+    {
+        workspace ws;
+        for (size_t sizet_f = sizet_first; sizet_f < sizet_last; sizet_f++)
+        {
+            viterbi(mat_frames.data() + sizet_f * mat_frames.no_rows(), sizet_stages, bool_terminated, ws,
+                    mat_ret.data() + sizet_f * sizet_stages);
+        }
+    });
+
+    return mat_ret;
+}
+
+std::vector <matrix <uint8_t> > ccode::decode_viterbi_batch(const std::vector <matrix <double> >& vec_frames, bool bool_terminated) const
+{
+    std::vector <matrix <uint8_t> > vec_ret(vec_frames.size());
+
+    SUSA_ASSERT_MESSAGE(uint_m > 0 && uint_m < 24, "the number of memories is not supported by the Viterbi decoder.");
+    SUSA_ASSERT_MESSAGE(uint_n > 0 && uint_n <= 8, "the number of outputs is not supported by the Viterbi decoder.");
+    if (uint_m == 0 || uint_m >= 24 || uint_n == 0 || uint_n > 8) return vec_ret;
+
+    for (size_t sizet_f = 0; sizet_f < vec_frames.size(); sizet_f++)
+    {
+        size_t sizet_stages = vec_frames[sizet_f].size() / uint_n;
+        if (sizet_stages > 0) vec_ret[sizet_f] = matrix <uint8_t> (sizet_stages, 1);
+    }
+
+    parallel_for(0, vec_frames.size(), 1, [&](size_t sizet_first, size_t sizet_last)
+    {
+        workspace ws;
+        for (size_t sizet_f = sizet_first; sizet_f < sizet_last; sizet_f++)
+        {
+            if (vec_ret[sizet_f].size() == 0) continue;
+            viterbi(vec_frames[sizet_f].data(), vec_ret[sizet_f].size(), bool_terminated, ws, vec_ret[sizet_f].data());
+        }
+    });
+
+    return vec_ret;
+}
+
+void ccode::bcjr(const double* ptr_in, size_t sizet_stages, double dbl_ebn0, size_t sizet_window, size_t sizet_warmup,
+  bcjr_metric metric, double c_k, workspace& ws, double* ptr_llr, const double* ptr_la) const
+{
+    SUSA_PROFILE_SCOPE("ccode.bcjr_log");
+
+    if (sizet_window == 0 || sizet_window > sizet_stages) sizet_window = sizet_stages;
+
+    double l_c = 4 * dbl_ebn0;
+
+    const double dbl_apriori[2] = {std::log(1 - c_k), std::log(c_k)};
+
+    if (metric == LOG_MAP)
+    {
+        bcjr_log <true> (ptr_in, uint_n, 0.5 * l_c, dbl_apriori, ptr_la, sizet_stages, *ptr_trellis, sizet_window, sizet_warmup, ptr_llr,
+                         ws.vec_alpha, ws.vec_bm, ws.vec_bm_stage, ws.vec_beta, ws.vec_beta_prev);
+    }
+    else
+    {
+        bcjr_log <false> (ptr_in, uint_n, 0.5 * l_c, dbl_apriori, ptr_la, sizet_stages, *ptr_trellis, sizet_window, sizet_warmup, ptr_llr,
+                          ws.vec_alpha, ws.vec_bm, ws.vec_bm_stage, ws.vec_beta, ws.vec_beta_prev);
+    }
+}
+
+// the correlation of the received values with all the possible outputs
+static inline void viterbi_branch(const double* ptr_in, uint32_t uint_n, float* ptr_bm)
+{
+    for (uint32_t uint_c = 0; uint_c < (1u << uint_n); uint_c++)
+    {
+        float flt_bm = 0;
+        for (uint32_t uint_i = 0; uint_i < uint_n; uint_i++)
+        {
+            flt_bm += ((uint_c >> uint_i) & 0x1) ? static_cast <float> (ptr_in[uint_i]) : -static_cast <float> (ptr_in[uint_i]);
+        }
+        ptr_bm[uint_c] = flt_bm;
+    }
+}
+
+// the correlation of the quantized values
+template <typename M> static inline void viterbi_branch(const M* ptr_in, uint32_t uint_n, M* ptr_bm)
+{
+    bcjr_branch(ptr_in, uint_n, 1.0, ptr_bm);
+}
+
+// the add-compare-select kernels of the metric types
+static inline void viterbi_acs(const cpu_kernels& kernels, const float* ptr_metric, const float* ptr_bm, uint32_t uint_half,
+  float* ptr_next, uint8_t* ptr_mask, uint64_t* ptr_dec)
+{
+    kernels.viterbi_acs_f32(ptr_metric, ptr_bm, uint_half, ptr_next, ptr_mask, ptr_dec);
+}
+
+static inline void viterbi_acs(const cpu_kernels& kernels, const int16_t* ptr_metric, const int16_t* ptr_bm, uint32_t uint_half,
+  int16_t* ptr_next, uint8_t* ptr_mask, uint64_t* ptr_dec)
+{
+    kernels.viterbi_acs_i16(ptr_metric, ptr_bm, uint_half, ptr_next, ptr_mask, ptr_dec);
+}
+
+static inline void viterbi_acs(const cpu_kernels& kernels, const int8_t* ptr_metric, const int8_t* ptr_bm, uint32_t uint_half,
+  int8_t* ptr_next, uint8_t* ptr_mask, uint64_t* ptr_dec)
+{
+    kernels.viterbi_acs_i8(ptr_metric, ptr_bm, uint_half, ptr_next, ptr_mask, ptr_dec);
+}
+
+template <typename M> matrix <uint8_t> ccode::decode_viterbi(const matrix <double>& mat_arg, const llr_quantizer& quant,
+  bool bool_terminated) const
+{
+    matrix <uint8_t> mat_ret;
+
+    SUSA_ASSERT_MESSAGE(uint_m > 0 && uint_m < 24, "the number of memories is not supported by the Viterbi decoder.");
+    SUSA_ASSERT_MESSAGE(uint_n > 0 && uint_n <= 8, "the number of outputs is not supported by the Viterbi decoder.");
+    if (uint_m == 0 || uint_m >= 24 || uint_n == 0 || uint_n > 8) return mat_ret;
+
+    size_t sizet_stages = mat_arg.size() / uint_n;
+    if (sizet_stages == 0) return mat_ret;
+
+    std::vector <M> vec_in(sizet_stages * uint_n);
+    for (size_t sizet_i = 0; sizet_i < vec_in.size(); sizet_i++) vec_in[sizet_i] = quant.quantize <M> (mat_arg(sizet_i));
+
+    // the largest metric grows by at most n times the quantizer range per stage
+    size_t sizet_period = 64;
+    if (metric_traits <M>::is_fixed)
+    {
+        double dbl_growth = std::max(1.0, static_cast <double> (uint_n) * quant.range <M> ());
+        sizet_period = std::min(sizet_period, std::max <size_t> (1, metric_traits <M>::highest() / dbl_growth));
+    }
+
+    workspace ws;
+    std::vector <M> vec_metric, vec_next, vec_branch;
+    mat_ret = matrix <uint8_t> (sizet_stages, 1);
+    viterbi(vec_in.data(), sizet_stages, bool_terminated, sizet_period, ws, vec_metric, vec_next, vec_branch, mat_ret.data());
+
+    return mat_ret;
+}
+
+template matrix <uint8_t> ccode::decode_viterbi <float>   (const matrix <double>&, const llr_quantizer&, bool) const;
+template matrix <uint8_t> ccode::decode_viterbi <int16_t> (const matrix <double>&, const llr_quantizer&, bool) const;
+template matrix <uint8_t> ccode::decode_viterbi <int8_t>  (const matrix <double>&, const llr_quantizer&, bool) const;
+
+void ccode::viterbi(const double* ptr_input, size_t sizet_stages, bool bool_terminated, workspace& ws, uint8_t* ptr_out) const
+{
+    viterbi(ptr_input, sizet_stages, bool_terminated, 64, ws, ws.vec_metric, ws.vec_next, ws.vec_branch, ptr_out);
+}
+
+template <typename I, typename M> void ccode::viterbi(const I* ptr_input, size_t sizet_stages, bool bool_terminated,
+  size_t sizet_period, workspace& ws, std::vector <M>& vec_metric, std::vector <M>& vec_next,
+  std::vector <M>& vec_branch, uint8_t* ptr_out) const
+{
+    SUSA_PROFILE_SCOPE("ccode.viterbi");
+
+    const uint32_t uint_states = 1 << uint_m;
+    const uint32_t uint_half   = uint_states >> 1;
+    const uint32_t uint_codes  = 1 << uint_n;
+    const size_t   sizet_words = (uint_states + 63) / 64;
+
+    // the butterfly: the states 2j and 2j+1 go to j (input zero) and j + S/2 (input one)
+    if (ws.vec_out00.size() != uint_half)
+    {
+        const trellis& trel = *ptr_trellis;
+        ws.vec_out00.resize(uint_half);
+        ws.vec_out10.resize(uint_half);
+        ws.vec_out01.resize(uint_half);
+        ws.vec_out11.resize(uint_half);
+        for (uint32_t uint_j = 0; uint_j < uint_half; uint_j++)
+        {
+            ws.vec_out00[uint_j] = trel.label(2 * uint_j, 0);
+            ws.vec_out10[uint_j] = trel.label(2 * uint_j + 1, 0);
+            ws.vec_out01[uint_j] = trel.label(2 * uint_j, 1);
+            ws.vec_out11[uint_j] = trel.label(2 * uint_j + 1, 1);
+        }
+    }
+
+    std::vector <uint64_t>& vec_decisions = ws.vec_decisions;
+    const uint8_t* ptr_out00 = ws.vec_out00.data();
+    const uint8_t* ptr_out10 = ws.vec_out10.data();
+    const uint8_t* ptr_out01 = ws.vec_out01.data();
+    const uint8_t* ptr_out11 = ws.vec_out11.data();
+    const cpu_kernels& kernels = cpu_dispatch();
+
+    vec_metric.assign(uint_states, metric_traits <M>::lowest());
+    vec_next.resize(uint_states);
+    vec_branch.resize(uint_codes + 4 * uint_half);
+    ws.vec_mask.resize(uint_states);
+    vec_decisions.resize(sizet_stages * sizet_words);
+    vec_metric[0] = 0;
+
+    M* ptr_bm = vec_branch.data() + uint_codes;
+    for (size_t sizet_stage = 0; sizet_stage < sizet_stages; sizet_stage++)
+    {
+        viterbi_branch(ptr_input + sizet_stage * uint_n, uint_n, vec_branch.data());
+        viterbi_permute(vec_branch.data(), ptr_out00, ptr_out10, ptr_out01, ptr_out11, uint_half, ptr_bm);
+
+        // add-compare-select without a branch over contiguous metrics
+        viterbi_acs(kernels, vec_metric.data(), ptr_bm, uint_half, vec_next.data(), ws.vec_mask.data(),
+                    vec_decisions.data() + sizet_stage * sizet_words);
+
+        // renormalization keeps the metrics in range for long blocks
+        if (sizet_stage % sizet_period == sizet_period - 1)
+        {
+            M t_max = *std::max_element(vec_next.begin(), vec_next.end());
+            for (uint32_t uint_s = 0; uint_s < uint_states; uint_s++) vec_next[uint_s] = metric_traits <M>::sub(vec_next[uint_s], t_max);
+        }
+
+        vec_metric.swap(vec_next);
+    }
+
+    uint32_t uint_state = 0;
+    if (!bool_terminated)
+    {
+        uint_state = std::max_element(vec_metric.begin(), vec_metric.end()) - vec_metric.begin();
+    }
+
+    // traceback through the survivors
+    for (size_t sizet_stage = sizet_stages; sizet_stage > 0; sizet_stage--)
+    {
+        const uint64_t* ptr_dec = vec_decisions.data() + (sizet_stage - 1) * sizet_words;
+        uint32_t uint_d = (ptr_dec[uint_state >> 6] >> (uint_state & 63)) & 0x1;
+
+        ptr_out[sizet_stage - 1] = (uint_state >> (uint_m - 1)) & 0x1;
+        uint_state = ((uint_state << 1) & uint_mmask) | uint_d;
+    }
+}
 
 // Private methods
 
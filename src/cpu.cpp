@@ -0,0 +1,260 @@
+/*
+ * This file is part of Susa.
+ *
+ * Susa is free software: you can redistribute it and/or modify
+ * it under the terms of the Lesser GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * at your option) any later version.
+ *
+ * Susa is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * Lesser GNU General Public License for more details.
+ *
+ * You should have received a copy of the Lesser GNU General Public License
+ * along with Susa.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file cpu.cpp
+ * @brief The runtime selection of the kernels by the CPU features (definition).
+ *
+ * This file is compiled without the contraction of the floating-point
+ * operations, otherwise the variants with FMA would round differently.
+ *
+ * @author Behrooz Kamary
+ * @version 1.0.0
+ */
+
+#include <susa.h>
+#include <atomic>
+#include <cstdlib>
+
+#if !defined(SUSA_NO_DISPATCH) && (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define SUSA_DISPATCH_X86
+#endif
+
+namespace susa {
+
+#define SUSA_CPU_PLANAR(NAME, SUFFIX, ATTRIBUTE) \
+    static ATTRIBUTE void planar_##NAME##_f64_##SUFFIX(const double* ptr_ar, const double* ptr_ai, const double* ptr_br, \
+      const double* ptr_bi, size_t sizet_n, double* ptr_yr, double* ptr_yi) \
+    { \
+        planar_##NAME <double> (ptr_ar, ptr_ai, ptr_br, ptr_bi, sizet_n, ptr_yr, ptr_yi); \
+    }
+
+#define SUSA_CPU_ACS(NAME, TYPE, SUFFIX, ATTRIBUTE) \
+    static ATTRIBUTE void viterbi_acs_##NAME##_##SUFFIX(const TYPE* ptr_metric, const TYPE* ptr_bm, uint32_t uint_half, \
+      TYPE* ptr_next, uint8_t* ptr_mask, uint64_t* ptr_dec) \
+    { \
+        viterbi_acs <TYPE> (ptr_metric, ptr_bm, uint_half, ptr_next, ptr_mask, ptr_dec); \
+    }
+
+// the variants are compiled for every target from the same inlined kernels, the
+// add-compare-selects may have their own attribute
+#define SUSA_CPU_VARIANT(SUFFIX, ATTRIBUTE, ACS_ATTRIBUTE) \
+    static ATTRIBUTE void fir_f64_##SUFFIX(const double* ptr_b, size_t size_b, const double* ptr_x, size_t size_x, \
+      double* ptr_y, size_t size_first, size_t size_last) \
+    { \
+        fir_kernel <double, double> (ptr_b, size_b, ptr_x, size_x, ptr_y, size_first, size_last); \
+    } \
+    SUSA_CPU_ACS(f32, float, SUFFIX, ACS_ATTRIBUTE) \
+    SUSA_CPU_ACS(i16, int16_t, SUFFIX, ACS_ATTRIBUTE) \
+    SUSA_CPU_ACS(i8, int8_t, SUFFIX, ACS_ATTRIBUTE) \
+    SUSA_CPU_PLANAR(mul, SUFFIX, ATTRIBUTE) \
+    SUSA_CPU_PLANAR(conj_mul, SUFFIX, ATTRIBUTE) \
+    SUSA_CPU_PLANAR(mac, SUFFIX, ATTRIBUTE) \
+    static ATTRIBUTE void planar_mag_f64_##SUFFIX(const double* ptr_ar, const double* ptr_ai, size_t sizet_n, double* ptr_y) \
+    { \
+        planar_mag <double> (ptr_ar, ptr_ai, sizet_n, ptr_y); \
+    } \
+    static ATTRIBUTE void qam_max_log_llr_f64_##SUFFIX(const double* ptr_x, size_t sizet_n, uint32_t uint_side, \
+      uint32_t uint_bpa, double dbl_scale, double* ptr_llr) \
+    { \
+        qam_max_log_llr <double> (ptr_x, sizet_n, uint_side, uint_bpa, dbl_scale, ptr_llr); \
+    }
+
+#define SUSA_CPU_TABLE(ISA, SUFFIX) {ISA, fir_f64_##SUFFIX, viterbi_acs_f32_##SUFFIX, viterbi_acs_i16_##SUFFIX, \
+    viterbi_acs_i8_##SUFFIX, planar_mul_f64_##SUFFIX, \
+    planar_conj_mul_f64_##SUFFIX, planar_mac_f64_##SUFFIX, planar_mag_f64_##SUFFIX, \
+    qam_max_log_llr_f64_##SUFFIX}
+
+SUSA_CPU_VARIANT(generic, , )
+static const cpu_kernels kernels_generic = SUSA_CPU_TABLE(ISA_GENERIC, generic);
+
+#ifdef SUSA_DISPATCH_X86
+// the 8 and 16-bit metrics of the add-compare-select need AVX-512BW; its 512-bit vectors
+// leave the butterflies of the common codes (32 for 64 states) to the scalar epilogue,
+// hence GCC keeps 256-bit vectors with the AVX-512 instructions for it
+#define SUSA_TARGET_AVX512 __attribute__((target("avx512f,avx512bw")))
+#if defined(__clang__)
+#define SUSA_TARGET_AVX512_ACS SUSA_TARGET_AVX512
+#else
+#define SUSA_TARGET_AVX512_ACS __attribute__((target("avx512f,avx512bw,prefer-vector-width=256")))
+#endif
+SUSA_CPU_VARIANT(sse2, __attribute__((target("sse2"))), __attribute__((target("sse2"))))
+SUSA_CPU_VARIANT(avx2, __attribute__((target("avx2"))), __attribute__((target("avx2"))))
+SUSA_CPU_VARIANT(avx512, SUSA_TARGET_AVX512, SUSA_TARGET_AVX512_ACS)
+static const cpu_kernels kernels_sse2   = SUSA_CPU_TABLE(ISA_SSE2, sse2);
+static const cpu_kernels kernels_avx2   = SUSA_CPU_TABLE(ISA_AVX2, avx2);
+static const cpu_kernels kernels_avx512 = SUSA_CPU_TABLE(ISA_AVX512, avx512);
+#endif
+
+// NEON is a part of the base instruction set of the builds that have it
+#if defined(__ARM_NEON) || defined(__aarch64__)
+static const cpu_kernels kernels_neon = SUSA_CPU_TABLE(ISA_NEON, generic);
+#endif
+
+static std::atomic <const cpu_kernels*> ptr_selected(nullptr);
+
+bool cpu_supports(cpu_isa isa)
+{
+#ifdef SUSA_DISPATCH_X86
+    __builtin_cpu_init();
+#endif
+
+    switch (isa)
+    {
+        case ISA_GENERIC:
+            return true;
+#ifdef SUSA_DISPATCH_X86
+        case ISA_SSE2:
+            return __builtin_cpu_supports("sse2");
+        case ISA_AVX2:
+            return __builtin_cpu_supports("avx2");
+        case ISA_AVX512:
+            return __builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw");
+#endif
+#if defined(__ARM_NEON) || defined(__aarch64__)
+        case ISA_NEON:
+            return true;
+#endif
+        default:
+            return false;
+    }
+}
+
+cpu_isa cpu_best_isa()
+{
+    const cpu_isa isa_order[] = {ISA_AVX512, ISA_AVX2, ISA_SSE2, ISA_NEON};
+
+    for (size_t sizet_i = 0; sizet_i < sizeof(isa_order) / sizeof(isa_order[0]); sizet_i++)
+    {
+        if (cpu_supports(isa_order[sizet_i])) return isa_order[sizet_i];
+    }
+
+    return ISA_GENERIC;
+}
+
+const char* cpu_isa_name(cpu_isa isa)
+{
+    switch (isa)
+    {
+        case ISA_SSE2:   return "sse2";
+        case ISA_AVX2:   return "avx2";
+        case ISA_AVX512: return "avx512";
+        case ISA_NEON:   return "neon";
+        default:         return "generic";
+    }
+}
+
+const cpu_kernels* cpu_kernels_for(cpu_isa isa)
+{
+    if (!cpu_supports(isa)) return nullptr;
+
+    switch (isa)
+    {
+#ifdef SUSA_DISPATCH_X86
+        case ISA_SSE2:   return &kernels_sse2;
+        case ISA_AVX2:   return &kernels_avx2;
+        case ISA_AVX512: return &kernels_avx512;
+#endif
+#if defined(__ARM_NEON) || defined(__aarch64__)
+        case ISA_NEON:   return &kernels_neon;
+#endif
+        default:         return &kernels_generic;
+    }
+}
+
+// the environment variable overrides the best instruction set e.g. for testing
+static const cpu_kernels* initial_kernels()
+{
+    const char* char_env = std::getenv("SUSA_ISA");
+
+    if (char_env != nullptr && *char_env != '\0')
+    {
+        const cpu_isa isa_all[] = {ISA_GENERIC, ISA_SSE2, ISA_AVX2, ISA_AVX512, ISA_NEON};
+
+        for (size_t sizet_i = 0; sizet_i < sizeof(isa_all) / sizeof(isa_all[0]); sizet_i++)
+        {
+            if (std::strcmp(char_env, cpu_isa_name(isa_all[sizet_i])) != 0) continue;
+
+            const cpu_kernels* ptr_kernels = cpu_kernels_for(isa_all[sizet_i]);
+            if (ptr_kernels != nullptr) return ptr_kernels;
+        }
+
+        SUSA_LOG_ERR("the instruction set of SUSA_ISA (" << char_env << ") is not supported, the best one is used.");
+    }
+
+    return cpu_kernels_for(cpu_best_isa());
+}
+
+const cpu_kernels& cpu_dispatch()
+{
+    const cpu_kernels* ptr_kernels = ptr_selected.load(std::memory_order_acquire);
+
+    if (ptr_kernels == nullptr)
+    {
+        // the concurrent first calls select the same table
+        ptr_kernels = initial_kernels();
+        ptr_selected.store(ptr_kernels, std::memory_order_release);
+    }
+
+    return *ptr_kernels;
+}
+
+bool cpu_select(cpu_isa isa)
+{
+    const cpu_kernels* ptr_kernels = cpu_kernels_for(isa);
+    SUSA_ASSERT_MESSAGE(ptr_kernels != nullptr, "the instruction set is not supported.");
+    if (ptr_kernels == nullptr) return false;
+
+    ptr_selected.store(ptr_kernels, std::memory_order_release);
+    return true;
+}
+
+void planar_mul(const double* ptr_ar, const double* ptr_ai, const double* ptr_br, const double* ptr_bi,
+  size_t sizet_n, double* ptr_yr, double* ptr_yi)
+{
+    cpu_dispatch().planar_mul_f64(ptr_ar, ptr_ai, ptr_br, ptr_bi, sizet_n, ptr_yr, ptr_yi);
+}
+
+void planar_conj_mul(const double* ptr_ar, const double* ptr_ai, const double* ptr_br, const double* ptr_bi,
+  size_t sizet_n, double* ptr_yr, double* ptr_yi)
+{
+    cpu_dispatch().planar_conj_mul_f64(ptr_ar, ptr_ai, ptr_br, ptr_bi, sizet_n, ptr_yr, ptr_yi);
+}
+
+void planar_mac(const double* ptr_ar, const double* ptr_ai, const double* ptr_br, const double* ptr_bi,
+  size_t sizet_n, double* ptr_yr, double* ptr_yi)
+{
+    cpu_dispatch().planar_mac_f64(ptr_ar, ptr_ai, ptr_br, ptr_bi, sizet_n, ptr_yr, ptr_yi);
+}
+
+void planar_mag(const double* ptr_ar, const double* ptr_ai, size_t sizet_n, double* ptr_y)
+{
+    cpu_dispatch().planar_mag_f64(ptr_ar, ptr_ai, sizet_n, ptr_y);
+}
+
+void qam_max_log_llr(const double* ptr_x, size_t sizet_n, uint32_t uint_side, uint32_t uint_bpa, double dbl_scale, double* ptr_llr)
+{
+    cpu_dispatch().qam_max_log_llr_f64(ptr_x, sizet_n, uint_side, uint_bpa, dbl_scale, ptr_llr);
+}
+
+void fir_kernel(const double* ptr_b, size_t size_b, const double* ptr_x, size_t size_x,
+  double* ptr_y, size_t size_first, size_t size_last)
+{
+    cpu_dispatch().fir_f64(ptr_b, size_b, ptr_x, size_x, ptr_y, size_first, size_last);
+}
+
+}      // NAMESPACE SUSA
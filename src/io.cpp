@@ -0,0 +1,253 @@
+/*
+ * This file is part of Susa.
+ *
+ * Susa is free software: you can redistribute it and/or modify
+ * it under the terms of the Lesser GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * at your option) any later version.
+ *
+ * Susa is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * Lesser GNU General Public License for more details.
+ *
+ * You should have received a copy of the Lesser GNU General Public License
+ * along with Susa.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file io.cpp
+ * @brief Binary and memory-mapped serialization in the NumPy format (definition).
+ * @author Behrooz Kamary
+ * @version 1.0.0
+ */
+
+#include <susa.h>
+
+#if !defined(_WIN32)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace susa {
+
+static const char   NPY_MAGIC[]  = "\x93NUMPY";
+static const size_t NPY_PREFIX   = 6;
+static const size_t NPY_ALIGN    = 64;
+
+static bool is_little_endian()
+{
+    uint16_t uint_probe = 1;
+    return *reinterpret_cast <const uint8_t*> (&uint_probe) == 1;
+}
+
+std::string npy_descr(char char_kind, size_t sizet_bytes, bool bool_swapped)
+{
+    char char_order = sizet_bytes == 1 ? '|' : ((is_little_endian() != bool_swapped) ? '<' : '>');
+
+    // the characters are appended as they are, the stream operator of susa prints them as numbers
+    std::ostringstream oss;
+    oss << sizet_bytes;
+    return std::string(1, char_order) + char_kind + oss.str();
+}
+
+bool write_npy_header(std::ostream& os, const npy_header& header)
+{
+    std::ostringstream oss;
+    oss << "{'descr': '" << header.str_descr << "', 'fortran_order': " << (header.bool_fortran ? "True" : "False")
+        << ", 'shape': (";
+    for (size_t sizet_axis = 0; sizet_axis < header.vec_shape.size(); sizet_axis++)
+    {
+        oss << header.vec_shape[sizet_axis] << (header.vec_shape.size() == 1 ? "," : (sizet_axis + 1 < header.vec_shape.size() ? ", " : ""));
+    }
+    oss << "), }";
+
+    std::string str_dict    = oss.str();
+    bool        bool_v1     = str_dict.size() + NPY_PREFIX + 4 + NPY_ALIGN < 65536;
+    size_t      sizet_fixed = NPY_PREFIX + 2 + (bool_v1 ? 2 : 4);
+    size_t      sizet_total = ((sizet_fixed + str_dict.size() + 1 + NPY_ALIGN - 1) / NPY_ALIGN) * NPY_ALIGN;
+
+    // the dictionary is padded with spaces and terminated by a new line
+    str_dict.append(sizet_total - sizet_fixed - str_dict.size() - 1, ' ');
+    str_dict.push_back('\n');
+
+    uint32_t uint_len = str_dict.size();
+    char     char_version[2] = {static_cast <char> (bool_v1 ? 1 : 2), 0};
+    char     char_len[4] = {static_cast <char> (uint_len & 0xFF), static_cast <char> ((uint_len >> 8) & 0xFF),
+                            static_cast <char> ((uint_len >> 16) & 0xFF), static_cast <char> ((uint_len >> 24) & 0xFF)};
+
+    os.write(NPY_MAGIC, NPY_PREFIX);
+    os.write(char_version, 2);
+    os.write(char_len, bool_v1 ? 2 : 4);
+    os.write(str_dict.data(), str_dict.size());
+
+    return os.good();
+}
+
+//! parses the header dictionary e.g. {'descr': '<f8', 'fortran_order': True, 'shape': (3, 4), }
+static bool parse_npy_dict(const std::string& str_dict, npy_header& header)
+{
+    size_t sizet_key = str_dict.find("'descr'");
+    if (sizet_key == std::string::npos) return false;
+    size_t sizet_colon = str_dict.find(':', sizet_key);
+    size_t sizet_open  = str_dict.find_first_not_of(" ", sizet_colon + 1);
+    if (sizet_colon == std::string::npos || sizet_open == std::string::npos || str_dict[sizet_open] != '\'') return false;
+    size_t sizet_close = str_dict.find('\'', sizet_open + 1);
+    if (sizet_close == std::string::npos) return false;
+    header.str_descr = str_dict.substr(sizet_open + 1, sizet_close - sizet_open - 1);
+
+    sizet_key = str_dict.find("'fortran_order'");
+    if (sizet_key == std::string::npos) return false;
+    sizet_colon = str_dict.find(':', sizet_key);
+    sizet_open  = str_dict.find_first_not_of(" ", sizet_colon + 1);
+    if (sizet_colon == std::string::npos || sizet_open == std::string::npos) return false;
+    header.bool_fortran = str_dict.compare(sizet_open, 4, "True") == 0;
+
+    sizet_key = str_dict.find("'shape'");
+    if (sizet_key == std::string::npos) return false;
+    sizet_open  = str_dict.find('(', sizet_key);
+    sizet_close = str_dict.find(')', sizet_open);
+    if (sizet_open == std::string::npos || sizet_close == std::string::npos) return false;
+
+    header.vec_shape.clear();
+    std::istringstream iss(str_dict.substr(sizet_open + 1, sizet_close - sizet_open - 1));
+    std::string str_dim;
+    while (std::getline(iss, str_dim, ','))
+    {
+        if (str_dim.find_first_of("0123456789") == std::string::npos) continue;
+        header.vec_shape.push_back(std::strtoull(str_dim.c_str(), nullptr, 10));
+    }
+
+    return true;
+}
+
+bool read_npy_header(std::istream& is, npy_header& header)
+{
+    char char_prefix[NPY_PREFIX + 2];
+    is.read(char_prefix, NPY_PREFIX + 2);
+    if (!is || std::memcmp(char_prefix, NPY_MAGIC, NPY_PREFIX) != 0)
+    {
+        SUSA_LOG_ERR("the file is not in the NumPy format.");
+        return false;
+    }
+
+    unsigned int uint_major = static_cast <uint8_t> (char_prefix[NPY_PREFIX]);
+    size_t       sizet_len_bytes = uint_major == 1 ? 2 : 4;
+    if (uint_major < 1 || uint_major > 3) return false;
+
+    uint8_t uint_len[4] = {0, 0, 0, 0};
+    is.read(reinterpret_cast <char*> (uint_len), sizet_len_bytes);
+    if (!is) return false;
+
+    size_t sizet_len = uint_len[0] | (uint_len[1] << 8) | (uint_len[2] << 16) | (static_cast <size_t> (uint_len[3]) << 24);
+    std::string str_dict(sizet_len, ' ');
+    is.read(&str_dict[0], sizet_len);
+    if (!is) return false;
+
+    header.sizet_offset = NPY_PREFIX + 2 + sizet_len_bytes + sizet_len;
+
+    return parse_npy_dict(str_dict, header);
+}
+
+void swap_bytes(void* ptr_data, size_t sizet_count, size_t sizet_bytes)
+{
+    uint8_t* ptr_byte = static_cast <uint8_t*> (ptr_data);
+
+    for (size_t sizet_i = 0; sizet_i < sizet_count; sizet_i++, ptr_byte += sizet_bytes)
+    {
+        std::reverse(ptr_byte, ptr_byte + sizet_bytes);
+    }
+}
+
+mapped_npy::mapped_npy()
+: ptr_map(nullptr)
+, sizet_bytes(0)
+{
+}
+
+mapped_npy::mapped_npy(const std::string& str_path)
+: ptr_map(nullptr)
+, sizet_bytes(0)
+{
+    open(str_path);
+}
+
+mapped_npy::~mapped_npy() noexcept
+{
+    close();
+}
+
+size_t mapped_npy::size() const
+{
+    if (ptr_map == nullptr) return 0;
+
+    size_t sizet_num = 1;
+    for (size_t sizet_axis = 0; sizet_axis < npy_head.vec_shape.size(); sizet_axis++) sizet_num *= npy_head.vec_shape[sizet_axis];
+    return sizet_num;
+}
+
+bool mapped_npy::open(const std::string& str_path)
+{
+    close();
+
+#if defined(_WIN32)
+    SUSA_LOG_ERR("the memory mapped files are not supported on this platform.");
+    (void) str_path;
+    return false;
+#else
+    int int_fd = ::open(str_path.c_str(), O_RDONLY);
+    SUSA_ASSERT_MESSAGE(int_fd >= 0, "the file can not be opened.");
+    if (int_fd < 0) return false;
+
+    struct stat file_stat;
+    if (fstat(int_fd, &file_stat) != 0 || file_stat.st_size <= 0)
+    {
+        ::close(int_fd);
+        return false;
+    }
+
+    size_t sizet_file = file_stat.st_size;
+    void*  ptr_file   = mmap(nullptr, sizet_file, PROT_READ, MAP_PRIVATE, int_fd, 0);
+    ::close(int_fd);
+    if (ptr_file == MAP_FAILED) return false;
+
+    ptr_map     = ptr_file;
+    sizet_bytes = sizet_file;
+
+    // only the header is copied for the parser
+    const uint8_t* ptr_byte   = static_cast <const uint8_t*> (ptr_map);
+    size_t         sizet_head = sizet_bytes;
+    if (sizet_bytes >= NPY_PREFIX + 6)
+    {
+        size_t sizet_len_bytes = ptr_byte[NPY_PREFIX] == 1 ? 2 : 4;
+        size_t sizet_len       = ptr_byte[NPY_PREFIX + 2] | (ptr_byte[NPY_PREFIX + 3] << 8);
+        if (sizet_len_bytes == 4) sizet_len |= (ptr_byte[NPY_PREFIX + 4] << 16) | (static_cast <size_t> (ptr_byte[NPY_PREFIX + 5]) << 24);
+        sizet_head = std::min(sizet_bytes, NPY_PREFIX + 2 + sizet_len_bytes + sizet_len);
+    }
+    std::istringstream iss(std::string(static_cast <const char*> (ptr_map), sizet_head));
+    bool bool_ok = read_npy_header(iss, npy_head);
+
+    // the elements shall fit in the file
+    size_t sizet_item = bool_ok && npy_head.str_descr.size() > 2 ? std::strtoull(npy_head.str_descr.c_str() + 2, nullptr, 10) : 0;
+    bool_ok = bool_ok && sizet_item > 0 && npy_head.sizet_offset + size() * sizet_item <= sizet_bytes;
+
+    SUSA_ASSERT_MESSAGE(bool_ok, "the file is not a valid NumPy file.");
+    if (!bool_ok) close();
+
+    return bool_ok;
+#endif
+}
+
+void mapped_npy::close()
+{
+#if !defined(_WIN32)
+    if (ptr_map != nullptr) munmap(ptr_map, sizet_bytes);
+#endif
+    ptr_map     = nullptr;
+    sizet_bytes = 0;
+    npy_head    = npy_header();
+}
+
+}      // NAMESPACE SUSA
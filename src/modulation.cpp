@@ -53,13 +53,24 @@ matrix <int8_t> bpsk(const matrix <uint8_t> &mat_arg)
 }
 
 qam::qam(unsigned int uint_m)
-: uint_m(uint_m)
+: dbl_es(0)
+, dbl_eb(0)
+, uint_bps(0)
+, uint_m(uint_m)
+, uint_side(0)
+, uint_bpa(0)
 {
-
-    uint_bps                = log2(uint_m);
     double          dbl_p   = sqrt(uint_m);
     unsigned int    uint_l  = (unsigned int)(uint_m/dbl_p);
 
+    // the fast slicer and the Gray mapping per axis need a square constellation,
+    // otherwise the object is left without symbols
+    bool bool_square = uint_m >= 4 && uint_l * uint_l == uint_m && (uint_m & (uint_m - 1)) == 0;
+    SUSA_ASSERT_MESSAGE(bool_square || uint_m == 0, "the fast slicer and the bit mapping need a square QAM.");
+    if (!bool_square) return;
+
+    uint_bps                = log2(uint_m);
+
     // Constellation generation
     mat_s    = matrix < std::complex <double> > (uint_l, uint_l, std::complex <double>(0,0));
     mat_axis = matrix < std::complex <double> > ((unsigned int)dbl_p, 1, std::complex <double>(0,0));
@@ -76,20 +87,198 @@ qam::qam(unsigned int uint_m)
     }
 
     // Energy computations
-    matrix <double> mat_mag     = mag(mat_s);
-    matrix <double> mat_sum     = sum(mat_mag);
-    dbl_es                      = sum(mat_sum)(0)/uint_m;
+    dbl_es                      = energy(mat_s, AXIS_ALL)(0) / uint_m;
     dbl_eb                      = dbl_es / uint_bps;
+
+    // Gray mapping per axis
+    uint_side = uint_l;
+    uint_bpa  = uint_bps / 2;
+
+    vec_gray_level.resize(uint_side);
+    for (unsigned int uint_level = 0; uint_level < uint_side; uint_level++)
+    {
+        vec_gray_level[uint_level ^ (uint_level >> 1)] = uint_level;
+    }
 }
 
 std::complex <double> qam::demodulate_symbol(std::complex <double> complex_arg)
 {
-    matrix <double> mat_dist(uint_m,1);
-    for (unsigned int uint_i = 0; uint_i < uint_m; uint_i++)
+    if (uint_side == 0) return std::complex <double> (0, 0);
+    return mat_s(slice(complex_arg.real()), slice(complex_arg.imag()));
+}
+
+void qam::demodulate_symbols(const matrix < std::complex <double> >& mat_symbols, matrix <int>& mat_indices)
+{
+    if (uint_side == 0)
+    {
+        mat_indices = matrix <int> ();
+        return;
+    }
+
+    if (mat_indices.no_rows() != mat_symbols.no_rows() || mat_indices.no_cols() != mat_symbols.no_cols())
+    {
+        mat_indices = matrix <int> (mat_symbols.no_rows(), mat_symbols.no_cols());
+    }
+
+    const std::complex <double>* ptr_in  = mat_symbols.data();
+    int*                         ptr_out = mat_indices.data();
+    size_t                       sizet_size = mat_symbols.size();
+
+    for (size_t sizet_i = 0; sizet_i < sizet_size; sizet_i++)
+    {
+        ptr_out[sizet_i] = slice(ptr_in[sizet_i].real()) + uint_side * slice(ptr_in[sizet_i].imag());
+    }
+}
+
+matrix <int> qam::demodulate_symbols(const matrix < std::complex <double> >& mat_symbols)
+{
+    matrix <int> mat_indices;
+    demodulate_symbols(mat_symbols, mat_indices);
+    return mat_indices;
+}
+
+void qam::demodulate_bits(const matrix < std::complex <double> >& mat_symbols, matrix <char>& mat_bits)
+{
+    if (uint_side == 0)
+    {
+        mat_bits = matrix <char> ();
+        return;
+    }
+
+    size_t sizet_size = mat_symbols.size();
+    if (mat_bits.size() != sizet_size * uint_bps) mat_bits = matrix <char> (sizet_size * uint_bps, 1);
+
+    const std::complex <double>* ptr_in  = mat_symbols.data();
+    char*                        ptr_out = mat_bits.data();
+
+    for (size_t sizet_i = 0; sizet_i < sizet_size; sizet_i++)
+    {
+        unsigned int uint_re = slice(ptr_in[sizet_i].real());
+        unsigned int uint_im = slice(ptr_in[sizet_i].imag());
+        uint_re ^= uint_re >> 1;
+        uint_im ^= uint_im >> 1;
+
+        for (unsigned int uint_b = 0; uint_b < uint_bpa; uint_b++)
+        {
+            ptr_out[uint_b]            = (uint_re >> (uint_bpa - 1 - uint_b)) & 0x1;
+            ptr_out[uint_bpa + uint_b] = (uint_im >> (uint_bpa - 1 - uint_b)) & 0x1;
+        }
+        ptr_out += uint_bps;
+    }
+}
+
+matrix <char> qam::demodulate_bits(const matrix < std::complex <double> >& mat_symbols)
+{
+    matrix <char> mat_bits;
+    demodulate_bits(mat_symbols, mat_bits);
+    return mat_bits;
+}
+
+matrix < std::complex <double> > qam::modulate_bits(matrix <char> mat_bits)
+{
+    if (uint_side == 0) return matrix < std::complex <double> > ();
+
+    size_t sizet_symbols = uint_bps == 0 ? 0 : mat_bits.size() / uint_bps;
+    matrix < std::complex <double> > mat_ret(sizet_symbols, 1);
+
+    const char* ptr_in = mat_bits.data();
+    for (size_t sizet_i = 0; sizet_i < sizet_symbols; sizet_i++)
     {
-        mat_dist(uint_i) = std::abs(complex_arg - mat_s(uint_i));
+        unsigned int uint_re = 0, uint_im = 0;
+        for (unsigned int uint_b = 0; uint_b < uint_bpa; uint_b++)
+        {
+            uint_re = (uint_re << 1) | (ptr_in[uint_b] != 0);
+            uint_im = (uint_im << 1) | (ptr_in[uint_bpa + uint_b] != 0);
+        }
+        mat_ret(sizet_i) = mat_s(vec_gray_level[uint_re], vec_gray_level[uint_im]);
+        ptr_in += uint_bps;
+    }
+
+    return mat_ret;
+}
+
+void qam::demodulate_llr(const matrix < std::complex <double> >& mat_symbols, double dbl_noise_var, matrix <double>& mat_llr,
+  llr_metric metric)
+{
+    if (uint_side == 0)
+    {
+        mat_llr = matrix <double> ();
+        return;
+    }
+
+    size_t sizet_size = mat_symbols.size();
+    if (mat_llr.size() != sizet_size * uint_bps) mat_llr = matrix <double> (sizet_size * uint_bps, 1);
+
+    SUSA_ASSERT_MESSAGE(dbl_noise_var > 0, "the noise variance must be positive.");
+    double dbl_scale = 1.0 / (dbl_noise_var > 0 ? dbl_noise_var : std::numeric_limits <double>::min());
+
+    const std::complex <double>* ptr_in  = mat_symbols.data();
+    double*                      ptr_out = mat_llr.data();
+
+    if (metric == MAX_LOG)
+    {
+        // the real and the imaginary parts are the interleaved values of the axis kernel,
+        // its bit planes of a block are then interleaved into the symbol order
+        const size_t sizet_block = 512;
+        std::vector <double> vec_planes(sizet_block * uint_bpa);
+        const double* ptr_axis = reinterpret_cast <const double*> (ptr_in);
+
+        for (size_t sizet_begin = 0; sizet_begin < 2 * sizet_size; sizet_begin += sizet_block)
+        {
+            size_t sizet_n = std::min(sizet_block, 2 * sizet_size - sizet_begin);
+            qam_max_log_llr(ptr_axis + sizet_begin, sizet_n, uint_side, uint_bpa, dbl_scale, vec_planes.data());
+
+            for (size_t sizet_i = 0; sizet_i < sizet_n; sizet_i++)
+            {
+                for (unsigned int uint_b = 0; uint_b < uint_bpa; uint_b++) ptr_out[uint_b] = vec_planes[uint_b * sizet_n + sizet_i];
+                ptr_out += uint_bpa;
+            }
+        }
+
+        return;
+    }
+
+    // the exact LLRs sum the likelihoods of all the levels of an axis
+    std::vector <double> vec_scratch(uint_side);
+    for (size_t sizet_i = 0; sizet_i < sizet_size; sizet_i++)
+    {
+        axis_llr(ptr_in[sizet_i].real(), dbl_scale, vec_scratch.data(), ptr_out);
+        axis_llr(ptr_in[sizet_i].imag(), dbl_scale, vec_scratch.data(), ptr_out + uint_bpa);
+        ptr_out += uint_bps;
+    }
+}
+
+matrix <double> qam::demodulate_llr(const matrix < std::complex <double> >& mat_symbols, double dbl_noise_var, llr_metric metric)
+{
+    matrix <double> mat_llr;
+    demodulate_llr(mat_symbols, dbl_noise_var, mat_llr, metric);
+    return mat_llr;
+}
+
+void qam::axis_llr(double dbl_arg, double dbl_scale, double* ptr_scratch, double* ptr_llr) const
+{
+    const int    int_side   = uint_side;
+    const double dbl_offset = 0.5 * (int_side - 1);
+
+    // the likelihoods relative to the nearest level do not underflow
+    double dbl_min = std::numeric_limits <double>::max();
+    for (int int_l = 0; int_l < int_side; int_l++)
+    {
+        double dbl_d = dbl_arg - int_l + dbl_offset;
+        ptr_scratch[int_l] = dbl_d * dbl_d;
+        dbl_min = std::min(dbl_min, ptr_scratch[int_l]);
+    }
+    for (int int_l = 0; int_l < int_side; int_l++) ptr_scratch[int_l] = std::exp((dbl_min - ptr_scratch[int_l]) * dbl_scale);
+
+    for (unsigned int uint_b = 0; uint_b < uint_bpa; uint_b++)
+    {
+        double dbl_p[2] = {std::numeric_limits <double>::min(), std::numeric_limits <double>::min()};
+        for (int int_l = 0; int_l < int_side; int_l++)
+        {
+            dbl_p[((int_l ^ (int_l >> 1)) >> (uint_bpa - 1 - uint_b)) & 0x1] += ptr_scratch[int_l];
+        }
+        ptr_llr[uint_b] = std::log(dbl_p[1]) - std::log(dbl_p[0]);
     }
-    return mat_s(min(mat_dist)(0));
 }
 
 double qam::get_noise_deviation(double dbl_arg)
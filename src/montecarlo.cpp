@@ -0,0 +1,85 @@
+/*
+ * This file is part of Susa.
+ *
+ * Susa is free software: you can redistribute it and/or modify
+ * it under the terms of the Lesser GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * at your option) any later version.
+ *
+ * Susa is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * Lesser GNU General Public License for more details.
+ *
+ * You should have received a copy of the Lesser GNU General Public License
+ * along with Susa.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file montecarlo.cpp
+ * @brief A parallel Monte Carlo error rate runner (definition).
+ * @author Behrooz Kamary
+ * @version 1.0.0
+ */
+
+#include <susa.h>
+
+namespace susa
+{
+
+double mc_point::rate() const
+{
+    return uint_samples == 0 ? 0 : static_cast <double> (uint_errors) / uint_samples;
+}
+
+double mc_point::half_width(double dbl_z) const
+{
+    if (uint_samples == 0) return 0;
+
+    double dbl_p = rate();
+    return dbl_z * std::sqrt(dbl_p * (1 - dbl_p) / uint_samples);
+}
+
+montecarlo::montecarlo(uint64_t uint_max_trials, uint64_t uint_target_errors, size_t sizet_batch, unsigned int uint_seed)
+: uint_max_trials(uint_max_trials)
+, uint_target_errors(uint_target_errors)
+, sizet_batch(sizet_batch == 0 ? 1 : sizet_batch)
+, sizet_round(64)
+, uint_seed(uint_seed)
+, dbl_relative(0)
+, dbl_z(1.96)
+{
+}
+
+void montecarlo::set_confidence(double dbl_relative, double dbl_z)
+{
+    this->dbl_relative = dbl_relative;
+    this->dbl_z        = dbl_z;
+}
+
+void montecarlo::set_round(size_t sizet_round)
+{
+    this->sizet_round = sizet_round == 0 ? 1 : sizet_round;
+}
+
+uint64_t montecarlo::batch_stream(size_t sizet_point, uint64_t uint_batch) const
+{
+    // 2^40 batches for each of 2^24 points
+    return (static_cast <uint64_t> (sizet_point) << 40) | (uint_batch & 0xFFFFFFFFFFull);
+}
+
+bool montecarlo::is_done(const mc_point& point) const
+{
+    if (point.uint_trials >= uint_max_trials) return true;
+    if (uint_target_errors > 0 && point.uint_errors >= uint_target_errors) return true;
+
+    // a rate without errors has no meaningful relative interval
+    if (dbl_relative > 0 && point.uint_errors > 0)
+    {
+        return point.half_width(dbl_z) <= dbl_relative * point.rate();
+    }
+
+    return false;
+}
+
+}      // NAMESPACE SUSA
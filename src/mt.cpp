@@ -41,6 +41,15 @@ mt::mt(uint32_t uint_seed)
     init_genrand(uint_seed);
 }
 
+mt::mt(uint32_t uint_seed, uint64_t uint_stream)
+{
+    uint_mt = new uint32_t[_MT_N];
+    mti = _MT_N + 1;
+
+    uint32_t uint_key[3] = {uint_seed, static_cast <uint32_t> (uint_stream), static_cast <uint32_t> (uint_stream >> 32)};
+    init_by_array(uint_key, 3);
+}
+
 mt::~mt()
 {
     delete [] uint_mt;
@@ -240,69 +249,110 @@ unsigned int mt::randint(unsigned int uint_max)
   return (genrand_int32() % uint_max + 1);
 }
 
-unsigned int mt::nonuniform(matrix <double> mat_probabilities)
+// Builds the alias table of Vose, i.e. outcome i is kept with probability ptr_prob[i]
+// otherwise its alias is returned
+static void alias_table(const matrix <double>& mat_probabilities, std::vector <double>& vec_prob, std::vector <uint32_t>& vec_alias)
 {
+  size_t sizet_size = mat_probabilities.size();
+  double dbl_sum    = 0;
+  for (size_t sizet_i = 0; sizet_i < sizet_size; sizet_i++) dbl_sum += mat_probabilities(sizet_i);
+
+  vec_prob.assign(sizet_size, 1.0);
+  vec_alias.resize(sizet_size);
+  if (sizet_size == 0 || dbl_sum <= 0) return;
 
-  unsigned int           uint_prob_size       = mat_probabilities.size();
-  matrix <unsigned int>  mat_sort_indices     = sort_indices(mat_probabilities);
-  matrix <double>        mat_prob_sorted      = sort(mat_probabilities);
-  double                 dbl_th               = 0;
-  double                 dbl_rnd              = genrand_real3();
+  std::vector <uint32_t> vec_small, vec_large;
+  for (size_t sizet_i = 0; sizet_i < sizet_size; sizet_i++)
+  {
+    vec_alias[sizet_i] = sizet_i;
+    vec_prob[sizet_i]  = mat_probabilities(sizet_i) * sizet_size / dbl_sum;
+    if (vec_prob[sizet_i] < 1.0) vec_small.push_back(sizet_i);
+    else vec_large.push_back(sizet_i);
+  }
 
-  dbl_th = 0;
-  for ( unsigned int uint_indx = 0; uint_indx < uint_prob_size; uint_indx++ )
+  while (!vec_small.empty() && !vec_large.empty())
   {
-    dbl_th += mat_prob_sorted(uint_indx);
-    if ( dbl_th > dbl_rnd)
+    uint32_t uint_s = vec_small.back();
+    uint32_t uint_l = vec_large.back();
+    vec_small.pop_back();
+
+    vec_alias[uint_s]  = uint_l;
+    vec_prob[uint_l]  += vec_prob[uint_s] - 1.0;
+
+    if (vec_prob[uint_l] < 1.0)
     {
-      return mat_sort_indices(uint_indx);
+      vec_large.pop_back();
+      vec_small.push_back(uint_l);
     }
   }
 
-  return 0;
+  // the leftovers are full columns up to the rounding errors
+  for (size_t sizet_i = 0; sizet_i < vec_small.size(); sizet_i++) vec_prob[vec_small[sizet_i]] = 1.0;
+  for (size_t sizet_i = 0; sizet_i < vec_large.size(); sizet_i++) vec_prob[vec_large[sizet_i]] = 1.0;
 }
 
+unsigned int mt::alias_sample(const double* ptr_prob, const uint32_t* ptr_alias, size_t sizet_size)
+{
+  // the integer part selects the column and the fraction is compared to its threshold
+  double       dbl_x  = genrand_real2() * sizet_size;
+  unsigned int uint_i = static_cast <unsigned int> (dbl_x);
+  if (uint_i >= sizet_size) uint_i = sizet_size - 1;
 
-unsigned int mt::nonuniform()
+  return (dbl_x - uint_i) < ptr_prob[uint_i] ? uint_i : ptr_alias[uint_i];
+}
+
+unsigned int mt::nonuniform(matrix <double> mat_probabilities)
 {
+  unsigned int uint_prob_size = mat_probabilities.size();
+  double       dbl_sum        = 0;
+  for (unsigned int uint_indx = 0; uint_indx < uint_prob_size; uint_indx++) dbl_sum += mat_probabilities(uint_indx);
 
-  unsigned int uint_prob_size = this->mat_probabilities.size();
-  double       dbl_th         = 0;
-  double       dbl_rnd        = genrand_real3();
+  double dbl_th  = 0;
+  double dbl_rnd = genrand_real3() * dbl_sum;
 
-  for ( unsigned int uint_indx = 0; uint_indx < uint_prob_size; uint_indx++ )
+  for (unsigned int uint_indx = 0; uint_indx < uint_prob_size; uint_indx++)
   {
-    dbl_th += this->mat_prob_sorted(uint_indx);
-    if ( dbl_th > dbl_rnd)
-    {
-      return this->mat_sort_indices(uint_indx);
-    }
+    dbl_th += mat_probabilities(uint_indx);
+    if (dbl_th > dbl_rnd) return uint_indx;
   }
 
-  return 0;
+  return uint_prob_size == 0 ? 0 : uint_prob_size - 1;
+}
+
+
+unsigned int mt::nonuniform()
+{
+  if (vec_alias.empty()) return 0;
+
+  return alias_sample(vec_alias_prob.data(), vec_alias.data(), vec_alias.size());
 }
 
 
 matrix <unsigned int> mt::nonuniform(matrix <double> mat_probabilities, unsigned int uint_length)
 {
-  matrix <unsigned int> mat_rand(uint_length, 1);
-  unsigned int uint_prob_size = mat_probabilities.size();
-  double       dbl_th         = 0;
-  double       dbl_rnd        = genrand_real3();
+  std::vector <double>   vec_prob;
+  std::vector <uint32_t> vec_table;
+  alias_table(mat_probabilities, vec_prob, vec_table);
+
+  matrix <unsigned int> mat_rand(uint_length, 1, 0);
+  if (vec_table.empty()) return mat_rand;
 
-  for (unsigned int uint_mat_indx = 0; uint_mat_indx < uint_length; uint_mat_indx++)
+  for (unsigned int uint_i = 0; uint_i < uint_length; uint_i++)
   {
-    for ( unsigned int uint_indx = 0; uint_indx < uint_prob_size; uint_indx++ )
-    {
-      dbl_th += mat_probabilities(uint_indx);
-      if ( dbl_th > dbl_rnd)
-      {
-        mat_rand(uint_mat_indx) = uint_indx;
-        break;
-      }
-    }
-    dbl_th  = 0;
-    dbl_rnd = genrand_real3();
+    mat_rand(uint_i) = alias_sample(vec_prob.data(), vec_table.data(), vec_table.size());
+  }
+
+  return mat_rand;
+}
+
+matrix <unsigned int> mt::nonuniform(unsigned int uint_length)
+{
+  matrix <unsigned int> mat_rand(uint_length, 1, 0);
+  if (vec_alias.empty()) return mat_rand;
+
+  for (unsigned int uint_i = 0; uint_i < uint_length; uint_i++)
+  {
+    mat_rand(uint_i) = alias_sample(vec_alias_prob.data(), vec_alias.data(), vec_alias.size());
   }
 
   return mat_rand;
@@ -311,8 +361,7 @@ matrix <unsigned int> mt::nonuniform(matrix <double> mat_probabilities, unsigned
 void mt::set_probabilities(matrix <double> mat_probabilities)
 {
   this->mat_probabilities = mat_probabilities;
-  this->mat_sort_indices  = sort_indices(mat_probabilities);
-  this->mat_prob_sorted   = sort(mat_probabilities);
+  alias_table(mat_probabilities, vec_alias_prob, vec_alias);
 }
 
 } //NAMESPACE SUSA
@@ -0,0 +1,197 @@
+/*
+ * This file is part of Susa.
+ *
+ * Susa is free software: you can redistribute it and/or modify
+ * it under the terms of the Lesser GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * at your option) any later version.
+ *
+ * Susa is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * Lesser GNU General Public License for more details.
+ *
+ * You should have received a copy of the Lesser GNU General Public License
+ * along with Susa.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file philox.cpp
+ * @brief Counter-based random number generator (definition).
+ * @author Behrooz Kamary
+ * @version 1.0.0
+ */
+
+#include <susa.h>
+
+namespace susa {
+
+philox::philox(uint64_t uint_seed, uint64_t uint_stream)
+{
+    init(uint_seed, uint_stream);
+}
+
+void philox::init(uint64_t uint_seed, uint64_t uint_stream)
+{
+    uint_key[0]       = static_cast <uint32_t> (uint_seed);
+    uint_key[1]       = static_cast <uint32_t> (uint_seed >> 32);
+    this->uint_stream = uint_stream;
+    uint_counter      = 0;
+    uint_index        = 4;
+}
+
+philox philox::stream(uint64_t uint_stream) const
+{
+    philox gen(*this);
+    gen.uint_stream  = uint_stream;
+    gen.uint_counter = 0;
+    gen.uint_index   = 4;
+    return gen;
+}
+
+void philox::seek(uint64_t uint_position)
+{
+    uint_counter = uint_position / 4;
+    uint_index   = 4;
+
+    if (uint_position % 4 != 0)
+    {
+        generate_block();
+        uint_index = uint_position % 4;
+    }
+}
+
+void philox::discard(uint64_t uint_num)
+{
+    seek(position() + uint_num);
+}
+
+void philox::block(const uint32_t* ptr_counter, const uint32_t* ptr_key, uint32_t* ptr_out)
+{
+    const uint64_t uint_m0 = 0xD2511F53;
+    const uint64_t uint_m1 = 0xCD9E8D57;
+
+    uint32_t uint_c[4] = {ptr_counter[0], ptr_counter[1], ptr_counter[2], ptr_counter[3]};
+    uint32_t uint_k[2] = {ptr_key[0], ptr_key[1]};
+
+    for (int int_round = 0; int_round < 10; int_round++)
+    {
+        uint64_t uint_p0 = uint_m0 * uint_c[0];
+        uint64_t uint_p1 = uint_m1 * uint_c[2];
+
+        uint32_t uint_t[4];
+        uint_t[0] = static_cast <uint32_t> (uint_p1 >> 32) ^ uint_c[1] ^ uint_k[0];
+        uint_t[1] = static_cast <uint32_t> (uint_p1);
+        uint_t[2] = static_cast <uint32_t> (uint_p0 >> 32) ^ uint_c[3] ^ uint_k[1];
+        uint_t[3] = static_cast <uint32_t> (uint_p0);
+
+        for (int int_i = 0; int_i < 4; int_i++) uint_c[int_i] = uint_t[int_i];
+
+        // the Weyl sequence of the round keys
+        uint_k[0] += 0x9E3779B9;
+        uint_k[1] += 0xBB67AE85;
+    }
+
+    for (int int_i = 0; int_i < 4; int_i++) ptr_out[int_i] = uint_c[int_i];
+}
+
+uint32_t philox::rand_uint()
+{
+    if (uint_index >= 4) generate_block();
+    return uint_buffer[uint_index++];
+}
+
+double philox::rand()
+{
+    // the centre of one of the 2^32 equal cells, never zero or one
+    return (rand_uint() + 0.5) * (1.0 / 4294967296.0);
+}
+
+double philox::randn()
+{
+    // Polar Box-Muller transform
+    double x1, x2, w;
+
+    do
+    {
+        x1 = 2.0 * rand() - 1.0;
+        x2 = 2.0 * rand() - 1.0;
+        w  = x1 * x1 + x2 * x2;
+    } while (w >= 1.0);
+
+    return x1 * std::sqrt((-2.0 * std::log(w)) / w);
+}
+
+unsigned int philox::rand_mask(unsigned int uint_mask)
+{
+    return rand_uint() & uint_mask;
+}
+
+matrix <unsigned int> philox::rand_mask(unsigned int uint_mask, unsigned int uint_num)
+{
+    matrix <unsigned int> mat_ret(uint_num, 1);
+
+    for (unsigned int uint_i = 0; uint_i < uint_num; uint_i++) mat_ret(uint_i) = rand_uint() & uint_mask;
+
+    return mat_ret;
+}
+
+matrix <double> philox::randn(unsigned int uint_num)
+{
+    double x1, x2, w;
+    matrix <double> mat_ret(uint_num, 1);
+
+    for (unsigned int uint_i = 0; uint_i < uint_num; uint_i += 2)
+    {
+        do
+        {
+            x1 = 2.0 * rand() - 1.0;
+            x2 = 2.0 * rand() - 1.0;
+            w  = x1 * x1 + x2 * x2;
+        } while (w >= 1.0);
+
+        w = std::sqrt((-2.0 * std::log(w)) / w);
+
+        mat_ret(uint_i) = x1 * w;
+        if ((uint_i + 1) < uint_num) mat_ret(uint_i + 1) = x2 * w;
+    }
+
+    return mat_ret;
+}
+
+matrix <double> philox::rand(unsigned int uint_num)
+{
+    return rand(uint_num, 1);
+}
+
+matrix <double> philox::rand(unsigned int uint_rows, unsigned int uint_cols)
+{
+    matrix <double> mat_ret(uint_rows, uint_cols);
+
+    for (size_t sizet_i = 0; sizet_i < mat_ret.size(); sizet_i++) mat_ret(sizet_i) = rand();
+
+    return mat_ret;
+}
+
+matrix <unsigned char> philox::bernoulli(size_t size_num)
+{
+    matrix <unsigned char> mat_ret(size_num, 1);
+
+    for (size_t size_i = 0; size_i < size_num; size_i++) mat_ret(size_i) = rand_uint() & 0x01;
+
+    return mat_ret;
+}
+
+// Private methods
+
+void philox::generate_block()
+{
+    uint32_t uint_ctr[4] = {static_cast <uint32_t> (uint_counter), static_cast <uint32_t> (uint_counter >> 32),
+                            static_cast <uint32_t> (uint_stream),  static_cast <uint32_t> (uint_stream >> 32)};
+
+    block(uint_ctr, uint_key, uint_buffer);
+    uint_counter++;
+    uint_index = 0;
+}
+
+}      // NAMESPACE SUSA
@@ -0,0 +1,229 @@
+/*
+ * This file is part of Susa.
+ *
+ * Susa is free software: you can redistribute it and/or modify
+ * it under the terms of the Lesser GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * at your option) any later version.
+ *
+ * Susa is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * Lesser GNU General Public License for more details.
+ *
+ * You should have received a copy of the Lesser GNU General Public License
+ * along with Susa.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file profile.cpp
+ * @brief Scoped timers and counters of the hot paths (definition).
+ * @author Behrooz Kamary
+ * @version 1.0.0
+ */
+
+#include <susa.h>
+#include <atomic>
+#include <iomanip>
+#include <map>
+#include <mutex>
+
+namespace susa {
+
+// the counters of a site, written by the owner thread and read by the reports
+struct profile_counter
+{
+    std::atomic <uint64_t> uint_calls;
+    std::atomic <uint64_t> uint_nanos;
+    std::atomic <uint64_t> uint_allocs;
+    std::atomic <uint64_t> uint_bytes;
+};
+
+struct profile_table;
+
+struct profile_registry
+{
+    std::mutex                          mtx;
+    std::map <std::string, size_t>      map_ids;
+    std::vector <std::string>           vec_names;
+    std::vector <profile_table*>        vec_tables;
+    std::vector <profile_record>        vec_retired;
+};
+
+static profile_registry& registry()
+{
+    static profile_registry reg;
+    return reg;
+}
+
+// the table of a thread, its totals are kept by the registry when the thread exits
+struct profile_table
+{
+    profile_counter counters[PROFILE_MAX_SITES];
+
+    profile_table()
+    {
+        clear();
+        profile_registry& reg = registry();
+        std::lock_guard <std::mutex> lock(reg.mtx);
+        reg.vec_tables.push_back(this);
+    }
+
+    ~profile_table()
+    {
+        profile_registry& reg = registry();
+        std::lock_guard <std::mutex> lock(reg.mtx);
+        add_to(reg.vec_retired);
+        reg.vec_tables.erase(std::find(reg.vec_tables.begin(), reg.vec_tables.end(), this));
+    }
+
+    void clear()
+    {
+        for (size_t sizet_id = 0; sizet_id < PROFILE_MAX_SITES; sizet_id++)
+        {
+            counters[sizet_id].uint_calls.store(0, std::memory_order_relaxed);
+            counters[sizet_id].uint_nanos.store(0, std::memory_order_relaxed);
+            counters[sizet_id].uint_allocs.store(0, std::memory_order_relaxed);
+            counters[sizet_id].uint_bytes.store(0, std::memory_order_relaxed);
+        }
+    }
+
+    void add_to(std::vector <profile_record>& vec_records) const
+    {
+        for (size_t sizet_id = 0; sizet_id < vec_records.size(); sizet_id++)
+        {
+            vec_records[sizet_id].uint_calls  += counters[sizet_id].uint_calls.load(std::memory_order_relaxed);
+            vec_records[sizet_id].uint_nanos  += counters[sizet_id].uint_nanos.load(std::memory_order_relaxed);
+            vec_records[sizet_id].uint_allocs += counters[sizet_id].uint_allocs.load(std::memory_order_relaxed);
+            vec_records[sizet_id].uint_bytes  += counters[sizet_id].uint_bytes.load(std::memory_order_relaxed);
+        }
+    }
+};
+
+static profile_table& thread_table()
+{
+    static thread_local profile_table table;
+    return table;
+}
+
+// the running allocation totals of the calling thread
+static thread_local uint64_t uint_thread_allocs = 0;
+static thread_local uint64_t uint_thread_bytes  = 0;
+
+profile_site::profile_site(const char* char_name)
+{
+    profile_registry& reg = registry();
+    std::lock_guard <std::mutex> lock(reg.mtx);
+
+    std::map <std::string, size_t>::const_iterator it = reg.map_ids.find(char_name);
+    if (it != reg.map_ids.end())
+    {
+        sizet_id = it->second;
+        return;
+    }
+
+    SUSA_ASSERT_MESSAGE(reg.vec_names.size() < PROFILE_MAX_SITES, "too many profiling sites, the new ones are ignored.");
+    if (reg.vec_names.size() >= PROFILE_MAX_SITES)
+    {
+        sizet_id = PROFILE_MAX_SITES;
+        return;
+    }
+
+    sizet_id = reg.vec_names.size();
+    reg.map_ids[char_name] = sizet_id;
+    reg.vec_names.push_back(char_name);
+
+    profile_record record = {char_name, 0, 0, 0, 0};
+    reg.vec_retired.push_back(record);
+}
+
+profile_scope::profile_scope(const profile_site& site)
+: sizet_id(site.id())
+, uint_allocs(uint_thread_allocs)
+, uint_bytes(uint_thread_bytes)
+, tp_start(clock::now())
+{
+}
+
+profile_scope::~profile_scope()
+{
+    clock::time_point tp_end = clock::now();
+    if (sizet_id >= PROFILE_MAX_SITES) return;
+
+    profile_counter& counter = thread_table().counters[sizet_id];
+    counter.uint_calls.fetch_add(1, std::memory_order_relaxed);
+    counter.uint_nanos.fetch_add(std::chrono::duration_cast <std::chrono::nanoseconds> (tp_end - tp_start).count(),
+                                 std::memory_order_relaxed);
+    counter.uint_allocs.fetch_add(uint_thread_allocs - uint_allocs, std::memory_order_relaxed);
+    counter.uint_bytes.fetch_add(uint_thread_bytes - uint_bytes, std::memory_order_relaxed);
+}
+
+void profile_count(const profile_site& site, uint64_t uint_value)
+{
+    if (site.id() >= PROFILE_MAX_SITES) return;
+    thread_table().counters[site.id()].uint_calls.fetch_add(uint_value, std::memory_order_relaxed);
+}
+
+void profile_allocation(size_t sizet_bytes)
+{
+    uint_thread_allocs++;
+    uint_thread_bytes += sizet_bytes;
+}
+
+std::vector <profile_record> profile_report()
+{
+    profile_registry& reg = registry();
+    std::lock_guard <std::mutex> lock(reg.mtx);
+
+    std::vector <profile_record> vec_records = reg.vec_retired;
+    for (size_t sizet_t = 0; sizet_t < reg.vec_tables.size(); sizet_t++) reg.vec_tables[sizet_t]->add_to(vec_records);
+
+    std::vector <profile_record> vec_ret;
+    for (size_t sizet_id = 0; sizet_id < vec_records.size(); sizet_id++)
+    {
+        if (vec_records[sizet_id].uint_calls > 0) vec_ret.push_back(vec_records[sizet_id]);
+    }
+
+    return vec_ret;
+}
+
+void profile_print(std::ostream& os)
+{
+    std::vector <profile_record> vec_records = profile_report();
+    std::stable_sort(vec_records.begin(), vec_records.end(), [](const profile_record& rec_a, const profile_record& rec_b)
+    {
+        return rec_a.uint_nanos > rec_b.uint_nanos;
+    });
+
+    os << std::left << std::setw(28) << "scope" << std::right << std::setw(12) << "calls" << std::setw(14) << "total [ms]"
+       << std::setw(14) << "average [us]" << std::setw(12) << "allocs" << std::setw(14) << "bytes" << std::endl;
+
+    for (size_t sizet_i = 0; sizet_i < vec_records.size(); sizet_i++)
+    {
+        const profile_record& record = vec_records[sizet_i];
+        os << std::left << std::setw(28) << record.str_name << std::right << std::setw(12) << record.uint_calls << std::fixed
+           << std::setprecision(3) << std::setw(14) << record.total() * 1e3 << std::setw(14) << record.average() * 1e6
+           << std::setw(12) << record.uint_allocs << std::setw(14) << record.uint_bytes << std::endl;
+        os.unsetf(std::ios::fixed);
+    }
+
+    os << std::setprecision(6);
+}
+
+void profile_reset()
+{
+    profile_registry& reg = registry();
+    std::lock_guard <std::mutex> lock(reg.mtx);
+
+    for (size_t sizet_id = 0; sizet_id < reg.vec_retired.size(); sizet_id++)
+    {
+        reg.vec_retired[sizet_id].uint_calls  = 0;
+        reg.vec_retired[sizet_id].uint_nanos  = 0;
+        reg.vec_retired[sizet_id].uint_allocs = 0;
+        reg.vec_retired[sizet_id].uint_bytes  = 0;
+    }
+
+    for (size_t sizet_t = 0; sizet_t < reg.vec_tables.size(); sizet_t++) reg.vec_tables[sizet_t]->clear();
+}
+
+}      // NAMESPACE SUSA
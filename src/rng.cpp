@@ -41,6 +41,11 @@ rng::rng(unsigned int uint_seed)
     init(uint_seed);
 }
 
+rng::rng(unsigned int uint_seed, uint64_t uint_stream)
+{
+    init(uint_seed, uint_stream);
+}
+
 
 unsigned int rng::rand_mask(unsigned int uint_mask)
 {
@@ -94,25 +99,14 @@ double rng::randn()
 matrix <double> rng::rand(unsigned int uint_num)
 {
     matrix <double> mat_ret(uint_num, 1);
-
-    for (unsigned int i = 0; i < uint_num; i++)
-    {
-        mat_ret(i) = (double)extract_number() / std::numeric_limits<uint32_t>::max();
-    }
-
+    fill_uniform(mat_ret);
     return mat_ret;
 }
 
 matrix <double> rng::rand(unsigned int uint_rows, unsigned int uint_cols)
 {
     matrix <double> mat_ret(uint_rows, uint_cols);
-    unsigned int uint_size = mat_ret.size();
-
-    for (unsigned int i = 0; i < uint_size; i++)
-    {
-        mat_ret(i) = (double)extract_number() / std::numeric_limits<uint32_t>::max();
-    }
-
+    fill_uniform(mat_ret);
     return mat_ret;
 }
 
@@ -152,6 +146,42 @@ void rng::init(unsigned int uint_seed)
     }
 }
 
+void rng::init(unsigned int uint_seed, uint64_t uint_stream)
+{
+    // init_by_array() of the reference MT19937 with the key (seed, stream)
+    const uint32_t uint_key[3] = {uint_seed, static_cast <uint32_t> (uint_stream), static_cast <uint32_t> (uint_stream >> 32)};
+    const uint32_t uint_len    = 3;
+
+    init(19650218u);
+
+    uint32_t i = 1, j = 0;
+    for (uint32_t k = N; k; k--)
+    {
+        MT[i] = (MT[i] ^ ((MT[i - 1] ^ (MT[i - 1] >> 30)) * 1664525u)) + uint_key[j] + j;
+        i++;
+        j++;
+        if (i >= N)
+        {
+            MT[0] = MT[N - 1];
+            i = 1;
+        }
+        if (j >= uint_len) j = 0;
+    }
+    for (uint32_t k = N - 1; k; k--)
+    {
+        MT[i] = (MT[i] ^ ((MT[i - 1] ^ (MT[i - 1] >> 30)) * 1566083941u)) - i;
+        i++;
+        if (i >= N)
+        {
+            MT[0] = MT[N - 1];
+            i = 1;
+        }
+    }
+
+    MT[0]      = 0x80000000u;
+    uint_index = N;
+}
+
 unsigned int rng::GetNonUniform(double* pr, unsigned int n)
 {
 
@@ -195,20 +225,225 @@ matrix <unsigned char> rng::bernoulli(size_t size_num)
     return mat_ret;
  }
 
+bitvec rng::bernoulli_packed(size_t sizet_num)
+{
+    bitvec bv_ret(sizet_num);
+    fill_bits(bv_ret);
+    return bv_ret;
+}
+
+void rng::fill_bits(bitvec& bv_arg)
+{
+    const size_t sizet_block = 256;
+    uint32_t  uint_buffer[sizet_block];
+    uint64_t* ptr_out     = bv_arg.data();
+    size_t    sizet_bits  = bv_arg.no_bits();
+    size_t    sizet_words = bv_arg.no_words();
+
+    for (size_t sizet_first = 0; sizet_first < sizet_words; sizet_first += sizet_block / 2)
+    {
+        size_t sizet_num = std::min(sizet_block / 2, sizet_words - sizet_first);
+        fill_uint(uint_buffer, 2 * sizet_num);
+
+        for (size_t sizet_i = 0; sizet_i < sizet_num; sizet_i++)
+        {
+            uint64_t uint_word = uint_buffer[2 * sizet_i] | (static_cast <uint64_t> (uint_buffer[2 * sizet_i + 1]) << 32);
+
+            if (sizet_first + sizet_i + 1 < sizet_words || (sizet_bits & 63) == 0)
+            {
+                ptr_out[sizet_first + sizet_i] = uint_word;
+            }
+            else
+            {
+                // the unused bits of the last word stay zero
+                bv_arg.set_bits((sizet_first + sizet_i) * 64, uint_word, sizet_bits & 63);
+            }
+        }
+    }
+}
+
+
+// The 128 layers of the Ziggurat of Marsaglia and Tsang (2000)
+namespace
+{
+struct ziggurat
+{
+    uint32_t kn[128];
+    double   wn[128];
+    double   fn[128];
+
+    ziggurat()
+    {
+        const double dbl_m1 = 2147483648.0;
+        const double dbl_vn = 9.91256303526217e-3;
+        double dbl_dn = 3.442619855899;
+        double dbl_tn = dbl_dn;
+        double dbl_q  = dbl_vn / std::exp(-0.5 * dbl_dn * dbl_dn);
+
+        kn[0]   = static_cast <uint32_t> ((dbl_dn / dbl_q) * dbl_m1);
+        kn[1]   = 0;
+        wn[0]   = dbl_q / dbl_m1;
+        wn[127] = dbl_dn / dbl_m1;
+        fn[0]   = 1.0;
+        fn[127] = std::exp(-0.5 * dbl_dn * dbl_dn);
+
+        for (int int_i = 126; int_i >= 1; int_i--)
+        {
+            dbl_dn          = std::sqrt(-2.0 * std::log(dbl_vn / dbl_dn + std::exp(-0.5 * dbl_dn * dbl_dn)));
+            kn[int_i + 1]   = static_cast <uint32_t> ((dbl_dn / dbl_tn) * dbl_m1);
+            dbl_tn          = dbl_dn;
+            fn[int_i]       = std::exp(-0.5 * dbl_dn * dbl_dn);
+            wn[int_i]       = dbl_dn / dbl_m1;
+        }
+    }
+};
+
+const ziggurat& ziggurat_tables()
+{
+    static const ziggurat zig;
+    return zig;
+}
+}
+
+void rng::fill_uniform(matrix <double>& mat_arg)
+{
+    const size_t sizet_block = 256;
+    uint32_t uint_buffer[sizet_block];
+    double*  ptr_out = mat_arg.data();
+    size_t   sizet_size = mat_arg.size();
+
+    for (size_t sizet_first = 0; sizet_first < sizet_size; sizet_first += sizet_block)
+    {
+        size_t sizet_num = std::min(sizet_block, sizet_size - sizet_first);
+        fill_uint(uint_buffer, sizet_num);
+        for (size_t sizet_i = 0; sizet_i < sizet_num; sizet_i++)
+        {
+            ptr_out[sizet_first + sizet_i] = (double)uint_buffer[sizet_i] / std::numeric_limits<uint32_t>::max();
+        }
+    }
+}
+
+void rng::fill_uniform(matrix <float>& mat_arg)
+{
+    const size_t sizet_block = 256;
+    uint32_t uint_buffer[sizet_block];
+    float*   ptr_out = mat_arg.data();
+    size_t   sizet_size = mat_arg.size();
+
+    for (size_t sizet_first = 0; sizet_first < sizet_size; sizet_first += sizet_block)
+    {
+        size_t sizet_num = std::min(sizet_block, sizet_size - sizet_first);
+        fill_uint(uint_buffer, sizet_num);
+        for (size_t sizet_i = 0; sizet_i < sizet_num; sizet_i++)
+        {
+            ptr_out[sizet_first + sizet_i] = (float)((double)uint_buffer[sizet_i] / std::numeric_limits<uint32_t>::max());
+        }
+    }
+}
+
+void rng::fill_normal(matrix <double>& mat_arg)
+{
+    fill_normal(mat_arg.data(), mat_arg.size(), 1, 1.0);
+}
+
+void rng::fill_complex_normal(matrix <std::complex <double> >& mat_arg, double dbl_sigma)
+{
+    // std::complex <double> is laid out as two doubles
+    fill_normal(reinterpret_cast <double*> (mat_arg.data()), 2 * mat_arg.size(), 1, dbl_sigma);
+}
 
 // Private methods
+
+void rng::fill_normal(double* ptr_out, size_t sizet_num, size_t sizet_stride, double dbl_sigma)
+{
+    const ziggurat& zig = ziggurat_tables();
+    const double dbl_r  = 3.442620;
+    const size_t sizet_block = 256;
+    uint32_t uint_buffer[sizet_block];
+
+    for (size_t sizet_first = 0; sizet_first < sizet_num; sizet_first += sizet_block)
+    {
+        size_t sizet_len = std::min(sizet_block, sizet_num - sizet_first);
+        fill_uint(uint_buffer, sizet_len);
+
+        for (size_t sizet_i = 0; sizet_i < sizet_len; sizet_i++)
+        {
+            int32_t  int_hz = static_cast <int32_t> (uint_buffer[sizet_i]);
+            uint32_t uint_iz = uint_buffer[sizet_i] & 127;
+            double   dbl_x;
+
+            // the fast path: the sample falls inside the rectangle of its layer
+            if (static_cast <uint32_t> (std::abs(static_cast <int64_t> (int_hz))) < zig.kn[uint_iz])
+            {
+                dbl_x = int_hz * zig.wn[uint_iz];
+            }
+            else
+            {
+                while (true)
+                {
+                    dbl_x = int_hz * zig.wn[uint_iz];
+
+                    // the base layer samples the tail beyond r
+                    if (uint_iz == 0)
+                    {
+                        double dbl_y;
+                        do
+                        {
+                            dbl_x = -std::log((extract_number() + 0.5) / 4294967296.0) / dbl_r;
+                            dbl_y = -std::log((extract_number() + 0.5) / 4294967296.0);
+                        } while (dbl_y + dbl_y < dbl_x * dbl_x);
+                        dbl_x = int_hz > 0 ? dbl_r + dbl_x : -dbl_r - dbl_x;
+                        break;
+                    }
+
+                    // the wedge of the layer
+                    double dbl_u = (extract_number() + 0.5) / 4294967296.0;
+                    if (zig.fn[uint_iz] + dbl_u * (zig.fn[uint_iz - 1] - zig.fn[uint_iz]) < std::exp(-0.5 * dbl_x * dbl_x)) break;
+
+                    uint32_t uint_draw = extract_number();
+                    int_hz  = static_cast <int32_t> (uint_draw);
+                    uint_iz = uint_draw & 127;
+                    if (static_cast <uint32_t> (std::abs(static_cast <int64_t> (int_hz))) < zig.kn[uint_iz])
+                    {
+                        dbl_x = int_hz * zig.wn[uint_iz];
+                        break;
+                    }
+                }
+            }
+
+            ptr_out[(sizet_first + sizet_i) * sizet_stride] = dbl_sigma * dbl_x;
+        }
+    }
+}
+
 void rng::generate_numbers()
 {
+    // the wrap-around of (indx + 1) % N and (indx + M) % N split in three loops
     uint32_t x;
-    for (uint32_t indx = 0; indx < N; indx++)
+    uint32_t indx = 0;
+    for (; indx < N - M; indx++)
     {
-        x = (MT[indx] & MASK_UPPER) + ((MT[(indx + 1) % N]) & MASK_LOWER);
-
-        if ((x & 0x01) == 0)  MT[indx] = MT[(indx + M) % N] ^ (x >> 1);
-        else  MT[indx] = MT[(indx + M) % N] ^ (x >> 1) ^ A;
+        x = (MT[indx] & MASK_UPPER) + (MT[indx + 1] & MASK_LOWER);
+        MT[indx] = MT[indx + M] ^ (x >> 1) ^ ((0u - (x & 0x01)) & static_cast <uint32_t> (A));
     }
+    for (; indx < N - 1; indx++)
+    {
+        x = (MT[indx] & MASK_UPPER) + (MT[indx + 1] & MASK_LOWER);
+        MT[indx] = MT[indx + M - N] ^ (x >> 1) ^ ((0u - (x & 0x01)) & static_cast <uint32_t> (A));
+    }
+    x = (MT[N - 1] & MASK_UPPER) + (MT[0] & MASK_LOWER);
+    MT[N - 1] = MT[M - 1] ^ (x >> 1) ^ ((0u - (x & 0x01)) & static_cast <uint32_t> (A));
 }
 
+// the output transformation of the generator
+static inline uint32_t rng_temper(uint32_t x)
+{
+    x = x ^ (x  >> rng::U);
+    x = x ^ ((x << rng::S)  & rng::B);
+    x = x ^ ((x << rng::T)  ^ rng::C);
+    x = x ^ (x  >> rng::L);
+    return x;
+}
 
 unsigned int rng::extract_number()
 {
@@ -218,12 +453,27 @@ unsigned int rng::extract_number()
         uint_index = 0;
     }
 
-    uint32_t x = MT[uint_index++];
-    x = x ^ (x  >> U);
-    x = x ^ ((x << S)  & B);
-    x = x ^ ((x << T)  ^ C);
-    x = x ^ (x  >> L);
-    return x;
+    return rng_temper(MT[uint_index++]);
+}
+
+void rng::fill_uint(uint32_t* ptr_out, size_t sizet_num)
+{
+    while (sizet_num > 0)
+    {
+        if (uint_index >= N)
+        {
+            generate_numbers();
+            uint_index = 0;
+        }
+
+        size_t sizet_len = std::min <size_t> (sizet_num, N - uint_index);
+        const uint32_t* ptr_state = MT + uint_index;
+        for (size_t sizet_i = 0; sizet_i < sizet_len; sizet_i++) ptr_out[sizet_i] = rng_temper(ptr_state[sizet_i]);
+
+        uint_index += sizet_len;
+        ptr_out    += sizet_len;
+        sizet_num  -= sizet_len;
+    }
 }
 
 }
@@ -0,0 +1,43 @@
+/*
+ * This file is part of Susa.
+ *
+ * Susa is free software: you can redistribute it and/or modify
+ * it under the terms of the Lesser GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * at your option) any later version.
+ *
+ * Susa is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * Lesser GNU General Public License for more details.
+ *
+ * You should have received a copy of the Lesser GNU General Public License
+ * along with Susa.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file signal.cpp
+ * @brief Signal processing (definition).
+ *
+ * @author Behrooz Kamary
+ * @version 1.0.0
+ */
+
+#include <atomic>
+#include <susa.h>
+
+namespace susa {
+
+static std::atomic <size_t> sizet_fft_conv_threshold(64);
+
+void set_fft_conv_threshold(size_t sizet_threshold)
+{
+    sizet_fft_conv_threshold = sizet_threshold;
+}
+
+size_t get_fft_conv_threshold()
+{
+    return sizet_fft_conv_threshold;
+}
+
+} // NAMESPACE SUSA
@@ -62,7 +62,7 @@ int svd(const matrix <float> &mat_arg_a,
     int n = mat_arg_a.no_cols();
     int p = (m > n)?n:m;
 
-    int flag, i, its, j, jj, k, l, nm;
+    int flag, i, its, j, jj, k, l, nm = 0;
     double c, f, h, s, x, y, z;
     double anorm = 0.0, g = 0.0, scale = 0.0;
     matrix <double> rv1(n, 1);
@@ -326,4 +326,213 @@ int svd(const matrix <float> &mat_arg_a,
     return 0;
 }
 
+// One-sided Jacobi SVD
+
+/*
+ * The rotation of the columns p and q of W (and V) that makes them orthogonal.
+ * With gamma = w_p^H w_q = |gamma| e, the real Jacobi rotation (c, s) of the pair
+ * (w_p, conj(e) w_q) is applied and the phase e is restored on the second column.
+ */
+template <class T> static bool svd_rotate(T* ptr_p, T* ptr_q, size_t sizet_m, T* ptr_vp, T* ptr_vq, size_t sizet_n)
+{
+    const double dbl_eps = std::numeric_limits <double>::epsilon();
+
+    double dbl_alpha = 0;
+    double dbl_beta  = 0;
+    T      T_gamma   = T(0);
+
+    for (size_t sizet_i = 0; sizet_i < sizet_m; sizet_i++)
+    {
+        dbl_alpha += std::norm(ptr_p[sizet_i]);
+        dbl_beta  += std::norm(ptr_q[sizet_i]);
+        T_gamma   += conjugate(ptr_p[sizet_i]) * ptr_q[sizet_i];
+    }
+
+    double dbl_gamma = std::abs(T_gamma);
+    if (dbl_gamma <= sizet_m * dbl_eps * std::sqrt(dbl_alpha * dbl_beta) || dbl_gamma == 0) return false;
+
+    double dbl_zeta = (dbl_beta - dbl_alpha) / (2 * dbl_gamma);
+    double dbl_t    = (dbl_zeta >= 0 ? 1.0 : -1.0) / (std::abs(dbl_zeta) + std::sqrt(1 + dbl_zeta * dbl_zeta));
+    double dbl_c    = 1 / std::sqrt(1 + dbl_t * dbl_t);
+    double dbl_s    = dbl_c * dbl_t;
+
+    const T T_e   = T_gamma / T(dbl_gamma);
+    const T T_spq = T(dbl_s) * conjugate(T_e);
+    const T T_sqp = T(dbl_s) * T_e;
+
+    for (size_t sizet_i = 0; sizet_i < sizet_m; sizet_i++)
+    {
+        T T_p = ptr_p[sizet_i];
+        T T_q = ptr_q[sizet_i];
+        ptr_p[sizet_i] = dbl_c * T_p - T_spq * T_q;
+        ptr_q[sizet_i] = T_sqp * T_p + dbl_c * T_q;
+    }
+
+    if (ptr_vp == nullptr) return true;
+
+    for (size_t sizet_i = 0; sizet_i < sizet_n; sizet_i++)
+    {
+        T T_p = ptr_vp[sizet_i];
+        T T_q = ptr_vq[sizet_i];
+        ptr_vp[sizet_i] = dbl_c * T_p - T_spq * T_q;
+        ptr_vq[sizet_i] = T_sqp * T_p + dbl_c * T_q;
+    }
+
+    return true;
+}
+
+//! the sweeps over the columns of W, the vectors are accumulated in V if it is not null
+template <class T> static int svd_jacobi(matrix <T>& mat_w, matrix <T>* ptr_mat_v)
+{
+    const size_t sizet_m      = mat_w.no_rows();
+    const size_t sizet_n      = mat_w.no_cols();
+    const size_t sizet_sweeps = 60;
+
+    // the round-robin tournament of an even number of players (a dummy one for odd n)
+    size_t sizet_players = sizet_n + (sizet_n % 2);
+    size_t sizet_pairs   = sizet_players / 2;
+    std::vector <size_t> vec_order(sizet_players);
+    std::vector <char>   vec_rotated(sizet_pairs);
+    for (size_t sizet_i = 0; sizet_i < sizet_players; sizet_i++) vec_order[sizet_i] = sizet_i;
+
+    // enough pairs per task to pay off the scheduling
+    size_t sizet_grain = std::max <size_t> (1, 8192 / (sizet_m + (ptr_mat_v == nullptr ? 0 : sizet_n) + 1));
+
+    T* ptr_w = mat_w.data();
+    T* ptr_v = ptr_mat_v == nullptr ? nullptr : ptr_mat_v->data();
+
+    for (size_t sizet_sweep = 0; sizet_sweep < sizet_sweeps; sizet_sweep++)
+    {
+        size_t sizet_rotations = 0;
+
+        for (size_t sizet_round = 0; sizet_round + 1 < sizet_players; sizet_round++)
+        {
+            parallel_for(0, sizet_pairs, sizet_grain, [&](size_t sizet_first, size_t sizet_last)
+            {
+                for (size_t sizet_k = sizet_first; sizet_k < sizet_last; sizet_k++)
+                {
+                    size_t sizet_p = std::min(vec_order[sizet_k], vec_order[sizet_players - 1 - sizet_k]);
+                    size_t sizet_q = std::max(vec_order[sizet_k], vec_order[sizet_players - 1 - sizet_k]);
+                    vec_rotated[sizet_k] = 0;
+                    if (sizet_q >= sizet_n) continue;
+
+                    vec_rotated[sizet_k] = svd_rotate(ptr_w + sizet_p * sizet_m, ptr_w + sizet_q * sizet_m, sizet_m,
+                        ptr_v == nullptr ? nullptr : ptr_v + sizet_p * sizet_n,
+                        ptr_v == nullptr ? nullptr : ptr_v + sizet_q * sizet_n, sizet_n);
+                }
+            });
+
+            for (size_t sizet_k = 0; sizet_k < sizet_pairs; sizet_k++) sizet_rotations += vec_rotated[sizet_k];
+
+            // the first player stays and the others move one seat
+            std::rotate(vec_order.begin() + 1, vec_order.end() - 1, vec_order.end());
+        }
+
+        if (sizet_rotations == 0) return 0;
+    }
+
+    return 1;
+}
+
+//! the decomposition of a matrix with at least as many rows as columns
+template <class T> static int svd_tall(const matrix <T>& mat_a, matrix <T>* ptr_mat_u, matrix <double>& mat_s, matrix <T>* ptr_mat_v)
+{
+    const size_t sizet_m = mat_a.no_rows();
+    const size_t sizet_n = mat_a.no_cols();
+
+    matrix <T> mat_w = mat_a;
+    matrix <T> mat_v;
+    if (ptr_mat_v != nullptr)
+    {
+        mat_v = matrix <T> (sizet_n, sizet_n, T(0));
+        for (size_t sizet_i = 0; sizet_i < sizet_n; sizet_i++) mat_v(sizet_i, sizet_i) = T(1);
+    }
+
+    int int_ret = svd_jacobi(mat_w, ptr_mat_v == nullptr ? nullptr : &mat_v);
+
+    // the singular values are the norms of the orthogonal columns
+    std::vector <double> vec_s(sizet_n, 0);
+    std::vector <size_t> vec_index(sizet_n);
+    for (size_t sizet_j = 0; sizet_j < sizet_n; sizet_j++)
+    {
+        for (size_t sizet_i = 0; sizet_i < sizet_m; sizet_i++) vec_s[sizet_j] += std::norm(mat_w(sizet_i, sizet_j));
+        vec_s[sizet_j]     = std::sqrt(vec_s[sizet_j]);
+        vec_index[sizet_j] = sizet_j;
+    }
+
+    std::stable_sort(vec_index.begin(), vec_index.end(), [&](size_t sizet_a, size_t sizet_b)
+    {
+        return vec_s[sizet_a] > vec_s[sizet_b];
+    });
+
+    mat_s = matrix <double> (sizet_n, 1);
+    for (size_t sizet_j = 0; sizet_j < sizet_n; sizet_j++) mat_s(sizet_j) = vec_s[vec_index[sizet_j]];
+
+    if (ptr_mat_u != nullptr)
+    {
+        // the columns of a zero singular value are left zero
+        *ptr_mat_u = matrix <T> (sizet_m, sizet_n, T(0));
+        for (size_t sizet_j = 0; sizet_j < sizet_n; sizet_j++)
+        {
+            double dbl_s = vec_s[vec_index[sizet_j]];
+            if (dbl_s == 0) continue;
+            for (size_t sizet_i = 0; sizet_i < sizet_m; sizet_i++)
+            {
+                (*ptr_mat_u)(sizet_i, sizet_j) = mat_w(sizet_i, vec_index[sizet_j]) / T(dbl_s);
+            }
+        }
+    }
+
+    if (ptr_mat_v != nullptr)
+    {
+        *ptr_mat_v = matrix <T> (sizet_n, sizet_n);
+        for (size_t sizet_j = 0; sizet_j < sizet_n; sizet_j++)
+        {
+            for (size_t sizet_i = 0; sizet_i < sizet_n; sizet_i++) (*ptr_mat_v)(sizet_i, sizet_j) = mat_v(sizet_i, vec_index[sizet_j]);
+        }
+    }
+
+    return int_ret;
+}
+
+template <class T> static int svd_jacobi(const matrix <T>& mat_a, matrix <T>* ptr_mat_u, matrix <double>& mat_s, matrix <T>* ptr_mat_v)
+{
+    if (mat_a.size() == 0) return 0;
+
+    // A^H = V S U^H for a wide matrix
+    if (mat_a.no_rows() < mat_a.no_cols()) return svd_tall(ctranspose(mat_a), ptr_mat_v, mat_s, ptr_mat_u);
+
+    return svd_tall(mat_a, ptr_mat_u, mat_s, ptr_mat_v);
+}
+
+int svd(const matrix <double> &mat_arg_a,
+              matrix <double> &mat_arg_u,
+              matrix <double> &mat_arg_s,
+              matrix <double> &mat_arg_v)
+{
+    return svd_jacobi(mat_arg_a, &mat_arg_u, mat_arg_s, &mat_arg_v);
+}
+
+int svd(const matrix <std::complex <double> > &mat_arg_a,
+              matrix <std::complex <double> > &mat_arg_u,
+              matrix <double> &mat_arg_s,
+              matrix <std::complex <double> > &mat_arg_v)
+{
+    return svd_jacobi(mat_arg_a, &mat_arg_u, mat_arg_s, &mat_arg_v);
+}
+
+matrix <double> singular_values(const matrix <double> &mat_arg_a)
+{
+    matrix <double> mat_s;
+    svd_jacobi <double> (mat_arg_a, nullptr, mat_s, nullptr);
+    return mat_s;
+}
+
+matrix <double> singular_values(const matrix <std::complex <double> > &mat_arg_a)
+{
+    matrix <double> mat_s;
+    svd_jacobi <std::complex <double> > (mat_arg_a, nullptr, mat_s, nullptr);
+    return mat_s;
+}
+
 } // NAMESPACE SUSA
@@ -0,0 +1,164 @@
+/*
+ * This file is part of Susa.
+ *
+ * Susa is free software: you can redistribute it and/or modify
+ * it under the terms of the Lesser GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * at your option) any later version.
+ *
+ * Susa is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * Lesser GNU General Public License for more details.
+ *
+ * You should have received a copy of the Lesser GNU General Public License
+ * along with Susa.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file thread.cpp
+ * @brief A thread pool and parallel loops (definition).
+ * @author Behrooz Kamary
+ * @version 1.0.0
+ */
+
+#include <memory>
+#include <susa.h>
+
+namespace susa {
+
+// true on the worker threads of any pool and while the caller runs a job
+static thread_local bool bool_in_job = false;
+
+thread_pool::thread_pool(size_t sizet_threads)
+: ptr_func(nullptr)
+, sizet_tasks(0)
+, sizet_next(0)
+, sizet_busy(0)
+, sizet_generation(0)
+, bool_stop(false)
+{
+    if (sizet_threads == 0) sizet_threads = std::thread::hardware_concurrency();
+    if (sizet_threads == 0) sizet_threads = 1;
+
+    for (size_t sizet_i = 1; sizet_i < sizet_threads; sizet_i++)
+    {
+        vec_workers.push_back(std::thread(&thread_pool::worker, this));
+    }
+}
+
+thread_pool::~thread_pool()
+{
+    {
+        std::lock_guard <std::mutex> lock(mutex_state);
+        bool_stop = true;
+    }
+
+    cv_start.notify_all();
+
+    for (size_t sizet_i = 0; sizet_i < vec_workers.size(); sizet_i++)
+    {
+        vec_workers[sizet_i].join();
+    }
+}
+
+size_t thread_pool::size() const
+{
+    return vec_workers.size() + 1;
+}
+
+void thread_pool::execute()
+{
+    size_t sizet_task;
+    while ((sizet_task = sizet_next.fetch_add(1)) < sizet_tasks)
+    {
+        (*ptr_func)(sizet_task);
+    }
+}
+
+void thread_pool::worker()
+{
+    bool_in_job = true;
+    size_t sizet_seen = 0;
+
+    while (true)
+    {
+        {
+            std::unique_lock <std::mutex> lock(mutex_state);
+            cv_start.wait(lock, [&]{ return bool_stop || sizet_generation != sizet_seen; });
+            if (bool_stop) return;
+            sizet_seen = sizet_generation;
+        }
+
+        execute();
+
+        {
+            std::lock_guard <std::mutex> lock(mutex_state);
+            sizet_busy--;
+        }
+
+        cv_done.notify_one();
+    }
+}
+
+void thread_pool::run(size_t sizet_num, const std::function <void (size_t)>& func)
+{
+    if (sizet_num == 0) return;
+
+    if (vec_workers.empty() || sizet_num == 1 || bool_in_job)
+    {
+        for (size_t sizet_task = 0; sizet_task < sizet_num; sizet_task++) func(sizet_task);
+        return;
+    }
+
+    // one job at a time; concurrent callers queue here
+    std::lock_guard <std::mutex> lock_job(mutex_job);
+
+    {
+        std::lock_guard <std::mutex> lock(mutex_state);
+        ptr_func    = &func;
+        sizet_tasks = sizet_num;
+        sizet_next  = 0;
+        sizet_busy  = vec_workers.size();
+        sizet_generation++;
+    }
+
+    cv_start.notify_all();
+
+    bool_in_job = true;
+    execute();
+    bool_in_job = false;
+
+    std::unique_lock <std::mutex> lock(mutex_state);
+    cv_done.wait(lock, [&]{ return sizet_busy == 0; });
+    ptr_func = nullptr;
+}
+
+static std::unique_ptr <thread_pool>& default_pool()
+{
+    static std::unique_ptr <thread_pool> ptr_pool;
+    return ptr_pool;
+}
+
+static std::mutex mutex_default_pool;
+
+thread_pool& get_thread_pool()
+{
+    std::lock_guard <std::mutex> lock(mutex_default_pool);
+    std::unique_ptr <thread_pool>& ptr_pool = default_pool();
+    if (!ptr_pool) ptr_pool.reset(new thread_pool());
+    return *ptr_pool;
+}
+
+void set_num_threads(size_t sizet_threads)
+{
+    std::lock_guard <std::mutex> lock(mutex_default_pool);
+    default_pool().reset(new thread_pool(sizet_threads));
+}
+
+size_t get_num_threads()
+{
+    return get_thread_pool().size();
+}
+
+} // NAMESPACE SUSA
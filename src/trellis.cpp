@@ -0,0 +1,85 @@
+/*
+ * This file is part of Susa.
+ *
+ * Susa is free software: you can redistribute it and/or modify
+ * it under the terms of the Lesser GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * at your option) any later version.
+ *
+ * Susa is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * Lesser GNU General Public License for more details.
+ *
+ * You should have received a copy of the Lesser GNU General Public License
+ * along with Susa.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file trellis.cpp
+ * @brief Precomputed trellis tables (definition).
+ * @author Behrooz Kamary
+ * @version 1.0.0
+ */
+
+#include <susa.h>
+
+namespace susa
+{
+
+trellis::trellis()
+: uint_states(0)
+, uint_inputs(0)
+{
+}
+
+trellis::trellis(uint32_t uint_states, uint32_t uint_inputs, const std::vector <uint32_t>& vec_next,
+  const std::vector <uint32_t>& vec_labels)
+: uint_states(uint_states)
+, uint_inputs(uint_inputs)
+{
+    size_t sizet_trans = static_cast <size_t> (uint_states) * uint_inputs;
+
+    SUSA_ASSERT_MESSAGE(vec_next.size() == sizet_trans && vec_labels.size() == sizet_trans,
+      "the transition tables do not match the number of states and inputs.");
+    if (vec_next.size() != sizet_trans || vec_labels.size() != sizet_trans)
+    {
+        this->uint_states = 0;
+        this->uint_inputs = 0;
+        return;
+    }
+
+    // the input-major (SoA) layout
+    this->vec_next.resize(sizet_trans);
+    this->vec_labels.resize(sizet_trans);
+    for (uint32_t uint_s = 0; uint_s < uint_states; uint_s++)
+    {
+        for (uint32_t uint_p = 0; uint_p < uint_inputs; uint_p++)
+        {
+            this->vec_next[uint_p * uint_states + uint_s]   = vec_next[uint_s * uint_inputs + uint_p];
+            this->vec_labels[uint_p * uint_states + uint_s] = vec_labels[uint_s * uint_inputs + uint_p];
+        }
+    }
+
+    // the predecessors in the order of the source states
+    std::vector <uint32_t> vec_count(uint_states, 0);
+    vec_prev.assign(sizet_trans, 0);
+    vec_prev_inputs.assign(sizet_trans, 0);
+
+    for (uint32_t uint_s = 0; uint_s < uint_states; uint_s++)
+    {
+        for (uint32_t uint_p = 0; uint_p < uint_inputs; uint_p++)
+        {
+            uint32_t uint_to = vec_next[uint_s * uint_inputs + uint_p];
+            SUSA_ASSERT_MESSAGE(uint_to < uint_states && vec_count[uint_to] < uint_inputs,
+              "every state must have as many predecessors as inputs.");
+            if (uint_to >= uint_states || vec_count[uint_to] >= uint_inputs) continue;
+
+            uint32_t uint_k = vec_count[uint_to]++;
+            vec_prev[uint_k * uint_states + uint_to]        = uint_s;
+            vec_prev_inputs[uint_k * uint_states + uint_to] = uint_p;
+        }
+    }
+}
+
+}      // NAMESPACE SUSA
@@ -0,0 +1,163 @@
+/*
+ * This file is part of Susa.
+ *
+ * Susa is free software: you can redistribute it and/or modify
+ * it under the terms of the Lesser GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * at your option) any later version.
+ *
+ * Susa is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * Lesser GNU General Public License for more details.
+ *
+ * You should have received a copy of the Lesser GNU General Public License
+ * along with Susa.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file turbo.cpp
+ * @brief Parallel concatenated convolutional (turbo) codes (definition).
+ * @author Behrooz Kamary
+ * @version 1.0.0
+ */
+
+#include <susa.h>
+
+namespace susa
+{
+
+std::vector <uint32_t> random_interleaver(size_t sizet_len, unsigned int uint_seed)
+{
+    std::vector <uint32_t> vec_perm(sizet_len);
+    for (size_t sizet_i = 0; sizet_i < sizet_len; sizet_i++) vec_perm[sizet_i] = sizet_i;
+
+    // Fisher-Yates shuffle
+    rng rng_gen(uint_seed);
+    for (size_t sizet_i = sizet_len; sizet_i > 1; sizet_i--)
+    {
+        size_t sizet_j = std::min <size_t> (sizet_i - 1, static_cast <size_t> (rng_gen.rand() * sizet_i));
+        std::swap(vec_perm[sizet_i - 1], vec_perm[sizet_j]);
+    }
+
+    return vec_perm;
+}
+
+turbo::turbo(const ccode& code_1, const ccode& code_2, const std::vector <uint32_t>& vec_interleaver,
+  size_t sizet_iterations, ccode::bcjr_metric metric)
+: ptr_code_1(&code_1),
+  ptr_code_2(&code_2),
+  vec_interleaver(vec_interleaver),
+  sizet_max_iterations(sizet_iterations),
+  metric(metric),
+  bool_early(true),
+  sizet_iterations(0)
+{
+    SUSA_ASSERT_MESSAGE(code_1.uint_n > 0 && code_1.uint_n <= 8 && code_2.uint_n > 0 && code_2.uint_n <= 8,
+      "the number of outputs is not supported by the BCJR decoder.");
+
+    std::vector <bool> vec_seen(vec_interleaver.size(), false);
+    bool bool_valid = true;
+    for (size_t sizet_i = 0; sizet_i < vec_interleaver.size() && bool_valid; sizet_i++)
+    {
+        bool_valid = vec_interleaver[sizet_i] < vec_interleaver.size() && !vec_seen[vec_interleaver[sizet_i]];
+        if (bool_valid) vec_seen[vec_interleaver[sizet_i]] = true;
+    }
+
+    SUSA_ASSERT_MESSAGE(bool_valid, "the interleaver is not a permutation.");
+    if (!bool_valid) this->vec_interleaver.clear();
+}
+
+size_t turbo::no_coded() const
+{
+    return ptr_code_1->uint_n * stages(*ptr_code_1) + ptr_code_2->uint_n * stages(*ptr_code_2);
+}
+
+matrix <uint8_t> turbo::encode(const matrix <uint8_t>& mat_bits) const
+{
+    matrix <uint8_t> mat_ret;
+
+    const size_t sizet_len = vec_interleaver.size();
+    SUSA_ASSERT_MESSAGE(mat_bits.size() == sizet_len, "the frame length does not match the interleaver.");
+    if (mat_bits.size() != sizet_len || sizet_len == 0) return mat_ret;
+
+    // the tail bits are zeros
+    bitvec bv_1(stages(*ptr_code_1));
+    bitvec bv_2(stages(*ptr_code_2));
+    for (size_t sizet_i = 0; sizet_i < sizet_len; sizet_i++)
+    {
+        if (mat_bits(sizet_i) != 0) bv_1.set(sizet_i);
+        if (mat_bits(vec_interleaver[sizet_i]) != 0) bv_2.set(sizet_i);
+    }
+
+    bitvec bv_out_1 = ptr_code_1->encode(bv_1);
+    bitvec bv_out_2 = ptr_code_2->encode(bv_2);
+
+    mat_ret = matrix <uint8_t> (bv_out_1.no_bits() + bv_out_2.no_bits(), 1);
+    for (size_t sizet_i = 0; sizet_i < bv_out_1.no_bits(); sizet_i++) mat_ret(sizet_i) = bv_out_1.exists(sizet_i);
+    for (size_t sizet_i = 0; sizet_i < bv_out_2.no_bits(); sizet_i++) mat_ret(bv_out_1.no_bits() + sizet_i) = bv_out_2.exists(sizet_i);
+
+    return mat_ret;
+}
+
+matrix <uint8_t> turbo::decode(const matrix <double>& mat_arg, double dbl_ebn0)
+{
+    SUSA_PROFILE_SCOPE("turbo.decode");
+
+    sizet_iterations = 0;
+
+    const size_t sizet_len = vec_interleaver.size();
+    SUSA_ASSERT_MESSAGE(mat_arg.size() == no_coded(), "the length of the code word does not match the codes.");
+    if (mat_arg.size() != no_coded() || sizet_len == 0) return matrix <uint8_t> ();
+
+    const size_t sizet_stages_1 = stages(*ptr_code_1);
+    const size_t sizet_stages_2 = stages(*ptr_code_2);
+    const uint32_t* ptr_perm    = vec_interleaver.data();
+
+    // the tail bits have no a priori information
+    vec_la_1.assign(sizet_stages_1, 0);
+    vec_la_2.assign(sizet_stages_2, 0);
+    vec_app_1.resize(sizet_stages_1);
+    vec_app_2.resize(sizet_stages_2);
+    vec_prev.resize(sizet_len);
+    if (mat_llr.size() != sizet_len) mat_llr = matrix <double> (sizet_len, 1);
+    if (mat_hard.size() != sizet_len) mat_hard = matrix <uint8_t> (sizet_len, 1);
+
+    const double* ptr_in_1 = mat_arg.data();
+    const double* ptr_in_2 = mat_arg.data() + ptr_code_1->uint_n * sizet_stages_1;
+
+    while (sizet_iterations < sizet_max_iterations)
+    {
+        sizet_iterations++;
+
+        ptr_code_1->bcjr(ptr_in_1, sizet_stages_1, dbl_ebn0, sizet_stages_1, 0, metric, 0.5, ws_1, vec_app_1.data(), vec_la_1.data());
+
+        // the extrinsic LLRs of the first decoder are the a priori LLRs of the second one
+        for (size_t sizet_i = 0; sizet_i < sizet_len; sizet_i++)
+        {
+            vec_la_2[sizet_i] = vec_app_1[ptr_perm[sizet_i]] - vec_la_1[ptr_perm[sizet_i]];
+        }
+
+        ptr_code_2->bcjr(ptr_in_2, sizet_stages_2, dbl_ebn0, sizet_stages_2, 0, metric, 0.5, ws_2, vec_app_2.data(), vec_la_2.data());
+
+        for (size_t sizet_i = 0; sizet_i < sizet_len; sizet_i++)
+        {
+            vec_la_1[ptr_perm[sizet_i]] = vec_app_2[sizet_i] - vec_la_2[sizet_i];
+            mat_llr(ptr_perm[sizet_i])  = vec_app_2[sizet_i];
+            mat_hard(ptr_perm[sizet_i]) = vec_app_2[sizet_i] > 0 ? 1 : 0;
+        }
+
+        if (func_stop && func_stop(mat_hard)) break;
+
+        bool bool_same = sizet_iterations > 1 && std::equal(vec_prev.begin(), vec_prev.end(), mat_hard.data());
+        if (bool_early && bool_same) break;
+
+        std::copy(mat_hard.data(), mat_hard.data() + sizet_len, vec_prev.begin());
+    }
+
+    SUSA_PROFILE_COUNT("turbo.iterations", sizet_iterations);
+
+    return mat_hard;
+}
+
+}      // NAMESPACE SUSA
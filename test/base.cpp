@@ -29,12 +29,61 @@ int main(void)
     susa::matrix <float> mat_m("[0 1 1; 2 3 2; 1 3 2; 4 2 2]");
     susa::matrix <float> result = susa::mean(mat_m);
     SUSA_TEST_EQ(result, susa::matrix<float> ("1.7500;2.2500;1.7500"), "mean of a matrix");
+
+    SUSA_TEST_EQ(susa::sum(mat_m.block_view(1, 1, 3, 2)), susa::matrix<float> ("8;6"), "sum of a matrix view");
+    SUSA_TEST_EQ(susa::sum(mat_m.row_view(3)), susa::matrix<float> ("8"), "sum of a row view");
+    SUSA_TEST_EQ(susa::max(mat_m.col_view(0))(0), 3, "maximum of a column view");
+    SUSA_TEST_EQ(susa::min(mat_m.view().strided(1, 4, 3))(0), 1, "minimum of a strided view");
+    SUSA_TEST_EQ(susa::sum(mat_m, susa::AXIS_ROWS), susa::matrix<float> ("2;7;6;8"), "sum of the rows");
+    SUSA_TEST_EQ(susa::sum(mat_m.block_view(1, 1, 3, 2), susa::AXIS_ALL)(0), 14, "sum of a whole view");
+    SUSA_TEST_EQ(susa::max(mat_m, susa::AXIS_ALL)(0), 3, "linear index of the maximum");
+
+    susa::matrix <float>  mat_lo, mat_hi;
+    susa::matrix <size_t> mat_ilo, mat_ihi;
+    susa::minmax(mat_m, mat_lo, mat_ilo, mat_hi, mat_ihi, susa::AXIS_ROWS);
+    SUSA_TEST_EQ((mat_lo == susa::matrix<float> ("0;2;1;2") && mat_ihi == susa::matrix<size_t> ("1;1;1;0")), true, "fused minimum and maximum");
+    susa::matrix <std::complex <double> > mat_c(1, 2);
+    mat_c(0) = std::complex <double> (1, 2);
+    mat_c(1) = std::complex <double> (3, -1);
+    SUSA_TEST_EQ_DOUBLE(susa::energy(mat_c)(0), 15, "energy of a complex vector");
+
+    // a long sum of a value without an exact binary representation
+    susa::matrix <float> mat_long(1 << 20, 1, 0.1f);
+    SUSA_TEST_EQ((std::abs(susa::sum(mat_long)(0) - 104857.6f) < 0.05f), true, "pairwise summation");
+
+    {
+    // two partial states merge into the state of the whole sequence
+    susa::running_stats <int> stats_all(0, 10, 5), stats_a(0, 10, 5), stats_b(0, 10, 5);
+    int int_samples[] = {4, 7, 13, 1, 9, -2, 5, 6};
+    for (size_t sizet_i = 0; sizet_i < 8; sizet_i++)
+    {
+        stats_all.push(int_samples[sizet_i]);
+        if (sizet_i < 3) stats_a.push(int_samples[sizet_i]);
+        else stats_b.push(int_samples[sizet_i]);
+    }
+    stats_a.merge(stats_b);
+    SUSA_TEST_EQ_DOUBLE(stats_all.mean(), 5.375, "running mean");
+    SUSA_TEST_EQ_DOUBLE(stats_all.sample_variance(), 21.410714, "running sample variance");
+    SUSA_TEST_EQ((stats_a.count() == 8 && std::abs(stats_a.variance() - stats_all.variance()) < 1e-12 &&
+      stats_a.min() == -2 && stats_a.max() == 13), true, "merged running statistics");
+    SUSA_TEST_EQ((stats_a.histogram()[2] == 2 && stats_a.histogram()[3] == 2 && stats_a.no_below() == 1 && stats_a.no_above() == 1), true, "running histogram");
+
+    // the moments of a histogram of other bins are merged, its counts are not
+    susa::running_stats <int> stats_c(0, 20, 5);
+    stats_c.merge(stats_all);
+    SUSA_TEST_EQ((stats_c.count() == 8 && stats_c.max() == 13 && std::abs(stats_c.variance() - stats_all.variance()) < 1e-12 &&
+      stats_c.histogram()[0] == 0 && stats_c.no_below() == 0), true, "running statistics merged over other bins");
+    }
     
     SUSA_TEST_EQ(susa::round(42.163574), 42.0, "Round a double with no decimals.");
     SUSA_TEST_EQ(susa::round(42.163574, 2), 42.16, "Round a double with two decimals.");
     SUSA_TEST_EQ_DOUBLE(susa::normcdf(0.5), 0.6915, "Normal Cumulative Distribution Function.");
     SUSA_TEST_EQ(susa::round(susa::normcdf(0.5), 4), 0.6915, "Normal Cumulative Distribution Function.");
 
+    const double dbl_inf = std::numeric_limits <double>::infinity();
+    SUSA_TEST_EQ((susa::log_sum_exp(-dbl_inf, -dbl_inf) == -dbl_inf), true, "Jacobian logarithm of the unreachable states.");
+    SUSA_TEST_EQ((susa::log_sum_exp(-dbl_inf, 1.5) == 1.5), true, "Jacobian logarithm of an unreachable state.");
+
     susa::rng mt_rng(35748);
     susa::matrix <float> mat_a = mt_rng.rand(20,10);
     std::stringstream ss;
@@ -42,6 +91,154 @@ int main(void)
     susa::matrix <double> mat_b(ss.str());
     SUSA_TEST_EQ(mat_b, round(mat_a, 2), "std::string to susa::matrix conversion.");
 
+
+    // Philox4x32-10 known answers of the reference implementation
+    {
+    uint32_t uint_ctr[4] = {0, 0, 0, 0};
+    uint32_t uint_key[2] = {0, 0};
+    uint32_t uint_out[4];
+    susa::philox::block(uint_ctr, uint_key, uint_out);
+    SUSA_TEST_EQ((uint_out[0] == 0x6627e8d5 && uint_out[1] == 0xe169c58d && uint_out[2] == 0xbc57ac4c && uint_out[3] == 0x9b00dbd8), true, "Philox4x32-10 zero block.");
+
+    uint32_t uint_ctr_pi[4] = {0x243f6a88, 0x85a308d3, 0x13198a2e, 0x03707344};
+    uint32_t uint_key_pi[2] = {0xa4093822, 0x299f31d0};
+    susa::philox::block(uint_ctr_pi, uint_key_pi, uint_out);
+    SUSA_TEST_EQ((uint_out[0] == 0xd16cfe09 && uint_out[1] == 0x94fdcceb && uint_out[2] == 0x5001e420 && uint_out[3] == 0x24126ea1), true, "Philox4x32-10 pi block.");
+
+    susa::philox ph_gen(2024, 7);
+    susa::matrix <unsigned int> mat_draws = ph_gen.rand_mask(0xFFFFFFFF, 11);
+    susa::philox ph_seek = ph_gen.stream(7);
+    ph_seek.seek(6);
+    SUSA_TEST_EQ((ph_seek.rand_uint() == mat_draws(6) && ph_seek.position() == 7), true, "Philox seek.");
+    ph_seek.discard(3);
+    SUSA_TEST_EQ(ph_seek.rand_uint(), mat_draws(10), "Philox discard.");
+    SUSA_TEST_EQ((ph_gen.stream(8).rand_mask(0xFFFFFFFF, 11) == mat_draws), false, "Philox streams.");
+
+    susa::matrix <double> mat_u = susa::philox(1).rand(20000);
+    SUSA_TEST_EQ((std::abs(susa::mean(mat_u)(0) - 0.5) < 0.01), true, "Philox uniform mean.");
+
+    susa::rng rng_first(11, 3);
+    susa::rng rng_second(11, 3);
+    susa::rng rng_other(11, 4);
+    susa::matrix <unsigned int> mat_first = rng_first.rand_mask(0xFFFFFFFF, 8);
+    SUSA_TEST_EQ((mat_first == rng_second.rand_mask(0xFFFFFFFF, 8)), true, "rng stream reproducibility.");
+    SUSA_TEST_EQ((mat_first == rng_other.rand_mask(0xFFFFFFFF, 8)), false, "rng streams.");
+    }
+
+    // the bulk fills
+    {
+    susa::rng rng_serial(4321);
+    susa::rng rng_bulk(4321);
+    susa::matrix <double> mat_serial(700, 1);
+    for (unsigned int uint_i = 0; uint_i < 700; uint_i++) mat_serial(uint_i) = rng_serial.rand();
+    susa::matrix <double> mat_bulk(700, 1);
+    rng_bulk.fill_uniform(mat_bulk);
+    SUSA_TEST_EQ((mat_bulk == mat_serial), true, "rng uniform bulk fill.");
+
+    susa::matrix <double> mat_n(100000, 1);
+    rng_bulk.fill_normal(mat_n);
+    double dbl_s1 = 0, dbl_s2 = 0;
+    for (unsigned int uint_i = 0; uint_i < mat_n.size(); uint_i++)
+    {
+        dbl_s1 += mat_n(uint_i);
+        dbl_s2 += mat_n(uint_i) * mat_n(uint_i);
+    }
+    SUSA_TEST_EQ((std::abs(dbl_s1 / mat_n.size()) < 0.02 && std::abs(dbl_s2 / mat_n.size() - 1) < 0.02), true, "rng Ziggurat normal moments.");
+
+    susa::matrix <std::complex <double> > cmat_noise(50000, 1);
+    rng_bulk.fill_complex_normal(cmat_noise, 0.5);
+    double dbl_power = 0;
+    for (unsigned int uint_i = 0; uint_i < cmat_noise.size(); uint_i++) dbl_power += std::norm(cmat_noise(uint_i));
+    SUSA_TEST_EQ((std::abs(dbl_power / cmat_noise.size() - 0.5) < 0.02), true, "rng complex normal power.");
+    }
+
+    // the alias method of the non-uniform distributions
+    {
+    susa::mt mt_gen(2718);
+    susa::matrix <double> mat_prob("[0.1 0 0.2 0.3 0.4]");
+    mt_gen.set_probabilities(mat_prob);
+    susa::matrix <unsigned int> mat_draws = mt_gen.nonuniform(100000);
+    susa::matrix <unsigned int> mat_single(1, 20000);
+    for (unsigned int uint_i = 0; uint_i < mat_single.size(); uint_i++) mat_single(uint_i) = mt_gen.nonuniform();
+    susa::matrix <unsigned int> mat_temp = mt_gen.nonuniform(mat_prob, 100000);
+
+    susa::matrix <double> mat_freq(5, 3, 0);
+    for (unsigned int uint_i = 0; uint_i < mat_draws.size(); uint_i++) mat_freq(mat_draws(uint_i), 0) += 1e-5;
+    for (unsigned int uint_i = 0; uint_i < mat_single.size(); uint_i++) mat_freq(mat_single(uint_i), 1) += 5e-5;
+    for (unsigned int uint_i = 0; uint_i < mat_temp.size(); uint_i++) mat_freq(mat_temp(uint_i), 2) += 1e-5;
+
+    double dbl_err = 0;
+    for (unsigned int uint_i = 0; uint_i < 5; uint_i++)
+        for (unsigned int uint_j = 0; uint_j < 3; uint_j++) dbl_err = std::max(dbl_err, std::abs(mat_freq(uint_i, uint_j) - mat_prob(uint_i)));
+    SUSA_TEST_EQ((dbl_err < 0.015 && mat_freq(1, 0) == 0 && mt_gen.nonuniform(mat_prob) != 1), true, "mt alias method.");
+    }
+
+    {
+    // 0 -> 1 -> 3 -> 4 is shorter than 0 -> 2 -> 4 and the vertex 5 is unreachable
+    std::vector <unsigned int> vec_from  = {0, 0, 1, 2, 3, 1, 4};
+    std::vector <unsigned int> vec_to    = {1, 2, 3, 4, 4, 2, 0};
+    std::vector <unsigned int> vec_w     = {2, 5, 1, 4, 1, 4, 1};
+    susa::csr_graph <unsigned int> graph(6, vec_from, vec_to, vec_w);
+    std::vector <unsigned int> vec_dist, vec_prev;
+
+    SUSA_TEST_EQ(susa::dijkstra(graph, 0, vec_dist, vec_prev), true, "Dijkstra over CSR.");
+    SUSA_TEST_EQ((vec_dist[4] == 4 && vec_prev[4] == 3 && vec_prev[3] == 1 && vec_dist[2] == 5), true, "Dijkstra distances and predecessors.");
+    SUSA_TEST_EQ((vec_prev[5] == susa::DIJKSTRA_NONE && vec_dist[5] == std::numeric_limits <unsigned int>::max()), true, "Dijkstra unreachable vertex.");
+    SUSA_TEST_EQ((susa::dijkstra(graph, 0, vec_dist, vec_prev, 3) && vec_dist[3] == 3 && vec_prev[4] == susa::DIJKSTRA_NONE), true, "Dijkstra early exit.");
+    SUSA_TEST_EQ(susa::dijkstra(graph, 0, vec_dist, vec_prev, 5), false, "Dijkstra unreachable target.");
+
+    susa::matrix <unsigned int> mat_graph(6, 6, 0u);
+    for (size_t sizet_e = 0; sizet_e < vec_w.size(); sizet_e++) mat_graph(vec_from[sizet_e], vec_to[sizet_e]) = vec_w[sizet_e];
+    SUSA_TEST_EQ(susa::dijkstra(mat_graph, 0), susa::matrix <unsigned int> ("0;0;0;1;3;5"), "Dijkstra over a dense matrix.");
+    SUSA_TEST_EQ((susa::dijkstra(susa::csr_graph <unsigned int> (susa::sparse_matrix <unsigned int> (mat_graph)), 0, vec_dist, vec_prev) && vec_dist[4] == 4),
+      true, "Dijkstra over a sparse matrix.");
+    }
+
+    {
+    susa::matrix <int> mat_v("5;-2;7;3;-2;0");
+    SUSA_TEST_EQ(susa::sort(mat_v), susa::matrix <int> ("-2;-2;0;3;5;7"), "sort a vector.");
+    SUSA_TEST_EQ(susa::stable_sort_indices(mat_v), susa::matrix <unsigned int> ("1;4;5;3;0;2"), "stable argsort.");
+    SUSA_TEST_EQ(susa::select_least(mat_v, 3), susa::matrix <unsigned int> ("1;4;5"), "select the least elements.");
+    SUSA_TEST_EQ(susa::select_most(mat_v, 2), susa::matrix <unsigned int> ("2;0"), "select the greatest elements.");
+    SUSA_TEST_EQ(susa::select_limited_least(mat_v, susa::matrix <unsigned int> ("0;2;3;5"), 2), susa::matrix <unsigned int> ("5;3"),
+      "select the least of the candidates.");
+
+    susa::matrix <double> mat_m("3 -1;1 4;2 0");
+    SUSA_TEST_EQ(susa::sort(mat_m), susa::matrix <double> ("1 -1;2 0;3 4"), "sort the columns of a matrix.");
+    SUSA_TEST_EQ(susa::sort_indices(mat_m), susa::matrix <unsigned int> ("1 0;2 2;0 1"), "argsort the columns of a matrix.");
+    SUSA_TEST_EQ(susa::select_most(mat_m, 1), susa::matrix <unsigned int> ("0 1"), "select the greatest of every column.");
+    }
+
+#if !defined(SUSA_NDEBUG) && !defined(SUSA_NO_PROFILE)
+    {
+    susa::profile_reset();
+    susa::parallel_for(0, 8, 1, [](size_t sizet_first, size_t sizet_last)
+    {
+        for (size_t sizet_i = sizet_first; sizet_i < sizet_last; sizet_i++)
+        {
+            SUSA_PROFILE_SCOPE("test.scope");
+            susa::matrix <double> mat_tmp(4, 4, 0);
+            SUSA_PROFILE_COUNT("test.counter", 2);
+        }
+    });
+
+    std::vector <susa::profile_record> vec_records = susa::profile_report();
+    uint64_t uint_calls = 0, uint_allocs = 0, uint_bytes = 0, uint_count = 0;
+    for (size_t sizet_r = 0; sizet_r < vec_records.size(); sizet_r++)
+    {
+        if (vec_records[sizet_r].str_name == "test.scope")
+        {
+            uint_calls  = vec_records[sizet_r].uint_calls;
+            uint_allocs = vec_records[sizet_r].uint_allocs;
+            uint_bytes  = vec_records[sizet_r].uint_bytes;
+        }
+        if (vec_records[sizet_r].str_name == "test.counter") uint_count = vec_records[sizet_r].uint_calls;
+    }
+    SUSA_TEST_EQ((uint_calls == 8 && uint_count == 16), true, "profile calls and counters merged over the threads.");
+    SUSA_TEST_EQ((uint_allocs == 8 && uint_bytes == 8 * 16 * sizeof(double)), true, "profile allocations.");
+    }
+#endif
+
     SUSA_TEST_PRINT_STATS();
 
     return (uint_failed);
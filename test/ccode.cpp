@@ -74,6 +74,184 @@ int main(void)
         SUSA_TEST_EQ(mat_expected, transpose(mat_coded), "Convolutional Code Encoder");
     }
 
+    {
+        susa::ccode code(2, 1, 2);
+        code.set_generator(7, 0);
+        code.set_generator(5, 1);
+
+        susa::trellis_ptr ptr_trellis = code.get_trellis();
+        SUSA_TEST_EQ(ptr_trellis->no_states(), 4, "trellis of the convolutional code");
+        SUSA_TEST_EQ(ptr_trellis->next_state(1, 1), 2, "trellis next state");
+        SUSA_TEST_EQ(ptr_trellis->label(0, 1), 3, "trellis output label");
+        SUSA_TEST_EQ(ptr_trellis->prev_states(1)[2], 1, "trellis predecessor");
+        SUSA_TEST_EQ(ptr_trellis->prev_inputs(1)[2], 1, "trellis predecessor input");
+
+        // two separated bit errors are corrected by the hard decision decoder
+        matrix<uint8_t> mat_bits("0 1 0 1 1 1 0 0 1 0 1 0 0 0 1 0 0");
+        matrix<uint8_t> mat_coded = code.encode(mat_bits);
+        mat_coded(3) ^= 1;
+        mat_coded(20) ^= 1;
+        SUSA_TEST_EQ(transpose(code.decode_viterbi(mat_coded)), mat_bits, "Viterbi decoder with hard input");
+
+        // the table encoder of packed bits and the bit-wise encoder
+        susa::rng rng_gen(17);
+        susa::bitvec bv_bits = rng_gen.bernoulli_packed(203);
+        SUSA_TEST_EQ(code.encode(bv_bits), susa::bitvec(code.encode(bv_bits.unpack())), "encoder of packed bits");
+        SUSA_TEST_EQ((bv_bits.count() > 70 && bv_bits.count() < 130), true, "packed Bernoulli samples");
+    }
+
+    {
+        susa::ccode code(2, 1, 6);
+        code.set_generator(171, 0);
+        code.set_generator(133, 1);
+
+        susa::rng rng_gen(4242);
+        matrix<uint8_t> mat_bits(500, 1, 0);
+        for (size_t sizet_i = 0; sizet_i < 494; sizet_i++) mat_bits(sizet_i) = rng_gen.rand() > 0.5 ? 1 : 0;
+
+        matrix<uint8_t> mat_coded = code.encode(mat_bits);
+        matrix<double>  mat_soft(mat_coded.size(), 1);
+        for (size_t sizet_i = 0; sizet_i < mat_coded.size(); sizet_i++) mat_soft(sizet_i) = (mat_coded(sizet_i) ? 1.0 : -1.0) + 0.5 * rng_gen.randn();
+
+        SUSA_TEST_EQ(code.decode_viterbi(mat_soft), mat_bits, "Viterbi decoder with soft input (m = 6)");
+        SUSA_TEST_EQ(code.decode_viterbi <float> (mat_soft, llr_quantizer()), mat_bits, "Viterbi decoder with float metrics");
+        SUSA_TEST_EQ(code.decode_viterbi <int16_t> (mat_soft, llr_quantizer(64, 8)), mat_bits, "Viterbi decoder with int16 metrics");
+        SUSA_TEST_EQ(code.decode_viterbi <int8_t> (mat_soft, llr_quantizer(4, 4)), mat_bits, "Viterbi decoder with int8 metrics");
+
+        // the sums of the same width saturate like the clipped 32-bit ones
+        bool bool_saturate = metric_traits <int8_t>::add(100, 100) == 127 && metric_traits <int8_t>::add(-100, -100) == -128
+          && metric_traits <int8_t>::sub(-100, 100) == -128 && metric_traits <int8_t>::sub(100, -100) == 127
+          && metric_traits <int16_t>::add(-32768, 32767) == -1 && metric_traits <int16_t>::sub(-2, 32767) == -32768;
+        SUSA_TEST_EQ(bool_saturate, true, "saturating fixed-point metrics");
+    }
+
+    {
+        susa::ccode code(2, 1, 2);
+        code.set_generator(7, 0);
+        code.set_generator(5, 1);
+
+        susa::rng rng_gen(1234);
+        matrix<uint8_t> mat_bits(60, 1, 0);
+        for (size_t sizet_i = 0; sizet_i < 58; sizet_i++) mat_bits(sizet_i) = rng_gen.rand() > 0.5 ? 1 : 0;
+
+        double dbl_ebn0 = 1.5;
+        matrix<uint8_t> mat_coded = code.encode(mat_bits);
+        matrix<double>  mat_soft(mat_coded.size(), 1);
+        for (size_t sizet_i = 0; sizet_i < mat_coded.size(); sizet_i++) mat_soft(sizet_i) = (mat_coded(sizet_i) ? 1.0 : -1.0) + 0.6 * rng_gen.randn();
+
+        matrix<double> mat_lr      = code.decode_bcjr(mat_soft, dbl_ebn0);
+        matrix<double> mat_log_map = code.decode_bcjr_log(mat_soft, dbl_ebn0);
+        matrix<double> mat_max_log = code.decode_bcjr_log(mat_soft, dbl_ebn0, susa::ccode::MAX_LOG_MAP);
+
+        double dbl_err = 0;
+        bool   bool_max_log = true;
+        for (size_t sizet_i = 0; sizet_i < 60; sizet_i++)
+        {
+            // the tail bits are known zeros
+            if (sizet_i < 58) dbl_err = std::max(dbl_err, std::abs(std::log(mat_lr(sizet_i)) - mat_log_map(sizet_i)));
+            bool_max_log = bool_max_log && (mat_max_log(sizet_i) > 0) == (mat_bits(sizet_i) == 1);
+        }
+        SUSA_TEST_EQ((dbl_err < 0.05), true, "Log-MAP decoder against the probability domain BCJR");
+        SUSA_TEST_EQ(bool_max_log, true, "Max-Log-MAP decoder decisions");
+
+        matrix<double> mat_window = code.decode_bcjr_window(mat_soft, dbl_ebn0, 16, 16);
+        dbl_err = 0;
+        for (size_t sizet_i = 0; sizet_i < 58; sizet_i++) dbl_err = std::max(dbl_err, std::abs(mat_window(sizet_i) - mat_log_map(sizet_i)));
+        SUSA_TEST_EQ((dbl_err < 1e-3), true, "sliding-window Log-MAP decoder");
+
+        // the float metrics scaled as the double ones, and the decisions of the fixed-point metrics
+        matrix<float>   mat_float = code.decode_bcjr_max_log <float> (mat_soft, llr_quantizer(2 * dbl_ebn0));
+        matrix<int16_t> mat_int16 = code.decode_bcjr_max_log <int16_t> (mat_soft, llr_quantizer(32, 8), 16, 16);
+        matrix<int8_t>  mat_int8  = code.decode_bcjr_max_log <int8_t> (mat_soft, llr_quantizer(4, 4));
+        dbl_err = 0;
+        bool bool_fixed = mat_int16.size() == 60 && mat_int8.size() == 60;
+        for (size_t sizet_i = 0; sizet_i < 60 && bool_fixed; sizet_i++)
+        {
+            if (sizet_i < 58) dbl_err = std::max(dbl_err, std::abs(mat_float(sizet_i) - mat_max_log(sizet_i)));
+            bool_fixed = (mat_int16(sizet_i) > 0) == (mat_bits(sizet_i) == 1) && (mat_int8(sizet_i) > 0) == (mat_bits(sizet_i) == 1);
+        }
+        SUSA_TEST_EQ((dbl_err < 1e-3), true, "Max-Log-MAP decoder with float metrics");
+        SUSA_TEST_EQ(bool_fixed, true, "Max-Log-MAP decoder with fixed-point metrics");
+    }
+
+    {
+        // the batched decoders against the frame by frame ones
+        susa::ccode code(2, 1, 2);
+        code.set_generator(7, 0);
+        code.set_generator(5, 1);
+
+        susa::rng rng_gen(777);
+        const size_t sizet_frames = 9;
+        matrix<double> mat_frames(80, sizet_frames);
+        std::vector <matrix<double> > vec_frames;
+        for (size_t sizet_f = 0; sizet_f < sizet_frames; sizet_f++)
+        {
+            matrix<uint8_t> mat_bits(40, 1, 0);
+            for (size_t sizet_i = 0; sizet_i < 38; sizet_i++) mat_bits(sizet_i) = rng_gen.rand() > 0.5 ? 1 : 0;
+            matrix<uint8_t> mat_coded = code.encode(mat_bits);
+            for (size_t sizet_i = 0; sizet_i < 80; sizet_i++) mat_frames(sizet_i, sizet_f) = (mat_coded(sizet_i) ? 1.0 : -1.0) + 0.7 * rng_gen.randn();
+            vec_frames.push_back(matrix<double> (mat_frames.col(sizet_f)));
+        }
+
+        matrix<uint8_t> mat_hard = code.decode_viterbi_batch(mat_frames);
+        matrix<double>  mat_llr  = code.decode_bcjr_batch(mat_frames, 1.5, 16, 16);
+        std::vector <matrix<double> > vec_llr = code.decode_bcjr_batch(vec_frames, 1.5, 16, 16);
+
+        bool bool_viterbi = mat_hard.no_rows() == 40 && mat_hard.no_cols() == sizet_frames;
+        double dbl_err = 0;
+        for (size_t sizet_f = 0; sizet_f < sizet_frames && bool_viterbi; sizet_f++)
+        {
+            bool_viterbi = matrix<uint8_t> (mat_hard.col(sizet_f)) == code.decode_viterbi(vec_frames[sizet_f]);
+            matrix<double> mat_serial = code.decode_bcjr_window(vec_frames[sizet_f], 1.5, 16, 16);
+            for (size_t sizet_i = 0; sizet_i < 40; sizet_i++)
+            {
+                dbl_err = std::max(dbl_err, std::abs(mat_llr(sizet_i, sizet_f) - mat_serial(sizet_i)));
+                dbl_err = std::max(dbl_err, std::abs(vec_llr[sizet_f](sizet_i) - mat_serial(sizet_i)));
+            }
+        }
+        SUSA_TEST_EQ(bool_viterbi, true, "batched Viterbi decoder");
+        SUSA_TEST_EQ((dbl_err < 1e-12), true, "batched Log-MAP decoder");
+    }
+
+    {
+        // the turbo code of two (7, 5) codes against the first code alone
+        susa::ccode code_1(2, 1, 2), code_2(2, 1, 2);
+        code_1.set_generator(7, 0);
+        code_1.set_generator(5, 1);
+        code_2.set_generator(7, 0);
+        code_2.set_generator(5, 1);
+
+        const size_t sizet_len = 400;
+        std::vector <uint32_t> vec_perm = susa::random_interleaver(sizet_len, 5);
+        std::vector <uint32_t> vec_sorted(vec_perm);
+        std::sort(vec_sorted.begin(), vec_sorted.end());
+        SUSA_TEST_EQ((vec_sorted.back() == sizet_len - 1 && std::unique(vec_sorted.begin(), vec_sorted.end()) == vec_sorted.end()), true, "random interleaver");
+
+        susa::turbo tcode(code_1, code_2, vec_perm);
+        susa::rng rng_gen(2024);
+        matrix<uint8_t> mat_bits  = rng_gen.bernoulli(sizet_len);
+        matrix<uint8_t> mat_coded = tcode.encode(mat_bits);
+        SUSA_TEST_EQ(mat_coded.size(), tcode.no_coded(), "turbo encoder");
+
+        double dbl_sigma = 0.85;
+        matrix<double> mat_soft(mat_coded.size(), 1);
+        for (size_t sizet_i = 0; sizet_i < mat_coded.size(); sizet_i++) mat_soft(sizet_i) = (mat_coded(sizet_i) ? 1.0 : -1.0) + dbl_sigma * rng_gen.randn();
+
+        double dbl_esn0 = 1 / (2 * dbl_sigma * dbl_sigma);
+        matrix<double> mat_first(2 * (sizet_len + 2), 1);
+        for (size_t sizet_i = 0; sizet_i < mat_first.size(); sizet_i++) mat_first(sizet_i) = mat_soft(sizet_i);
+        matrix<double> mat_llr = code_1.decode_bcjr_log(mat_first, dbl_esn0);
+        size_t sizet_errors = 0;
+        for (size_t sizet_i = 0; sizet_i < sizet_len; sizet_i++) sizet_errors += (mat_llr(sizet_i) > 0) != (mat_bits(sizet_i) == 1);
+
+        SUSA_TEST_EQ((sizet_errors > 0 && tcode.decode(mat_soft, dbl_esn0) == mat_bits), true, "turbo decoder");
+        SUSA_TEST_EQ((tcode.iterations() > 1 && tcode.iterations() < 8), true, "turbo decoder early termination");
+
+        tcode.set_stop_check([&](const matrix<uint8_t>&) { return true; });
+        tcode.decode(mat_soft, dbl_esn0);
+        SUSA_TEST_EQ(tcode.iterations(), 1, "turbo decoder stop check");
+    }
+
     SUSA_TEST_PRINT_STATS();
 
     return (uint_failed);
@@ -81,6 +81,267 @@ int main(void)
     //std::cout << "\ndecoded : \n" << mat_decoded_bits.left(len);
 
     SUSA_TEST_EQ(mat_bits.left(len), mat_decoded_bits.left(len), "BCJR channel equalizer.");
+
+    {
+    // the sliding window against the full frame
+    susa::rng rng_gen(8080);
+    susa::matrix<double> mat_long(400, 1, -1);
+    for (unsigned int uint_i = 0; uint_i < 397; uint_i++) mat_long(uint_i) = rng_gen.rand() > 0.5 ? 1 : -1;
+    susa::matrix<double> mat_rx = filter(mat_taps, susa::matrix<double> (1, 1, 1), mat_long);
+    for (unsigned int uint_i = 0; uint_i < mat_rx.size(); uint_i++) mat_rx(uint_i) += 0.3 * rng_gen.randn();
+
+    susa::matrix<double> mat_full = ch.decode_bcjr(mat_rx, 4);
+    susa::matrix<double> mat_win  = ch.decode_bcjr_window(mat_rx, 4, 50, 30);
+    unsigned int uint_same = 0;
+    for (unsigned int uint_i = 0; uint_i < mat_full.size(); uint_i++) uint_same += (mat_full(uint_i) > 1) == (mat_win(uint_i) > 1);
+    SUSA_TEST_EQ(uint_same, mat_full.size(), "sliding-window BCJR channel equalizer.");
+    SUSA_TEST_EQ_DOUBLE(std::log(mat_win(123)), std::log(mat_full(123)), "sliding-window BCJR likelihood ratio.");
+    }
+
+    {
+    // the streaming MLSE equalizer with a fixed latency
+    susa::rng rng_gen(99);
+    susa::matrix<double> mat_sym(300, 1);
+    for (unsigned int uint_i = 0; uint_i < mat_sym.size(); uint_i++) mat_sym(uint_i) = rng_gen.rand() > 0.5 ? 1 : -1;
+    susa::matrix<double> mat_rx = ch.encode_isi(mat_sym, 0);
+    for (unsigned int uint_i = 0; uint_i < mat_rx.size(); uint_i++) mat_rx(uint_i) += 0.2 * rng_gen.randn();
+
+    susa::viterbi_equalizer<double> eq(ch, 20);
+    eq.reset(0);
+    susa::matrix<double> mat_first  = eq.process(mat_rx.left(100));
+    susa::matrix<double> mat_second = eq.process(mat_rx.mid(100, 299));
+    susa::matrix<double> mat_tail   = eq.flush();
+
+    SUSA_TEST_EQ(mat_first.size(), 80, "streaming MLSE equalizer latency.");
+    SUSA_TEST_EQ(mat_second.size() + mat_tail.size(), 220, "streaming MLSE equalizer flush.");
+    SUSA_TEST_EQ(mat_first, mat_sym.left(80), "streaming MLSE equalizer.");
+    SUSA_TEST_EQ(concat(mat_second, mat_tail), mat_sym.right(220), "streaming MLSE equalizer.");
+    }
+
+    {
+    // the batched equalizers against the frame by frame ones
+    susa::rng rng_gen(31);
+    susa::matrix<double> mat_frames(103, 6);
+    for (unsigned int uint_f = 0; uint_f < mat_frames.no_cols(); uint_f++)
+    {
+        susa::matrix<double> mat_sym(100, 1);
+        for (unsigned int uint_i = 0; uint_i < mat_sym.size(); uint_i++) mat_sym(uint_i) = rng_gen.rand() > 0.5 ? 1 : -1;
+        susa::matrix<double> mat_rx = ch.encode_isi(mat_sym, 0);
+        for (unsigned int uint_i = 0; uint_i < mat_rx.size(); uint_i++) mat_frames(uint_i, uint_f) = mat_rx(uint_i) + 0.3 * rng_gen.randn();
+    }
+
+    susa::matrix<double> mat_mlse = ch.decode_mlse_batch(mat_frames, 0);
+    susa::matrix<double> mat_lr   = ch.decode_bcjr_batch(mat_frames, 4, 50, 30);
+    bool bool_mlse = mat_mlse.no_rows() == 100 && mat_mlse.no_cols() == mat_frames.no_cols();
+    bool bool_bcjr = true;
+    for (unsigned int uint_f = 0; uint_f < mat_frames.no_cols() && bool_mlse; uint_f++)
+    {
+        susa::matrix<double> mat_frame(mat_frames.col(uint_f));
+        bool_mlse = susa::matrix<double> (mat_mlse.col(uint_f)) == ch.decode_mlse(mat_frame, 0);
+        bool_bcjr = bool_bcjr && susa::matrix<double> (mat_lr.col(uint_f)) == ch.decode_bcjr_window(mat_frame, 4, 50, 30);
+    }
+    SUSA_TEST_EQ(bool_mlse, true, "batched MLSE equalizer.");
+    SUSA_TEST_EQ(bool_bcjr, true, "batched BCJR equalizer.");
+    }
+
+    {
+    // the reduced-state and the decision-feedback equalizers
+    susa::rng rng_gen(5);
+    susa::matrix<double> mat_sym(300, 1);
+    for (unsigned int uint_i = 0; uint_i < mat_sym.size(); uint_i++) mat_sym(uint_i) = rng_gen.rand() > 0.5 ? 1 : -1;
+    susa::matrix<double> mat_rx = ch.encode_isi(mat_sym, 0);
+    for (unsigned int uint_i = 0; uint_i < mat_rx.size(); uint_i++) mat_rx(uint_i) += 0.2 * rng_gen.randn();
+
+    susa::rsse_equalizer<double> rsse_full(mat_taps, mat_pam, 8, 3);
+    SUSA_TEST_EQ(rsse_full.decode(mat_rx, 0), ch.decode_mlse(mat_rx, 0), "RSSE equalizer with all the states.");
+    SUSA_TEST_EQ(ch.decode_bpsk_dfe(mat_rx, 0), mat_sym, "ZF-DFE equalizer.");
+
+    // a channel of fourteen taps (8192 states for the full trellis)
+    susa::matrix<double> mat_long_taps("1 0.6 -0.5 0.4 0.3 -0.25 0.2 0.15 -0.1 0.1 0.08 -0.05 0.04 0.03");
+    const unsigned int uint_len = 2000;
+    // the initial state of the detector is the first symbol i.e. the 13 symbols before the frame are -1
+    susa::matrix<double> mat_frame(13 + uint_len + 13, 1, -1);
+    for (unsigned int uint_i = 0; uint_i < uint_len; uint_i++) mat_frame(13 + uint_i) = rng_gen.rand() > 0.5 ? 1 : -1;
+    susa::matrix<double> mat_long    = mat_frame.mid(13, mat_frame.size() - 1);
+    susa::matrix<double> mat_long_rx = filter(mat_long_taps, susa::matrix<double> (1, 1, 1), mat_frame).mid(13, mat_frame.size() - 1);
+    for (unsigned int uint_i = 0; uint_i < mat_long_rx.size(); uint_i++) mat_long_rx(uint_i) += 0.3 * rng_gen.randn();
+
+    susa::rsse_equalizer<double> rsse(mat_long_taps, mat_pam, 16, 4);
+    SUSA_TEST_EQ(rsse.decode(mat_long_rx, 0), mat_long.left(uint_len), "RSSE equalizer of a long channel.");
+
+    // the LMS taps are trained on the first symbols and then decision-directed
+    susa::dfe_equalizer<double> dfe(susa::matrix<double> ("1;0;0"), susa::matrix<double> (13, 1, 0), mat_pam, 0, 0.01);
+    dfe.train(mat_long_rx.left(500), mat_long.left(500));
+    susa::matrix<double> mat_dfe = dfe.process(mat_long_rx.mid(500, uint_len - 1));
+    unsigned int uint_errors = 0;
+    for (unsigned int uint_i = 0; uint_i < mat_dfe.size(); uint_i++) uint_errors += mat_dfe(uint_i) != mat_long(500 + uint_i);
+    SUSA_TEST_EQ((mat_dfe.size() == uint_len - 500 && uint_errors < 5), true, "LMS-adaptive DFE equalizer.");
+    }
+
+    {
+    // the Monte Carlo runner does not depend on the number of threads
+    auto trial = [](double dbl_snr, susa::rng& rng_gen) -> susa::mc_count
+    {
+        double dbl_dev = std::sqrt(0.5 * std::pow(10, -dbl_snr / 10));
+        susa::mc_count count = {0, 100};
+        for (unsigned int uint_i = 0; uint_i < 100; uint_i++)
+        {
+            double dbl_bit = rng_gen.rand() > 0.5 ? 1 : -1;
+            count.uint_errors += (dbl_bit + dbl_dev * rng_gen.randn()) * dbl_bit < 0;
+        }
+        return count;
+    };
+
+    susa::montecarlo mc(2000, 200, 4);
+    mc.set_round(8);
+    susa::matrix<double> mat_snr(2, 1);
+    mat_snr(0) = 0;
+    mat_snr(1) = 20;
+
+    size_t sizet_threads = susa::get_num_threads();
+    susa::set_num_threads(1);
+    std::vector<susa::mc_point> vec_serial = mc.sweep(mat_snr, trial);
+    susa::set_num_threads(4);
+    std::vector<susa::mc_point> vec_parallel = mc.sweep(mat_snr, trial);
+    susa::set_num_threads(sizet_threads);
+
+    SUSA_TEST_EQ((vec_serial[0].uint_errors == vec_parallel[0].uint_errors && vec_serial[0].uint_trials == vec_parallel[0].uint_trials), true, "Monte Carlo runner reproducibility.");
+    SUSA_TEST_EQ((vec_serial[0].uint_errors >= 200 && vec_serial[0].uint_trials < 2000), true, "Monte Carlo runner early stop.");
+    SUSA_TEST_EQ((std::abs(vec_serial[0].rate() - 0.0786) < 4 * vec_serial[0].half_width()), true, "Monte Carlo runner error rate.");
+    SUSA_TEST_EQ(vec_parallel[1].uint_trials, 2000, "Monte Carlo runner maximum number of trials.");
+    }
+
+    {
+    // the per-axis QAM slicer against the minimum distance search
+    susa::qam qam_64(64);
+    susa::rng rng_gen(64);
+    susa::matrix <std::complex <double> > cmat_const = qam_64.get_constellation();
+    susa::matrix <std::complex <double> > cmat_rx(500, 1);
+    rng_gen.fill_complex_normal(cmat_rx, 3);
+
+    bool bool_slicer = true;
+    susa::matrix <int> mat_indices = qam_64.demodulate_symbols(cmat_rx);
+    for (unsigned int uint_i = 0; uint_i < cmat_rx.size(); uint_i++)
+    {
+        unsigned int uint_best = 0;
+        for (unsigned int uint_k = 1; uint_k < 64; uint_k++)
+        {
+            if (std::abs(cmat_rx(uint_i) - cmat_const(uint_k)) < std::abs(cmat_rx(uint_i) - cmat_const(uint_best))) uint_best = uint_k;
+        }
+        bool_slicer = bool_slicer && qam_64.demodulate_symbol(cmat_rx(uint_i)) == cmat_const(uint_best) && mat_indices(uint_i) == (int)uint_best;
+    }
+    SUSA_TEST_EQ(bool_slicer, true, "QAM per-axis slicer.");
+
+    susa::matrix <char> mat_bits(600, 1);
+    for (unsigned int uint_i = 0; uint_i < mat_bits.size(); uint_i++) mat_bits(uint_i) = rng_gen.rand_mask(0x1);
+    susa::matrix <std::complex <double> > cmat_tx = qam_64.modulate_bits(mat_bits);
+    susa::matrix <char> mat_rx_bits;
+    qam_64.demodulate_bits(cmat_tx + std::complex <double> (0.3, -0.3), mat_rx_bits);
+    SUSA_TEST_EQ((cmat_tx.size() == 100 && mat_rx_bits == mat_bits), true, "QAM Gray mapping.");
+
+    // the neighbours differ in one bit
+    susa::matrix <char> mat_near = qam_64.demodulate_bits(cmat_tx + std::complex <double> (1, 0));
+    unsigned int uint_diff = 0;
+    for (unsigned int uint_i = 0; uint_i < mat_near.size(); uint_i++) uint_diff += mat_near(uint_i) != mat_bits(uint_i);
+    unsigned int uint_edge = 0;
+    for (unsigned int uint_i = 0; uint_i < cmat_tx.size(); uint_i++) uint_edge += cmat_tx(uint_i).real() > 3;
+    SUSA_TEST_EQ(uint_diff, 100 - uint_edge, "QAM Gray neighbours.");
+
+    // the values out of the range are sliced to the outer levels and a NaN to the level zero
+    const double dbl_nan = std::numeric_limits <double>::quiet_NaN();
+    susa::matrix <std::complex <double> > cmat_far(3, 1), cmat_corner(3, 1);
+    cmat_far(0) = std::complex <double> (1e300, -1e300);
+    cmat_far(1) = std::complex <double> (-std::numeric_limits <double>::infinity(), 20);
+    cmat_far(2) = std::complex <double> (dbl_nan, dbl_nan);
+    cmat_corner(0) = std::complex <double> (3.5, -3.5);
+    cmat_corner(1) = std::complex <double> (-3.5, 3.5);
+    cmat_corner(2) = std::complex <double> (-3.5, -3.5);
+    bool bool_far = qam_64.demodulate_bits(cmat_far) == qam_64.demodulate_bits(cmat_corner)
+      && qam_64.demodulate_symbols(cmat_far) == qam_64.demodulate_symbols(cmat_corner);
+    for (unsigned int uint_i = 0; uint_i < cmat_far.size(); uint_i++)
+    {
+        bool_far = bool_far && qam_64.demodulate_symbol(cmat_far(uint_i)) == cmat_corner(uint_i);
+    }
+    SUSA_TEST_EQ(bool_far, true, "QAM hard slicer out of range and NaN.");
+    }
+
+    {
+    // an empty QAM returns empty results
+    susa::qam qam_empty;
+    susa::matrix <std::complex <double> > cmat_rx(8, 1, std::complex <double> (0.5, -0.5));
+    size_t sizet_results = qam_empty.demodulate_symbols(cmat_rx).size() + qam_empty.demodulate_bits(cmat_rx).size()
+      + qam_empty.demodulate_llr(cmat_rx, 0.5).size() + qam_empty.demodulate_llr(cmat_rx, 0.5, susa::qam::EXACT).size()
+      + qam_empty.modulate_bits(susa::matrix <char> (8, 1, 1)).size();
+    SUSA_TEST_EQ(sizet_results, 0, "empty QAM.");
+    }
+
+    {
+    // the soft demapper against the search over the constellation
+    susa::qam qam_16(16);
+    susa::rng rng_gen(16);
+    susa::matrix <char> mat_labels(64, 1);
+    for (unsigned int uint_k = 0; uint_k < 16; uint_k++)
+        for (unsigned int uint_b = 0; uint_b < 4; uint_b++) mat_labels(4 * uint_k + uint_b) = (uint_k >> (3 - uint_b)) & 0x1;
+    susa::matrix <std::complex <double> > cmat_points = qam_16.modulate_bits(mat_labels);
+
+    susa::matrix <std::complex <double> > cmat_rx(40, 1);
+    rng_gen.fill_complex_normal(cmat_rx, 2);
+    double dbl_n0 = 0.8;
+    susa::matrix <double> mat_max_log = qam_16.demodulate_llr(cmat_rx, dbl_n0);
+    susa::matrix <double> mat_exact   = qam_16.demodulate_llr(cmat_rx, dbl_n0, susa::qam::EXACT);
+
+    double dbl_err_max = 0, dbl_err_exact = 0;
+    for (unsigned int uint_i = 0; uint_i < cmat_rx.size(); uint_i++)
+    {
+        for (unsigned int uint_b = 0; uint_b < 4; uint_b++)
+        {
+            double dbl_min[2] = {1e300, 1e300};
+            double dbl_sum[2] = {0, 0};
+            for (unsigned int uint_k = 0; uint_k < 16; uint_k++)
+            {
+                double dbl_d = std::norm(cmat_rx(uint_i) - cmat_points(uint_k));
+                int    int_v = mat_labels(4 * uint_k + uint_b);
+                dbl_min[int_v] = std::min(dbl_min[int_v], dbl_d);
+                dbl_sum[int_v] += std::exp(-dbl_d / dbl_n0);
+            }
+            dbl_err_max   = std::max(dbl_err_max, std::abs(mat_max_log(4 * uint_i + uint_b) - (dbl_min[0] - dbl_min[1]) / dbl_n0));
+            dbl_err_exact = std::max(dbl_err_exact, std::abs(mat_exact(4 * uint_i + uint_b) - std::log(dbl_sum[1] / dbl_sum[0])));
+        }
+    }
+    SUSA_TEST_EQ((dbl_err_max < 1e-9), true, "QAM max-log LLR demapper.");
+    SUSA_TEST_EQ((dbl_err_exact < 1e-9), true, "QAM exact LLR demapper.");
+
+    // the values far out of the range are sliced to the corner levels, a NaN gives NaN LLRs
+    susa::matrix <std::complex <double> > cmat_edge(3, 1);
+    cmat_edge(0) = std::complex <double> (1e6, -1e6);
+    cmat_edge(1) = std::complex <double> (1.5, -1.5);
+    cmat_edge(2) = std::complex <double> (std::numeric_limits <double>::quiet_NaN(), 0);
+    susa::matrix <double> mat_edge = qam_16.demodulate_llr(cmat_edge, dbl_n0);
+    bool bool_edge = true;
+    for (unsigned int uint_b = 0; uint_b < 4; uint_b++)
+    {
+        bool_edge = bool_edge && std::isfinite(mat_edge(uint_b)) && (mat_edge(uint_b) > 0) == (mat_edge(4 + uint_b) > 0);
+    }
+    bool_edge = bool_edge && std::isnan(mat_edge(8)) && std::isnan(mat_edge(9));
+    SUSA_TEST_EQ(bool_edge, true, "QAM max-log LLR demapper out of range.");
+
+    // a bit-interleaved coded modulation chain
+    susa::ccode code(2, 1, 2);
+    code.set_generator(7, 0);
+    code.set_generator(5, 1);
+    susa::matrix <uint8_t> mat_info(200, 1, 0);
+    for (unsigned int uint_i = 0; uint_i < 198; uint_i++) mat_info(uint_i) = rng_gen.rand_mask(0x1);
+    susa::matrix <uint8_t> mat_coded = code.encode(mat_info);
+    susa::matrix <char> mat_coded_bits(mat_coded.size(), 1);
+    for (unsigned int uint_i = 0; uint_i < mat_coded.size(); uint_i++) mat_coded_bits(uint_i) = mat_coded(uint_i);
+
+    susa::matrix <std::complex <double> > cmat_noise(mat_coded.size() / 4, 1);
+    rng_gen.fill_complex_normal(cmat_noise, 0.35);
+    susa::matrix <std::complex <double> > cmat_tx = qam_16.modulate_bits(mat_coded_bits);
+    susa::matrix <double> mat_soft = qam_16.demodulate_llr(cmat_tx + cmat_noise, 2 * 0.35 * 0.35);
+    SUSA_TEST_EQ(code.decode_viterbi(mat_soft), mat_info, "QAM soft demapper with a Viterbi decoder.");
+    }
+
     SUSA_TEST_PRINT_STATS();
 
     return (uint_failed);
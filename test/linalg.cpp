@@ -59,6 +59,33 @@ int main(void)
     SUSA_TEST_EQ (experiment, expected, "Singular Value Decomposition (SVD) for a sample matrix.");
     }
 
+    {
+    susa::matrix <double> mat_a("16,  2,  3, 13;5, 11, 10,  8;9,  7,  6, 12;4, 14, 15,  1");
+    susa::matrix <double> mat_s = susa::singular_values(mat_a);
+    SUSA_TEST_EQ_DOUBLE(mat_s(0), 34, "Jacobi singular values.");
+    SUSA_TEST_EQ_DOUBLE(mat_s(1), 17.88854382, "Jacobi singular values.");
+    SUSA_TEST_EQ_DOUBLE(mat_s(2), 4.472135955, "Jacobi singular values.");
+
+    // a wide complex matrix is reconstructed from U S V^H
+    typedef std::complex <double> cplx;
+    susa::matrix <cplx>   mat_c(3, 5);
+    for (size_t sizet_i = 0; sizet_i < mat_c.size(); sizet_i++) mat_c(sizet_i) = cplx(std::cos(1.0 + sizet_i), std::sin(2.0 * sizet_i));
+    susa::matrix <cplx>   mat_u, mat_v;
+    SUSA_TEST_EQ(susa::svd(mat_c, mat_u, mat_s, mat_v), 0, "Jacobi SVD of a complex matrix converges.");
+
+    double dbl_err = 0;
+    for (size_t sizet_r = 0; sizet_r < 3; sizet_r++)
+    {
+        for (size_t sizet_c = 0; sizet_c < 5; sizet_c++)
+        {
+            cplx cplx_sum = 0;
+            for (size_t sizet_k = 0; sizet_k < 3; sizet_k++) cplx_sum += mat_u(sizet_r, sizet_k) * mat_s(sizet_k) * std::conj(mat_v(sizet_c, sizet_k));
+            dbl_err = std::max(dbl_err, std::abs(cplx_sum - mat_c(sizet_r, sizet_c)));
+        }
+    }
+    SUSA_TEST_EQ((dbl_err < 1e-12), true, "Jacobi SVD of a complex matrix.");
+    }
+
     {
     susa::matrix <int> mat_left ("5 6;3 2; 7 4;-4 8");
     susa::matrix <int> mat_right ("5 6 9 -3;-1 -2 0 1");
@@ -67,6 +94,51 @@ int main(void)
     SUSA_TEST_EQ(experiment, expected, "matmul() matrix multiplication.");
     }
 
+    {
+    // large enough for the packed and the threaded paths with ragged edges
+    susa::set_num_threads(3);
+    susa::rng rng_gen(1234);
+    size_t sizet_m = 101, sizet_k = 67, sizet_n = 83;
+    susa::matrix <double> mat_l(sizet_m, sizet_k);
+    susa::matrix <double> mat_r(sizet_k, sizet_n);
+    susa::matrix <std::complex <double> > cmat_l(sizet_m, sizet_k);
+    susa::matrix <std::complex <double> > cmat_r(sizet_k, sizet_n);
+    for (size_t sizet_i = 0; sizet_i < mat_l.size(); sizet_i++)
+    {
+        mat_l(sizet_i)  = rng_gen.randn();
+        cmat_l(sizet_i) = std::complex <double> (rng_gen.randn(), rng_gen.randn());
+    }
+    for (size_t sizet_i = 0; sizet_i < mat_r.size(); sizet_i++)
+    {
+        mat_r(sizet_i)  = rng_gen.randn();
+        cmat_r(sizet_i) = std::complex <double> (rng_gen.randn(), rng_gen.randn());
+    }
+
+    susa::matrix <double> mat_res = susa::matmul(mat_l, mat_r);
+    susa::matrix <std::complex <double> > cmat_res = susa::matmul(cmat_l, cmat_r);
+
+    double dbl_err  = 0;
+    double dbl_cerr = 0;
+    for (size_t sizet_row = 0; sizet_row < sizet_m; sizet_row++)
+    {
+        for (size_t sizet_col = 0; sizet_col < sizet_n; sizet_col++)
+        {
+            double dbl_ref = 0;
+            std::complex <double> cdbl_ref = 0;
+            for (size_t sizet_p = 0; sizet_p < sizet_k; sizet_p++)
+            {
+                dbl_ref  += mat_l(sizet_row, sizet_p) * mat_r(sizet_p, sizet_col);
+                cdbl_ref += cmat_l(sizet_row, sizet_p) * cmat_r(sizet_p, sizet_col);
+            }
+            dbl_err  = std::max(dbl_err, std::abs(dbl_ref - mat_res(sizet_row, sizet_col)));
+            dbl_cerr = std::max(dbl_cerr, std::abs(cdbl_ref - cmat_res(sizet_row, sizet_col)));
+        }
+    }
+    SUSA_TEST_EQ_DOUBLE(dbl_err, 0, "blocked matmul() for double.");
+    SUSA_TEST_EQ_DOUBLE(dbl_cerr, 0, "blocked matmul() for complex double.");
+    susa::set_num_threads(0);
+    }
+
     {
     susa::matrix <int>      mat_a("2, -1, -2;-4, 6, 3;-4, -2, 8");
     susa::lu <int>          solver(mat_a);
@@ -109,6 +181,145 @@ int main(void)
     SUSA_TEST_EQ_DOUBLE(mat_err_sum(0), 0, "compute LUP decomposition");
     }
 
+    {
+    // the tiles of a shape that is not a multiple of the tile size
+    susa::matrix <int>        mat_a(37, 21);
+    for (size_t sizet_i = 0; sizet_i < mat_a.size(); sizet_i++) mat_a(sizet_i) = sizet_i;
+    susa::matrix <int>        mat_t = susa::transpose(mat_a);
+    bool bool_tiled = mat_t.no_rows() == 21 && mat_t.no_cols() == 37;
+    for (size_t sizet_r = 0; sizet_r < 37 && bool_tiled; sizet_r++)
+    {
+        for (size_t sizet_c = 0; sizet_c < 21; sizet_c++) bool_tiled &= mat_t(sizet_c, sizet_r) == mat_a(sizet_r, sizet_c);
+    }
+    SUSA_TEST_EQ(bool_tiled, true, "tiled transpose");
+
+    susa::matrix <int>        mat_in = mat_a;
+    susa::transpose_inplace(mat_in);
+    SUSA_TEST_EQ(mat_in, mat_t, "in-place transpose of a rectangular matrix");
+
+    susa::matrix <int>        mat_sq = mat_a.block_view(0, 0, 21, 21);
+    susa::matrix <int>        mat_sq_t = susa::transpose(mat_sq);
+    susa::transpose_inplace(mat_sq);
+    SUSA_TEST_EQ(mat_sq, mat_sq_t, "in-place transpose of a square matrix");
+
+    susa::matrix <std::complex <double> > mat_c(2, 3);
+    for (size_t sizet_i = 0; sizet_i < mat_c.size(); sizet_i++) mat_c(sizet_i) = std::complex <double> (sizet_i, 1);
+    susa::matrix <std::complex <double> > mat_ch = susa::ctranspose(mat_c);
+    SUSA_TEST_EQ(mat_ch(2, 1), std::complex <double> (5, -1), "conjugate transpose");
+    susa::ctranspose_inplace(mat_c);
+    SUSA_TEST_EQ(mat_c, mat_ch, "in-place conjugate transpose");
+    }
+
+    {
+    susa::matrix <double>     mat_a("[1 2.3 -3.4;8 4.5 1.2;9.1 3 -5]");
+    SUSA_TEST_EQ_DOUBLE(susa::det(mat_a), 148.646, "determinant");
+    SUSA_TEST_EQ_DOUBLE(susa::det(susa::matrix <int> ("[2 0 1;1 3 2;1 1 1]")), 0, "determinant of a singular matrix");
+
+    susa::matrix <std::complex <double> > mat_c(2, 2, std::complex <double> (0));
+    mat_c(0, 1) = std::complex <double> (0, 1);
+    mat_c(1, 0) = 2;
+    SUSA_TEST_EQ_DOUBLE(std::abs(susa::det(mat_c) - std::complex <double> (0, -2)), 0, "determinant of a complex matrix");
+
+    double dbl_sign = 0;
+    SUSA_TEST_EQ_DOUBLE(susa::logdet(mat_a, dbl_sign), std::log(148.646), "logarithm of the determinant");
+    SUSA_TEST_EQ_DOUBLE(susa::logdet(susa::matrix <double> ("[0 2;3 0]"), dbl_sign), std::log(6.0), "logarithm of the determinant");
+    SUSA_TEST_EQ_DOUBLE(dbl_sign, -1, "sign of the determinant");
+    SUSA_TEST_EQ_DOUBLE(susa::logdet_hpd(susa::matrix <double> ("[4 2;2 3]")), std::log(8.0), "logarithm of the determinant of a positive-definite matrix");
+    }
+
+    {
+    // the blocked factorisation across several panels with a block of right-hand sides
+    susa::rng                 rng_gen(7);
+    susa::matrix <double>     mat_a = rng_gen.rand(70, 70);
+    susa::matrix <double>     mat_b = rng_gen.rand(70, 5);
+    susa::lup <double>        solver(mat_a);
+    SUSA_TEST_EQ(solver.decompose(), true, "blocked LUP decomposition");
+
+    susa::matrix <double>     mat_res = susa::matmul(mat_a, solver.solve(mat_b)) - mat_b;
+    double dbl_err = 0;
+    for (size_t sizet_i = 0; sizet_i < mat_res.size(); sizet_i++) dbl_err = std::max(dbl_err, std::abs(mat_res(sizet_i)));
+    SUSA_TEST_EQ((dbl_err < 1e-10), true, "LUP solution of several right-hand sides");
+
+    susa::matrix <double>     mat_copy = mat_a;
+    susa::lup <double>        solver_in(std::move(mat_copy));
+    solver_in.decompose();
+    SUSA_TEST_EQ(solver_in.get_lu(), solver.get_lu(), "LUP decomposition of a moved-in matrix");
+
+    // the moved-in input survives the factorisation
+    solver.decompose_alt();
+    solver_in.decompose_alt();
+    SUSA_TEST_EQ(solver_in.get_lu(), solver.get_lu(), "LUP decompositions of a moved-in matrix");
+    }
+
+    {
+    // a complex Hermitian positive-definite system across several panels
+    typedef std::complex <double> cplx;
+    susa::rng                 rng_gen(11);
+    size_t                    sizet_n = 40;
+    susa::matrix <cplx>       mat_a(sizet_n, sizet_n, cplx(0));
+    susa::matrix <cplx>       mat_x(sizet_n, 1), mat_b(sizet_n, 3);
+    for (size_t sizet_i = 0; sizet_i < sizet_n; sizet_i++) mat_x(sizet_i) = cplx(rng_gen.randn(), rng_gen.randn());
+    for (size_t sizet_i = 0; sizet_i < mat_b.size(); sizet_i++) mat_b(sizet_i) = cplx(rng_gen.randn(), rng_gen.randn());
+    for (size_t sizet_r = 0; sizet_r < sizet_n; sizet_r++)
+    {
+        for (size_t sizet_c = 0; sizet_c < sizet_n; sizet_c++)
+        {
+            double dbl_d = double(sizet_c) - double(sizet_r);
+            mat_a(sizet_r, sizet_c) = std::polar(std::exp(-0.3 * std::abs(dbl_d)), 0.7 * dbl_d);
+        }
+        mat_a(sizet_r, sizet_r) += 0.1;
+    }
+
+    susa::cholesky <cplx>     solver(mat_a);
+    SUSA_TEST_EQ(solver.decompose(), true, "Cholesky decomposition");
+
+    susa::ldl <cplx>          solver_ldl(mat_a);
+    SUSA_TEST_EQ(solver_ldl.decompose(), true, "LDL decomposition");
+
+    susa::matrix <cplx>       mat_rx = mat_a;
+    for (size_t sizet_r = 0; sizet_r < sizet_n; sizet_r++)
+    {
+        for (size_t sizet_c = 0; sizet_c < sizet_n; sizet_c++) mat_rx(sizet_r, sizet_c) += mat_x(sizet_r) * std::conj(mat_x(sizet_c));
+    }
+
+    double dbl_err = 0, dbl_err_ldl = 0, dbl_err_up = 0;
+    susa::matrix <cplx>       mat_res = susa::matmul(mat_a, solver.solve(mat_b)) - mat_b;
+    susa::matrix <cplx>       mat_res_ldl = susa::matmul(mat_a, solver_ldl.solve(mat_b)) - mat_b;
+    solver.update(mat_x);
+    susa::matrix <cplx>       mat_res_up = susa::matmul(mat_rx, solver.solve(mat_b)) - mat_b;
+    for (size_t sizet_i = 0; sizet_i < mat_b.size(); sizet_i++)
+    {
+        dbl_err     = std::max(dbl_err, std::abs(mat_res(sizet_i)));
+        dbl_err_ldl = std::max(dbl_err_ldl, std::abs(mat_res_ldl(sizet_i)));
+        dbl_err_up  = std::max(dbl_err_up, std::abs(mat_res_up(sizet_i)));
+    }
+    SUSA_TEST_EQ((dbl_err < 1e-10), true, "Cholesky solution of several right-hand sides");
+    SUSA_TEST_EQ((dbl_err_ldl < 1e-10), true, "LDL solution of several right-hand sides");
+    SUSA_TEST_EQ((dbl_err_up < 1e-10), true, "Cholesky rank-1 update");
+
+    susa::cholesky <cplx>     solver_ref(mat_a);
+    solver_ref.decompose();
+    solver.downdate(mat_x);
+    double dbl_err_down = 0;
+    for (size_t sizet_i = 0; sizet_i < mat_a.size(); sizet_i++)
+    {
+        dbl_err_down = std::max(dbl_err_down, std::abs(solver.get_lower()(sizet_i) - solver_ref.get_lower()(sizet_i)));
+    }
+    SUSA_TEST_EQ((dbl_err_down < 1e-10), true, "Cholesky rank-1 downdate");
+
+    susa::matrix <cplx>       mat_copy = mat_a;
+    susa::cholesky <cplx>     solver_in(std::move(mat_copy));
+    solver_in.decompose();
+    SUSA_TEST_EQ(solver_in.decompose(), true, "Cholesky decompositions of a moved-in matrix");
+    SUSA_TEST_EQ(solver_in.get_lower(), solver_ref.get_lower(), "Cholesky factor of a moved-in matrix");
+
+    mat_copy = mat_a;
+    susa::ldl <cplx>          solver_ldl_in(std::move(mat_copy));
+    solver_ldl_in.decompose();
+    SUSA_TEST_EQ(solver_ldl_in.decompose(), true, "LDL decompositions of a moved-in matrix");
+    SUSA_TEST_EQ(solver_ldl_in.get_ldl(), solver_ldl.get_ldl(), "LDL factors of a moved-in matrix");
+    }
+
     {
     susa::matrix <float>      mat_a("1 0 2;-1 5 0; 0 3 -9");
     susa::matrix <float>      mat_res = susa::inv(mat_a);
@@ -119,6 +330,65 @@ int main(void)
     std::cout << susa::sum(susa::sum(mat_exp - mat_res)) << std::endl;
     }
 
+    {
+    // a banded matrix with duplicated triplets, large enough for the row-parallel product
+    size_t sizet_n = 300;
+    std::vector <unsigned int> vec_row, vec_col;
+    std::vector <double>       vec_val;
+    for (unsigned int uint_i = 0; uint_i < sizet_n; uint_i++)
+    {
+        for (unsigned int uint_j = uint_i + 3 > sizet_n ? sizet_n - 3 : uint_i; uint_j < uint_i + 3 && uint_j < sizet_n; uint_j++)
+        {
+            vec_row.push_back(uint_i);
+            vec_col.push_back(uint_j);
+            vec_val.push_back(0.5 * uint_i - 0.25 * uint_j + 1);
+        }
+        vec_row.push_back(uint_i);
+        vec_col.push_back(uint_i);
+        vec_val.push_back(1);
+    }
+    susa::sparse_matrix <double> mat_s(sizet_n, sizet_n + 2, vec_row, vec_col, vec_val);
+    susa::matrix <double>        mat_d = mat_s.dense();
+    susa::matrix <double>        mat_x(sizet_n + 2, 3);
+    for (size_t sizet_i = 0; sizet_i < mat_x.size(); sizet_i++) mat_x(sizet_i) = std::sin(0.1 * sizet_i);
+
+    auto max_error = [](const susa::matrix <double>& mat_a, const susa::matrix <double>& mat_b)
+    {
+        double dbl_err = mat_a.size() == mat_b.size() ? 0 : 1;
+        for (size_t sizet_i = 0; sizet_i < std::min(mat_a.size(), mat_b.size()); sizet_i++)
+            dbl_err = std::max(dbl_err, std::abs(mat_a(sizet_i) - mat_b(sizet_i)));
+        return dbl_err;
+    };
+
+    SUSA_TEST_EQ((mat_s.nnz() == 3 * sizet_n && mat_s(4, 4) == 3 && mat_s(4, 7) == 0), true, "sparse triplets");
+    SUSA_TEST_EQ((max_error(susa::matmul(mat_s, mat_x), susa::matmul(mat_d, mat_x)) < 1e-12), true, "CSR sparse-dense product");
+    SUSA_TEST_EQ((max_error(susa::matmul(mat_s.to_csc(), mat_x), susa::matmul(mat_d, mat_x)) < 1e-12), true, "CSC sparse-dense product");
+    SUSA_TEST_EQ((max_error(susa::matmul(susa::transpose(mat_x), susa::transpose(mat_s)), susa::transpose(susa::matmul(mat_d, mat_x))) < 1e-12),
+      true, "dense-sparse product");
+    SUSA_TEST_EQ(susa::sparse_matrix <double> (mat_d, susa::CSC).to_csr().dense(), mat_d, "sparse format conversion");
+    }
+
+    {
+    susa::fixed_matrix <double, 4, 4> mat_a {4, 1, 2, 0, 1, 5, 1, 2, 2, 1, 6, 1, 0, 2, 1, 7};
+    susa::matrix <double>             mat_d(mat_a);
+    SUSA_TEST_EQ_DOUBLE(susa::det(mat_a), susa::det(mat_d), "closed-form 4x4 determinant");
+    susa::matrix <double>             mat_err = susa::matrix <double> (susa::inv(mat_a)) - susa::inv(mat_d);
+    double dbl_err = 0;
+    for (size_t sizet_i = 0; sizet_i < mat_err.size(); sizet_i++) dbl_err = std::max(dbl_err, std::abs(mat_err(sizet_i)));
+    SUSA_TEST_EQ((dbl_err < 1e-12), true, "closed-form 4x4 inverse");
+
+    susa::fixed_matrix <double, 3, 3> mat_b {2, -1, 0, -1, 2, -1, 0, -1, 2};
+    susa::fixed_vector <double, 3>    vec_x {1, 2, 3};
+    susa::fixed_vector <double, 3>    vec_y = susa::matmul(mat_b, susa::linsolve(mat_b, vec_x)) - vec_x;
+    SUSA_TEST_EQ((susa::det(mat_b) == 4 && std::abs(vec_y(0)) + std::abs(vec_y(1)) + std::abs(vec_y(2)) < 1e-12), true, "closed-form 3x3 solve");
+
+    typedef std::complex <double> cplx;
+    susa::fixed_matrix <cplx, 2, 2> mat_c {cplx(1, 1), 2, 3, cplx(0, -1)};
+    SUSA_TEST_EQ((susa::det(mat_c) == cplx(-5, -1) && std::abs(susa::matmul(mat_c, susa::inv(mat_c))(0, 1)) < 1e-12), true,
+      "closed-form complex 2x2 inverse");
+    SUSA_TEST_EQ((static_cast <susa::matrix <double> > (susa::transpose(mat_a)) == susa::transpose(mat_d)), true, "fixed matrix conversion");
+    }
+
 
     SUSA_TEST_PRINT_STATS();
 
@@ -39,6 +39,278 @@ int main(void)
         susa::matrix<int> mat_res = conv(mat_a, mat_b);
         SUSA_TEST_EQ(mat_res, mat_exp, "convolution.");
     }
+    {
+        susa::matrix<int> mat_a("[1 2;3 4;5 6]");
+        susa::matrix<int> mat_b("[1 1;1 -1]");
+        susa::matrix<int> mat_exp("[1 2;4 2;8 2;5 -6]");
+        SUSA_TEST_EQ(conv(mat_a, mat_b), mat_exp, "column-wise convolution of two matrices.");
+    }
+    {
+        susa::matrix <int> mat_b("[1 -1 2]");
+        susa::matrix <int> mat_x("[1 0;2 1;3 0;4 0]");
+        SUSA_TEST_EQ(filter(mat_b, susa::matrix <int> (1, 1, 1), mat_x, 2), susa::matrix <int> ("[1 0;1 1;3 -1;5 2;2 0;8 0]"), "column-wise FIR filter with a tail.");
+        SUSA_TEST_EQ(filter(mat_b, susa::matrix <int> (1, 1, 1), susa::matrix <int> (1, 1, 3), 2), susa::matrix <int> ("[3;-3;6]"), "FIR filter of a scalar.");
+
+        // the impulse response of the recursion y(n) = x(n) + 0.5 y(n-1) - 0.25 y(n-2) in the tail
+        susa::matrix <double> mat_iir = filter(susa::matrix <double> ("[1 0 0 0]"), susa::matrix <double> ("[1 -0.5 0.25]"),
+                                               susa::matrix <double> ("[1 2]"), 3);
+        SUSA_TEST_EQ(mat_iir.no_cols(), 5, "IIR filter size.");
+        SUSA_TEST_EQ_DOUBLE(mat_iir(1), 2.5, "IIR filter.");
+        SUSA_TEST_EQ_DOUBLE(mat_iir(2), 1, "IIR filter tail.");
+        SUSA_TEST_EQ_DOUBLE(mat_iir(3), -0.125, "IIR filter tail.");
+    }
+    {
+        // the overlap-save (real packed and complex) against the direct form
+        susa::rng rng_gen(1618);
+        susa::matrix <double> mat_x(1, 3000);
+        susa::matrix <double> mat_h(1, 200);
+        susa::matrix <std::complex <double> > cmat_x(777, 2);
+        susa::matrix <std::complex <double> > cmat_h(150, 1);
+        for (size_t sizet_i = 0; sizet_i < mat_x.size(); sizet_i++) mat_x(sizet_i) = rng_gen.randn();
+        for (size_t sizet_i = 0; sizet_i < mat_h.size(); sizet_i++) mat_h(sizet_i) = rng_gen.randn();
+        for (size_t sizet_i = 0; sizet_i < cmat_x.size(); sizet_i++) cmat_x(sizet_i) = std::complex <double> (rng_gen.randn(), rng_gen.randn());
+        for (size_t sizet_i = 0; sizet_i < cmat_h.size(); sizet_i++) cmat_h(sizet_i) = std::complex <double> (rng_gen.randn(), rng_gen.randn());
+
+        susa::matrix <double> mat_fast = conv(mat_x, mat_h);
+        susa::matrix <std::complex <double> > cmat_fast = conv(cmat_x, cmat_h);
+        susa::set_fft_conv_threshold(std::numeric_limits <size_t>::max());
+        susa::matrix <double> mat_direct = conv(mat_x, mat_h);
+        susa::matrix <std::complex <double> > cmat_direct = conv(cmat_x, cmat_h);
+        susa::set_fft_conv_threshold(64);
+
+        double dbl_err = 0;
+        for (size_t sizet_i = 0; sizet_i < mat_direct.size(); sizet_i++)
+        {
+            dbl_err = std::max(dbl_err, std::abs(mat_fast(sizet_i) - mat_direct(sizet_i)));
+        }
+        SUSA_TEST_EQ(mat_fast.no_cols(), 3199, "FFT convolution size.");
+        SUSA_TEST_EQ_DOUBLE(dbl_err, 0, "FFT convolution of real vectors.");
+
+        dbl_err = 0;
+        for (size_t sizet_i = 0; sizet_i < cmat_direct.size(); sizet_i++)
+        {
+            dbl_err = std::max(dbl_err, std::abs(cmat_fast(sizet_i) - cmat_direct(sizet_i)));
+        }
+        SUSA_TEST_EQ(cmat_fast.no_rows(), 926, "FFT convolution size.");
+        SUSA_TEST_EQ_DOUBLE(dbl_err, 0, "column-wise FFT convolution of complex matrices.");
+    }
+    {
+        // block by block streaming against the one-shot filter
+        susa::rng rng_gen(577);
+        susa::matrix <double> mat_x(1, 100);
+        for (size_t sizet_i = 0; sizet_i < mat_x.size(); sizet_i++) mat_x(sizet_i) = rng_gen.randn();
+        susa::matrix <double> mat_b("[0.5 0.3 -0.2 0.1]");
+        susa::matrix <double> mat_a("[1 -0.6 0.25]");
+
+        susa::matrix <double> mat_fir = filter(mat_b, susa::matrix <double> (1, 1, 1), mat_x);
+        susa::matrix <double> mat_iir = filter(mat_b, mat_a, mat_x);
+
+        susa::fir_filter <double> fir(mat_b);
+        susa::iir_filter <double> iir(mat_b, mat_a);
+        susa::matrix <double> mat_out;
+        double dbl_fir_err = 0;
+        double dbl_iir_err = 0;
+        for (size_t sizet_blk = 0; sizet_blk < 100; sizet_blk += 25)
+        {
+            susa::matrix <double> mat_blk = mat_x.mid(sizet_blk, sizet_blk + 24);
+            fir.process(mat_blk, mat_out);
+            for (size_t sizet_i = 0; sizet_i < 25; sizet_i++)
+                dbl_fir_err = std::max(dbl_fir_err, std::abs(mat_out(sizet_i) - mat_fir(sizet_blk + sizet_i)));
+            iir.process(mat_blk, mat_out);
+            for (size_t sizet_i = 0; sizet_i < 25; sizet_i++)
+                dbl_iir_err = std::max(dbl_iir_err, std::abs(mat_out(sizet_i) - mat_iir(sizet_blk + sizet_i)));
+        }
+        SUSA_TEST_EQ_DOUBLE(dbl_fir_err, 0, "streaming FIR filter.");
+        SUSA_TEST_EQ_DOUBLE(dbl_iir_err, 0, "streaming IIR filter.");
+        SUSA_TEST_EQ(fir.get_state()(0), mat_x(99), "FIR filter state.");
+        SUSA_TEST_EQ(fir.get_state()(2), mat_x(97), "FIR filter state.");
+
+        // seeding the delay line continues the stream
+        susa::fir_filter <double> fir_seeded(mat_b);
+        fir_seeded.set_state(fir.get_state());
+        SUSA_TEST_EQ(fir_seeded.process(1.0), fir.process(1.0), "seeded FIR filter.");
+        fir.reset();
+        SUSA_TEST_EQ(fir.process(2.0), 1.0, "FIR filter reset.");
+    }
+    {
+        // the polyphase resampler against upsample, filter and downsample
+        susa::rng rng_gen(1414);
+        susa::matrix <std::complex <double> > cmat_x(30, 1);
+        for (size_t sizet_i = 0; sizet_i < cmat_x.size(); sizet_i++) cmat_x(sizet_i) = std::complex <double> (rng_gen.randn(), rng_gen.randn());
+        susa::matrix <double> mat_h(1, 19);
+        for (size_t sizet_i = 0; sizet_i < mat_h.size(); sizet_i++) mat_h(sizet_i) = rng_gen.randn();
+
+        susa::matrix <std::complex <double> > cmat_ref = susa::downsample(filter(mat_h, susa::matrix <double> (1, 1, 1), susa::upsample(cmat_x, 4)), 3);
+
+        susa::polyphase_resampler <std::complex <double> > resampler(4, 3, mat_h);
+        susa::matrix <std::complex <double> > cmat_y(resampler.no_outputs(30), 1);
+        size_t sizet_no = resampler.process(cmat_x.data(), 7, cmat_y.data());
+        sizet_no += resampler.process(cmat_x.data() + 7, 13, cmat_y.data() + sizet_no);
+        sizet_no += resampler.process(cmat_x.data() + 20, 10, cmat_y.data() + sizet_no);
+
+        double dbl_err = 0;
+        for (size_t sizet_i = 0; sizet_i < cmat_ref.size(); sizet_i++) dbl_err = std::max(dbl_err, std::abs(cmat_y(sizet_i) - cmat_ref(sizet_i)));
+        SUSA_TEST_EQ(sizet_no, cmat_ref.size(), "polyphase resampler output size.");
+        SUSA_TEST_EQ_DOUBLE(dbl_err, 0, "streaming polyphase resampler.");
+
+        // the Root-Raised Cosine pulse shaping at eight samples per symbol
+        susa::polyphase_resampler <double> shaper(8, 1, 0.5, 4);
+        susa::matrix <double> mat_s("[1 -1 -1 1 1]");
+        susa::matrix <double> mat_shaped = shaper.process(mat_s);
+        susa::matrix <double> mat_rrc = susa::RRCosine(8, 1, 0.5, 33).get();
+        susa::matrix <double> mat_conv = filter(mat_rrc, susa::matrix <double> (1, 1, 1), susa::upsample(susa::transpose(mat_s), 8));
+        SUSA_TEST_EQ(mat_shaped.no_cols(), 40, "RRC pulse shaping size.");
+        SUSA_TEST_EQ_DOUBLE(mat_shaped(37), mat_conv(37), "RRC pulse shaping.");
+        SUSA_TEST_EQ_DOUBLE(mat_shaped(12), mat_conv(12), "RRC pulse shaping.");
+    }
+    {
+        // the radix-2^2 (odd and even number of stages) and the Bluestein paths
+        susa::rng rng_gen(2718);
+        size_t arr_sizes[] = {8, 64, 12, 1000};
+        for (size_t sizet_s = 0; sizet_s < 4; sizet_s++)
+        {
+            size_t sizet_n = arr_sizes[sizet_s];
+            susa::matrix <std::complex <double> > mat_x(sizet_n, 2);
+            for (size_t sizet_i = 0; sizet_i < mat_x.size(); sizet_i++)
+            {
+                mat_x(sizet_i) = std::complex <double> (rng_gen.randn(), rng_gen.randn());
+            }
+
+            susa::matrix <std::complex <double> > mat_y = mat_x;
+            susa::fft_plan <double> plan(sizet_n);
+            plan.forward(mat_y);
+
+            double dbl_err = 0;
+            for (size_t sizet_col = 0; sizet_col < 2; sizet_col++)
+            {
+                for (size_t sizet_k = 0; sizet_k < sizet_n; sizet_k++)
+                {
+                    std::complex <double> cplx_ref = 0;
+                    for (size_t sizet_t = 0; sizet_t < sizet_n; sizet_t++)
+                    {
+                        cplx_ref += mat_x(sizet_t, sizet_col)
+                                  * std::polar(1.0, -2.0 * PI * (double)((sizet_k * sizet_t) % sizet_n) / sizet_n);
+                    }
+                    dbl_err = std::max(dbl_err, std::abs(cplx_ref - mat_y(sizet_k, sizet_col)) / sizet_n);
+                }
+            }
+            SUSA_TEST_EQ_DOUBLE(dbl_err, 0, "batched FFT plan against the DFT.");
+
+            plan.inverse(mat_y);
+            dbl_err = 0;
+            for (size_t sizet_i = 0; sizet_i < mat_x.size(); sizet_i++)
+            {
+                dbl_err = std::max(dbl_err, std::abs(mat_x(sizet_i) - mat_y(sizet_i)));
+            }
+            SUSA_TEST_EQ_DOUBLE(dbl_err, 0, "inverse FFT plan.");
+        }
+
+        std::vector <std::complex <double> > vec_x = {1, 2, 3, 4};
+        susa::fft <std::complex <double> > fft_legacy;
+        std::vector <std::complex <double> > vec_y = fft_legacy.radix2(vec_x);
+        SUSA_TEST_EQ_DOUBLE(std::abs(vec_y[0] - std::complex <double> (10, 0)), 0, "FFT radix2.");
+        SUSA_TEST_EQ_DOUBLE(std::abs(vec_y[1] - std::complex <double> (-2, 2)), 0, "FFT radix2.");
+    }
+    {
+        // the even size uses a half size transform and the odd size a full one
+        susa::rng rng_gen(3141);
+        size_t arr_sizes[] = {16, 15};
+        for (size_t sizet_s = 0; sizet_s < 2; sizet_s++)
+        {
+            size_t sizet_n = arr_sizes[sizet_s];
+            susa::matrix <double> mat_x(1, sizet_n);
+            susa::matrix <std::complex <double> > mat_c(1, sizet_n);
+            for (size_t sizet_i = 0; sizet_i < sizet_n; sizet_i++)
+            {
+                mat_x(sizet_i) = rng_gen.randn();
+                mat_c(sizet_i) = mat_x(sizet_i);
+            }
+
+            susa::rfft_plan <double> rplan(sizet_n);
+            susa::fft_plan <double>  plan(sizet_n);
+            susa::matrix <std::complex <double> > mat_r = rplan.forward(mat_x);
+            plan.forward(mat_c);
+
+            double dbl_err = 0;
+            for (size_t sizet_k = 0; sizet_k <= sizet_n / 2; sizet_k++)
+            {
+                dbl_err = std::max(dbl_err, std::abs(mat_r(sizet_k) - mat_c(sizet_k)));
+            }
+            SUSA_TEST_EQ(mat_r.size(), sizet_n / 2 + 1, "real-input FFT size.");
+            SUSA_TEST_EQ_DOUBLE(dbl_err, 0, "real-input FFT.");
+
+            susa::matrix <double> mat_back = rplan.inverse(mat_r);
+            dbl_err = 0;
+            for (size_t sizet_i = 0; sizet_i < sizet_n; sizet_i++)
+            {
+                dbl_err = std::max(dbl_err, std::abs(mat_back(sizet_i) - mat_x(sizet_i)));
+            }
+            SUSA_TEST_EQ_DOUBLE(dbl_err, 0, "complex-to-real inverse FFT.");
+        }
+    }
+    {
+        // all the kernel variants round identically
+        susa::rng rng_gen(1031);
+        std::vector <double> vec_x(700), vec_b(13), vec_ref(712), vec_y(712);
+        for (size_t sizet_i = 0; sizet_i < vec_x.size(); sizet_i++) vec_x[sizet_i] = rng_gen.randn();
+        for (size_t sizet_i = 0; sizet_i < vec_b.size(); sizet_i++) vec_b[sizet_i] = rng_gen.randn();
+
+        const susa::cpu_kernels* ptr_generic = susa::cpu_kernels_for(susa::ISA_GENERIC);
+        ptr_generic->fir_f64(vec_b.data(), vec_b.size(), vec_x.data(), vec_x.size(), vec_ref.data(), 0, vec_ref.size());
+
+        bool bool_same = true;
+        const susa::cpu_isa isa_all[] = {susa::ISA_SSE2, susa::ISA_AVX2, susa::ISA_AVX512, susa::ISA_NEON};
+        for (size_t sizet_i = 0; sizet_i < 4; sizet_i++)
+        {
+            const susa::cpu_kernels* ptr_kernels = susa::cpu_kernels_for(isa_all[sizet_i]);
+            if (ptr_kernels == nullptr) continue;
+            ptr_kernels->fir_f64(vec_b.data(), vec_b.size(), vec_x.data(), vec_x.size(), vec_y.data(), 0, vec_y.size());
+            bool_same = bool_same && vec_y == vec_ref;
+        }
+        SUSA_TEST_EQ(bool_same, true, "FIR kernel variants.");
+
+        // the add-compare-select of 256 states, the odd predecessors win where their metric is larger
+        std::vector <int16_t>  vec_metric(256), vec_bm(512), vec_next(256);
+        std::vector <uint8_t>  vec_mask(256);
+        std::vector <uint64_t> vec_dec_ref(4), vec_dec(4);
+        for (size_t sizet_i = 0; sizet_i < vec_metric.size(); sizet_i++) vec_metric[sizet_i] = static_cast <int16_t> (rng_gen.rand_mask(2047)) - 1024;
+        for (size_t sizet_i = 0; sizet_i < vec_bm.size(); sizet_i++) vec_bm[sizet_i] = static_cast <int16_t> (rng_gen.rand_mask(255)) - 128;
+        ptr_generic->viterbi_acs_i16(vec_metric.data(), vec_bm.data(), 128, vec_next.data(), vec_mask.data(), vec_dec_ref.data());
+
+        bool bool_acs = ((vec_dec_ref[0] & 0x1) != 0) == (vec_metric[1] + vec_bm[128] > vec_metric[0] + vec_bm[0]);
+        for (size_t sizet_i = 0; sizet_i < 4; sizet_i++)
+        {
+            const susa::cpu_kernels* ptr_kernels = susa::cpu_kernels_for(isa_all[sizet_i]);
+            if (ptr_kernels == nullptr) continue;
+            ptr_kernels->viterbi_acs_i16(vec_metric.data(), vec_bm.data(), 128, vec_next.data(), vec_mask.data(), vec_dec.data());
+            bool_acs = bool_acs && vec_dec == vec_dec_ref;
+        }
+        SUSA_TEST_EQ(bool_acs, true, "Viterbi ACS kernel variants.");
+
+        // the max-log LLRs of a 64-QAM axis, the NaN is sliced like in the generic kernel
+        std::vector <double> vec_llr_ref(3 * vec_x.size()), vec_llr(3 * vec_x.size());
+        for (size_t sizet_i = 0; sizet_i < vec_x.size(); sizet_i++) vec_x[sizet_i] *= 4;
+        vec_x[7] = std::numeric_limits <double>::quiet_NaN();
+        ptr_generic->qam_max_log_llr_f64(vec_x.data(), vec_x.size(), 8, 3, 1.5, vec_llr_ref.data());
+
+        bool_same = true;
+        for (size_t sizet_i = 0; sizet_i < 4; sizet_i++)
+        {
+            const susa::cpu_kernels* ptr_kernels = susa::cpu_kernels_for(isa_all[sizet_i]);
+            if (ptr_kernels == nullptr) continue;
+            ptr_kernels->qam_max_log_llr_f64(vec_x.data(), vec_x.size(), 8, 3, 1.5, vec_llr.data());
+            for (size_t sizet_k = 0; sizet_k < vec_llr.size(); sizet_k++)
+            {
+                bool_same = bool_same && (vec_llr[sizet_k] == vec_llr_ref[sizet_k]
+                  || (std::isnan(vec_llr[sizet_k]) && std::isnan(vec_llr_ref[sizet_k])));
+            }
+        }
+        SUSA_TEST_EQ(bool_same, true, "QAM LLR kernel variants.");
+
+        susa::cpu_isa isa_best = susa::cpu_dispatch().isa;
+        SUSA_TEST_EQ((susa::cpu_select(susa::ISA_GENERIC) && susa::cpu_dispatch().isa == susa::ISA_GENERIC), true, "select the generic kernels.");
+        susa::cpu_select(isa_best);
+    }
 
     SUSA_TEST_PRINT_STATS();
 
@@ -89,6 +89,116 @@ int main(void)
   SUSA_TEST_EQ(mat_h.size(), mat_a.size(), "matrix copy constructor cols.");
 
 
+  {
+  susa::matrix <double> mat_x("[1 2;3 4]");
+  susa::matrix <double> mat_y("[5 6;7 8]");
+  susa::matrix <double> mat_c("[1 1;1 1]");
+  susa::matrix <double> mat_eager = mat_x * 2.0 + mat_y * 3.0 - mat_c;
+  susa::matrix <double> mat_lazy  = susa::lazy(mat_x) * 2.0 + susa::lazy(mat_y) * 3.0 - mat_c;
+  SUSA_TEST_EQ(mat_lazy, mat_eager, "lazy expression evaluation.");
+
+  mat_x = -susa::lazy(mat_x) / 2.0 + mat_x;
+  SUSA_TEST_EQ(mat_x, susa::matrix <double> ("[0.5 1;1.5 2]"), "lazy expression aliasing the destination.");
+
+  mat_c += 2.0 * susa::lazy(mat_y);
+  SUSA_TEST_EQ(mat_c, susa::matrix <double> ("[11 13;15 17]"), "lazy expression compound assignment.");
+
+  susa::matrix <double> mat_literal = susa::lazy(mat_y) * 2 + 1;
+  SUSA_TEST_EQ(mat_literal, mat_y * 2.0 + 1.0, "lazy expression with int literals.");
+  }
+
+  {
+  susa::matrix <int> mat_x("[1 2;3 4]");
+  susa::matrix <int> mat_y("[5 6;7 8]");
+  susa::matrix <int> mat_z;
+  mat_z = susa::matrix <int> (mat_y);
+  SUSA_TEST_EQ(mat_z, mat_y, "move assignment.");
+
+  mat_z = std::move(mat_x);
+  SUSA_TEST_EQ(mat_x.size(), 0, "move assignment releases the source.");
+  SUSA_TEST_EQ(mat_z, susa::matrix <int> ("[1 2;3 4]"), "move assignment.");
+
+  SUSA_TEST_EQ((mat_z + mat_y) * 2, susa::matrix <int> ("[12 16;20 24]"), "rvalue operators.");
+  SUSA_TEST_EQ(mat_y - (mat_z * 2), susa::matrix <int> ("[3 2;1 0]"), "rvalue operators.");
+  SUSA_TEST_EQ(10 - (mat_z + 1), susa::matrix <int> ("[8 7;6 5]"), "rvalue operators.");
+
+  (mat_z += mat_y) -= 1;
+  SUSA_TEST_EQ(mat_z, susa::matrix <int> ("[5 7;9 11]"), "compound assignment returns a reference.");
+  }
+
+  {
+  susa::aligned_allocator alloc_aligned(64);
+  susa::pool_allocator    alloc_pool;
+  susa::matrix <double>   mat_heap("[1 2;3 4]");
+
+  {
+  susa::allocator_scope scope(alloc_aligned);
+  susa::matrix <double> mat_x(7, 3, 1.5);
+  SUSA_TEST_EQ(reinterpret_cast <size_t> (mat_x.data()) % 64, 0, "aligned allocator.");
+  mat_x = mat_heap;
+  SUSA_TEST_EQ(mat_x, mat_heap, "copy between allocators.");
+  }
+
+  {
+  susa::allocator_scope scope(alloc_pool);
+  const double* ptr_first;
+  {
+  susa::matrix <double> mat_x(4, 4, 2.0);
+  ptr_first = mat_x.data();
+  }
+  susa::matrix <double> mat_y(3, 5, 1.0);
+  SUSA_TEST_EQ((mat_y.data() == ptr_first), true, "pool allocator reuses a released block.");
+  mat_y = mat_y + mat_heap(3);
+  SUSA_TEST_EQ(mat_y(14), 5, "pool allocator.");
+  }
+
+  susa::arena_allocator& alloc_arena = susa::thread_arena();
+  {
+  susa::allocator_scope scope(alloc_arena);
+  susa::matrix <int> mat_x(8, 8, 3);
+  susa::matrix <int> mat_y = mat_x * 2;
+  SUSA_TEST_EQ((alloc_arena.used() > 0), true, "arena allocator.");
+  SUSA_TEST_EQ(mat_y(63), 6, "arena allocator.");
+  }
+  alloc_arena.reset();
+  SUSA_TEST_EQ(alloc_arena.used(), 0, "arena allocator reset.");
+
+  // a block released after a reset does not rewind the arena under a live block
+  void* ptr_stale = alloc_arena.allocate(256);
+  alloc_arena.reset();
+  void* ptr_live  = alloc_arena.allocate(256);
+  alloc_arena.deallocate(ptr_stale, 256);
+  void* ptr_next  = alloc_arena.allocate(256);
+  SUSA_TEST_EQ((ptr_next != ptr_live), true, "arena allocator stale release.");
+  alloc_arena.reset();
+
+  // the heap buffer is resized through its own allocator
+  mat_heap.resize(3, 3);
+  SUSA_TEST_EQ(mat_heap.size(), 9, "heap allocator resize.");
+  }
+
+  {
+  susa::matrix <int> mat_x("[1 2 3;4 5 6;7 8 9]");
+  SUSA_TEST_EQ(susa::matrix <int> (mat_x.row_view(1)), mat_x.row(1), "row view.");
+  SUSA_TEST_EQ(susa::matrix <int> (mat_x.col_view(2)), mat_x.col(2), "column view.");
+  SUSA_TEST_EQ(susa::matrix <int> (mat_x.block_view(1, 1, 2, 2)), susa::matrix <int> ("[5 6;8 9]"), "block view.");
+  SUSA_TEST_EQ(mat_x.row_view(2).right(2)(0), 8, "vector slice of a row view.");
+
+  susa::matrix <int> mat_v("[1 2 3 4 5 6 7]");
+  SUSA_TEST_EQ(susa::matrix <int> (mat_v.mid_view(2, 4)), mat_v.mid(2, 4), "mid view.");
+  SUSA_TEST_EQ(susa::matrix <int> (mat_v.view().strided(1, 3, 2)), susa::matrix <int> ("[2 4 6]"), "strided view.");
+
+  mat_x.block_view(0, 0, 2, 2) = mat_x.block_view(1, 1, 2, 2) * 0;
+  mat_x.col_view(2) += mat_x.col_view(1);
+  SUSA_TEST_EQ(mat_x, susa::matrix <int> ("[0 0 3;0 0 6;7 8 17]"), "assignment through views.");
+
+  mat_x.set_row(0, mat_v.left_view(3));
+  SUSA_TEST_EQ(mat_x.row(0), susa::matrix <int> ("[1 2 3]"), "set a row from a view.");
+
+  mat_x = mat_x.col_view(2);
+  SUSA_TEST_EQ(mat_x, susa::matrix <int> ("[3;6;17]"), "assignment of a view of the destination.");
+  }
+
   susa::array <int> arr_a({21,6,5,15,43});
   arr_a(2,4,3,0,1) = 55;
   arr_a(12,4,3,5,1) = 32;
@@ -97,6 +207,67 @@ int main(void)
   SUSA_TEST_EQ(55, arr_b(2,4,3,0,1), "array copy assignment.");
   SUSA_TEST_EQ(32, arr_b(12,4,3,5,1), "array copy assignment.");
 
+  // antenna x subcarrier x symbol x frame
+  susa::array <int, 4> arr_t(2, 12, 7, 3);
+  for (size_t sizet_i = 0; sizet_i < arr_t.size(); sizet_i++) arr_t.data()[sizet_i] = sizet_i;
+  const susa::array <int, 4>& arr_c = arr_t;
+  SUSA_TEST_EQ((arr_c(1, 5, 3, 2) == int(1 + 2 * (5 + 12 * (3 + 7 * 2))) && arr_t.stride(3) == 168), true, "fixed rank array index.");
+  SUSA_TEST_EQ((arr_c.end() - arr_c.begin() == 504 && arr_b.no_dims() == 5), true, "array iteration.");
+  SUSA_TEST_EQ(susa::sum(arr_c.slice(1, 1, 0, 3, 2))(0), (12 * (1 + 2 * 12 * (3 + 7 * 2)) + 2 * 66), "array slice along an axis.");
+  SUSA_TEST_EQ(susa::max(arr_t.slice2(1, 2, 0, 4, 1, 0), susa::AXIS_ALL)(0), 47, "array two dimensional slice.");
+
+  // the NumPy files keep the type, the shape and the column-major order
+  susa::matrix <double> mat_npy("[1.5 -2 3; 4 5.25 -6]");
+  susa::matrix <double> mat_loaded;
+  SUSA_TEST_EQ((susa::save_npy("susa_test.npy", mat_npy) && susa::load_npy("susa_test.npy", mat_loaded)), true, "npy save and load.");
+  SUSA_TEST_EQ((mat_loaded.no_rows() == 2 && mat_loaded.no_cols() == 3 && mat_loaded == mat_npy), true, "npy matrix round trip.");
+  {
+    susa::mapped_npy npy_map("susa_test.npy");
+    susa::matrix_view <const double> view_map = npy_map.view <double> ();
+    SUSA_TEST_EQ((npy_map.is_open() && npy_map.header().sizet_offset % 64 == 0 && view_map(1, 2) == -6 && view_map.no_cols() == 3),
+      true, "npy memory mapped view.");
+    SUSA_TEST_EQ((npy_map.data <float> () == nullptr), true, "npy memory mapped type check.");
+  }
+  susa::array <int, 4> arr_loaded;
+  SUSA_TEST_EQ((susa::save_npy("susa_test.npy", arr_t) && susa::load_npy("susa_test.npy", arr_loaded)
+    && arr_loaded(1, 5, 3, 2) == arr_t(1, 5, 3, 2) && arr_loaded.dim(2) == 7), true, "npy array round trip.");
+  std::remove("susa_test.npy");
+
+  susa::matrix <uint8_t> mat_bits("[1 0 1 1 0 0 0 1 1 1 0 1 0 1 1 0 0 1 1 1 0 1 0 1 1 0 0 1 1 1 0 1 0 1 1 0 0 1 1 1 0 1 0 1 1 0 0 1 1 1 0 1 0 1 1 0 0 1 1 1 0 1 0 1 1 1 0 1]");
+  susa::bitvec bv_a(mat_bits);
+  susa::bitvec bv_b(bv_a);
+  bv_b.reset(2);
+  bv_b.set(66);
+  bv_b.assign(67, false);
+  SUSA_TEST_EQ(bv_a.no_words(), 2, "bitvec words.");
+  SUSA_TEST_EQ(bv_a.unpack(), susa::transpose(mat_bits), "bitvec pack and unpack.");
+  SUSA_TEST_EQ(bv_a.count(), 41, "bitvec count.");
+  SUSA_TEST_EQ(susa::hamming_distance(bv_a, bv_b), 3, "bitvec Hamming distance.");
+  SUSA_TEST_EQ((bv_a ^ bv_b).count(), 3, "bitvec exclusive or.");
+  SUSA_TEST_EQ(bv_a.get_bits(60, 8), 0xBAu, "bitvec bits across words.");
+  bv_b.set();
+  SUSA_TEST_EQ(bv_b.count(), 68, "bitvec set keeps the unused bits zero.");
+
+  typedef std::complex <double> cplx;
+  susa::matrix <cplx> mat_ca(2, 3), mat_cb(2, 3);
+  for (size_t sizet_i = 0; sizet_i < mat_ca.size(); sizet_i++)
+  {
+      mat_ca(sizet_i) = cplx(1.0 + sizet_i, 0.5 * sizet_i - 1);
+      mat_cb(sizet_i) = cplx(2.0 - sizet_i, 0.25 * sizet_i);
+  }
+  susa::cmatrix <double> cmat_a(mat_ca), cmat_b(mat_cb), cmat_acc(mat_ca.shape());
+  susa::mac(cmat_acc, cmat_a, cmat_b);
+  double dbl_cerr = 0;
+  for (size_t sizet_i = 0; sizet_i < mat_ca.size(); sizet_i++)
+  {
+      dbl_cerr = std::max(dbl_cerr, std::abs((cmat_a * cmat_b)(sizet_i) - mat_ca(sizet_i) * mat_cb(sizet_i)));
+      dbl_cerr = std::max(dbl_cerr, std::abs(susa::conj_mul(cmat_a, cmat_b)(sizet_i) - std::conj(mat_ca(sizet_i)) * mat_cb(sizet_i)));
+      dbl_cerr = std::max(dbl_cerr, std::abs(cmat_acc(sizet_i) - mat_ca(sizet_i) * mat_cb(sizet_i)));
+      dbl_cerr = std::max(dbl_cerr, std::abs(susa::mag(cmat_a)(sizet_i) - std::norm(mat_ca(sizet_i))));
+  }
+  SUSA_TEST_EQ((dbl_cerr < 1e-14), true, "planar complex kernels.");
+  SUSA_TEST_EQ((static_cast <susa::matrix <cplx> > (cmat_a) == mat_ca && cmat_a.no_cols() == 3), true, "planar complex conversion.");
+
 
   SUSA_TEST_PRINT_STATS();
 